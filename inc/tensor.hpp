@@ -2,6 +2,7 @@
 
 #include "tensor_useful_concepts.hpp"
 #include "tensor_useful_specializations.hpp"
+#include "tensor_kernels.hpp"
 
 #include <array>
 #include <memory>
@@ -53,6 +54,107 @@ namespace tensor_lib
 			}
 		}
 
+		// Contiguous copies of trivially copyable elements go through the vectorized kernels.
+		//
+		template <typename T>
+		inline constexpr T* _copy_n(const T* source, const std::size_t n, T* destination)
+		{
+			if constexpr (std::is_trivially_copyable_v<T>)
+			{
+				kernels::copy(source, destination, n);
+				return destination + n;
+			}
+			else
+			{
+				return std::copy_n(source, n, destination);
+			}
+		}
+
+		template <typename T>
+		inline constexpr T* _uninitialized_copy_n(const T* source, const std::size_t n, T* destination)
+		{
+			if constexpr (std::is_trivially_copyable_v<T>)
+			{
+				if (!std::is_constant_evaluated())
+				{
+					kernels::copy(source, destination, n);
+					return destination + n;
+				}
+			}
+
+			return std::uninitialized_copy_n(source, n, destination);
+		}
+
+		// Flat offset of an element: the dot product of its indices with the sizes of the subdimensions one level below,
+		// the last index having a stride of one.
+		//
+		template <typename Sizes, std::size_t... Levels, typename... Indices>
+		inline constexpr std::size_t _flat_offset(const Sizes& sizes, std::index_sequence<Levels...>, const Indices ... indices) noexcept
+		{
+			return ((static_cast<std::size_t>(indices) * ((Levels + 1 < sizeof...(Levels)) ? sizes[Levels + 1] : std::size_t{ 1 })) + ...);
+		}
+
+		// True for the arguments of allocator-extended constructors, which lead with std::allocator_arg.
+		//
+		template <typename... Args>
+		inline constexpr bool _is_allocator_extended_v = false;
+
+		template <typename... Args>
+		inline constexpr bool _is_allocator_extended_v<std::allocator_arg_t, Args...> = true;
+
+		template <typename Sizes, typename... Indices>
+		inline constexpr std::size_t _flat_offset(const Sizes& sizes, const Indices ... indices) noexcept
+		{
+			return _flat_offset(sizes, std::index_sequence_for<Indices...>{}, indices...);
+		}
+
+		template <std::size_t Rank>
+		inline constexpr std::array<std::size_t, Rank> _sizes_of_subdimensions(const std::array<std::size_t, Rank>& order_of_dimension) noexcept
+		{
+			std::array<std::size_t, Rank> size_of_subdimension;
+			std::partial_sum(order_of_dimension.crbegin(), order_of_dimension.crend(), size_of_subdimension.rbegin(), std::multiplies<std::size_t>());
+
+			return size_of_subdimension;
+		}
+
+		// Shapes computed by reshape(), squeeze() and unsqueeze(), the number of elements never changes.
+		//
+		template <std::size_t NewRank, typename... Sizes>
+		inline constexpr std::array<std::size_t, NewRank> _reshaped_order(const std::size_t size, const Sizes ... sizes)
+		{
+			if ((static_cast<std::size_t>(sizes) * ...) != size)
+			{
+				throw std::runtime_error("Can't reshape a tensor into a different number of elements!");
+			}
+
+			return { static_cast<std::size_t>(sizes)... };
+		}
+
+		template <std::size_t Axis, std::size_t Rank>
+		inline constexpr std::array<std::size_t, Rank - 1> _squeezed_order(const std::span<const std::size_t, Rank> order_of_dimension)
+		{
+			if (order_of_dimension[Axis] != 1)
+			{
+				throw std::runtime_error("Can't squeeze an axis whose size isn't 1!");
+			}
+
+			std::array<std::size_t, Rank - 1> squeezed;
+			std::copy_n(order_of_dimension.begin(), Axis, squeezed.begin());
+			std::copy(order_of_dimension.begin() + Axis + 1, order_of_dimension.end(), squeezed.begin() + Axis);
+
+			return squeezed;
+		}
+
+		template <std::size_t Axis, std::size_t Rank>
+		inline constexpr std::array<std::size_t, Rank + 1> _unsqueezed_order(const std::span<const std::size_t, Rank> order_of_dimension) noexcept
+		{
+			std::array<std::size_t, Rank + 1> unsqueezed;
+			std::copy_n(order_of_dimension.begin(), Axis, unsqueezed.begin());
+			unsqueezed[Axis] = 1;
+			std::copy(order_of_dimension.begin() + Axis, order_of_dimension.end(), unsqueezed.begin() + Axis + 1);
+
+			return unsqueezed;
+		}
 	}
 
 	template <typename T>
@@ -64,7 +166,13 @@ namespace tensor_lib
 	};
 	
 
-	template <typename T, std::size_t Rank, typename allocator_type = std::allocator<std::remove_cv_t<T>>> requires (Rank != 0u)
+	// Layouts map the indices of an element to its place in the buffer. Only layout_right (row-major) is defined here, it is the layout of
+	// every tensor unless stated otherwise and the one subdimensions, expressions and the kernels are written for.
+	// layout_left, user provided layouts and the tensors that use them are in "tensor_layout.hpp".
+	//
+	struct layout_right;
+
+	template <typename T, std::size_t Rank, typename allocator_type = std::allocator<std::remove_cv_t<T>>, typename Layout = layout_right> requires (Rank != 0u)
 	class tensor;
 
 	template <typename T, std::size_t Rank, typename allocator_type = std::allocator<std::remove_cv_t<T>>> requires (Rank != 0u)
@@ -73,6 +181,9 @@ namespace tensor_lib
 	template <typename T, std::size_t Rank, typename allocator_type = std::allocator<std::remove_cv_t<T>>> requires (Rank != 0u)
 	class const_subdimension;
 
+	template <typename View>
+	class reshaped_view;
+
 	template<typename T, std::size_t Rank, typename allocator_type = std::allocator<std::remove_cv_t<T>>>
 	inline constexpr void swap(tensor<T, Rank, allocator_type>& left, tensor<T, Rank, allocator_type>& right) noexcept;
 
@@ -102,14 +213,44 @@ namespace tensor_lib
 	template<typename U, std::size_t Rank, typename Allocator>
 	struct is_tensor_object <const_subdimension<U, Rank, Allocator>> : std::true_type {};
 
+	template<typename View>
+	struct is_tensor_object <reshaped_view<View>> : std::true_type {};
+
 	template<typename T>
 	static constexpr bool is_tensor_object_v = is_tensor_object<T>::value;
 
+	// Alignment guaranteed for the buffers returned by an allocator. Nothing beyond alignof(T) is promised by default,
+	// allocators with stronger guarantees (see "tensor_allocators.hpp") specialize it and tensor::alignment reports it.
+	//
+	template<typename Allocator>
+	struct allocator_alignment : std::integral_constant<std::size_t, alignof(typename Allocator::value_type)> {};
+
+	template<typename Allocator>
+	static constexpr std::size_t allocator_alignment_v = allocator_alignment<Allocator>::value;
+
 	template <typename T>
 	concept tensor_object = is_tensor_object_v<std::decay_t<T>>;
 
+	// Lazy element-wise expressions (see "tensor_expressions.hpp") specialize this trait.
+	// tensor and subdimension only need to know that such a type exists in order to be assigned from one.
+	//
+	template<typename T>
+	struct is_tensor_expression : std::false_type {};
+
+	template<typename T>
+	static constexpr bool is_tensor_expression_v = is_tensor_expression<T>::value;
+
+	template <typename T>
+	concept tensor_expression = is_tensor_expression_v<std::decay_t<T>>;
+
+	namespace tensor_lib_internal
+	{
+		template <typename U, typename Expression>
+		inline constexpr void _assign_expression(U* destination, const Expression& expression);
+	}
+
 	template <typename T, std::size_t Rank, typename allocator_type> requires (Rank != 0u)
-	class tensor : public _tensor_common<T>, private allocator_type
+	class tensor<T, Rank, allocator_type, layout_right> : public _tensor_common<T>, private allocator_type
 	{
 		static_assert(not std::same_as<T, void>,							"T cannot be void.");
 		static_assert(not std::is_const_v<T>,								"T cannot be const qualified.");
@@ -138,11 +279,20 @@ namespace tensor_lib
 		//
 		T* _data = nullptr;
 
-		constexpr allocator_type& get_allocator() noexcept
+		// Number of elements the buffer has room for, at least size_of_current_tensor(). Only the first size_of_current_tensor() are constructed.
+		//
+		std::size_t _capacity = 0;
+
+		constexpr allocator_type& _allocator() noexcept
 		{
 			return *static_cast<allocator_type*>(this);
 		}
 
+		constexpr const allocator_type& _allocator() const noexcept
+		{
+			return *static_cast<const allocator_type*>(this);
+		}
+
 		using allocator_type_traits = std::allocator_traits<allocator_type>;
 
 		static constexpr bool no_throw_default_construction = std::is_nothrow_default_constructible_v<T>;
@@ -157,6 +307,16 @@ namespace tensor_lib
 		inline constexpr void uninitialized_fill(ForwardIt first, ForwardIt last, const Args& ... args)
 		{
 			using V = std::iter_value_t<ForwardIt>;
+
+			if constexpr (std::is_pointer_v<ForwardIt> && std::is_arithmetic_v<V> && (sizeof...(Args) == 1))
+			{
+				if (!std::is_constant_evaluated())
+				{
+					kernels::fill(first, static_cast<std::size_t>(last - first), V(args...));
+					return;
+				}
+			}
+
 			ForwardIt current = first;
 
 			try 
@@ -239,15 +399,18 @@ namespace tensor_lib
 
 			std::partial_sum(_order_of_dimension.crbegin(), _order_of_dimension.crend(), _size_of_subdimension.rbegin(), std::multiplies<size_t>());
 
-			_data = allocator_type_traits::allocate(get_allocator(), size_of_current_tensor());
+			const std::size_t size = size_of_current_tensor();
+
+			_data = allocator_type_traits::allocate(_allocator(), size);
+			_capacity = size;
 
 			try 
 			{
-				uninitialized_fill(_data, _data + size_of_current_tensor(), data...);
+				uninitialized_fill(_data, _data + size, data...);
 			}
 			catch (...)
 			{
-				allocator_type_traits::deallocate(get_allocator(), _data, size_of_current_tensor());
+				allocator_type_traits::deallocate(_allocator(), _data, size_of_current_tensor());
 				throw;
 			}
 			
@@ -287,11 +450,285 @@ namespace tensor_lib
 			_assign_subdimensions<Index + 1, Args...>(tensors...);
 		}
 
+		// Destroys the elements and returns the buffer to the allocator, leaving an empty tensor.
+		//
+		inline constexpr void _release() noexcept
+		{
+			if (_data)
+			{
+				std::destroy_n(_data, size_of_current_tensor());
+				allocator_type_traits::deallocate(_allocator(), _data, _capacity);
+				_data = nullptr;
+				_capacity = 0;
+			}
+
+			_order_of_dimension = {};
+			_size_of_subdimension = {};
+		}
+
+		inline constexpr void _value_construct_n(T* destination, const std::size_t n)
+		{
+			if (std::is_constant_evaluated())
+			{
+				tensor_lib_internal::_constexpr_uninitialized_value_construct_n(destination, n);
+			}
+			else
+			{
+				std::uninitialized_value_construct_n(destination, n);
+			}
+		}
+
+		// Moves 'n' elements into uninitialized memory. Elements that could throw while being moved are copied instead,
+		// so the source is left unchanged if that happens.
+		//
+		static inline constexpr void _relocate_n(T* source, const std::size_t n, T* destination)
+		{
+			if constexpr (std::is_trivially_copyable_v<T>)
+			{
+				tensor_lib_internal::_uninitialized_copy_n(source, n, destination);
+			}
+			else if constexpr (std::is_nothrow_move_constructible_v<T>)
+			{
+				std::uninitialized_move_n(source, n, destination);
+			}
+			else
+			{
+				std::uninitialized_copy_n(source, n, destination);
+			}
+		}
+
+		// Moves the elements into a buffer of 'new_capacity' elements, the tensor is left unchanged if that throws.
+		//
+		inline constexpr void _reallocate(const std::size_t new_capacity)
+		{
+			const std::size_t size = size_of_current_tensor();
+			T* buffer = allocator_type_traits::allocate(_allocator(), new_capacity);
+
+			try
+			{
+				_relocate_n(_data, size, buffer);
+			}
+			catch (...)
+			{
+				allocator_type_traits::deallocate(_allocator(), buffer, new_capacity);
+				throw;
+			}
+
+			if (_data)
+			{
+				std::destroy_n(_data, size);
+				allocator_type_traits::deallocate(_allocator(), _data, _capacity);
+			}
+
+			_data = buffer;
+			_capacity = new_capacity;
+		}
+
+		// Appends 'slices' slices of the shape 'slice_ranks' along the first dimension, 'construct' builds their elements in the uninitialized memory
+		// it is given and cleans up after itself if it throws. Running out of capacity at least doubles it, so appending is amortized O(1).
+		// The new elements are constructed before the old ones are relocated, which lets them be copies of elements of this tensor.
+		//
+		template <typename Ranks, typename Construct>
+		inline constexpr void _append(const std::size_t slices, const Ranks& slice_ranks, Construct construct)
+		{
+			if (!empty() && !std::equal(slice_ranks.begin(), slice_ranks.end(), _order_of_dimension.begin() + 1))
+			{
+				throw std::runtime_error("Can't append a tensor of a different size!");
+			}
+
+			const std::size_t count = slices * std::accumulate(slice_ranks.begin(), slice_ranks.end(), std::size_t{ 1 }, std::multiplies<std::size_t>());
+			const std::size_t size = size_of_current_tensor();
+
+			if (count == 0)
+			{
+				return;
+			}
+
+			if (size + count <= _capacity)
+			{
+				construct(_data + size);
+			}
+			else
+			{
+				const std::size_t new_capacity = std::max(size + count, 2 * _capacity);
+				T* buffer = allocator_type_traits::allocate(_allocator(), new_capacity);
+
+				try
+				{
+					construct(buffer + size);
+				}
+				catch (...)
+				{
+					allocator_type_traits::deallocate(_allocator(), buffer, new_capacity);
+					throw;
+				}
+
+				try
+				{
+					_relocate_n(_data, size, buffer);
+				}
+				catch (...)
+				{
+					std::destroy_n(buffer + size, count);
+					allocator_type_traits::deallocate(_allocator(), buffer, new_capacity);
+					throw;
+				}
+
+				if (_data)
+				{
+					std::destroy_n(_data, size);
+					allocator_type_traits::deallocate(_allocator(), _data, _capacity);
+				}
+
+				_data = buffer;
+				_capacity = new_capacity;
+			}
+
+			_order_of_dimension[0] = (size == 0) ? slices : _order_of_dimension[0] + slices;
+			std::copy(slice_ranks.begin(), slice_ranks.end(), _order_of_dimension.begin() + 1);
+			std::partial_sum(_order_of_dimension.crbegin(), _order_of_dimension.crend(), _size_of_subdimension.rbegin(), std::multiplies<std::size_t>());
+		}
+
+		// Assigns the elements present in both the current shape and the given one to their place in 'destination', a buffer of the given shape.
+		// Each run along the last dimension is contiguous in both buffers.
+		//
+		inline constexpr void _copy_overlap(T* destination, const std::array<std::size_t, Rank>& size_of_subdimension, const std::array<std::size_t, Rank>& order_of_dimension)
+		{
+			std::array<std::size_t, Rank> overlap;
+			std::array<std::size_t, Rank> index{};
+
+			for (std::size_t level = 0; level < Rank; level++)
+			{
+				overlap[level] = std::min(order_of_dimension[level], _order_of_dimension[level]);
+			}
+
+			while (true)
+			{
+				std::size_t source_offset = 0, destination_offset = 0;
+
+				for (std::size_t level = 0; level + 1 < Rank; level++)
+				{
+					source_offset += index[level] * _size_of_subdimension[level + 1];
+					destination_offset += index[level] * size_of_subdimension[level + 1];
+				}
+
+				if constexpr (std::is_nothrow_move_assignable_v<T>)
+				{
+					std::move(_data + source_offset, _data + source_offset + overlap[Rank - 1], destination + destination_offset);
+				}
+				else
+				{
+					std::copy_n(_data + source_offset, overlap[Rank - 1], destination + destination_offset);
+				}
+
+				std::size_t level = Rank - 1;
+
+				while (level > 0 && ++index[level - 1] == overlap[level - 1])
+				{
+					index[level - 1] = 0;
+					--level;
+				}
+
+				if (level == 0)
+				{
+					return;
+				}
+			}
+		}
+
+		// Copies the elements of a tensor object of the given shape. The buffer is reused when it has room for them and copying them
+		// can't throw halfway (trivially copyable elements are copied as bytes). Otherwise a new buffer is filled first,
+		// so if a copy throws the tensor is left untouched.
+		//
+		template <typename Ranks>
+		inline constexpr void _assign_copy(const T* source, const Ranks& ranks)
+		{
+			std::array<std::size_t, Rank> order_of_dimension;
+			std::array<std::size_t, Rank> size_of_subdimension;
+
+			std::copy_n(ranks.begin(), Rank, order_of_dimension.begin());
+			std::partial_sum(order_of_dimension.crbegin(), order_of_dimension.crend(), size_of_subdimension.rbegin(), std::multiplies<std::size_t>());
+
+			const std::size_t size = size_of_subdimension[0];
+			const std::size_t old_size = size_of_current_tensor();
+
+			if (size <= _capacity && std::is_nothrow_copy_assignable_v<T> && std::is_nothrow_copy_constructible_v<T>)
+			{
+				tensor_lib_internal::_copy_n(source, std::min(size, old_size), _data);
+
+				if (size > old_size)
+				{
+					tensor_lib_internal::_uninitialized_copy_n(source + old_size, size - old_size, _data + old_size);
+				}
+				else
+				{
+					std::destroy_n(_data + size, old_size - size);
+				}
+			}
+			else
+			{
+				T* buffer = size ? allocator_type_traits::allocate(_allocator(), size) : nullptr;
+
+				try
+				{
+					tensor_lib_internal::_uninitialized_copy_n(source, size, buffer);
+				}
+				catch (...)
+				{
+					allocator_type_traits::deallocate(_allocator(), buffer, size);
+					throw;
+				}
+
+				_release();
+				_data = buffer;
+				_capacity = size;
+			}
+
+			_order_of_dimension = order_of_dimension;
+			_size_of_subdimension = size_of_subdimension;
+		}
+
+		template <std::size_t NewRank>
+		inline constexpr auto _reshaped(const std::array<std::size_t, NewRank>& order_of_dimension) & noexcept
+		{
+			return reshaped_view<subdimension<T, NewRank, allocator_type>>(std::span<T>(_data, size_of_current_tensor()), order_of_dimension);
+		}
+
+		template <std::size_t NewRank>
+		inline constexpr auto _reshaped(const std::array<std::size_t, NewRank>& order_of_dimension) const & noexcept
+		{
+			return reshaped_view<const_subdimension<T, NewRank, allocator_type>>(std::span<const T>(_data, size_of_current_tensor()), order_of_dimension);
+		}
+
+		template <std::size_t NewRank>
+		inline constexpr auto _reshaped(const std::array<std::size_t, NewRank>& order_of_dimension) && noexcept
+		{
+			tensor<T, NewRank, allocator_type> result(_allocator());
+
+			// Empty tensors have all their sizes 0, whatever shape they're reshaped to.
+			//
+			if (!empty())
+			{
+				result._order_of_dimension = order_of_dimension;
+				result._size_of_subdimension = tensor_lib_internal::_sizes_of_subdimensions(order_of_dimension);
+			}
+
+			result._data = std::exchange(_data, nullptr);
+			result._capacity = std::exchange(_capacity, 0);
+			_order_of_dimension = {};
+			_size_of_subdimension = {};
+
+			return result;
+		}
+
 	public:
 
 		friend class subdimension<T, Rank, allocator_type>;
 		friend class const_subdimension<T, Rank, allocator_type>;
 
+		template <typename U, std::size_t OtherRank, typename other_allocator_type, typename OtherLayout> requires (OtherRank != 0u)
+		friend class tensor;
+
 		friend constexpr void swap<T, Rank, allocator_type>(tensor& left, tensor& right) noexcept;
 		friend constexpr void swap<T, Rank, allocator_type>(tensor&& left, tensor&& right) noexcept;
 
@@ -307,6 +744,9 @@ namespace tensor_lib
 		using subdimension_type = std::conditional_t <(Rank > 1), subdimension<T, (Rank <= 1) ? 1 : Rank - 1, allocator_type>, T&>;
 		using const_subdimension_type = std::conditional_t <(Rank > 1), const_subdimension<T, (Rank <= 1) ? 1 : Rank - 1, allocator_type>, const T&>;
 
+		// data() is always aligned to this many bytes.
+		//
+		static constexpr std::size_t alignment = allocator_alignment_v<allocator_type>;
 
 		// All tensor() constructors take a series of unsigned, non-zero, integeres that reprezent
 		// the sizes of each dimension, be it as an array or initializer_list.
@@ -323,7 +763,18 @@ namespace tensor_lib
 
 		template<typename... Sizes> requires (sizeof...(Sizes) == Rank) && useful_concepts::integrals<Sizes...>
 		inline constexpr tensor(const Sizes ... sizes)
-			: _order_of_dimension{ {} }
+			: tensor(std::allocator_arg, allocator_type{}, sizes...)
+		{
+
+		}
+
+		// Allocator-extended constructors, the allocator comes first (tagged by std::allocator_arg) because the sizes are variadic.
+		// Ex: tensor<float, 2, arena_allocator<float>> t(std::allocator_arg, arena_allocator<float>(my_arena), 3, 4);
+		//
+		template<typename... Sizes> requires (sizeof...(Sizes) == Rank) && useful_concepts::integrals<Sizes...>
+		inline constexpr tensor(std::allocator_arg_t, const allocator_type& allocator, const Sizes ... sizes)
+			: allocator_type { allocator }
+			, _order_of_dimension{ {} }
 			, _size_of_subdimension{ {} }
 			, _data { nullptr }
 		{
@@ -336,7 +787,8 @@ namespace tensor_lib
 				std::array<std::size_t, Rank> temp_order_of_dimension { static_cast<std::size_t>(sizes)... };
 				std::array<std::size_t, Rank> temp_size_of_subdimension;
 				std::partial_sum(temp_order_of_dimension.crbegin(), temp_order_of_dimension.crend(), temp_size_of_subdimension.rbegin(), std::multiplies<std::size_t>());
-				_data = allocator_type_traits::allocate(get_allocator(), temp_size_of_subdimension[0]);
+				_data = allocator_type_traits::allocate(_allocator(), temp_size_of_subdimension[0]);
+				_capacity = temp_size_of_subdimension[0];
 				try
 				{
 					if (std::is_constant_evaluated())
@@ -350,7 +802,8 @@ namespace tensor_lib
 				}
 				catch (...)
 				{
-					allocator_type_traits::deallocate(get_allocator(), _data, temp_size_of_subdimension.front());
+					allocator_type_traits::deallocate(_allocator(), _data, temp_size_of_subdimension.front());
+					throw;
 				}
 				std::copy_n(temp_order_of_dimension.cbegin(), Rank, _order_of_dimension.begin());
 				std::copy_n(temp_size_of_subdimension.cbegin(), Rank, _size_of_subdimension.begin());
@@ -358,10 +811,11 @@ namespace tensor_lib
 		}
 
 		inline constexpr tensor(tensor&& other) noexcept
-			: allocator_type { other.get_allocator() }
+			: allocator_type { other._allocator() }
 			, _order_of_dimension(std::exchange(other._order_of_dimension, {}))
 			, _size_of_subdimension(std::exchange(other._size_of_subdimension, {}))
 			, _data(std::exchange(other._data, nullptr))
+			, _capacity(std::exchange(other._capacity, 0))
 		{
 
 		}
@@ -369,25 +823,27 @@ namespace tensor_lib
 		inline constexpr tensor(tensor&& other, const allocator_type& allocator)
 			: allocator_type { allocator }
 		{
-			if (get_allocator() == other.get_allocator())
+			if (_allocator() == other._allocator())
 			{
 				_order_of_dimension = std::exchange(other._order_of_dimension, {});
 				_size_of_subdimension = std::exchange(other._size_of_subdimension, {});
 				_data = std::exchange(other._data, nullptr);
+				_capacity = std::exchange(other._capacity, 0);
 			}
 			else
 			{
 				_order_of_dimension = other._order_of_dimension;
 				_size_of_subdimension = other._size_of_subdimension;
-				_data = allocator_type_traits::allocate(get_allocator(), size_of_current_tensor());
+				_data = allocator_type_traits::allocate(_allocator(), size_of_current_tensor());
+				_capacity = size_of_current_tensor();
 
 				try
 				{
-					std::uninitialized_copy_n(other.cbegin(), size_of_current_tensor(), _data);
+					tensor_lib_internal::_uninitialized_copy_n(other.data(), size_of_current_tensor(), _data);
 				}
 				catch (...)
 				{
-					allocator_type_traits::deallocate(get_allocator(), _data, size_of_current_tensor());
+					allocator_type_traits::deallocate(_allocator(), _data, size_of_current_tensor());
 					throw;
 				}
 			}
@@ -399,7 +855,8 @@ namespace tensor_lib
 			, _order_of_dimension { data.size() }
 			, _size_of_subdimension { data.size() }
 		{
-			_data = allocator_type_traits::allocate(get_allocator(), data.size());
+			_data = allocator_type_traits::allocate(_allocator(), data.size());
+			_capacity = data.size();
 
 			try
 			{
@@ -407,7 +864,7 @@ namespace tensor_lib
 			}
 			catch (...)
 			{
-				allocator_type_traits::deallocate(get_allocator(), _data, size_of_current_tensor());
+				allocator_type_traits::deallocate(_allocator(), _data, size_of_current_tensor());
 				throw;
 			}
 		}
@@ -418,7 +875,8 @@ namespace tensor_lib
 			_construct_order_array<Rank>(data);
 			std::partial_sum(_order_of_dimension.crbegin(), _order_of_dimension.crend(), _size_of_subdimension.rbegin(), std::multiplies<std::size_t>());
 
-			_data = allocator_type_traits::allocate(get_allocator(), size_of_current_tensor());
+			_data = allocator_type_traits::allocate(_allocator(), size_of_current_tensor());
+			_capacity = size_of_current_tensor();
 
 			try
 			{
@@ -433,53 +891,132 @@ namespace tensor_lib
 			}
 			catch (...)
 			{
-				allocator_type_traits::deallocate(get_allocator(), _data, size_of_current_tensor());
+				allocator_type_traits::deallocate(_allocator(), _data, size_of_current_tensor());
 				throw;
 			}
 			*this = data; 
 		}
 
 		inline constexpr tensor(const tensor& other)
-			: allocator_type { other.get_allocator() }
+			: tensor(other, allocator_type_traits::select_on_container_copy_construction(other._allocator()))
+		{
+
+		}
+
+		inline constexpr tensor(const tensor& other, const allocator_type& allocator)
+			: allocator_type { allocator }
 			, _order_of_dimension(other._order_of_dimension)
 			, _size_of_subdimension(other._size_of_subdimension)
-			, _data(allocator_type_traits::allocate(get_allocator(), other.size_of_current_tensor()))
+			, _data(allocator_type_traits::allocate(_allocator(), other.size_of_current_tensor()))
+			, _capacity(other.size_of_current_tensor())
 		{
 			try
 			{
-				std::uninitialized_copy_n(other.cbegin(), size_of_current_tensor(), _data);
+				tensor_lib_internal::_uninitialized_copy_n(other.data(), size_of_current_tensor(), _data);
 			}
 			catch (...)
 			{
-				allocator_type_traits::deallocate(get_allocator(), _data, size_of_current_tensor());
+				allocator_type_traits::deallocate(_allocator(), _data, size_of_current_tensor());
 				throw;
 			}
 		}
 
 		inline constexpr tensor(const subdimension<T, Rank>& subdimension, const allocator_type& allocator = allocator_type{})
 			: allocator_type { allocator }
-			, _data(allocator_type_traits::allocate(get_allocator(), subdimension.size_of_current_tensor()))
+			, _data(allocator_type_traits::allocate(_allocator(), subdimension.size_of_current_tensor()))
+			, _capacity(subdimension.size_of_current_tensor())
 		{
 			try
 			{
-				std::uninitialized_copy_n(subdimension.cbegin(), subdimension.size_of_current_tensor(), _data);
+				tensor_lib_internal::_uninitialized_copy_n(subdimension.data(), subdimension.size_of_current_tensor(), _data);
 			}
 			catch (...)
 			{
-				allocator_type_traits::deallocate(get_allocator(), _data, subdimension.size_of_current_tensor());
+				allocator_type_traits::deallocate(_allocator(), _data, subdimension.size_of_current_tensor());
 				throw;
 			}
 			std::copy_n(subdimension._order_of_dimension.begin(), Rank, _order_of_dimension.begin());
 			std::copy_n(subdimension._size_of_subdimension.begin(), Rank, _size_of_subdimension.begin());
-			
+
+		}
+
+		inline constexpr tensor(const const_subdimension<T, Rank>& subdimension, const allocator_type& allocator = allocator_type{})
+			: allocator_type { allocator }
+			, _data(allocator_type_traits::allocate(_allocator(), subdimension.size_of_current_tensor()))
+			, _capacity(subdimension.size_of_current_tensor())
+		{
+			try
+			{
+				tensor_lib_internal::_uninitialized_copy_n(subdimension.data(), subdimension.size_of_current_tensor(), _data);
+			}
+			catch (...)
+			{
+				allocator_type_traits::deallocate(_allocator(), _data, subdimension.size_of_current_tensor());
+				throw;
+			}
+			std::copy_n(subdimension.get_ranks().begin(), Rank, _order_of_dimension.begin());
+			std::copy_n(subdimension.get_sizes().begin(), Rank, _size_of_subdimension.begin());
+		}
+
+		// Evaluates a lazy expression (ex: "b * c + d") in a single pass directly into the newly allocated buffer.
+		//
+		template <typename Expression> requires (tensor_expression<Expression> && (Expression::rank == Rank))
+		inline constexpr tensor(const Expression& expression, const allocator_type& allocator = allocator_type{})
+			: allocator_type { allocator }
+		{
+			if (expression.size_of_current_tensor() == 0)
+			{
+				return;
+			}
+
+			std::copy_n(expression.get_ranks().begin(), Rank, _order_of_dimension.begin());
+			std::partial_sum(_order_of_dimension.crbegin(), _order_of_dimension.crend(), _size_of_subdimension.rbegin(), std::multiplies<std::size_t>());
+
+			_data = allocator_type_traits::allocate(_allocator(), size_of_current_tensor());
+			_capacity = size_of_current_tensor();
+
+			try
+			{
+				if (std::is_constant_evaluated())
+				{
+					tensor_lib_internal::_constexpr_uninitialized_value_construct_n(_data, size_of_current_tensor());
+				}
+				else
+				{
+					std::uninitialized_default_construct_n(_data, size_of_current_tensor());
+				}
+			}
+			catch (...)
+			{
+				allocator_type_traits::deallocate(_allocator(), _data, size_of_current_tensor());
+				throw;
+			}
+
+			try
+			{
+				tensor_lib_internal::_assign_expression(_data, expression);
+			}
+			catch (...)
+			{
+				std::destroy_n(_data, size_of_current_tensor());
+				allocator_type_traits::deallocate(_allocator(), _data, size_of_current_tensor());
+				throw;
+			}
 		}
 
-		template<typename ... Args> requires (sizeof...(Args) > Rank && !(is_tensor<Args, T, Rank - 1, allocator_type> && ...))
+		template<typename ... Args> requires (sizeof...(Args) > Rank && !(is_tensor<Args, T, Rank - 1, allocator_type> && ...) && !tensor_lib_internal::_is_allocator_extended_v<Args...>)
 			inline constexpr tensor(const Args& ... args)
 		{
 			_construct_order_array_and_forward_rest<Rank, Args...>(args...);
 		}
 
+		template<typename ... Args> requires (sizeof...(Args) > Rank)
+			inline constexpr tensor(std::allocator_arg_t, const allocator_type& allocator, const Args& ... args)
+			: allocator_type { allocator }
+		{
+			_construct_order_array_and_forward_rest<Rank, Args...>(args...);
+		}
+
 		template<typename First, typename ... Args> requires (is_tensor<First, T, Rank - 1, allocator_type>) && (is_tensor<Args, T, Rank - 1, allocator_type> && ...) && (sizeof...(Args) > 0)
 		inline constexpr tensor(const First& first, const Args& ... tensors)
 		{
@@ -493,7 +1030,8 @@ namespace tensor_lib
 
 			std::partial_sum(_order_of_dimension.crbegin(), _order_of_dimension.crend(), _size_of_subdimension.rbegin(), std::multiplies<std::size_t>());
 
-			_data = allocator_type_traits::allocate(get_allocator(), size_of_current_tensor());
+			_data = allocator_type_traits::allocate(_allocator(), size_of_current_tensor());
+			_capacity = size_of_current_tensor();
 			
 			try
 			{
@@ -501,25 +1039,34 @@ namespace tensor_lib
 			}
 			catch (...)
 			{
-				allocator_type_traits::deallocate(get_allocator(), _data, size_of_current_tensor());
+				allocator_type_traits::deallocate(_allocator(), _data, size_of_current_tensor());
 				throw;
 			}
 		}
 
 		inline constexpr auto& operator= (const tensor& other)
 		{
-			if (!std::is_fundamental_v<T>)
+			if (this == std::addressof(other))
 			{
-				std::destroy_n(_data, size_of_current_tensor());
+				return *this;
 			}
 
-			allocator_type_traits::deallocate(get_allocator(), _data, size_of_current_tensor());
+			if constexpr (allocator_type_traits::propagate_on_container_copy_assignment::value)
+			{
+				// Our buffer can only be reused if the allocator we're taking over is able to release it.
+				//
+				if constexpr (!allocator_type_traits::is_always_equal::value)
+				{
+					if (_allocator() != other._allocator())
+					{
+						_release();
+					}
+				}
 
-			_order_of_dimension = other.get_ranks();
-			_size_of_subdimension = other.get_sizes();
+				_allocator() = other._allocator();
+			}
 
-			_data = allocator_type_traits::allocate(get_allocator(), size_of_current_tensor());
-			std::uninitialized_copy_n(other.cbegin(), size_of_current_tensor(), &_data[0]);
+			_assign_copy(other.data(), other.get_ranks());
 
 			return *this;
 		}
@@ -527,58 +1074,58 @@ namespace tensor_lib
 		template <typename Tensor_Type>
 		inline constexpr auto& operator= (const Tensor_Type& other) requires (is_tensor<Tensor_Type, T, Rank, allocator_type> && !std::is_same_v<Tensor_Type, tensor>)
 		{
-			if (size_of_current_tensor() != other.size_of_current_tensor())
-			{
-				if (size_of_current_tensor())
-				{
-					if (!std::is_fundamental_v<T>)
-					{
-						std::destroy_n(_data, size_of_current_tensor());
-					}
-
-					allocator_type_traits::deallocate(get_allocator(), _data, size_of_current_tensor());
-				}
-
-				T* temp_data = allocator_type_traits::allocate(get_allocator(), size_of_current_tensor());
+			_assign_copy(other.data(), other.get_ranks());
 
-				try 
-				{
-					std::uninitialized_copy_n(other.cbegin(), size_of_current_tensor(), temp_data);
-				}
-				catch (...)
-				{
-					allocator_type_traits::deallocate(get_allocator(), temp_data, size_of_current_tensor());
-				}
+			return *this;
+		}
 
-				_data = temp_data;
-				
+		// Element-wise expressions only ever read the element found at the same index they write, so evaluating
+		// in place is safe even when the expression refers to this tensor. A different shape requires a new buffer.
+		//
+		template <typename Expression> requires (tensor_expression<Expression> && (Expression::rank == Rank))
+		inline constexpr auto& operator= (const Expression& expression)
+		{
+			if (std::equal(_order_of_dimension.begin(), _order_of_dimension.end(), expression.get_ranks().begin(), expression.get_ranks().end()))
+			{
+				tensor_lib_internal::_assign_expression(_data, expression);
 			}
 			else
 			{
-				std::copy_n(other.cbegin(), size_of_current_tensor(), _data);
+				tensor temp(expression, _allocator());
+				tensor_lib::swap(*this, temp);
 			}
 
-			_order_of_dimension = other.get_ranks();
-			_size_of_subdimension = other.get_sizes();
-
 			return *this;
 		}
 
-		inline constexpr auto& operator= (tensor&& other) noexcept
+		// The buffer of 'other' is taken over when it can be released through our allocator afterwards, that is when the allocator
+		// propagates on move assignment (std::allocator) or both allocators compare equal (ex: two pmr allocators of the same resource).
+		// Otherwise the elements are moved into a buffer of our own.
+		//
+		inline constexpr auto& operator= (tensor&& other)
+			noexcept(allocator_type_traits::propagate_on_container_move_assignment::value || allocator_type_traits::is_always_equal::value)
 		{
 			if (this != std::addressof(other))
 			{
-				if (size_of_current_tensor())
+				if constexpr (!allocator_type_traits::propagate_on_container_move_assignment::value && !allocator_type_traits::is_always_equal::value)
 				{
-					if constexpr (!std::is_fundamental_v<T>)
+					if (_allocator() != other._allocator())
 					{
-						std::destroy_n(_data, size_of_current_tensor());
+						tensor temp(std::move(other), _allocator());
+						tensor_lib::swap(*this, temp);
+						return *this;
 					}
+				}
 
-					allocator_type_traits::deallocate(get_allocator(), _data, size_of_current_tensor());
+				_release();
+
+				if constexpr (allocator_type_traits::propagate_on_container_move_assignment::value)
+				{
+					_allocator() = std::move(other._allocator());
 				}
 
 				_data = std::exchange(other._data, nullptr);
+				_capacity = std::exchange(other._capacity, 0);
 				_order_of_dimension = std::exchange(other._order_of_dimension, {});
 				_size_of_subdimension = std::exchange(other._size_of_subdimension, {});
 			}
@@ -593,7 +1140,7 @@ namespace tensor_lib
 				throw std::runtime_error("Size of tensor we take values from must match the size of current tensor");
 			}
 
-			std::copy_n(&other._data[0], size_of_current_tensor(), &_data[0]);
+			tensor_lib_internal::_copy_n(other.data(), size_of_current_tensor(), _data);
 
 			return *this;
 		}
@@ -615,7 +1162,7 @@ namespace tensor_lib
 
 			std::partial_sum(temp_order_of_dimension.crbegin(), temp_order_of_dimension.crend(), temp_size_of_subdimension.rbegin(), std::multiplies<std::size_t>());
 
-			temp_data = allocator_type_traits::allocate(get_allocator(), temp_size_of_subdimension[0]);
+			temp_data = allocator_type_traits::allocate(_allocator(), temp_size_of_subdimension[0]);
 
 			ptrdiff_t index = 0;
 
@@ -641,21 +1188,14 @@ namespace tensor_lib
 					std::destroy_at(&temp_data[index]);
 					--index;
 				}
-				allocator_type_traits::deallocate(get_allocator(), temp_data, size_of_current_tensor());
+				allocator_type_traits::deallocate(_allocator(), temp_data, temp_size_of_subdimension[0]);
 				throw;
 			}
 
-			if (size_of_current_tensor())
-			{
-				if (!std::is_fundamental_v<T>)
-				{
-					std::destroy_n(_data, size_of_current_tensor());
-				}
-
-				allocator_type_traits::deallocate(get_allocator(), _data, size_of_current_tensor());
-			}
+			_release();
 
 			_data = temp_data;
+			_capacity = temp_size_of_subdimension[0];
 			std::copy_n(temp_order_of_dimension.cbegin(), Rank, _order_of_dimension.begin());
 			std::copy_n(temp_size_of_subdimension.cbegin(), Rank, _size_of_subdimension.begin());
 
@@ -689,81 +1229,284 @@ namespace tensor_lib
 				(*this)[index] = *(it + index);
 			}
 
-			return (*this);
+			return (*this);
+		}
+
+		inline constexpr auto& operator=(const std::initializer_list<std::initializer_list<T>>& data) requires (Rank == 2)
+		{
+			if (order_of_current_dimension() != data.size())
+			{
+				throw std::runtime_error("Size of initializer_list doesn't match size of dimension!");
+			}
+
+			const auto it = data.begin();
+
+			for (size_t index = 0; index < order_of_current_dimension(); index++)
+			{
+				(*this)[index] = *(it + index);
+			}
+
+			return (*this);
+		}
+
+		inline constexpr auto& operator=(const std::initializer_list<T>& data)
+		{
+			if (size_of_current_tensor() != data.size())
+			{
+				throw std::runtime_error("Size of initializer_list doesn't match size of tensor!");
+			}
+
+			std::copy_n(data.begin(), data.size(), begin());
+
+			return (*this);
+		}
+
+		// Gives the tensor the new sizes with default initialized elements, the previous elements are discarded.
+		// The buffer is kept when it has room for the new elements.
+		//
+		template<typename... Sizes> requires (sizeof...(Sizes) == Rank) && useful_concepts::integrals<Sizes...>
+		inline constexpr void resize(const Sizes ... new_sizes)
+		{
+			std::destroy_n(_data, size_of_current_tensor());
+			std::fill_n(_order_of_dimension.begin(), Rank, 0u);
+			std::fill_n(_size_of_subdimension.begin(), Rank, 0u);
+
+			if (!(new_sizes && ...))
+			{
+				return;
+			}
+
+			std::array<std::size_t, Rank> order_of_dimension{ static_cast<std::size_t>(new_sizes)... };
+			std::array<std::size_t, Rank> size_of_subdimension;
+			std::partial_sum(order_of_dimension.crbegin(), order_of_dimension.crend(), size_of_subdimension.rbegin(), std::multiplies<std::size_t>());
+
+			if (size_of_subdimension[0] > _capacity)
+			{
+				_release();
+				_data = allocator_type_traits::allocate(_allocator(), size_of_subdimension[0]);
+				_capacity = size_of_subdimension[0];
+			}
+
+			if (std::is_constant_evaluated())
+			{
+				tensor_lib_internal::_constexpr_uninitialized_value_construct_n(&_data[0], size_of_subdimension[0]);
+			}
+			else
+			{
+				std::uninitialized_default_construct_n(&_data[0], size_of_subdimension[0]);
+			}
+
+			_order_of_dimension = order_of_dimension;
+			_size_of_subdimension = size_of_subdimension;
+		}
+
+		// Gives the tensor the new sizes while keeping every element whose indices are still in range at the same indices,
+		// new elements are value initialized (zero for arithmetic types). When only the first dimension changes the elements don't move:
+		// shrinking keeps the buffer and growing beyond the capacity at least doubles it, so growing one row at a time is amortized O(1)
+		// like std::vector::push_back.
+		// If an element can't be constructed the tensor is left unchanged.
+		//
+		template<typename... Sizes> requires (sizeof...(Sizes) == Rank) && useful_concepts::integrals<Sizes...>
+		inline constexpr void resize_preserve(const Sizes ... new_sizes)
+		{
+			if (!(new_sizes && ...))
+			{
+				std::destroy_n(_data, size_of_current_tensor());
+				std::fill_n(_order_of_dimension.begin(), Rank, 0u);
+				std::fill_n(_size_of_subdimension.begin(), Rank, 0u);
+				return;
+			}
+
+			std::array<std::size_t, Rank> order_of_dimension{ static_cast<std::size_t>(new_sizes)... };
+			std::array<std::size_t, Rank> size_of_subdimension;
+			std::partial_sum(order_of_dimension.crbegin(), order_of_dimension.crend(), size_of_subdimension.rbegin(), std::multiplies<std::size_t>());
+
+			const std::size_t size = size_of_subdimension[0];
+			const std::size_t old_size = size_of_current_tensor();
+
+			if (old_size == 0 || std::equal(order_of_dimension.begin() + 1, order_of_dimension.end(), _order_of_dimension.begin() + 1))
+			{
+				if (size > _capacity)
+				{
+					_reallocate(std::max(size, 2 * _capacity));
+				}
+
+				if (size > old_size)
+				{
+					_value_construct_n(_data + old_size, size - old_size);
+				}
+				else
+				{
+					std::destroy_n(_data + size, old_size - size);
+				}
+			}
+			else
+			{
+				T* buffer = allocator_type_traits::allocate(_allocator(), size);
+
+				try
+				{
+					_value_construct_n(buffer, size);
+				}
+				catch (...)
+				{
+					allocator_type_traits::deallocate(_allocator(), buffer, size);
+					throw;
+				}
+
+				try
+				{
+					_copy_overlap(buffer, size_of_subdimension, order_of_dimension);
+				}
+				catch (...)
+				{
+					std::destroy_n(buffer, size);
+					allocator_type_traits::deallocate(_allocator(), buffer, size);
+					throw;
+				}
+
+				_release();
+				_data = buffer;
+				_capacity = size;
+			}
+
+			_order_of_dimension = order_of_dimension;
+			_size_of_subdimension = size_of_subdimension;
+		}
+
+		// Number of elements the tensor can hold without allocating.
+		//
+		inline constexpr std::size_t capacity() const noexcept
+		{
+			return _capacity;
 		}
 
-		inline constexpr auto& operator=(const std::initializer_list<std::initializer_list<T>>& data) requires (Rank == 2)
+		// Makes room for at least 'new_capacity' elements, the elements and the shape are unchanged.
+		//
+		inline constexpr void reserve(const std::size_t new_capacity)
 		{
-			if (order_of_current_dimension() != data.size())
+			if (new_capacity > _capacity)
 			{
-				throw std::runtime_error("Size of initializer_list doesn't match size of dimension!");
+				_reallocate(new_capacity);
 			}
+		}
 
-			const auto it = data.begin();
-
-			for (size_t index = 0; index < order_of_current_dimension(); index++)
+		inline constexpr void shrink_to_fit()
+		{
+			if (_capacity > size_of_current_tensor())
 			{
-				(*this)[index] = *(it + index);
+				if (size_of_current_tensor() == 0)
+				{
+					_release();
+				}
+				else
+				{
+					_reallocate(size_of_current_tensor());
+				}
 			}
+		}
 
-			return (*this);
+		// Appends 'slice', a tensor object of rank Rank - 1, after the last slice along the first dimension.
+		// Its sizes must match the trailing sizes of the tensor, unless the tensor is empty and takes them over.
+		//
+		template <typename Slice> requires (Rank > 1u) && tensor_object<Slice>
+			&& (decltype(std::declval<const Slice&>().get_ranks())::extent == Rank - 1)
+			&& std::same_as<std::remove_cvref_t<decltype(*std::declval<const Slice&>().data())>, T>
+		inline constexpr void push_back(const Slice& slice)
+		{
+			const std::size_t count = slice.size_of_current_tensor();
+			const T* source = slice.data();
+
+			_append(1, slice.get_ranks(), [source, count](T* destination) { tensor_lib_internal::_uninitialized_copy_n(source, count, destination); });
 		}
 
-		inline constexpr auto& operator=(const std::initializer_list<T>& data)
+		inline constexpr void push_back(tensor<T, (Rank <= 1) ? 1 : Rank - 1, allocator_type>&& slice) requires (Rank > 1u)
 		{
-			if (size_of_current_tensor() != data.size())
-			{
-				throw std::runtime_error("Size of initializer_list doesn't match size of tensor!");
-			}
+			const std::size_t count = slice.size_of_current_tensor();
+			T* source = slice.data();
 
-			std::copy_n(data.begin(), data.size(), begin());
+			_append(1, slice.get_ranks(), [source, count](T* destination) { std::uninitialized_move_n(source, count, destination); });
+		}
 
-			return (*this);
+		inline constexpr void push_back(const T& value) requires (Rank == 1u)
+		{
+			emplace_back(value);
 		}
 
-		template<typename... Sizes> requires (sizeof...(Sizes) == Rank) && useful_concepts::integrals<Sizes...>
-		inline constexpr void resize(const Sizes ... new_sizes)
+		inline constexpr void push_back(T&& value) requires (Rank == 1u)
 		{
-			const auto old_size = size_of_current_tensor();
+			emplace_back(std::move(value));
+		}
 
-			if (old_size)
+		// Appends an element constructed from 'args', or for Rank > 1 a slice of the current trailing sizes whose elements are all constructed from them.
+		//
+		template <typename... Args>
+		inline constexpr decltype(auto) emplace_back(Args&& ... args)
+		{
+			if constexpr (Rank == 1u)
 			{
-				std::destroy_n(_data, size_of_current_tensor());
-				allocator_type_traits::deallocate(get_allocator(), _data, size_of_current_tensor());
-				_data = nullptr;
-			}
+				_append(1, std::array<std::size_t, 0>{}, [&args...](T* destination) { std::construct_at(destination, std::forward<Args>(args)...); });
 
-			if (!(new_sizes && ...))
-			{
-				std::fill_n(_order_of_dimension.begin(), Rank, 0u);
-				std::fill_n(_size_of_subdimension.begin(), Rank, 0u);
-				return;
+				return _data[size_of_current_tensor() - 1];
 			}
-
-			_order_of_dimension = { static_cast<size_t>(new_sizes)... };
-
-			std::partial_sum(_order_of_dimension.crbegin(), _order_of_dimension.crend(), _size_of_subdimension.rbegin(), std::multiplies<size_t>());
-
-			_data = allocator_type_traits::allocate(get_allocator(), size_of_current_tensor());
-			try
+			else
 			{
-				if (std::is_constant_evaluated())
+				if (empty())
 				{
-					tensor_lib_internal::_constexpr_uninitialized_value_construct_n(&_data[0], size_of_current_tensor());
+					throw std::runtime_error("Can't emplace a slice into a tensor without sizes!");
 				}
-				else
+
+				const std::size_t count = _size_of_subdimension[1];
+
+				_append(1, std::span<const std::size_t, Rank - 1>(_order_of_dimension.begin() + 1, Rank - 1), [&args..., count](T* destination)
 				{
-					std::uninitialized_default_construct_n(&_data[0], size_of_current_tensor());
-				}
+					std::size_t index = 0;
+
+					try
+					{
+						for (; index < count; index++)
+						{
+							std::construct_at(destination + index, args...);
+						}
+					}
+					catch (...)
+					{
+						std::destroy_n(destination, index);
+						throw;
+					}
+				});
+
+				return (*this)[_order_of_dimension[0] - 1];
 			}
-			catch (...)
+		}
+
+		// Appends all the slices of 'other', a tensor object of the same rank, along the first dimension.
+		//
+		template <typename Other> requires tensor_object<Other>
+			&& (decltype(std::declval<const Other&>().get_ranks())::extent == Rank)
+			&& std::same_as<std::remove_cvref_t<decltype(*std::declval<const Other&>().data())>, T>
+		inline constexpr void append(const Other& other)
+		{
+			const std::size_t count = other.size_of_current_tensor();
+			const T* source = other.data();
+
+			_append(other.get_ranks()[0], other.get_ranks().template last<Rank - 1>(), [source, count](T* destination) { tensor_lib_internal::_uninitialized_copy_n(source, count, destination); });
+		}
+
+		// Same as above, but the elements of 'other' are moved from.
+		//
+		inline constexpr void append(tensor&& other)
+		{
+			if (this == std::addressof(other))
 			{
-				allocator_type_traits::deallocate(get_allocator(), _data, size_of_current_tensor());
-				_data = nullptr;
-				std::fill_n(_order_of_dimension.begin(), Rank, 0u);
-				std::fill_n(_size_of_subdimension.begin(), Rank, 0u);
-				throw;
+				append(std::as_const(other));
+				return;
 			}
+
+			const std::size_t count = other.size_of_current_tensor();
+			T* source = other.data();
+
+			_append(other.get_ranks()[0], other.get_ranks().template last<Rank - 1>(), [source, count](T* destination) { std::uninitialized_move_n(source, count, destination); });
 		}
 
 		inline constexpr auto operator[] (const size_t index) noexcept requires (Rank > 1u)
@@ -802,6 +1545,35 @@ namespace tensor_lib
 			return _data[index];
 		}
 
+		// Element access with all the indices at once, t(i, j, k) refers to the same element as t[i][j][k] but no subdimension is built
+		// on the way, the offset is computed directly from the sizes of the subdimensions.
+		//
+		template <typename... Indices> requires (sizeof...(Indices) == Rank) && useful_concepts::integrals<Indices...>
+		inline constexpr T& operator() (const Indices ... indices) noexcept
+		{
+			return _data[tensor_lib_internal::_flat_offset(_size_of_subdimension, indices...)];
+		}
+
+		template <typename... Indices> requires (sizeof...(Indices) == Rank) && useful_concepts::integrals<Indices...>
+		inline constexpr const T& operator() (const Indices ... indices) const noexcept
+		{
+			return _data[tensor_lib_internal::_flat_offset(_size_of_subdimension, indices...)];
+		}
+
+#if defined(__cpp_multidimensional_subscript)
+		template <typename... Indices> requires (sizeof...(Indices) == Rank) && (Rank > 1u) && useful_concepts::integrals<Indices...>
+		inline constexpr T& operator[] (const Indices ... indices) noexcept
+		{
+			return (*this)(indices...);
+		}
+
+		template <typename... Indices> requires (sizeof...(Indices) == Rank) && (Rank > 1u) && useful_concepts::integrals<Indices...>
+		inline constexpr const T& operator[] (const Indices ... indices) const noexcept
+		{
+			return (*this)(indices...);
+		}
+#endif
+
 		inline constexpr iterator begin() noexcept
 		{
 			return iterator(&_data[0]);
@@ -874,21 +1646,118 @@ namespace tensor_lib
 
 		inline constexpr T* data() noexcept
 		{
-			return _data;
+			return std::assume_aligned<alignment>(_data);
 		}
 
 		inline constexpr const T* data() const noexcept
 		{
-			return _data;
+			return std::assume_aligned<alignment>(_data);
+		}
+
+		inline constexpr allocator_type get_allocator() const noexcept
+		{
+			return _allocator();
+		}
+
+		// Views the buffer with another shape holding as many elements, nothing is copied.
+		// Ex: for a 2x3x4 tensor, t.reshape<2>(6, 4) is a 6x4 view, t.flatten() a view of all 24 elements, t.unsqueeze<0>() a 1x2x3x4 view
+		// and t.unsqueeze<0>().squeeze<0>() is 2x3x4 again. squeeze() only drops axes of size 1.
+		//
+		// Called on an rvalue, the result is a tensor of the new shape that takes over the buffer instead: std::move(t).reshape<2>(6, 4).
+		//
+		template <std::size_t NewRank, typename... Sizes> requires (sizeof...(Sizes) == NewRank) && useful_concepts::integrals<Sizes...>
+		inline constexpr auto reshape(const Sizes ... sizes) &
+		{
+			return _reshaped(tensor_lib_internal::_reshaped_order<NewRank>(size_of_current_tensor(), sizes...));
+		}
+
+		template <std::size_t NewRank, typename... Sizes> requires (sizeof...(Sizes) == NewRank) && useful_concepts::integrals<Sizes...>
+		inline constexpr auto reshape(const Sizes ... sizes) const &
+		{
+			return _reshaped(tensor_lib_internal::_reshaped_order<NewRank>(size_of_current_tensor(), sizes...));
+		}
+
+		template <std::size_t NewRank, typename... Sizes> requires (sizeof...(Sizes) == NewRank) && useful_concepts::integrals<Sizes...>
+		inline constexpr auto reshape(const Sizes ... sizes) &&
+		{
+			return std::move(*this)._reshaped(tensor_lib_internal::_reshaped_order<NewRank>(size_of_current_tensor(), sizes...));
+		}
+
+		inline constexpr auto flatten() &
+		{
+			return _reshaped(std::array<std::size_t, 1>{ size_of_current_tensor() });
+		}
+
+		inline constexpr auto flatten() const &
+		{
+			return _reshaped(std::array<std::size_t, 1>{ size_of_current_tensor() });
+		}
+
+		inline constexpr auto flatten() &&
+		{
+			return std::move(*this)._reshaped(std::array<std::size_t, 1>{ size_of_current_tensor() });
+		}
+
+		template <std::size_t Axis> requires (Axis < Rank) && (Rank > 1u)
+		inline constexpr auto squeeze() &
+		{
+			return _reshaped(tensor_lib_internal::_squeezed_order<Axis>(get_ranks()));
+		}
+
+		template <std::size_t Axis> requires (Axis < Rank) && (Rank > 1u)
+		inline constexpr auto squeeze() const &
+		{
+			return _reshaped(tensor_lib_internal::_squeezed_order<Axis>(get_ranks()));
+		}
+
+		template <std::size_t Axis> requires (Axis < Rank) && (Rank > 1u)
+		inline constexpr auto squeeze() &&
+		{
+			return std::move(*this)._reshaped(tensor_lib_internal::_squeezed_order<Axis>(get_ranks()));
+		}
+
+		template <std::size_t Axis> requires (Axis <= Rank)
+		inline constexpr auto unsqueeze() &
+		{
+			return _reshaped(tensor_lib_internal::_unsqueezed_order<Axis>(get_ranks()));
+		}
+
+		template <std::size_t Axis> requires (Axis <= Rank)
+		inline constexpr auto unsqueeze() const &
+		{
+			return _reshaped(tensor_lib_internal::_unsqueezed_order<Axis>(get_ranks()));
+		}
+
+		template <std::size_t Axis> requires (Axis <= Rank)
+		inline constexpr auto unsqueeze() &&
+		{
+			return std::move(*this)._reshaped(tensor_lib_internal::_unsqueezed_order<Axis>(get_ranks()));
 		}
 
 		inline constexpr ~tensor()
 		{
-			std::destroy_n(_data, size_of_current_tensor());
-			allocator_type_traits::deallocate(get_allocator(), _data, size_of_current_tensor());
+			if (_data)
+			{
+				std::destroy_n(_data, size_of_current_tensor());
+				allocator_type_traits::deallocate(_allocator(), _data, _capacity);
+			}
 		}
 	};
 
+	// The row-major tensor is a partial specialization, so the constructors that deduce the element type and the rank need guides of their own.
+	//
+	template <typename T, std::size_t Rank>
+	tensor(const subdimension<T, Rank>&) -> tensor<T, Rank>;
+
+	template <typename T, std::size_t Rank, typename allocator_type>
+	tensor(const subdimension<T, Rank>&, const allocator_type&) -> tensor<T, Rank, allocator_type>;
+
+	template <typename T, std::size_t Rank>
+	tensor(const const_subdimension<T, Rank>&) -> tensor<T, Rank>;
+
+	template <typename T, std::size_t Rank, typename allocator_type>
+	tensor(const const_subdimension<T, Rank>&, const allocator_type&) -> tensor<T, Rank, allocator_type>;
+
 	template <typename T, size_t Rank, typename allocator_type> requires (Rank != 0u)
 	class const_subdimension : public _tensor_common<T>
 	{
@@ -905,6 +1774,12 @@ namespace tensor_lib
 		static constexpr bool no_throw_destructible = std::is_nothrow_destructible_v<T>;
 		static constexpr bool no_throw_copyable = std::is_nothrow_copy_assignable_v<T>;
 
+		template <std::size_t NewRank>
+		inline constexpr auto _reshaped(const std::array<std::size_t, NewRank>& order_of_dimension) const noexcept
+		{
+			return reshaped_view<const_subdimension<T, NewRank, allocator_type>>(_data, order_of_dimension);
+		}
+
 	public:
 
 		friend class subdimension<T, Rank, allocator_type>;
@@ -986,6 +1861,20 @@ namespace tensor_lib
 			return _data[index];
 		}
 
+		template <typename... Indices> requires (sizeof...(Indices) == Rank) && useful_concepts::integrals<Indices...>
+		inline constexpr const T& operator() (const Indices ... indices) const noexcept
+		{
+			return _data[tensor_lib_internal::_flat_offset(_size_of_subdimension, indices...)];
+		}
+
+#if defined(__cpp_multidimensional_subscript)
+		template <typename... Indices> requires (sizeof...(Indices) == Rank) && (Rank > 1u) && useful_concepts::integrals<Indices...>
+		inline constexpr const T& operator[] (const Indices ... indices) const noexcept
+		{
+			return (*this)(indices...);
+		}
+#endif
+
 		inline constexpr auto begin() const noexcept
 		{
 			return const_iterator(_data.data());
@@ -1056,6 +1945,31 @@ namespace tensor_lib
 			return (Rank == 2);
 		}
 
+		// Views of the same elements with another shape, see tensor::reshape().
+		//
+		template <std::size_t NewRank, typename... Sizes> requires (sizeof...(Sizes) == NewRank) && useful_concepts::integrals<Sizes...>
+		inline constexpr auto reshape(const Sizes ... sizes) const
+		{
+			return _reshaped(tensor_lib_internal::_reshaped_order<NewRank>(size_of_current_tensor(), sizes...));
+		}
+
+		inline constexpr auto flatten() const
+		{
+			return _reshaped(std::array<std::size_t, 1>{ size_of_current_tensor() });
+		}
+
+		template <std::size_t Axis> requires (Axis < Rank) && (Rank > 1u)
+		inline constexpr auto squeeze() const
+		{
+			return _reshaped(tensor_lib_internal::_squeezed_order<Axis>(get_ranks()));
+		}
+
+		template <std::size_t Axis> requires (Axis <= Rank)
+		inline constexpr auto unsqueeze() const
+		{
+			return _reshaped(tensor_lib_internal::_unsqueezed_order<Axis>(get_ranks()));
+		}
+
 		inline constexpr bool is_square_matrix() const noexcept requires (Rank == 2u)
 		{
 			return (_size_of_subdimension[0] == _size_of_subdimension[1]);
@@ -1097,6 +2011,18 @@ namespace tensor_lib
 			_assign_subdimensions<Index + 1, Args...>(tensors...);
 		}
 
+		template <std::size_t NewRank>
+		inline constexpr auto _reshaped(const std::array<std::size_t, NewRank>& order_of_dimension) noexcept
+		{
+			return reshaped_view<subdimension<T, NewRank, allocator_type>>(_data, order_of_dimension);
+		}
+
+		template <std::size_t NewRank>
+		inline constexpr auto _reshaped(const std::array<std::size_t, NewRank>& order_of_dimension) const noexcept
+		{
+			return reshaped_view<const_subdimension<T, NewRank, allocator_type>>(std::span<const T>(_data), order_of_dimension);
+		}
+
 	public:
 		friend class const_subdimension<T, Rank, allocator_type>;
 		friend class tensor<T, Rank, allocator_type>;
@@ -1179,7 +2105,7 @@ namespace tensor_lib
 				throw std::runtime_error("Size of tensor we take values from must match the size of current tensor");
 			}
 
-			std::copy_n(other.cbegin(), size_of_current_tensor(), begin());
+			tensor_lib_internal::_copy_n(other.data(), size_of_current_tensor(), data());
 
 			return *this;
 		}
@@ -1250,7 +2176,20 @@ namespace tensor_lib
 				throw std::runtime_error("Size of tensor doesn't match size of subdimension!");
 			}
 
-			std::copy_n(tensor.cbegin(), size_of_current_tensor(), begin());
+			tensor_lib_internal::_copy_n(tensor.data(), size_of_current_tensor(), data());
+
+			return (*this);
+		}
+
+		template <typename Expression> requires (tensor_expression<Expression> && (Expression::rank == Rank))
+		inline constexpr auto& operator=(const Expression& expression)
+		{
+			if (!std::equal(_order_of_dimension.begin(), _order_of_dimension.end(), expression.get_ranks().begin(), expression.get_ranks().end()))
+			{
+				throw std::runtime_error("Size of expression doesn't match size of subdimension!");
+			}
+
+			tensor_lib_internal::_assign_expression(data(), expression);
 
 			return (*this);
 		}
@@ -1291,6 +2230,32 @@ namespace tensor_lib
 			return _data[index];
 		}
 
+		template <typename... Indices> requires (sizeof...(Indices) == Rank) && useful_concepts::integrals<Indices...>
+		inline constexpr T& operator() (const Indices ... indices) noexcept
+		{
+			return _data[tensor_lib_internal::_flat_offset(_size_of_subdimension, indices...)];
+		}
+
+		template <typename... Indices> requires (sizeof...(Indices) == Rank) && useful_concepts::integrals<Indices...>
+		inline constexpr const T& operator() (const Indices ... indices) const noexcept
+		{
+			return _data[tensor_lib_internal::_flat_offset(_size_of_subdimension, indices...)];
+		}
+
+#if defined(__cpp_multidimensional_subscript)
+		template <typename... Indices> requires (sizeof...(Indices) == Rank) && (Rank > 1u) && useful_concepts::integrals<Indices...>
+		inline constexpr T& operator[] (const Indices ... indices) noexcept
+		{
+			return (*this)(indices...);
+		}
+
+		template <typename... Indices> requires (sizeof...(Indices) == Rank) && (Rank > 1u) && useful_concepts::integrals<Indices...>
+		inline constexpr const T& operator[] (const Indices ... indices) const noexcept
+		{
+			return (*this)(indices...);
+		}
+#endif
+
 		inline constexpr auto begin() noexcept
 		{
 			return iterator(_data.data());
@@ -1361,6 +2326,54 @@ namespace tensor_lib
 			return (Rank == 2);
 		}
 
+		// Views of the same elements with another shape, see tensor::reshape().
+		//
+		template <std::size_t NewRank, typename... Sizes> requires (sizeof...(Sizes) == NewRank) && useful_concepts::integrals<Sizes...>
+		inline constexpr auto reshape(const Sizes ... sizes)
+		{
+			return _reshaped(tensor_lib_internal::_reshaped_order<NewRank>(size_of_current_tensor(), sizes...));
+		}
+
+		template <std::size_t NewRank, typename... Sizes> requires (sizeof...(Sizes) == NewRank) && useful_concepts::integrals<Sizes...>
+		inline constexpr auto reshape(const Sizes ... sizes) const
+		{
+			return _reshaped(tensor_lib_internal::_reshaped_order<NewRank>(size_of_current_tensor(), sizes...));
+		}
+
+		inline constexpr auto flatten()
+		{
+			return _reshaped(std::array<std::size_t, 1>{ size_of_current_tensor() });
+		}
+
+		inline constexpr auto flatten() const
+		{
+			return _reshaped(std::array<std::size_t, 1>{ size_of_current_tensor() });
+		}
+
+		template <std::size_t Axis> requires (Axis < Rank) && (Rank > 1u)
+		inline constexpr auto squeeze()
+		{
+			return _reshaped(tensor_lib_internal::_squeezed_order<Axis>(get_ranks()));
+		}
+
+		template <std::size_t Axis> requires (Axis < Rank) && (Rank > 1u)
+		inline constexpr auto squeeze() const
+		{
+			return _reshaped(tensor_lib_internal::_squeezed_order<Axis>(get_ranks()));
+		}
+
+		template <std::size_t Axis> requires (Axis <= Rank)
+		inline constexpr auto unsqueeze()
+		{
+			return _reshaped(tensor_lib_internal::_unsqueezed_order<Axis>(get_ranks()));
+		}
+
+		template <std::size_t Axis> requires (Axis <= Rank)
+		inline constexpr auto unsqueeze() const
+		{
+			return _reshaped(tensor_lib_internal::_unsqueezed_order<Axis>(get_ranks()));
+		}
+
 		inline constexpr auto get_sizes() const noexcept
 		{
 			return std::span<const size_t, Rank>(_size_of_subdimension);
@@ -1372,6 +2385,72 @@ namespace tensor_lib
 		}
 	};
 
+	namespace tensor_lib_internal
+	{
+		template <typename View>
+		struct _subdimension_rank;
+
+		template <typename T, std::size_t Rank, typename allocator_type>
+		struct _subdimension_rank<subdimension<T, Rank, allocator_type>> : std::integral_constant<std::size_t, Rank> {};
+
+		template <typename T, std::size_t Rank, typename allocator_type>
+		struct _subdimension_rank<const_subdimension<T, Rank, allocator_type>> : std::integral_constant<std::size_t, Rank> {};
+
+		template <std::size_t Rank>
+		struct _reshaped_shape
+		{
+			std::array<std::size_t, Rank> _reshaped_order_of_dimension;
+			std::array<std::size_t, Rank> _reshaped_size_of_subdimension;
+		};
+	}
+
+	// What reshape(), flatten(), squeeze() and unsqueeze() return: a subdimension (View) over the elements of the tensor object it was made from,
+	// that keeps the new shape itself since no tensor holds it. It is valid for as long as those elements are.
+	//
+	template <typename View>
+	class reshaped_view : private tensor_lib_internal::_reshaped_shape<tensor_lib_internal::_subdimension_rank<View>::value>, public View
+	{
+		static constexpr std::size_t Rank = tensor_lib_internal::_subdimension_rank<View>::value;
+
+		using shape_type = tensor_lib_internal::_reshaped_shape<Rank>;
+
+		// The spans of View have to refer to the shape of this object, not to the shape of the one it was copied from.
+		//
+		inline constexpr void _rebind() noexcept
+		{
+			View::operator=(View(this->_reshaped_order_of_dimension, this->_reshaped_size_of_subdimension, std::span(View::data(), View::size_of_current_tensor())));
+		}
+
+	public:
+		using View::operator=;
+
+		inline constexpr reshaped_view() = delete;
+
+		template <typename Data>
+		inline constexpr reshaped_view(const Data data, const std::array<std::size_t, Rank>& order_of_dimension) noexcept
+			: shape_type{ order_of_dimension, tensor_lib_internal::_sizes_of_subdimensions(order_of_dimension) }
+			, View(this->_reshaped_order_of_dimension, this->_reshaped_size_of_subdimension, data)
+		{
+
+		}
+
+		inline constexpr reshaped_view(const reshaped_view& other) noexcept
+			: shape_type(other)
+			, View(other)
+		{
+			_rebind();
+		}
+
+		inline constexpr reshaped_view& operator=(const reshaped_view& other) noexcept
+		{
+			shape_type::operator=(other);
+			View::operator=(other);
+			_rebind();
+
+			return *this;
+		}
+	};
+
 	template <typename T>
 	struct _tensor_common<T>::iterator
 	{
@@ -1636,9 +2715,15 @@ namespace tensor_lib
 	template <typename T, size_t Rank, typename allocator_type>
 	inline constexpr void swap(tensor<T, Rank, allocator_type>& left, tensor<T, Rank, allocator_type>& right) noexcept
 	{
+		if constexpr (std::allocator_traits<allocator_type>::propagate_on_container_swap::value)
+		{
+			std::swap(left._allocator(), right._allocator());
+		}
+
 		std::swap(left._order_of_dimension, right._order_of_dimension);
 		std::swap(left._size_of_subdimension, right._size_of_subdimension);
 		std::swap(left._data, right._data);
+		std::swap(left._capacity, right._capacity);
 	}
 
 	template <typename T, size_t Rank, typename lhs_allocator_type, typename rhs_allocator_type>
@@ -1664,6 +2749,25 @@ namespace tensor_lib
 		swap(left, right);
 	}
 
+	// Two tensor objects are equal when they have the same shape and the same elements, regardless of which of them are subdimensions.
+	//
+	template <typename Lhs, typename Rhs>
+		requires tensor_object<Lhs> && tensor_object<Rhs>
+		&& std::same_as<std::remove_cvref_t<decltype(*std::declval<const Lhs&>().data())>, std::remove_cvref_t<decltype(*std::declval<const Rhs&>().data())>>
+		&& (decltype(std::declval<const Lhs&>().get_ranks())::extent == decltype(std::declval<const Rhs&>().get_ranks())::extent)
+	inline constexpr bool operator==(const Lhs& lhs, const Rhs& rhs)
+	{
+		const auto lhs_ranks = lhs.get_ranks();
+		const auto rhs_ranks = rhs.get_ranks();
+
+		if (!std::equal(lhs_ranks.begin(), lhs_ranks.end(), rhs_ranks.begin(), rhs_ranks.end()))
+		{
+			return false;
+		}
+
+		return kernels::equal(lhs.data(), rhs.data(), lhs.size_of_current_tensor());
+	}
+
 	template <typename T>
 	using tensor_1d = tensor<T, 1>;
 
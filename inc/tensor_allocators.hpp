@@ -0,0 +1,420 @@
+#pragma once
+
+#include "tensor.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+namespace tensor_lib
+{
+	// A bump-pointer memory resource for short lived tensors. Allocating moves a cursor forward inside a chunk obtained from the
+	// upstream resource, deallocating does nothing, and reset() rewinds the cursor so that the next batch reuses the same memory.
+	// It is not thread safe, give each thread its own arena.
+	//
+	// Ex: tensor_lib::arena scratch(1 << 20);
+	//     for (const auto& request : requests)
+	//     {
+	//         pmr::tensor<float, 2> hidden(std::allocator_arg, &scratch, 128, 512);
+	//         ...
+	//         scratch.reset();
+	//     }
+	//
+	template <typename T>
+	class arena_allocator;
+
+	class arena final : public std::pmr::memory_resource
+	{
+	private:
+		template <typename T>
+		friend class arena_allocator;
+
+		struct _chunk
+		{
+			std::byte* data;
+			std::size_t size;
+		};
+
+		static constexpr std::size_t _default_capacity = std::size_t{ 1 } << 16;
+		static constexpr std::size_t _chunk_alignment = alignof(std::max_align_t);
+
+		std::pmr::memory_resource* _upstream;
+		std::vector<_chunk> _chunks;
+		std::byte* _cursor = nullptr;
+		std::byte* _end = nullptr;
+		std::size_t _next_chunk_size;
+		std::size_t _used = 0;
+
+		inline void _grow(const std::size_t minimum_size)
+		{
+			const std::size_t size = std::max(_next_chunk_size, minimum_size);
+			std::byte* const data = static_cast<std::byte*>(_upstream->allocate(size, _chunk_alignment));
+
+			try
+			{
+				_chunks.push_back({ data, size });
+			}
+			catch (...)
+			{
+				_upstream->deallocate(data, size, _chunk_alignment);
+				throw;
+			}
+
+			_cursor = data;
+			_end = data + size;
+			_next_chunk_size = size * 2;
+		}
+
+		// Fast path shared by do_allocate() and arena_allocator, which calls it directly instead of going through the virtual interface.
+		//
+		inline void* _allocate(const std::size_t bytes, const std::size_t alignment)
+		{
+			const auto cursor = reinterpret_cast<std::uintptr_t>(_cursor);
+			const auto aligned = (cursor + alignment - 1) & ~(std::uintptr_t{ alignment } - 1);
+
+			if (_cursor == nullptr || aligned + bytes > reinterpret_cast<std::uintptr_t>(_end)) [[unlikely]]
+			{
+				_grow(bytes + alignment);
+				return _allocate(bytes, alignment);
+			}
+
+			_cursor = reinterpret_cast<std::byte*>(aligned + bytes);
+			_used += bytes;
+
+			return reinterpret_cast<void*>(aligned);
+		}
+
+		void* do_allocate(const std::size_t bytes, const std::size_t alignment) override
+		{
+			return _allocate(bytes, alignment);
+		}
+
+		void do_deallocate(void*, std::size_t, std::size_t) noexcept override
+		{
+
+		}
+
+		bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+		{
+			return this == &other;
+		}
+
+	public:
+		inline explicit arena(const std::size_t initial_capacity = _default_capacity, std::pmr::memory_resource* upstream = std::pmr::new_delete_resource())
+			: _upstream{ upstream }
+			, _next_chunk_size{ std::max(initial_capacity, std::size_t{ 1 }) }
+		{
+
+		}
+
+		arena(const arena&) = delete;
+		arena& operator=(const arena&) = delete;
+
+		inline ~arena()
+		{
+			release();
+		}
+
+		// Makes all the memory handed out so far available again, without returning it upstream.
+		// If the last batch didn't fit in one chunk, the chunks are merged into a single one of their total size on the next allocation,
+		// so a steady workload ends up with one upstream allocation in total.
+		//
+		inline void reset() noexcept
+		{
+			if (_chunks.size() > 1)
+			{
+				const std::size_t total = capacity();
+				release();
+				_next_chunk_size = total;
+			}
+			else if (!_chunks.empty())
+			{
+				_cursor = _chunks.front().data;
+				_end = _cursor + _chunks.front().size;
+			}
+
+			_used = 0;
+		}
+
+		// Returns every chunk to the upstream resource.
+		//
+		inline void release() noexcept
+		{
+			for (const auto& chunk : _chunks)
+			{
+				_upstream->deallocate(chunk.data, chunk.size, _chunk_alignment);
+			}
+
+			_chunks.clear();
+			_cursor = nullptr;
+			_end = nullptr;
+			_used = 0;
+		}
+
+		// Bytes handed out since the last reset, without the padding needed for alignment.
+		//
+		inline std::size_t used() const noexcept
+		{
+			return _used;
+		}
+
+		inline std::size_t capacity() const noexcept
+		{
+			std::size_t total = 0;
+
+			for (const auto& chunk : _chunks)
+			{
+				total += chunk.size;
+			}
+
+			return total;
+		}
+
+		inline std::pmr::memory_resource* upstream_resource() const noexcept
+		{
+			return _upstream;
+		}
+	};
+
+	// Allocator bound to an arena, for tensors that should skip the virtual calls of std::pmr::polymorphic_allocator.
+	// Moving and swapping tensors carries the arena along with the buffer, copies keep the arena of the destination.
+	//
+	template <typename T>
+	class arena_allocator
+	{
+	private:
+		arena* _arena;
+
+	public:
+		using value_type = T;
+		using propagate_on_container_copy_assignment = std::false_type;
+		using propagate_on_container_move_assignment = std::true_type;
+		using propagate_on_container_swap = std::true_type;
+		using is_always_equal = std::false_type;
+
+		inline constexpr arena_allocator(arena& resource) noexcept
+			: _arena{ &resource }
+		{
+
+		}
+
+		template <typename U>
+		inline constexpr arena_allocator(const arena_allocator<U>& other) noexcept
+			: _arena{ other.resource() }
+		{
+
+		}
+
+		inline T* allocate(const std::size_t n)
+		{
+			if (n > std::numeric_limits<std::size_t>::max() / sizeof(T))
+			{
+				throw std::bad_array_new_length();
+			}
+
+			return static_cast<T*>(_arena->_allocate(n * sizeof(T), alignof(T)));
+		}
+
+		inline constexpr void deallocate(T*, std::size_t) noexcept
+		{
+
+		}
+
+		inline constexpr arena* resource() const noexcept
+		{
+			return _arena;
+		}
+
+		template <typename U>
+		friend inline constexpr bool operator==(const arena_allocator& lhs, const arena_allocator<U>& rhs) noexcept
+		{
+			return lhs.resource() == rhs.resource();
+		}
+	};
+
+	template <typename T, std::size_t Rank>
+	using arena_tensor = tensor<T, Rank, arena_allocator<T>>;
+
+	// Allocator returning buffers aligned to 'Alignment' bytes (a cache line by default), so that vector loads never straddle two cache lines.
+	//
+	template <typename T, std::size_t Alignment = 64>
+	class aligned_allocator
+	{
+		static_assert((Alignment & (Alignment - 1)) == 0,	"Alignment must be a power of two.");
+		static_assert(Alignment >= alignof(T),				"Alignment can't be weaker than the alignment of T.");
+
+	public:
+		using value_type = T;
+		using is_always_equal = std::true_type;
+
+		template <typename U>
+		struct rebind
+		{
+			using other = aligned_allocator<U, Alignment>;
+		};
+
+		inline constexpr aligned_allocator() noexcept = default;
+
+		template <typename U>
+		inline constexpr aligned_allocator(const aligned_allocator<U, Alignment>&) noexcept
+		{
+
+		}
+
+		inline T* allocate(const std::size_t n)
+		{
+			if (n > std::numeric_limits<std::size_t>::max() / sizeof(T))
+			{
+				throw std::bad_array_new_length();
+			}
+
+			return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{ Alignment }));
+		}
+
+		inline void deallocate(T* pointer, std::size_t) noexcept
+		{
+			::operator delete(pointer, std::align_val_t{ Alignment });
+		}
+
+		template <typename U>
+		friend inline constexpr bool operator==(const aligned_allocator&, const aligned_allocator<U, Alignment>&) noexcept
+		{
+			return true;
+		}
+	};
+
+	// Allocator for large tensors that backs buffers of at least one huge page (2 MiB) with huge pages, cutting the number of TLB misses
+	// when walking through them. On Linux it asks for explicit huge pages (MAP_HUGETLB) first, and when none are reserved it maps a
+	// huge page aligned region and marks it for transparent huge pages (MADV_HUGEPAGE). Smaller buffers, and every buffer on other
+	// platforms, come from the aligned operator new. Buffers are always aligned to at least 64 bytes.
+	//
+	template <typename T>
+	class huge_page_allocator
+	{
+	private:
+		static constexpr std::size_t _huge_page_size = std::size_t{ 2 } << 20;
+		static constexpr std::size_t _small_alignment = std::max<std::size_t>(64, alignof(T));
+
+		static inline constexpr std::size_t _mapping_size(const std::size_t bytes) noexcept
+		{
+			return (bytes + _huge_page_size - 1) & ~(_huge_page_size - 1);
+		}
+
+#if defined(__linux__)
+		static inline void* _map(const std::size_t size)
+		{
+#if defined(MAP_HUGETLB)
+			if (void* pointer = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0); pointer != MAP_FAILED)
+			{
+				return pointer;
+			}
+#endif
+			// Over-map by one huge page and trim both ends, so the region starts on a huge page boundary.
+			//
+			void* const mapping = ::mmap(nullptr, size + _huge_page_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+			if (mapping == MAP_FAILED)
+			{
+				throw std::bad_alloc();
+			}
+
+			const auto base = reinterpret_cast<std::uintptr_t>(mapping);
+			const auto aligned = (base + _huge_page_size - 1) & ~(std::uintptr_t{ _huge_page_size } - 1);
+
+			if (aligned != base)
+			{
+				::munmap(mapping, aligned - base);
+			}
+
+			if (const std::size_t tail = base + _huge_page_size - aligned; tail != 0)
+			{
+				::munmap(reinterpret_cast<void*>(aligned + size), tail);
+			}
+
+#if defined(MADV_HUGEPAGE)
+			::madvise(reinterpret_cast<void*>(aligned), size, MADV_HUGEPAGE);
+#endif
+			return reinterpret_cast<void*>(aligned);
+		}
+#endif
+
+	public:
+		using value_type = T;
+		using is_always_equal = std::true_type;
+
+		inline constexpr huge_page_allocator() noexcept = default;
+
+		template <typename U>
+		inline constexpr huge_page_allocator(const huge_page_allocator<U>&) noexcept
+		{
+
+		}
+
+		inline T* allocate(const std::size_t n)
+		{
+			if (n > (std::numeric_limits<std::size_t>::max() - _huge_page_size) / sizeof(T))
+			{
+				throw std::bad_array_new_length();
+			}
+
+			const std::size_t bytes = n * sizeof(T);
+
+#if defined(__linux__)
+			if (bytes >= _huge_page_size)
+			{
+				return static_cast<T*>(_map(_mapping_size(bytes)));
+			}
+#endif
+			return static_cast<T*>(::operator new(bytes, std::align_val_t{ _small_alignment }));
+		}
+
+		inline void deallocate(T* pointer, const std::size_t n) noexcept
+		{
+#if defined(__linux__)
+			if (n * sizeof(T) >= _huge_page_size)
+			{
+				::munmap(pointer, _mapping_size(n * sizeof(T)));
+				return;
+			}
+#endif
+			::operator delete(pointer, std::align_val_t{ _small_alignment });
+		}
+
+		template <typename U>
+		friend inline constexpr bool operator==(const huge_page_allocator&, const huge_page_allocator<U>&) noexcept
+		{
+			return true;
+		}
+	};
+
+	template <typename U, std::size_t Alignment>
+	struct allocator_alignment<aligned_allocator<U, Alignment>> : std::integral_constant<std::size_t, Alignment> {};
+
+	template <typename U>
+	struct allocator_alignment<huge_page_allocator<U>> : std::integral_constant<std::size_t, std::max<std::size_t>(64, alignof(U))> {};
+
+	template <typename T, std::size_t Rank, std::size_t Alignment = 64>
+	using aligned_tensor = tensor<T, Rank, aligned_allocator<T, Alignment>>;
+
+	template <typename T, std::size_t Rank>
+	using huge_page_tensor = tensor<T, Rank, huge_page_allocator<T>>;
+
+	// Tensors allocating through a std::pmr::memory_resource, ex: an arena or a std::pmr::monotonic_buffer_resource.
+	// Default constructed pmr allocators use std::pmr::get_default_resource().
+	//
+	namespace pmr
+	{
+		template <typename T, std::size_t Rank>
+		using tensor = tensor_lib::tensor<T, Rank, std::pmr::polymorphic_allocator<T>>;
+	}
+}
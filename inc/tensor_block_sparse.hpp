@@ -0,0 +1,405 @@
+#pragma once
+
+#include "tensor.hpp"
+#include "tensor_execution.hpp"
+#include "tensor_kernels.hpp"
+#include "tensor_matmul.hpp"
+#include "tensor_sparse.hpp"
+#include "tensor_tiled.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace tensor_lib
+{
+	// Block sparse storage for matrices whose non-zero elements come in blocks, such as weights pruned block by block:
+	// block_sparse_matrix<T, 16, 16> keeps only the 16x16 blocks that hold a non-zero element, each as a dense row-major tile,
+	// with an index of the stored blocks in compressed sparse row form (where each row of blocks starts, and the column of every block).
+	//
+	// Products go block by block through the dense GEMM kernel, so the inner loops stay as fast as dense ones while the zero blocks take
+	// neither memory nor time. m.tiles() goes over the stored blocks as tensor_tile views, dense tensor objects that know where they start,
+	// and for_each_tile() runs a kernel on each of them, as for tiled tensors. Sizes of the matrix must be multiples of the block sizes.
+	//
+	template <typename T, std::size_t BlockRows = 16, std::size_t BlockColumns = 16, typename allocator_type = std::allocator<T>>
+		requires (BlockRows != 0u) && (BlockColumns != 0u)
+	class block_sparse_matrix;
+
+	namespace tensor_lib_internal
+	{
+		// What block_sparse_matrix::block_index() returns, the geometry of the stored blocks by their number in storage order.
+		//
+		template <std::size_t BlockRows, std::size_t BlockColumns>
+		class _block_index
+		{
+		private:
+			std::span<const std::size_t> _block_row_offsets;
+			std::span<const std::size_t> _block_columns;
+
+		public:
+			inline constexpr _block_index(const std::span<const std::size_t> block_row_offsets, const std::span<const std::size_t> block_columns) noexcept
+				: _block_row_offsets{ block_row_offsets }
+				, _block_columns{ block_columns }
+			{
+
+			}
+
+			inline constexpr std::size_t tile_count() const noexcept
+			{
+				return _block_columns.size();
+			}
+
+			inline constexpr _tile_geometry<2> tile(const std::size_t index) const noexcept
+			{
+				const std::size_t block_row = static_cast<std::size_t>(std::upper_bound(_block_row_offsets.begin(), _block_row_offsets.end(), index) - _block_row_offsets.begin()) - 1;
+
+				return { { block_row * BlockRows, _block_columns[index] * BlockColumns }, { BlockRows, BlockColumns }, index * BlockRows * BlockColumns };
+			}
+		};
+	}
+
+	template <typename T, std::size_t BlockRows, std::size_t BlockColumns, typename allocator_type> requires (BlockRows != 0u) && (BlockColumns != 0u)
+	class block_sparse_matrix
+	{
+	private:
+		using index_allocator_type = typename std::allocator_traits<allocator_type>::template rebind_alloc<std::size_t>;
+
+		static constexpr std::size_t _block_size = BlockRows * BlockColumns;
+
+		std::array<std::size_t, 2> _order_of_dimension{};
+
+		// The stored blocks of block row i are [_block_row_offsets[i], _block_row_offsets[i + 1]), by column, and block n
+		// takes elements [n * _block_size, (n + 1) * _block_size) of _values.
+		//
+		std::vector<std::size_t, index_allocator_type> _block_row_offsets;
+		std::vector<std::size_t, index_allocator_type> _block_columns;
+		std::vector<T, allocator_type> _values;
+
+		inline std::size_t _block_rows() const noexcept
+		{
+			return _order_of_dimension[0] / BlockRows;
+		}
+
+		// Position of the stored block at (block_row, block_column), block_count() if it isn't stored.
+		//
+		inline std::size_t _find_block(const std::size_t block_row, const std::size_t block_column) const noexcept
+		{
+			const auto first = _block_columns.begin() + _block_row_offsets[block_row];
+			const auto last = _block_columns.begin() + _block_row_offsets[block_row + 1];
+			const auto found = std::lower_bound(first, last, block_column);
+
+			return (found != last && *found == block_column) ? static_cast<std::size_t>(found - _block_columns.begin()) : block_count();
+		}
+
+	public:
+		using value_type = T;
+
+		static constexpr std::array<std::size_t, 2> block_extents{ BlockRows, BlockColumns };
+
+		inline block_sparse_matrix(const allocator_type& allocator = allocator_type{})
+			: _block_row_offsets(1, 0, index_allocator_type(allocator))
+			, _block_columns(index_allocator_type(allocator))
+			, _values(allocator)
+		{
+
+		}
+
+		// A rows x columns matrix with no block stored, all zeros.
+		//
+		inline block_sparse_matrix(const std::size_t rows, const std::size_t columns, const allocator_type& allocator = allocator_type{})
+			: _order_of_dimension{ rows, columns }
+			, _block_row_offsets(index_allocator_type(allocator))
+			, _block_columns(index_allocator_type(allocator))
+			, _values(allocator)
+		{
+			if (rows % BlockRows != 0 || columns % BlockColumns != 0)
+			{
+				throw std::runtime_error("Sizes of a block sparse matrix must be multiples of the block sizes!");
+			}
+
+			_block_row_offsets.assign(_block_rows() + 1, 0);
+		}
+
+		// Stores zero blocks at the given (block row, block column) indices, to be filled through tiles(). Indices don't have to be sorted
+		// and may repeat. Ex: block_sparse_matrix<float, 32, 32> weights(execution::par, { 4096, 4096 }, kept_blocks);
+		//
+		template <typename Policy> requires execution::execution_policy<Policy>
+		inline block_sparse_matrix(const Policy& policy, const std::array<std::size_t, 2>& order_of_dimension, const std::span<const std::array<std::size_t, 2>> blocks,
+			const allocator_type& allocator = allocator_type{})
+			: block_sparse_matrix(order_of_dimension[0], order_of_dimension[1], allocator)
+		{
+			const auto keys = tensor_lib_internal::_sorted_sparse_keys(policy, std::array<std::size_t, 2>{ _block_rows(), order_of_dimension[1] / BlockColumns }, blocks,
+				"Block index of a block sparse matrix is out of range!");
+
+			for (std::size_t position = 0; position < keys.size(); position++)
+			{
+				if (position == 0 || keys[position].first != keys[position - 1].first)
+				{
+					_block_row_offsets[blocks[keys[position].second][0] + 1]++;
+					_block_columns.push_back(blocks[keys[position].second][1]);
+				}
+			}
+
+			for (std::size_t block_row = 0; block_row < _block_rows(); block_row++)
+			{
+				_block_row_offsets[block_row + 1] += _block_row_offsets[block_row];
+			}
+
+			_values.assign(_block_columns.size() * _block_size, T{});
+		}
+
+		inline block_sparse_matrix(const std::array<std::size_t, 2>& order_of_dimension, const std::span<const std::array<std::size_t, 2>> blocks,
+			const allocator_type& allocator = allocator_type{})
+			: block_sparse_matrix(execution::seq, order_of_dimension, blocks, allocator)
+		{
+
+		}
+
+		// Stores the blocks of a dense matrix object that hold a non-zero element.
+		//
+		template <typename Dense> requires tensor_lib_internal::_dense_operand_of<Dense, T, 2>
+		inline explicit block_sparse_matrix(const Dense& dense, const allocator_type& allocator = allocator_type{})
+			: block_sparse_matrix(dense.order_of_dimension(0), dense.order_of_dimension(1), allocator)
+		{
+			const std::size_t columns = _order_of_dimension[1];
+			const T* data = dense.data();
+
+			for (std::size_t block_row = 0; block_row < _block_rows(); block_row++)
+			{
+				for (std::size_t block_column = 0; block_column < columns / BlockColumns; block_column++)
+				{
+					const T* block = data + block_row * BlockRows * columns + block_column * BlockColumns;
+					bool nonzero = false;
+
+					for (std::size_t i = 0; i < BlockRows && !nonzero; i++)
+					{
+						nonzero = std::any_of(block + i * columns, block + i * columns + BlockColumns, [](const T& element) { return element != T{}; });
+					}
+
+					if (nonzero)
+					{
+						_block_columns.push_back(block_column);
+
+						for (std::size_t i = 0; i < BlockRows; i++)
+						{
+							_values.insert(_values.end(), block + i * columns, block + i * columns + BlockColumns);
+						}
+					}
+				}
+
+				_block_row_offsets[block_row + 1] = _block_columns.size();
+			}
+		}
+
+		inline tensor<T, 2> to_dense() const
+		{
+			const std::size_t columns = _order_of_dimension[1];
+
+			tensor<T, 2> result(_order_of_dimension[0], columns);
+			std::fill(result.begin(), result.end(), T{});
+
+			for (const auto tile : tiles())
+			{
+				for (std::size_t i = 0; i < BlockRows; i++)
+				{
+					std::copy_n(&tile[i][0], BlockColumns, result.data() + (tile.origin(0) + i) * columns + tile.origin(1));
+				}
+			}
+
+			return result;
+		}
+
+		// The element at (row, column), zero if its block isn't stored.
+		//
+		inline T operator() (const std::size_t row, const std::size_t column) const
+		{
+			const T* element = find(row, column);
+
+			return element ? *element : T{};
+		}
+
+		// Pointer to the element at (row, column), nullptr if its block isn't stored.
+		//
+		inline T* find(const std::size_t row, const std::size_t column) noexcept
+		{
+			return const_cast<T*>(std::as_const(*this).find(row, column));
+		}
+
+		inline const T* find(const std::size_t row, const std::size_t column) const noexcept
+		{
+			const std::size_t position = _find_block(row / BlockRows, column / BlockColumns);
+
+			return position < block_count() ? _values.data() + position * _block_size + (row % BlockRows) * BlockColumns + column % BlockColumns : nullptr;
+		}
+
+		// The stored blocks as dense BlockRows x BlockColumns tensor objects, in storage order.
+		// Ex: for (auto block : weights.tiles()) block *= scale[block.origin(0) / 32];
+		//
+		inline auto tiles() noexcept
+		{
+			return tensor_lib_internal::_tile_range<block_sparse_matrix>(*this);
+		}
+
+		inline auto tiles() const noexcept
+		{
+			return tensor_lib_internal::_tile_range<const block_sparse_matrix>(*this);
+		}
+
+		inline tensor_lib_internal::_block_index<BlockRows, BlockColumns> block_index() const noexcept
+		{
+			return { _block_row_offsets, _block_columns };
+		}
+
+		inline std::span<const std::size_t> block_row_offsets() const noexcept
+		{
+			return _block_row_offsets;
+		}
+
+		inline std::span<const std::size_t> block_columns() const noexcept
+		{
+			return _block_columns;
+		}
+
+		inline std::size_t block_count() const noexcept
+		{
+			return _block_columns.size();
+		}
+
+		// The stored blocks one after the other, each in row-major order.
+		//
+		inline T* data() noexcept
+		{
+			return _values.data();
+		}
+
+		inline const T* data() const noexcept
+		{
+			return _values.data();
+		}
+
+		inline std::size_t order_of_dimension(const std::size_t index) const noexcept
+		{
+			return _order_of_dimension[index];
+		}
+
+		inline auto get_ranks() const noexcept
+		{
+			return std::span<const std::size_t, 2>(_order_of_dimension);
+		}
+
+		inline allocator_type get_allocator() const noexcept
+		{
+			return _values.get_allocator();
+		}
+
+		friend inline bool operator== (const block_sparse_matrix& left, const block_sparse_matrix& right)
+		{
+			return left._order_of_dimension == right._order_of_dimension && left._block_row_offsets == right._block_row_offsets
+				&& left._block_columns == right._block_columns && left._values == right._values;
+		}
+	};
+
+	// Block sparse times dense products. Every stored block is multiplied by the rows (or columns) of the dense matrix it meets with
+	// kernels::gemm, adding into the result, and the zero blocks are skipped. With a parallel policy the tasks take disjoint rows of the result.
+	//
+	template <typename Policy, typename T, std::size_t BlockRows, std::size_t BlockColumns, typename allocator_type, typename Dense>
+		requires execution::execution_policy<Policy> && tensor_lib_internal::_dense_operand_of<Dense, T, 2>
+	inline tensor<T, 2> matmul(const Policy& policy, const block_sparse_matrix<T, BlockRows, BlockColumns, allocator_type>& a, const Dense& b)
+	{
+		tensor_lib_internal::_check_matmul_sizes(a, b);
+
+		const std::size_t block_rows = a.order_of_dimension(0) / BlockRows;
+		const std::size_t columns = b.order_of_dimension(1);
+
+		tensor<T, 2> result(a.order_of_dimension(0), columns);
+
+		const auto offsets = a.block_row_offsets();
+		const auto block_columns = a.block_columns();
+		const T* blocks = a.data();
+		const T* b_data = b.data();
+		T* result_data = result.data();
+
+		const std::size_t row_work = BlockRows * BlockColumns * columns * (a.block_count() / std::max<std::size_t>(1, block_rows) + 1);
+
+		tensor_lib_internal::_for_each_sparse_row(policy, block_rows, row_work, [=](const std::size_t first, const std::size_t last)
+		{
+			for (std::size_t block_row = first; block_row < last; block_row++)
+			{
+				T* result_rows = result_data + block_row * BlockRows * columns;
+				std::fill_n(result_rows, BlockRows * columns, T{});
+
+				for (std::size_t position = offsets[block_row]; position < offsets[block_row + 1]; position++)
+				{
+					kernels::gemm<true>(BlockRows, columns, BlockColumns, blocks + position * BlockRows * BlockColumns, BlockColumns, std::size_t{ 1 },
+						b_data + block_columns[position] * BlockColumns * columns, columns, std::size_t{ 1 }, result_rows, columns);
+				}
+			}
+		});
+
+		return result;
+	}
+
+	template <typename Policy, typename Dense, typename T, std::size_t BlockRows, std::size_t BlockColumns, typename allocator_type>
+		requires execution::execution_policy<Policy> && tensor_lib_internal::_dense_operand_of<Dense, T, 2>
+	inline tensor<T, 2> matmul(const Policy& policy, const Dense& a, const block_sparse_matrix<T, BlockRows, BlockColumns, allocator_type>& b)
+	{
+		tensor_lib_internal::_check_matmul_sizes(a, b);
+
+		const std::size_t rows = a.order_of_dimension(0);
+		const std::size_t depth = a.order_of_dimension(1);
+		const std::size_t columns = b.order_of_dimension(1);
+
+		tensor<T, 2> result(rows, columns);
+
+		const auto offsets = b.block_row_offsets();
+		const auto block_columns = b.block_columns();
+		const T* blocks = b.data();
+		const T* a_data = a.data();
+		T* result_data = result.data();
+
+		// Rows of 'a' go in bands as tall as a row block of the packed GEMM, so each block of 'b' is packed once per band.
+		//
+		constexpr std::size_t band = kernels::_gemm_row_block;
+		const std::size_t bands = (rows + band - 1) / band;
+
+		tensor_lib_internal::_for_each_sparse_row(policy, bands, band * BlockRows * BlockColumns * (b.block_count() + 1), [=](const std::size_t first, const std::size_t last)
+		{
+			for (std::size_t index = first; index < last; index++)
+			{
+				const std::size_t first_row = index * band;
+				const std::size_t band_rows = std::min(band, rows - first_row);
+				T* result_rows = result_data + first_row * columns;
+
+				std::fill_n(result_rows, band_rows * columns, T{});
+
+				for (std::size_t block_row = 0; block_row < depth / BlockRows; block_row++)
+				{
+					for (std::size_t position = offsets[block_row]; position < offsets[block_row + 1]; position++)
+					{
+						kernels::gemm<true>(band_rows, BlockColumns, BlockRows, a_data + first_row * depth + block_row * BlockRows, depth, std::size_t{ 1 },
+							blocks + position * BlockRows * BlockColumns, BlockColumns, std::size_t{ 1 }, result_rows + block_columns[position] * BlockColumns, columns);
+					}
+				}
+			}
+		});
+
+		return result;
+	}
+
+	template <typename T, std::size_t BlockRows, std::size_t BlockColumns, typename allocator_type, typename Dense> requires tensor_lib_internal::_dense_operand_of<Dense, T, 2>
+	inline tensor<T, 2> matmul(const block_sparse_matrix<T, BlockRows, BlockColumns, allocator_type>& a, const Dense& b)
+	{
+		return matmul(execution::seq, a, b);
+	}
+
+	template <typename Dense, typename T, std::size_t BlockRows, std::size_t BlockColumns, typename allocator_type> requires tensor_lib_internal::_dense_operand_of<Dense, T, 2>
+	inline tensor<T, 2> matmul(const Dense& a, const block_sparse_matrix<T, BlockRows, BlockColumns, allocator_type>& b)
+	{
+		return matmul(execution::seq, a, b);
+	}
+}
@@ -0,0 +1,686 @@
+#pragma once
+
+#include "tensor.hpp"
+#include "tensor_expressions.hpp"
+#include "tensor_kernels.hpp"
+#include "tensor_view.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace tensor_lib
+{
+	// Einstein summation over one or two operands, "einsum<"ij,jk->ik">(a, b)", and tensordot. Operands are tensor objects or strided views,
+	// so "einsum<"ij,jk->ik">(transpose(a), b)" reads 'a' in place.
+	//
+	// Subscripts are parsed at compile time: the rank of the result is known and operands of the wrong rank don't compile.
+	// A two operand contraction is planned as a batched GEMM. Labels in both operands and in the output are batch dimensions, labels in both
+	// operands only are contracted, and the remaining labels of each operand are the rows and the columns of the product. An operand whose
+	// group of row (or column) labels and group of contracted labels can each be walked with a single stride is read in place, any other
+	// is first copied in that order. Repeated labels (diagonals) and labels summed within a single operand are reduced by a loop nest beforehand.
+	//
+
+	namespace tensor_lib_internal
+	{
+		inline constexpr std::size_t _einsum_max_labels = 52;
+
+		// Subscripts passed as a template argument: einsum<"ij,jk->ik">.
+		//
+		template <std::size_t N>
+		struct _einsum_subscripts
+		{
+			char value[N]{};
+
+			inline constexpr _einsum_subscripts(const char (&subscripts)[N]) noexcept
+			{
+				std::copy_n(subscripts, N, value);
+			}
+		};
+
+		struct _einsum_term
+		{
+			std::array<char, _einsum_max_labels> labels{};
+			std::size_t rank = 0;
+
+			inline constexpr std::size_t count(const char label) const noexcept
+			{
+				return static_cast<std::size_t>(std::count(labels.begin(), labels.begin() + rank, label));
+			}
+
+			inline constexpr std::string_view view() const noexcept
+			{
+				return std::string_view(labels.data(), rank);
+			}
+		};
+
+		struct _einsum_spec
+		{
+			std::array<_einsum_term, 2> inputs{};
+			std::size_t operands = 1;
+			_einsum_term output{};
+		};
+
+		inline constexpr bool _is_einsum_label(const char character) noexcept
+		{
+			return (character >= 'a' && character <= 'z') || (character >= 'A' && character <= 'Z');
+		}
+
+		inline constexpr void _push_einsum_label(_einsum_term& term, const char label)
+		{
+			if (!_is_einsum_label(label))
+			{
+				throw std::runtime_error("Einsum subscripts must be letters!");
+			}
+
+			if (term.rank == _einsum_max_labels)
+			{
+				throw std::runtime_error("Too many einsum subscripts!");
+			}
+
+			term.labels[term.rank++] = label;
+		}
+
+		// Errors are thrown during constant evaluation, so malformed subscripts don't compile.
+		// Without "->" the output is made of the labels that appear once, in alphabetical order (as in NumPy).
+		//
+		template <std::size_t N>
+		inline constexpr _einsum_spec _parse_einsum(const _einsum_subscripts<N>& subscripts)
+		{
+			_einsum_spec spec;
+
+			const std::size_t length = N - 1;
+			std::size_t position = 0;
+			bool explicit_output = false;
+
+			for (; position < length; position++)
+			{
+				const char character = subscripts.value[position];
+
+				if (character == ' ')
+				{
+					continue;
+				}
+
+				if (character == ',')
+				{
+					if (spec.operands == spec.inputs.size())
+					{
+						throw std::runtime_error("Einsum takes one or two operands!");
+					}
+
+					spec.operands++;
+				}
+				else if (character == '-')
+				{
+					if (position + 1 == length || subscripts.value[position + 1] != '>')
+					{
+						throw std::runtime_error("Expected '->' in the einsum subscripts!");
+					}
+
+					position += 2;
+					explicit_output = true;
+					break;
+				}
+				else
+				{
+					_push_einsum_label(spec.inputs[spec.operands - 1], character);
+				}
+			}
+
+			const auto occurrences = [&spec](const char label)
+			{
+				return spec.inputs[0].count(label) + spec.inputs[1].count(label);
+			};
+
+			if (explicit_output)
+			{
+				for (; position < length; position++)
+				{
+					const char character = subscripts.value[position];
+
+					if (character == ' ')
+					{
+						continue;
+					}
+
+					if (spec.output.count(character) != 0)
+					{
+						throw std::runtime_error("Repeated einsum output subscript!");
+					}
+
+					if (_is_einsum_label(character) && occurrences(character) == 0)
+					{
+						throw std::runtime_error("Einsum output subscript missing from the operands!");
+					}
+
+					_push_einsum_label(spec.output, character);
+				}
+			}
+			else
+			{
+				for (char label = 'A'; label <= 'z'; label++)
+				{
+					if (_is_einsum_label(label) && occurrences(label) == 1)
+					{
+						_push_einsum_label(spec.output, label);
+					}
+				}
+			}
+
+			return spec;
+		}
+
+		template <auto Subscripts>
+		inline constexpr _einsum_spec _einsum_spec_v = _parse_einsum(Subscripts);
+
+		// Rank and element type of the operands einsum and tensordot accept: tensor objects and strided views.
+		//
+		template <typename U>
+		struct _einsum_traits {};
+
+		template <typename U> requires tensor_object<U>
+		struct _einsum_traits<U>
+		{
+			static constexpr std::size_t rank = _rank_of<U>;
+			using element_type = std::remove_cvref_t<decltype(*std::declval<const U&>().data())>;
+		};
+
+		template <typename T, std::size_t Rank>
+		struct _einsum_traits<tensor_view<T, Rank>>
+		{
+			static constexpr std::size_t rank = Rank;
+			using element_type = std::remove_cv_t<T>;
+		};
+
+		template <typename U>
+		concept _einsum_operand_object = requires { _einsum_traits<std::remove_cvref_t<U>>::rank; };
+
+		template <typename U>
+		using _einsum_element_t = typename _einsum_traits<std::remove_cvref_t<U>>::element_type;
+
+		template <typename U>
+		inline constexpr std::size_t _einsum_rank_v = _einsum_traits<std::remove_cvref_t<U>>::rank;
+
+		// An operand of the contraction engine: one label, extent and stride (in elements) per axis.
+		//
+		template <typename T>
+		struct _einsum_operand
+		{
+			const T* data = nullptr;
+			std::string labels;
+			std::vector<std::size_t> extents;
+			std::vector<std::size_t> strides;
+
+			inline std::size_t extent(const char label) const noexcept
+			{
+				return extents[labels.find(label)];
+			}
+
+			inline std::size_t stride(const char label) const noexcept
+			{
+				return strides[labels.find(label)];
+			}
+
+			inline bool has(const char label) const noexcept
+			{
+				return labels.find(label) != std::string::npos;
+			}
+		};
+
+		template <typename T, typename Operand>
+		inline _einsum_operand<T> _make_einsum_operand(const Operand& operand, const std::string_view labels)
+		{
+			constexpr std::size_t Rank = _einsum_rank_v<Operand>;
+			const tensor_view<const T, Rank> strided(operand);
+
+			return _einsum_operand<T>{ strided.data(), std::string(labels), std::vector<std::size_t>(strided.extents().begin(), strided.extents().end()),
+				std::vector<std::size_t>(strided.strides().begin(), strided.strides().end()) };
+		}
+
+		// Row-major operand of the given labels over a buffer.
+		//
+		template <typename T>
+		inline _einsum_operand<T> _dense_einsum_operand(const T* data, const std::string_view labels, const _einsum_operand<T>& lhs, const _einsum_operand<T>& rhs)
+		{
+			_einsum_operand<T> result{ data, std::string(labels), std::vector<std::size_t>(labels.size()), std::vector<std::size_t>(labels.size()) };
+			std::size_t stride = 1;
+
+			for (std::size_t axis = labels.size(); axis-- > 0;)
+			{
+				result.extents[axis] = lhs.has(labels[axis]) ? lhs.extent(labels[axis]) : rhs.extent(labels[axis]);
+				result.strides[axis] = stride;
+				stride *= result.extents[axis];
+			}
+
+			return result;
+		}
+
+		template <typename T>
+		inline std::size_t _einsum_size(const _einsum_operand<T>& operand) noexcept
+		{
+			return std::accumulate(operand.extents.begin(), operand.extents.end(), std::size_t{ 1 }, std::multiplies<std::size_t>());
+		}
+
+		struct _einsum_loop
+		{
+			char label;
+			std::size_t extent;
+			std::size_t input_stride;
+			std::size_t output_stride;
+		};
+
+		// out[keep] = sum of 'in' over the labels missing from 'keep', where 'out' is row-major in the order of 'keep'.
+		// It covers transposes, diagonals, traces and partial sums: there is one loop per distinct label, stepping by the sum of the strides
+		// of its axes in the input and by its stride in the output (0 for a summed label). The loop with the smallest input stride is innermost.
+		//
+		template <typename T>
+		inline void _einsum_reduce(const _einsum_operand<T>& in, const std::string_view keep, T* out)
+		{
+			std::vector<_einsum_loop> loops;
+
+			for (std::size_t axis = 0; axis < in.labels.size(); axis++)
+			{
+				const auto loop = std::find_if(loops.begin(), loops.end(), [&](const _einsum_loop& other) { return other.label == in.labels[axis]; });
+
+				if (loop == loops.end())
+				{
+					loops.push_back({ in.labels[axis], in.extents[axis], in.strides[axis], 0 });
+				}
+				else if (loop->extent != in.extents[axis])
+				{
+					throw std::runtime_error("Sizes of the dimensions sharing an einsum subscript don't match!");
+				}
+				else
+				{
+					loop->input_stride += in.strides[axis];
+				}
+			}
+
+			std::size_t size = 1;
+
+			for (std::size_t axis = keep.size(); axis-- > 0;)
+			{
+				const auto loop = std::find_if(loops.begin(), loops.end(), [&](const _einsum_loop& other) { return other.label == keep[axis]; });
+
+				loop->output_stride = size;
+				size *= loop->extent;
+			}
+
+			std::fill_n(out, size, T{});
+
+			if (std::any_of(loops.begin(), loops.end(), [](const _einsum_loop& loop) { return loop.extent == 0; }))
+			{
+				return;
+			}
+
+			std::stable_sort(loops.begin(), loops.end(), [](const _einsum_loop& lhs, const _einsum_loop& rhs) { return lhs.input_stride > rhs.input_stride; });
+
+			const _einsum_loop inner = loops.back();
+			std::vector<std::size_t> index(loops.size(), 0);
+			const T* input = in.data;
+			T* output = out;
+
+			while (true)
+			{
+				for (std::size_t position = 0; position < inner.extent; position++)
+				{
+					output[position * inner.output_stride] += input[position * inner.input_stride];
+				}
+
+				std::size_t level = loops.size() - 1;
+
+				while (true)
+				{
+					if (level == 0)
+					{
+						return;
+					}
+
+					level--;
+					index[level]++;
+					input += loops[level].input_stride;
+					output += loops[level].output_stride;
+
+					if (index[level] < loops[level].extent)
+					{
+						break;
+					}
+
+					input -= loops[level].extent * loops[level].input_stride;
+					output -= loops[level].extent * loops[level].output_stride;
+					index[level] = 0;
+				}
+			}
+		}
+
+		// Extent and stride of a group of labels walked as a single index. False when the strides of the group aren't nested.
+		//
+		template <typename T>
+		inline bool _fuse_einsum_labels(const _einsum_operand<T>& operand, const std::string_view group, std::size_t& extent, std::size_t& stride) noexcept
+		{
+			extent = 1;
+			stride = 1;
+
+			for (std::size_t position = group.size(); position-- > 0;)
+			{
+				const std::size_t label_extent = operand.extent(group[position]);
+				const std::size_t label_stride = operand.stride(group[position]);
+
+				if (label_extent == 1)
+				{
+					continue;
+				}
+
+				if (extent == 1)
+				{
+					stride = label_stride;
+				}
+				else if (label_stride != stride * extent)
+				{
+					return false;
+				}
+
+				extent *= label_extent;
+			}
+
+			return true;
+		}
+
+		template <typename T>
+		inline std::unique_ptr<T[]> _einsum_buffer(const std::size_t size)
+		{
+			return std::make_unique<T[]>(std::max<std::size_t>(size, 1));
+		}
+
+		// Reduces an operand to the labels it shares with the other operand or the output, and copies it in the order 'order'
+		// when the groups the GEMM walks can't be fused. Returns the operand to read with the fused extents and strides of both groups.
+		//
+		template <typename T>
+		inline _einsum_operand<T> _prepare_einsum_operand(_einsum_operand<T> operand, const _einsum_operand<T>& other, const std::string_view output,
+			const std::string_view order, const std::string_view first_group, const std::string_view second_group, std::unique_ptr<T[]>& storage,
+			std::array<std::size_t, 4>& fused)
+		{
+			std::string keep;
+
+			for (const char label : operand.labels)
+			{
+				if ((other.has(label) || output.find(label) != std::string_view::npos) && keep.find(label) == std::string::npos)
+				{
+					keep += label;
+				}
+			}
+
+			if (keep.size() != operand.labels.size())
+			{
+				const _einsum_operand<T> reduced = _dense_einsum_operand<T>(nullptr, keep, operand, operand);
+
+				storage = _einsum_buffer<T>(_einsum_size(reduced));
+				_einsum_reduce(operand, keep, storage.get());
+
+				operand = _dense_einsum_operand<T>(storage.get(), keep, operand, operand);
+			}
+
+			for (const char label : operand.labels)
+			{
+				if (other.has(label) && other.extent(label) != operand.extent(label))
+				{
+					throw std::runtime_error("Sizes of the dimensions sharing an einsum subscript don't match!");
+				}
+			}
+
+			if (!_fuse_einsum_labels(operand, first_group, fused[0], fused[1]) || !_fuse_einsum_labels(operand, second_group, fused[2], fused[3]))
+			{
+				std::unique_ptr<T[]> packed = _einsum_buffer<T>(_einsum_size(operand));
+				_einsum_reduce(operand, order, packed.get());
+
+				operand = _dense_einsum_operand<T>(packed.get(), order, operand, operand);
+				storage = std::move(packed);
+
+				_fuse_einsum_labels(operand, first_group, fused[0], fused[1]);
+				_fuse_einsum_labels(operand, second_group, fused[2], fused[3]);
+			}
+
+			return operand;
+		}
+
+		// out[output] = sum of lhs * rhs over the labels missing from 'output', as one GEMM per combination of the batch labels.
+		//
+		template <typename T>
+		inline void _einsum_contract(const _einsum_operand<T>& lhs, const _einsum_operand<T>& rhs, const std::string_view output, T* out)
+		{
+			std::string batch, rows, columns, depth;
+
+			for (const char label : output)
+			{
+				(lhs.has(label) ? (rhs.has(label) ? batch : rows) : columns) += label;
+			}
+
+			for (const char label : lhs.labels)
+			{
+				if (rhs.has(label) && output.find(label) == std::string_view::npos && depth.find(label) == std::string::npos)
+				{
+					depth += label;
+				}
+			}
+
+			std::unique_ptr<T[]> a_storage, b_storage;
+			std::array<std::size_t, 4> a_fused, b_fused;
+
+			const _einsum_operand<T> a = _prepare_einsum_operand(lhs, rhs, output, batch + rows + depth, rows, depth, a_storage, a_fused);
+			const _einsum_operand<T> b = _prepare_einsum_operand(rhs, lhs, output, batch + depth + columns, depth, columns, b_storage, b_fused);
+
+			const auto [m, a_row_stride, k, a_depth_stride] = a_fused;
+			const auto [b_k, b_depth_stride, n, b_column_stride] = b_fused;
+
+			const std::string product_labels = batch + rows + columns;
+			const _einsum_operand<T> product = _dense_einsum_operand<T>(nullptr, product_labels, a, b);
+			const std::size_t size = _einsum_size(product);
+
+			std::unique_ptr<T[]> product_storage;
+			T* c = out;
+
+			if (product_labels != output)
+			{
+				product_storage = _einsum_buffer<T>(size);
+				c = product_storage.get();
+			}
+
+			if (m * n != 0)
+			{
+				std::vector<std::size_t> index(batch.size(), 0);
+				std::size_t a_offset = 0;
+				std::size_t b_offset = 0;
+
+				for (std::size_t c_offset = 0; c_offset < size; c_offset += m * n)
+				{
+					kernels::gemm(m, n, k, a.data + a_offset, a_row_stride, a_depth_stride, b.data + b_offset, b_depth_stride, b_column_stride, c + c_offset, n);
+
+					for (std::size_t level = batch.size(); level-- > 0;)
+					{
+						const std::size_t extent = a.extent(batch[level]);
+
+						index[level]++;
+						a_offset += a.stride(batch[level]);
+						b_offset += b.stride(batch[level]);
+
+						if (index[level] < extent)
+						{
+							break;
+						}
+
+						a_offset -= extent * a.stride(batch[level]);
+						b_offset -= extent * b.stride(batch[level]);
+						index[level] = 0;
+					}
+				}
+			}
+
+			if (c != out)
+			{
+				_einsum_reduce(_dense_einsum_operand<T>(c, product_labels, a, b), output, out);
+			}
+		}
+
+		template <typename T, std::size_t OutRank, std::size_t Operands>
+		inline auto _einsum_evaluate(const std::array<_einsum_operand<T>, Operands>& operands, const std::string_view output)
+		{
+			const _einsum_operand<T>& lhs = operands[0];
+			const _einsum_operand<T>& rhs = operands[Operands - 1];
+
+			const auto run = [&](T* out)
+			{
+				if constexpr (Operands == 1)
+				{
+					_einsum_reduce(lhs, output, out);
+				}
+				else
+				{
+					_einsum_contract(lhs, rhs, output, out);
+				}
+			};
+
+			if constexpr (OutRank == 0)
+			{
+				T result{};
+				run(&result);
+
+				return result;
+			}
+			else
+			{
+				std::array<std::size_t, OutRank> order_of_dimension;
+
+				for (std::size_t axis = 0; axis < OutRank; axis++)
+				{
+					order_of_dimension[axis] = lhs.has(output[axis]) ? lhs.extent(output[axis]) : rhs.extent(output[axis]);
+				}
+
+				tensor<T, OutRank> result = std::apply([](const auto ... sizes) { return tensor<T, OutRank>(sizes...); }, order_of_dimension);
+				run(result.data());
+
+				return result;
+			}
+		}
+
+		template <typename... Operands>
+		concept _einsum_operands = (_einsum_operand_object<Operands> && ...)
+			&& (std::same_as<_einsum_element_t<Operands>, _einsum_element_t<std::tuple_element_t<0, std::tuple<Operands...>>>> && ...);
+	}
+
+	// einsum<"ij,jk->ik">(a, b) is a matrix product, einsum<"ii->">(a) a trace, einsum<"bij,bkj->bik">(a, b) a batched product with a transposed
+	// right operand... Returns a tensor of the rank of the output subscripts, or a single element when there are none.
+	//
+	template <tensor_lib_internal::_einsum_subscripts Subscripts, typename... Operands>
+		requires (sizeof...(Operands) == tensor_lib_internal::_einsum_spec_v<Subscripts>.operands) && tensor_lib_internal::_einsum_operands<Operands...>
+	inline auto einsum(const Operands& ... operands)
+	{
+		using T = tensor_lib_internal::_einsum_element_t<std::tuple_element_t<0, std::tuple<Operands...>>>;
+
+		return [&]<std::size_t... Term>(std::index_sequence<Term...>)
+		{
+			constexpr const tensor_lib_internal::_einsum_spec& spec = tensor_lib_internal::_einsum_spec_v<Subscripts>;
+
+			static_assert(((tensor_lib_internal::_einsum_rank_v<Operands> == spec.inputs[Term].rank) && ...), "The number of subscripts of an operand doesn't match its rank!");
+
+			const std::array<tensor_lib_internal::_einsum_operand<T>, sizeof...(Operands)> list{ tensor_lib_internal::_make_einsum_operand<T>(operands, spec.inputs[Term].view())... };
+
+			return tensor_lib_internal::_einsum_evaluate<T, spec.output.rank>(list, spec.output.view());
+		}(std::index_sequence_for<Operands...>{});
+	}
+
+	// Sums the products of 'a' and 'b' over the pairs of axes (a_axes[i], b_axes[i]). The result has the remaining axes of 'a' followed by
+	// the remaining axes of 'b', or is a single element when no axis remains.
+	//
+	template <std::size_t Axes, typename Lhs, typename Rhs>
+		requires tensor_lib_internal::_einsum_operands<Lhs, Rhs> && (Axes <= tensor_lib_internal::_einsum_rank_v<Lhs>) && (Axes <= tensor_lib_internal::_einsum_rank_v<Rhs>)
+	inline auto tensordot(const Lhs& a, const Rhs& b, const std::array<std::size_t, Axes>& a_axes, const std::array<std::size_t, Axes>& b_axes)
+	{
+		using T = tensor_lib_internal::_einsum_element_t<Lhs>;
+
+		constexpr std::size_t LhsRank = tensor_lib_internal::_einsum_rank_v<Lhs>;
+		constexpr std::size_t RhsRank = tensor_lib_internal::_einsum_rank_v<Rhs>;
+
+		static_assert(LhsRank + RhsRank <= tensor_lib_internal::_einsum_max_labels, "Too many axes for tensordot!");
+
+		constexpr std::string_view alphabet = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ";
+
+		std::string lhs_labels(alphabet.substr(0, LhsRank));
+		std::string rhs_labels(alphabet.substr(LhsRank, RhsRank));
+
+		for (std::size_t pair = 0; pair < Axes; pair++)
+		{
+			if (a_axes[pair] >= LhsRank || b_axes[pair] >= RhsRank)
+			{
+				throw std::runtime_error("Tensordot axis out of range!");
+			}
+
+			if (std::count(a_axes.begin(), a_axes.end(), a_axes[pair]) != 1 || std::count(b_axes.begin(), b_axes.end(), b_axes[pair]) != 1)
+			{
+				throw std::runtime_error("Repeated tensordot axis!");
+			}
+
+			rhs_labels[b_axes[pair]] = lhs_labels[a_axes[pair]];
+		}
+
+		std::string output;
+
+		for (std::size_t axis = 0; axis < LhsRank; axis++)
+		{
+			if (std::find(a_axes.begin(), a_axes.end(), axis) == a_axes.end())
+			{
+				output += lhs_labels[axis];
+			}
+		}
+
+		for (std::size_t axis = 0; axis < RhsRank; axis++)
+		{
+			if (std::find(b_axes.begin(), b_axes.end(), axis) == b_axes.end())
+			{
+				output += rhs_labels[axis];
+			}
+		}
+
+		const std::array<tensor_lib_internal::_einsum_operand<T>, 2> list{ tensor_lib_internal::_make_einsum_operand<T>(a, lhs_labels),
+			tensor_lib_internal::_make_einsum_operand<T>(b, rhs_labels) };
+
+		return tensor_lib_internal::_einsum_evaluate<T, LhsRank + RhsRank - 2 * Axes>(list, output);
+	}
+
+	// tensordot(a, b, { 1, 2 }, { 0, 1 }) without spelling out std::array.
+	//
+	template <std::size_t Axes, typename Lhs, typename Rhs>
+		requires tensor_lib_internal::_einsum_operands<Lhs, Rhs> && (Axes <= tensor_lib_internal::_einsum_rank_v<Lhs>) && (Axes <= tensor_lib_internal::_einsum_rank_v<Rhs>)
+	inline auto tensordot(const Lhs& a, const Rhs& b, const std::size_t (&a_axes)[Axes], const std::size_t (&b_axes)[Axes])
+	{
+		return tensordot(a, b, std::to_array(a_axes), std::to_array(b_axes));
+	}
+
+	// Contracts the last 'Axes' axes of 'a' with the first 'Axes' axes of 'b': tensordot<1>(a, b) is a matrix product and tensordot<0>(a, b)
+	// an outer product.
+	//
+	template <std::size_t Axes, typename Lhs, typename Rhs>
+		requires tensor_lib_internal::_einsum_operands<Lhs, Rhs> && (Axes <= tensor_lib_internal::_einsum_rank_v<Lhs>) && (Axes <= tensor_lib_internal::_einsum_rank_v<Rhs>)
+	inline auto tensordot(const Lhs& a, const Rhs& b)
+	{
+		std::array<std::size_t, Axes> a_axes, b_axes;
+
+		for (std::size_t pair = 0; pair < Axes; pair++)
+		{
+			a_axes[pair] = tensor_lib_internal::_einsum_rank_v<Lhs> - Axes + pair;
+			b_axes[pair] = pair;
+		}
+
+		return tensordot(a, b, a_axes, b_axes);
+	}
+}
@@ -0,0 +1,502 @@
+#pragma once
+
+#include "tensor.hpp"
+#include "tensor_expressions.hpp"
+#include "tensor_kernels.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace tensor_lib
+{
+	// Parallel execution of the element-wise operations, fills, copies, reductions and matrix products of the library.
+	// Each of them takes an execution policy as its first argument:
+	//
+	//	execution::seq			- runs on the calling thread, exactly like the overloads without a policy.
+	//	execution::par			- splits the work into tasks run by a work-stealing thread pool.
+	//	execution::par_unseq	- same as par; the kernels run by every task are always vectorized.
+	//
+	// Work on a tensor object is split on the boundaries of its subdimensions, every task owns whole contiguous subdimension slabs.
+	//
+	namespace execution
+	{
+		struct sequenced_policy {};
+		struct parallel_policy {};
+		struct parallel_unsequenced_policy {};
+
+		inline constexpr sequenced_policy seq{};
+		inline constexpr parallel_policy par{};
+		inline constexpr parallel_unsequenced_policy par_unseq{};
+
+		template <typename T>
+		static constexpr bool is_parallel_policy_v = std::is_same_v<T, parallel_policy> || std::is_same_v<T, parallel_unsequenced_policy>;
+
+		template <typename T>
+		static constexpr bool is_execution_policy_v = std::is_same_v<T, sequenced_policy> || is_parallel_policy_v<T>;
+
+		template <typename T>
+		concept execution_policy = is_execution_policy_v<std::remove_cvref_t<T>>;
+
+		// Fork-join pool where every worker owns a deque of tasks. A task covering more than 'grain' indices splits off its upper half
+		// onto the back of the deque of the thread running it, owners pop from the back (the most recently split, cache-hot halves)
+		// and idle threads steal from the front (the biggest halves). Threads outside the pool share one extra deque.
+		//
+		// The thread calling parallel_for() works on the tasks too, until its own range is done, so a pool of 'thread_count' threads
+		// only starts 'thread_count - 1' workers and parallel_for() may be called from inside a running task.
+		//
+		class thread_pool
+		{
+		private:
+			struct _job
+			{
+				void (*run)(const void* function, std::size_t first, std::size_t last);
+				const void* function;
+				std::size_t grain;
+				std::atomic<std::size_t> remaining;
+				std::mutex exception_mutex;
+				std::exception_ptr exception;
+			};
+
+			struct _task
+			{
+				_job* job;
+				std::size_t first;
+				std::size_t last;
+			};
+
+			struct _queue
+			{
+				std::mutex mutex;
+				std::deque<_task> tasks;
+			};
+
+			std::size_t _queue_count;
+			std::unique_ptr<_queue[]> _queues;
+			std::vector<std::thread> _workers;
+			std::atomic<std::size_t> _pending{ 0 };
+			std::mutex _sleep_mutex;
+			std::condition_variable _wake;
+			bool _stop = false;
+
+			inline static thread_local const thread_pool* _current_pool = nullptr;
+			inline static thread_local std::size_t _current_queue = 0;
+
+			inline std::size_t _queue_index() const noexcept
+			{
+				return (_current_pool == this) ? _current_queue : _queue_count - 1;
+			}
+
+			inline void _push(const std::size_t queue, const _task& task)
+			{
+				{
+					std::lock_guard lock(_queues[queue].mutex);
+					_queues[queue].tasks.push_back(task);
+				}
+
+				_pending.fetch_add(1, std::memory_order_release);
+
+				{
+					std::lock_guard lock(_sleep_mutex);
+				}
+				_wake.notify_one();
+			}
+
+			inline bool _try_pop(const std::size_t queue, _task& task)
+			{
+				{
+					std::lock_guard lock(_queues[queue].mutex);
+
+					if (!_queues[queue].tasks.empty())
+					{
+						task = _queues[queue].tasks.back();
+						_queues[queue].tasks.pop_back();
+						_pending.fetch_sub(1, std::memory_order_relaxed);
+						return true;
+					}
+				}
+
+				for (std::size_t offset = 1; offset < _queue_count; ++offset)
+				{
+					_queue& victim = _queues[(queue + offset) % _queue_count];
+					std::lock_guard lock(victim.mutex);
+
+					if (!victim.tasks.empty())
+					{
+						task = victim.tasks.front();
+						victim.tasks.pop_front();
+						_pending.fetch_sub(1, std::memory_order_relaxed);
+						return true;
+					}
+				}
+
+				return false;
+			}
+
+			inline void _run(const std::size_t queue, _task task)
+			{
+				_job& job = *task.job;
+
+				while (task.last - task.first > job.grain)
+				{
+					const std::size_t middle = task.first + (task.last - task.first) / 2;
+					_push(queue, _task{ task.job, middle, task.last });
+					task.last = middle;
+				}
+
+				try
+				{
+					job.run(job.function, task.first, task.last);
+				}
+				catch (...)
+				{
+					std::lock_guard lock(job.exception_mutex);
+
+					if (!job.exception)
+					{
+						job.exception = std::current_exception();
+					}
+				}
+
+				// Once this reaches zero the thread waiting for the job may destroy it, nothing may touch it afterwards.
+				//
+				job.remaining.fetch_sub(task.last - task.first, std::memory_order_acq_rel);
+			}
+
+			inline void _work(const std::size_t queue)
+			{
+				_current_pool = this;
+				_current_queue = queue;
+
+				while (true)
+				{
+					_task task;
+
+					if (_try_pop(queue, task))
+					{
+						_run(queue, task);
+						continue;
+					}
+
+					std::unique_lock lock(_sleep_mutex);
+					_wake.wait(lock, [this]() { return _stop || _pending.load(std::memory_order_acquire) != 0; });
+
+					if (_stop && _pending.load(std::memory_order_acquire) == 0)
+					{
+						return;
+					}
+				}
+			}
+
+		public:
+			inline explicit thread_pool(const std::size_t thread_count = std::max<std::size_t>(1, std::thread::hardware_concurrency()))
+				: _queue_count{ std::max<std::size_t>(1, thread_count) }
+				, _queues{ std::make_unique<_queue[]>(_queue_count) }
+			{
+				_workers.reserve(_queue_count - 1);
+
+				for (std::size_t index = 0; index + 1 < _queue_count; ++index)
+				{
+					_workers.emplace_back([this, index]() { _work(index); });
+				}
+			}
+
+			thread_pool(const thread_pool&) = delete;
+			thread_pool& operator=(const thread_pool&) = delete;
+
+			inline ~thread_pool()
+			{
+				{
+					std::lock_guard lock(_sleep_mutex);
+					_stop = true;
+				}
+				_wake.notify_all();
+
+				for (auto& worker : _workers)
+				{
+					worker.join();
+				}
+			}
+
+			// Number of threads taking part in a parallel_for(), counting the calling one.
+			//
+			inline std::size_t size() const noexcept
+			{
+				return _queue_count;
+			}
+
+			// Calls function(first, last) over disjoint ranges covering [0, count), none of them longer than 'grain',
+			// and returns once all of them are done. The first exception thrown by 'function' is rethrown after the others finish.
+			//
+			template <typename Function>
+			inline void parallel_for(const std::size_t count, std::size_t grain, const Function& function)
+			{
+				grain = std::max<std::size_t>(grain, 1);
+
+				if (count == 0)
+				{
+					return;
+				}
+
+				if (_workers.empty() || count <= grain)
+				{
+					function(std::size_t{ 0 }, count);
+					return;
+				}
+
+				_job job;
+				job.run = [](const void* erased, const std::size_t first, const std::size_t last)
+				{
+					(*static_cast<const Function*>(erased))(first, last);
+				};
+				job.function = std::addressof(function);
+				job.grain = grain;
+				job.remaining.store(count, std::memory_order_relaxed);
+
+				const std::size_t queue = _queue_index();
+
+				_push(queue, _task{ &job, 0, count });
+
+				while (job.remaining.load(std::memory_order_acquire) != 0)
+				{
+					_task task;
+
+					if (_try_pop(queue, task))
+					{
+						_run(queue, task);
+					}
+					else
+					{
+						std::this_thread::yield();
+					}
+				}
+
+				if (job.exception)
+				{
+					std::rethrow_exception(job.exception);
+				}
+			}
+		};
+
+		inline std::unique_ptr<thread_pool>& _default_pool_storage()
+		{
+			static std::unique_ptr<thread_pool> pool;
+			return pool;
+		}
+
+		inline std::mutex& _default_pool_mutex()
+		{
+			static std::mutex mutex;
+			return mutex;
+		}
+
+		// The pool used by the parallel policies, created on first use with one thread per hardware thread.
+		//
+		inline thread_pool& default_pool()
+		{
+			std::lock_guard lock(_default_pool_mutex());
+
+			auto& pool = _default_pool_storage();
+
+			if (!pool)
+			{
+				pool = std::make_unique<thread_pool>();
+			}
+
+			return *pool;
+		}
+
+		// Replaces the default pool with one of 'thread_count' threads. Mustn't be called while a parallel operation is running.
+		//
+		inline void set_thread_count(const std::size_t thread_count)
+		{
+			std::lock_guard lock(_default_pool_mutex());
+
+			auto& pool = _default_pool_storage();
+			pool.reset();
+			pool = std::make_unique<thread_pool>(thread_count);
+		}
+
+		inline std::size_t thread_count()
+		{
+			return default_pool().size();
+		}
+
+		inline std::atomic<std::size_t>& _grain_size()
+		{
+			static std::atomic<std::size_t> grain{ std::size_t{ 1 } << 15 };
+			return grain;
+		}
+
+		// Smallest number of elements worth giving to a task.
+		//
+		inline std::size_t grain_size() noexcept
+		{
+			return _grain_size().load(std::memory_order_relaxed);
+		}
+
+		inline void set_grain_size(const std::size_t elements) noexcept
+		{
+			_grain_size().store(std::max<std::size_t>(elements, 1), std::memory_order_relaxed);
+		}
+
+		// Calls function(offset, count) over ranges of the elements of 'tsor' that cover whole subdimensions. The slabs are the biggest
+		// subdimensions no larger than the grain size (or the innermost ones, when even those are larger), so tasks stay close to the grain.
+		//
+		template <typename Policy, typename Tensor, typename Function> requires execution_policy<Policy>
+		inline void _for_each_slab(const Policy&, const Tensor& tsor, const Function& function)
+		{
+			const std::size_t size = tsor.size_of_current_tensor();
+
+			if constexpr (!is_parallel_policy_v<std::remove_cvref_t<Policy>>)
+			{
+				function(std::size_t{ 0 }, size);
+			}
+			else
+			{
+				if (size == 0)
+				{
+					return;
+				}
+
+				constexpr std::size_t rank = tensor_lib_internal::_rank_of<Tensor>;
+				const std::size_t grain = grain_size();
+
+				std::size_t slab = 1;
+
+				if constexpr (rank > 1)
+				{
+					std::size_t level = 1;
+
+					while (level + 1 < rank && tsor.size_of_subdimension(level) > grain)
+					{
+						++level;
+					}
+
+					slab = tsor.size_of_subdimension(level);
+				}
+
+				default_pool().parallel_for(size / slab, std::max<std::size_t>(1, grain / slab), [&function, slab](const std::size_t first, const std::size_t last)
+				{
+					function(first * slab, (last - first) * slab);
+				});
+			}
+		}
+	}
+
+	namespace tensor_lib_internal
+	{
+		template <typename U>
+		static constexpr bool _is_owning_tensor_object = false;
+
+		template <typename T, std::size_t Rank, typename allocator_type>
+		static constexpr bool _is_owning_tensor_object<tensor<T, Rank, allocator_type>> = true;
+
+		// Gives 'destination' the shape in 'ranks': tensors are resized (losing their values), subdimensions have to match already.
+		//
+		template <typename Destination, std::size_t Rank>
+		inline constexpr void _fit_shape(Destination& destination, const std::span<const std::size_t, Rank> ranks)
+		{
+			const auto destination_ranks = destination.get_ranks();
+
+			if (std::equal(destination_ranks.begin(), destination_ranks.end(), ranks.begin(), ranks.end()))
+			{
+				return;
+			}
+
+			if constexpr (_is_owning_tensor_object<std::remove_cvref_t<Destination>>)
+			{
+				std::array<std::size_t, Rank> sizes;
+				std::copy_n(ranks.begin(), Rank, sizes.begin());
+				std::apply([&destination](const auto ... new_sizes) { destination.resize(new_sizes...); }, sizes);
+			}
+			else
+			{
+				throw std::runtime_error("Size of the source doesn't match size of subdimension!");
+			}
+		}
+	}
+
+	// Evaluates 'expression' into 'destination'. Only an empty tensor takes the shape of the expression, any other destination has to match it.
+	//
+	template <typename Policy, typename Destination, typename Expression>
+		requires execution::execution_policy<Policy> && _assignable_tensor_object<Destination> && tensor_expression<Expression>
+		&& (Expression::rank == tensor_lib_internal::_rank_of<std::remove_cvref_t<Destination>>)
+	inline void assign(const Policy& policy, Destination&& destination, const Expression& expression)
+	{
+		const auto* first = destination.data();
+		const auto* last = first + destination.size_of_current_tensor();
+		const auto ranks = destination.get_ranks();
+
+		if (first != last && !std::equal(ranks.begin(), ranks.end(), expression.get_ranks().begin(), expression.get_ranks().end()))
+		{
+			throw std::runtime_error("Size of the result doesn't match size of the destination!");
+		}
+
+		// Slabs are evaluated concurrently, so an expression broadcasting the destination is evaluated into a temporary first.
+		//
+		if (expression._broadcast_reads_from(first, last))
+		{
+			const tensor<typename Expression::value_type, Expression::rank> result(expression);
+			assign(policy, std::forward<Destination>(destination), tensor_lib_internal::_make_expression<std::identity>(result));
+
+			return;
+		}
+
+		tensor_lib_internal::_fit_shape(destination, expression.get_ranks());
+
+		auto* data = destination.data();
+
+		execution::_for_each_slab(policy, destination, [data, &expression](const std::size_t offset, const std::size_t count)
+		{
+			tensor_lib_internal::_assign_expression(data, expression, offset, offset + count);
+		});
+	}
+
+	// Copies the elements of 'source' into 'destination'. They may not overlap.
+	//
+	template <typename Policy, typename Source, typename Destination>
+		requires execution::execution_policy<Policy> && tensor_object<Source> && _assignable_tensor_object<Destination>
+		&& std::same_as<tensor_lib_internal::_element_type_of<Source>, tensor_lib_internal::_element_type_of<std::remove_cvref_t<Destination>>>
+		&& (tensor_lib_internal::_rank_of<Source> == tensor_lib_internal::_rank_of<std::remove_cvref_t<Destination>>)
+	inline void copy(const Policy& policy, const Source& source, Destination&& destination)
+	{
+		tensor_lib_internal::_fit_shape(destination, source.get_ranks());
+
+		const auto* source_data = source.data();
+		auto* destination_data = destination.data();
+
+		execution::_for_each_slab(policy, destination, [source_data, destination_data](const std::size_t offset, const std::size_t count)
+		{
+			tensor_lib_internal::_copy_n(source_data + offset, count, destination_data + offset);
+		});
+	}
+
+	template <typename Policy, typename Destination, typename U>
+		requires execution::execution_policy<Policy> && _assignable_tensor_object<Destination>
+		&& std::is_convertible_v<const U&, tensor_lib_internal::_element_type_of<std::remove_cvref_t<Destination>>>
+	inline void fill(const Policy& policy, Destination&& destination, const U& value)
+	{
+		using T = tensor_lib_internal::_element_type_of<std::remove_cvref_t<Destination>>;
+
+		const T converted = static_cast<T>(value);
+		auto* data = destination.data();
+
+		execution::_for_each_slab(policy, destination, [data, &converted](const std::size_t offset, const std::size_t count)
+		{
+			kernels::fill(data + offset, count, converted);
+		});
+	}
+}
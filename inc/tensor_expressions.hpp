@@ -0,0 +1,829 @@
+#pragma once
+
+#include "tensor.hpp"
+#include "tensor_kernels.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+
+namespace tensor_lib
+{
+	// Arithmetic on tensor objects doesn't compute anything by itself. Each operator returns a small expression node
+	// holding its operands by value (data pointers for tensors, subdimensions and const_subdimensions, the scalar itself for scalars),
+	// so "a = b * c + d" builds a tree of nodes and only walks the memory once, when the tree is assigned into 'a'.
+	//
+	// Expressions don't own the data they refer to and shouldn't outlive their operands.
+	//
+	// Operands of different shapes are broadcast following NumPy's rules: shapes are aligned on their last axis, missing leading axes count
+	// as extent 1, and an axis of extent 1 is repeated along the extent of the other operand (ex: "matrix + row" adds the row to every row).
+	// Broadcast operands are never expanded in memory, tensor leaves walk their own data with a stride of 0 along the repeated axes.
+	//
+	// Expressions over arithmetic types are evaluated '_chunk_size' elements at a time: every node writes its chunk into a small stack buffer
+	// that stays in L1 and the element-wise kernels run over whole chunks, so the operands are still streamed from memory only once.
+	//
+
+	template <typename Operation, typename Lhs, typename Rhs>
+	class _binary_expression;
+
+	namespace tensor_lib_internal
+	{
+		static constexpr std::size_t _chunk_size = 512;
+
+		// Scratch space for the chunk of an operand. Scalars hand out a pointer to their value and need none, tensor leaves only write to it
+		// when they're broadcast. Operands of the same type as 'Shared' write straight into the buffer of their parent.
+		//
+		template <typename Operand, typename Shared = void>
+		struct _chunk_buffer
+		{
+			using value_type = typename Operand::value_type;
+
+			static constexpr bool shares_buffer = std::is_same_v<value_type, Shared>;
+
+			std::array<value_type, (Operand::is_scalar || shares_buffer) ? 0 : _chunk_size> buffer;
+
+			inline value_type* get([[maybe_unused]] Shared* shared) noexcept
+			{
+				if constexpr (shares_buffer)
+				{
+					return shared;
+				}
+				else
+				{
+					return buffer.data();
+				}
+			}
+		};
+
+		template <typename Lhs, typename Rhs, typename U>
+		static constexpr bool _uses_kernels = kernels::is_vectorizable_v<U>
+			&& std::is_same_v<typename Lhs::value_type, U>
+			&& std::is_same_v<typename Rhs::value_type, U>;
+
+		template <typename Operand, typename U>
+		static constexpr bool _is_kernel_multiply = false;
+
+		template <typename A, typename B, typename U>
+		static constexpr bool _is_kernel_multiply<_binary_expression<std::multiplies<>, A, B>, U> = _uses_kernels<A, B, U>;
+
+		template <typename U>
+		using _element_type_of = std::remove_cvref_t<decltype(*std::declval<const U&>().cbegin())>;
+
+		template <typename U>
+		static constexpr std::size_t _rank_of = decltype(std::declval<const U&>().get_ranks())::extent;
+
+		struct _abs_operation
+		{
+			template <typename U>
+			inline constexpr auto operator()(const U& value) const
+			{
+				using std::abs;
+				return abs(value);
+			}
+		};
+
+		struct _sqrt_operation
+		{
+			template <typename U>
+			inline constexpr auto operator()(const U& value) const
+			{
+				using std::sqrt;
+				return sqrt(value);
+			}
+		};
+
+		struct _exp_operation
+		{
+			template <typename U>
+			inline constexpr auto operator()(const U& value) const
+			{
+				using std::exp;
+				return exp(value);
+			}
+		};
+
+		struct _log_operation
+		{
+			template <typename U>
+			inline constexpr auto operator()(const U& value) const
+			{
+				using std::log;
+				return log(value);
+			}
+		};
+	}
+
+	// Leaf referring to the contiguous data of a tensor, subdimension or const_subdimension.
+	//
+	// A leaf broadcast over a larger shape is indexed with the positions of that shape. It keeps the extents of the trailing axes of that shape
+	// and its own stride along each of them (0 along the axes it repeats), the leading axes of the larger shape don't move it at all.
+	//
+	template <typename T, std::size_t Rank>
+	class _tensor_operand
+	{
+	private:
+		const T* _data;
+		std::span<const std::size_t, Rank> _order_of_dimension;
+		std::size_t _size;
+		std::array<std::size_t, Rank> _broadcast_extents{};
+		std::array<std::size_t, Rank> _broadcast_strides{};
+		std::size_t _broadcast_period = 0;
+
+		// Offset in '_data' of the element at 'index' in the broadcast shape, along with its position on each of the trailing axes.
+		//
+		inline constexpr std::size_t _broadcast_offset(std::size_t index, std::array<std::size_t, Rank>& position) const noexcept
+		{
+			std::size_t offset = 0;
+			index %= _broadcast_period;
+
+			for (std::size_t axis = Rank; axis-- > 0;)
+			{
+				position[axis] = index % _broadcast_extents[axis];
+				index /= _broadcast_extents[axis];
+				offset += position[axis] * _broadcast_strides[axis];
+			}
+
+			return offset;
+		}
+
+	public:
+		using value_type = T;
+		static constexpr std::size_t rank = Rank;
+		static constexpr bool is_scalar = false;
+		static constexpr bool _is_chunkable = std::is_arithmetic_v<T>;
+
+		template <typename Tensor> requires tensor_object<Tensor>
+		inline constexpr _tensor_operand(const Tensor& tsor) noexcept
+			: _data{ tsor.data() }
+			, _order_of_dimension{ tsor.get_ranks() }
+			, _size{ tsor.size_of_current_tensor() }
+		{
+
+		}
+
+		inline constexpr auto get_ranks() const noexcept
+		{
+			return _order_of_dimension;
+		}
+
+		inline constexpr std::size_t size_of_current_tensor() const noexcept
+		{
+			return _size;
+		}
+
+		inline constexpr const T& _evaluate_at(const std::size_t index) const noexcept
+		{
+			if (_broadcast_period == 0)
+			{
+				return _data[index];
+			}
+
+			std::array<std::size_t, Rank> position;
+			return _data[_broadcast_offset(index, position)];
+		}
+
+		inline const T* _evaluate_chunk(const std::size_t offset, const std::size_t count, T* scratch) const noexcept
+		{
+			if (_broadcast_period == 0)
+			{
+				return _data + offset;
+			}
+
+			std::array<std::size_t, Rank> position;
+			std::size_t source = _broadcast_offset(offset, position);
+
+			const std::size_t inner_extent = _broadcast_extents[Rank - 1];
+			const std::size_t inner_stride = _broadcast_strides[Rank - 1];
+
+			// A chunk that doesn't leave a row of the leaf is read in place (ex: a bias row added to long rows).
+			//
+			if (inner_stride == 1 && position[Rank - 1] + count <= inner_extent)
+			{
+				return _data + source;
+			}
+
+			for (std::size_t written = 0; written < count;)
+			{
+				const std::size_t run = std::min(inner_extent - position[Rank - 1], count - written);
+
+				if (inner_stride == 0)
+				{
+					std::fill_n(scratch + written, run, _data[source]);
+				}
+				else
+				{
+					std::copy_n(_data + source, run, scratch + written);
+				}
+
+				written += run;
+				position[Rank - 1] += run;
+				source += run * inner_stride;
+
+				for (std::size_t axis = Rank; axis-- > 0 && position[axis] == _broadcast_extents[axis];)
+				{
+					source -= _broadcast_extents[axis] * _broadcast_strides[axis];
+					position[axis] = 0;
+
+					if (axis > 0)
+					{
+						position[axis - 1]++;
+						source += _broadcast_strides[axis - 1];
+					}
+				}
+			}
+
+			return scratch;
+		}
+
+		inline bool _reads_from(const void* first, const void* last) const noexcept
+		{
+			return std::less<const void*>()(_data, last) && std::less<const void*>()(first, _data + _size);
+		}
+
+		// Broadcast leaves read elements at other positions than the one being written, so they can't be evaluated in place over their own data.
+		//
+		inline bool _broadcast_reads_from(const void* first, const void* last) const noexcept
+		{
+			return _broadcast_period != 0 && _reads_from(first, last);
+		}
+
+		template <std::size_t ShapeRank>
+		inline constexpr void _broadcast_to(const std::span<const std::size_t, ShapeRank> shape) noexcept
+		{
+			std::size_t stride = 1;
+			std::size_t period = 1;
+			std::size_t size = 1;
+
+			for (std::size_t axis = Rank; axis-- > 0;)
+			{
+				const std::size_t extent = shape[ShapeRank - Rank + axis];
+
+				_broadcast_extents[axis] = extent;
+				_broadcast_strides[axis] = (_order_of_dimension[axis] == extent) ? stride : 0;
+				stride *= _order_of_dimension[axis];
+				period *= extent;
+			}
+
+			for (const std::size_t extent : shape)
+			{
+				size *= extent;
+			}
+
+			_broadcast_period = (size == _size) ? 0 : period;
+		}
+	};
+
+	// Leaf broadcasting a single value over the whole shape of the other operand.
+	//
+	template <typename T>
+	class _scalar_operand
+	{
+	private:
+		T _value;
+
+	public:
+		using value_type = T;
+		static constexpr std::size_t rank = 0;
+		static constexpr bool is_scalar = true;
+		static constexpr bool _is_chunkable = std::is_arithmetic_v<T>;
+
+		inline constexpr _scalar_operand(const T& value)
+			: _value{ value }
+		{
+
+		}
+
+		inline constexpr const T& _evaluate_at(const std::size_t) const noexcept
+		{
+			return _value;
+		}
+
+		inline const T* _evaluate_chunk(const std::size_t, const std::size_t, T*) const noexcept
+		{
+			return &_value;
+		}
+
+		inline bool _reads_from(const void*, const void*) const noexcept
+		{
+			return false;
+		}
+
+		inline bool _broadcast_reads_from(const void*, const void*) const noexcept
+		{
+			return false;
+		}
+
+		template <std::size_t ShapeRank>
+		inline constexpr void _broadcast_to(const std::span<const std::size_t, ShapeRank>) noexcept
+		{
+
+		}
+	};
+
+	template <typename Operation, typename Operand>
+	class _unary_expression
+	{
+	private:
+		Operand _operand;
+		Operation _operation;
+
+	public:
+		using value_type = std::remove_cvref_t<std::invoke_result_t<const Operation&, const typename Operand::value_type&>>;
+		static constexpr std::size_t rank = Operand::rank;
+		static constexpr bool is_scalar = false;
+		static constexpr bool _is_chunkable = std::is_arithmetic_v<value_type> && Operand::_is_chunkable;
+
+		inline constexpr _unary_expression(const Operand& operand, const Operation& operation = Operation{})
+			: _operand{ operand }
+			, _operation{ operation }
+		{
+
+		}
+
+		inline constexpr auto get_ranks() const noexcept
+		{
+			return _operand.get_ranks();
+		}
+
+		inline constexpr std::size_t size_of_current_tensor() const noexcept
+		{
+			return _operand.size_of_current_tensor();
+		}
+
+		inline constexpr value_type _evaluate_at(const std::size_t index) const
+		{
+			return _operation(_operand._evaluate_at(index));
+		}
+
+		inline const value_type* _evaluate_chunk(const std::size_t offset, const std::size_t count, value_type* scratch) const
+		{
+			tensor_lib_internal::_chunk_buffer<Operand, value_type> operand_buffer;
+			const auto operand = _operand._evaluate_chunk(offset, count, operand_buffer.get(scratch));
+
+			if constexpr (std::is_same_v<Operation, std::negate<>> && tensor_lib_internal::_uses_kernels<Operand, Operand, value_type>)
+			{
+				const value_type minus_one = -1;
+				kernels::binary<std::multiplies<>, false, true>(operand, &minus_one, scratch, count);
+			}
+			else
+			{
+				for (std::size_t index = 0; index < count; ++index)
+				{
+					scratch[index] = _operation(operand[index]);
+				}
+			}
+
+			return scratch;
+		}
+
+		inline bool _reads_from(const void* first, const void* last) const noexcept
+		{
+			return _operand._reads_from(first, last);
+		}
+
+		inline bool _broadcast_reads_from(const void* first, const void* last) const noexcept
+		{
+			return _operand._broadcast_reads_from(first, last);
+		}
+
+		template <std::size_t ShapeRank>
+		inline constexpr void _broadcast_to(const std::span<const std::size_t, ShapeRank> shape) noexcept
+		{
+			_operand._broadcast_to(shape);
+		}
+	};
+
+	template <typename Operation, typename Lhs, typename Rhs>
+	class _binary_expression
+	{
+		template <typename, typename, typename>
+		friend class _binary_expression;
+
+		static_assert(!(Lhs::is_scalar && Rhs::is_scalar), "At least one operand of an expression must be a tensor object.");
+
+	public:
+		using value_type = std::remove_cvref_t<std::invoke_result_t<const Operation&, const typename Lhs::value_type&, const typename Rhs::value_type&>>;
+		static constexpr std::size_t rank = std::max(Lhs::rank, Rhs::rank);
+
+	private:
+		Lhs _lhs;
+		Rhs _rhs;
+		Operation _operation;
+		std::array<std::size_t, rank> _order_of_dimension{};
+		std::size_t _size = 1;
+
+		// Extent of an operand along an axis of the expression, 1 along the leading axes it doesn't have.
+		//
+		template <typename Operand>
+		static inline constexpr std::size_t _extent_of(const Operand& operand, const std::size_t axis) noexcept
+		{
+			if constexpr (Operand::is_scalar)
+			{
+				return 1;
+			}
+			else
+			{
+				return (axis < rank - Operand::rank) ? 1 : operand.get_ranks()[axis - (rank - Operand::rank)];
+			}
+		}
+
+	public:
+		static constexpr bool is_scalar = false;
+		static constexpr bool _is_chunkable = std::is_arithmetic_v<value_type> && Lhs::_is_chunkable && Rhs::_is_chunkable;
+
+		inline constexpr _binary_expression(const Lhs& lhs, const Rhs& rhs, const Operation& operation = Operation{})
+			: _lhs{ lhs }
+			, _rhs{ rhs }
+			, _operation{ operation }
+		{
+			for (std::size_t axis = 0; axis < rank; axis++)
+			{
+				const std::size_t lhs_extent = _extent_of(_lhs, axis);
+				const std::size_t rhs_extent = _extent_of(_rhs, axis);
+
+				if (lhs_extent != rhs_extent && lhs_extent != 1 && rhs_extent != 1)
+				{
+					throw std::runtime_error("Can't combine tensors of different sizes in an expression!");
+				}
+
+				_order_of_dimension[axis] = (lhs_extent == 1) ? rhs_extent : lhs_extent;
+				_size *= _order_of_dimension[axis];
+			}
+
+			if constexpr (!Lhs::is_scalar)
+			{
+				if (_lhs.size_of_current_tensor() != _size)
+				{
+					_lhs._broadcast_to(get_ranks());
+				}
+			}
+
+			if constexpr (!Rhs::is_scalar)
+			{
+				if (_rhs.size_of_current_tensor() != _size)
+				{
+					_rhs._broadcast_to(get_ranks());
+				}
+			}
+		}
+
+		inline constexpr auto get_ranks() const noexcept
+		{
+			return std::span<const std::size_t, rank>(_order_of_dimension);
+		}
+
+		inline constexpr std::size_t size_of_current_tensor() const noexcept
+		{
+			return _size;
+		}
+
+		inline constexpr value_type _evaluate_at(const std::size_t index) const
+		{
+			return _operation(_lhs._evaluate_at(index), _rhs._evaluate_at(index));
+		}
+
+		inline const value_type* _evaluate_chunk(const std::size_t offset, const std::size_t count, value_type* scratch) const
+		{
+			if constexpr (_is_multiply_add<Lhs, Rhs>)
+			{
+				return _multiply_add_chunk(_lhs, _rhs, offset, count, scratch);
+			}
+			else if constexpr (_is_multiply_add<Rhs, Lhs>)
+			{
+				return _multiply_add_chunk(_rhs, _lhs, offset, count, scratch);
+			}
+			else
+			{
+				tensor_lib_internal::_chunk_buffer<Lhs, value_type> lhs_buffer;
+				tensor_lib_internal::_chunk_buffer<Rhs> rhs_buffer;
+				const auto lhs = _lhs._evaluate_chunk(offset, count, lhs_buffer.get(scratch));
+				const auto rhs = _rhs._evaluate_chunk(offset, count, rhs_buffer.get(nullptr));
+
+				if constexpr (kernels::is_kernel_operation_v<Operation> && tensor_lib_internal::_uses_kernels<Lhs, Rhs, value_type>)
+				{
+					kernels::binary<Operation, Lhs::is_scalar, Rhs::is_scalar>(lhs, rhs, scratch, count);
+				}
+				else
+				{
+					for (std::size_t index = 0; index < count; ++index)
+					{
+						scratch[index] = _operation(lhs[Lhs::is_scalar ? 0 : index], rhs[Rhs::is_scalar ? 0 : index]);
+					}
+				}
+
+				return scratch;
+			}
+		}
+
+		inline bool _reads_from(const void* first, const void* last) const noexcept
+		{
+			return _lhs._reads_from(first, last) || _rhs._reads_from(first, last);
+		}
+
+		inline bool _broadcast_reads_from(const void* first, const void* last) const noexcept
+		{
+			return _lhs._broadcast_reads_from(first, last) || _rhs._broadcast_reads_from(first, last);
+		}
+
+		// The operands have already been broadcast to the shape of this expression, which is itself compatible with 'shape'.
+		//
+		template <std::size_t ShapeRank>
+		inline constexpr void _broadcast_to(const std::span<const std::size_t, ShapeRank> shape) noexcept
+		{
+			_lhs._broadcast_to(shape);
+			_rhs._broadcast_to(shape);
+		}
+
+	private:
+		// "a * b + c" (in either order) is evaluated by the fused multiply-add kernel.
+		//
+		template <typename Product, typename Addend>
+		static constexpr bool _is_multiply_add = std::is_same_v<Operation, std::plus<>> && tensor_lib_internal::_is_kernel_multiply<Product, value_type> && std::is_same_v<typename Addend::value_type, value_type>;
+
+		template <typename Product, typename Addend>
+		static inline const value_type* _multiply_add_chunk(const Product& product, const Addend& addend, const std::size_t offset, const std::size_t count, value_type* scratch)
+		{
+			using product_lhs = decltype(product._lhs);
+			using product_rhs = decltype(product._rhs);
+
+			tensor_lib_internal::_chunk_buffer<product_lhs, value_type> a_buffer;
+			tensor_lib_internal::_chunk_buffer<product_rhs> b_buffer;
+			tensor_lib_internal::_chunk_buffer<Addend> c_buffer;
+			const auto a = product._lhs._evaluate_chunk(offset, count, a_buffer.get(scratch));
+			const auto b = product._rhs._evaluate_chunk(offset, count, b_buffer.get(nullptr));
+			const auto c = addend._evaluate_chunk(offset, count, c_buffer.get(nullptr));
+
+			kernels::fma<product_lhs::is_scalar, product_rhs::is_scalar, Addend::is_scalar>(a, b, c, scratch, count);
+
+			return scratch;
+		}
+	};
+
+	template <typename Operation, typename Operand>
+	struct is_tensor_expression<_unary_expression<Operation, Operand>> : std::true_type {};
+
+	template <typename Operation, typename Lhs, typename Rhs>
+	struct is_tensor_expression<_binary_expression<Operation, Lhs, Rhs>> : std::true_type {};
+
+	template <typename U>
+	concept expression_operand = tensor_object<U> || tensor_expression<U>;
+
+	namespace tensor_lib_internal
+	{
+		template <typename U> requires expression_operand<U>
+		inline constexpr auto _as_operand(const U& operand)
+		{
+			if constexpr (tensor_expression<U>)
+			{
+				return operand;
+			}
+			else
+			{
+				return _tensor_operand<_element_type_of<U>, _rank_of<U>>(operand);
+			}
+		}
+
+		template <typename U>
+		using _operand_t = decltype(_as_operand(std::declval<const U&>()));
+
+		// A scalar takes the value type of the tensor side of the expression, so "tsor_of_floats * 2.0" stays a float expression.
+		//
+		template <typename Scalar, typename Operand>
+		concept _scalar_for = expression_operand<Operand>
+			&& !expression_operand<Scalar>
+			&& std::is_convertible_v<const Scalar&, typename _operand_t<Operand>::value_type>;
+
+		template <typename Operation, typename Lhs, typename Rhs> requires expression_operand<Lhs> && expression_operand<Rhs>
+		inline constexpr auto _make_expression(const Lhs& lhs, const Rhs& rhs)
+		{
+			return _binary_expression<Operation, _operand_t<Lhs>, _operand_t<Rhs>>(_as_operand(lhs), _as_operand(rhs));
+		}
+
+		template <typename Operation, typename Lhs, typename Scalar> requires _scalar_for<Scalar, Lhs>
+		inline constexpr auto _make_expression(const Lhs& lhs, const Scalar& rhs)
+		{
+			using scalar_type = _scalar_operand<typename _operand_t<Lhs>::value_type>;
+			return _binary_expression<Operation, _operand_t<Lhs>, scalar_type>(_as_operand(lhs), scalar_type(static_cast<typename scalar_type::value_type>(rhs)));
+		}
+
+		template <typename Operation, typename Scalar, typename Rhs> requires _scalar_for<Scalar, Rhs>
+		inline constexpr auto _make_expression(const Scalar& lhs, const Rhs& rhs)
+		{
+			using scalar_type = _scalar_operand<typename _operand_t<Rhs>::value_type>;
+			return _binary_expression<Operation, scalar_type, _operand_t<Rhs>>(scalar_type(static_cast<typename scalar_type::value_type>(lhs)), _as_operand(rhs));
+		}
+
+		template <typename Operation, typename Operand> requires expression_operand<Operand>
+		inline constexpr auto _make_expression(const Operand& operand)
+		{
+			return _unary_expression<Operation, _operand_t<Operand>>(_as_operand(operand));
+		}
+
+		// Evaluates the elements in [first, last) of the expression into the same positions of 'destination'.
+		// Disjoint ranges can be evaluated concurrently.
+		//
+		template <typename U, typename Expression>
+		inline constexpr void _assign_expression(U* destination, const Expression& expression, const std::size_t first, const std::size_t last)
+		{
+			using value_type = typename Expression::value_type;
+
+			const std::size_t size = expression.size_of_current_tensor();
+
+			if constexpr (Expression::_is_chunkable && std::is_arithmetic_v<U>)
+			{
+				if (!std::is_constant_evaluated())
+				{
+					// The root may only evaluate straight into the destination if none of the leaves read from it,
+					// otherwise a subexpression could overwrite values before they are read.
+					//
+					const bool in_place = std::is_same_v<U, value_type> && !expression._reads_from(destination, destination + size);
+
+					std::array<value_type, _chunk_size> buffer;
+
+					for (std::size_t offset = first; offset < last; offset += _chunk_size)
+					{
+						const std::size_t count = std::min(_chunk_size, last - offset);
+
+						if constexpr (std::is_same_v<U, value_type>)
+						{
+							if (in_place)
+							{
+								expression._evaluate_chunk(offset, count, destination + offset);
+							}
+							else
+							{
+								kernels::copy(expression._evaluate_chunk(offset, count, buffer.data()), destination + offset, count);
+							}
+						}
+						else
+						{
+							const value_type* chunk = expression._evaluate_chunk(offset, count, buffer.data());
+
+							for (std::size_t index = 0; index < count; ++index)
+							{
+								destination[offset + index] = static_cast<U>(chunk[index]);
+							}
+						}
+					}
+
+					return;
+				}
+			}
+
+			for (std::size_t index = first; index < last; ++index)
+			{
+				destination[index] = static_cast<U>(expression._evaluate_at(index));
+			}
+		}
+
+		template <typename U, typename Expression>
+		inline constexpr void _assign_expression(U* destination, const Expression& expression)
+		{
+			const std::size_t size = expression.size_of_current_tensor();
+
+			// A broadcast operand overlapping the destination would be read after being overwritten (ex: "m = m + m[0]"),
+			// so the result is computed aside first.
+			//
+			if (!std::is_constant_evaluated() && expression._broadcast_reads_from(destination, destination + size))
+			{
+				const auto result = std::make_unique_for_overwrite<typename Expression::value_type[]>(size);
+				_assign_expression(result.get(), expression, 0, size);
+
+				for (std::size_t index = 0; index < size; ++index)
+				{
+					destination[index] = static_cast<U>(result[index]);
+				}
+
+				return;
+			}
+
+			_assign_expression(destination, expression, 0, size);
+		}
+	}
+
+	template <typename Lhs, typename Rhs>
+	concept _expression_operands = (expression_operand<Lhs> && expression_operand<Rhs>)
+		|| tensor_lib_internal::_scalar_for<Lhs, Rhs>
+		|| tensor_lib_internal::_scalar_for<Rhs, Lhs>;
+
+	template <typename Lhs, typename Rhs> requires _expression_operands<Lhs, Rhs>
+	inline constexpr auto operator+(const Lhs& lhs, const Rhs& rhs)
+	{
+		return tensor_lib_internal::_make_expression<std::plus<>>(lhs, rhs);
+	}
+
+	template <typename Lhs, typename Rhs> requires _expression_operands<Lhs, Rhs>
+	inline constexpr auto operator-(const Lhs& lhs, const Rhs& rhs)
+	{
+		return tensor_lib_internal::_make_expression<std::minus<>>(lhs, rhs);
+	}
+
+	template <typename Lhs, typename Rhs> requires _expression_operands<Lhs, Rhs>
+	inline constexpr auto operator*(const Lhs& lhs, const Rhs& rhs)
+	{
+		return tensor_lib_internal::_make_expression<std::multiplies<>>(lhs, rhs);
+	}
+
+	template <typename Lhs, typename Rhs> requires _expression_operands<Lhs, Rhs>
+	inline constexpr auto operator/(const Lhs& lhs, const Rhs& rhs)
+	{
+		return tensor_lib_internal::_make_expression<std::divides<>>(lhs, rhs);
+	}
+
+	template <typename Lhs, typename Rhs> requires _expression_operands<Lhs, Rhs>
+	inline constexpr auto minimum(const Lhs& lhs, const Rhs& rhs)
+	{
+		return tensor_lib_internal::_make_expression<kernels::minimum_operation>(lhs, rhs);
+	}
+
+	template <typename Lhs, typename Rhs> requires _expression_operands<Lhs, Rhs>
+	inline constexpr auto maximum(const Lhs& lhs, const Rhs& rhs)
+	{
+		return tensor_lib_internal::_make_expression<kernels::maximum_operation>(lhs, rhs);
+	}
+
+	template <typename Operand> requires expression_operand<Operand>
+	inline constexpr auto operator-(const Operand& operand)
+	{
+		return tensor_lib_internal::_make_expression<std::negate<>>(operand);
+	}
+
+	template <typename Operand> requires expression_operand<Operand>
+	inline constexpr auto abs(const Operand& operand)
+	{
+		return tensor_lib_internal::_make_expression<tensor_lib_internal::_abs_operation>(operand);
+	}
+
+	template <typename Operand> requires expression_operand<Operand>
+	inline constexpr auto sqrt(const Operand& operand)
+	{
+		return tensor_lib_internal::_make_expression<tensor_lib_internal::_sqrt_operation>(operand);
+	}
+
+	template <typename Operand> requires expression_operand<Operand>
+	inline constexpr auto exp(const Operand& operand)
+	{
+		return tensor_lib_internal::_make_expression<tensor_lib_internal::_exp_operation>(operand);
+	}
+
+	template <typename Operand> requires expression_operand<Operand>
+	inline constexpr auto log(const Operand& operand)
+	{
+		return tensor_lib_internal::_make_expression<tensor_lib_internal::_log_operation>(operand);
+	}
+
+	// Compound assignment is just "destination = destination op operand", evaluated in place.
+	// Works on temporaries returned by operator[] as well, ex: "tsor[1] *= 2".
+	// The operand may broadcast, but never to a shape larger than the destination's.
+	//
+
+	template <typename U>
+	concept _assignable_tensor_object = tensor_object<U> && !std::is_const_v<std::remove_reference_t<U>>
+		&& !std::derived_from<std::remove_cvref_t<U>, const_subdimension<tensor_lib_internal::_element_type_of<std::remove_cvref_t<U>>, tensor_lib_internal::_rank_of<std::remove_cvref_t<U>>>>;
+
+	namespace tensor_lib_internal
+	{
+		template <typename Destination, typename Expression>
+		inline constexpr auto& _compound_assign(Destination& destination, const Expression& expression)
+		{
+			const auto destination_ranks = destination.get_ranks();
+			const auto expression_ranks = expression.get_ranks();
+
+			if (!std::equal(destination_ranks.begin(), destination_ranks.end(), expression_ranks.begin(), expression_ranks.end()))
+			{
+				throw std::runtime_error("Size of the result doesn't match size of the destination!");
+			}
+
+			return destination = expression;
+		}
+	}
+
+	template <typename Destination, typename Operand> requires _assignable_tensor_object<Destination> && _expression_operands<std::remove_cvref_t<Destination>, Operand>
+	inline constexpr auto& operator+=(Destination&& destination, const Operand& operand)
+	{
+		return tensor_lib_internal::_compound_assign(destination, destination + operand);
+	}
+
+	template <typename Destination, typename Operand> requires _assignable_tensor_object<Destination> && _expression_operands<std::remove_cvref_t<Destination>, Operand>
+	inline constexpr auto& operator-=(Destination&& destination, const Operand& operand)
+	{
+		return tensor_lib_internal::_compound_assign(destination, destination - operand);
+	}
+
+	template <typename Destination, typename Operand> requires _assignable_tensor_object<Destination> && _expression_operands<std::remove_cvref_t<Destination>, Operand>
+	inline constexpr auto& operator*=(Destination&& destination, const Operand& operand)
+	{
+		return tensor_lib_internal::_compound_assign(destination, destination * operand);
+	}
+
+	template <typename Destination, typename Operand> requires _assignable_tensor_object<Destination> && _expression_operands<std::remove_cvref_t<Destination>, Operand>
+	inline constexpr auto& operator/=(Destination&& destination, const Operand& operand)
+	{
+		return tensor_lib_internal::_compound_assign(destination, destination / operand);
+	}
+}
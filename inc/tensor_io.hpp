@@ -0,0 +1,364 @@
+#pragma once
+
+#include "tensor.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <istream>
+#include <limits>
+#include <numeric>
+#include <ostream>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace tensor_lib
+{
+	// Tensor files hold a header padded to a multiple of 64 bytes, followed by the elements in row-major order,
+	// so the buffer is read with a single call (or mapped) at an aligned offset.
+	//
+	//   bytes 0-3     magic "TNSR"
+	//   bytes 4-5     format version
+	//   byte  6       dtype of the elements
+	//   byte  7       byte order of the elements (0 little endian, 1 big endian)
+	//   bytes 8-11    rank
+	//   bytes 12-15   size of an element in bytes
+	//   then          the order of each dimension, 8 bytes each
+	//
+	// Header fields are little endian. Elements are stored in the byte order of the machine that wrote them and swapped on load when needed.
+	//
+
+	inline constexpr std::array<char, 4> tensor_file_magic{ 'T', 'N', 'S', 'R' };
+	inline constexpr std::uint16_t tensor_file_version = 1;
+	inline constexpr std::size_t tensor_file_alignment = 64;
+
+	// Element types with a fixed meaning across machines. Other trivially copyable types are stored as 'raw' and only checked by size.
+	//
+	enum class dtype : std::uint8_t
+	{
+		raw = 0,
+		int8,
+		uint8,
+		int16,
+		uint16,
+		int32,
+		uint32,
+		int64,
+		uint64,
+		float32,
+		float64,
+		boolean
+	};
+
+	template <typename T>
+	inline constexpr dtype dtype_of() noexcept
+	{
+		using U = std::remove_cv_t<T>;
+
+		if constexpr (std::is_same_v<U, bool>)
+		{
+			return dtype::boolean;
+		}
+		else if constexpr (std::is_floating_point_v<U> && std::numeric_limits<U>::is_iec559 && (sizeof(U) == 4 || sizeof(U) == 8))
+		{
+			return (sizeof(U) == 4) ? dtype::float32 : dtype::float64;
+		}
+		else if constexpr (std::is_integral_v<U> && (sizeof(U) == 1 || sizeof(U) == 2 || sizeof(U) == 4 || sizeof(U) == 8))
+		{
+			constexpr std::size_t level = std::bit_width(sizeof(U)) - 1;
+			return static_cast<dtype>(static_cast<std::uint8_t>(dtype::int8) + 2 * level + (std::is_unsigned_v<U> ? 1 : 0));
+		}
+		else
+		{
+			return dtype::raw;
+		}
+	}
+
+	template <typename T>
+	inline constexpr dtype dtype_of_v = dtype_of<T>();
+
+	struct tensor_file_header
+	{
+		std::uint16_t version = tensor_file_version;
+		dtype type = dtype::raw;
+		std::endian byte_order = std::endian::native;
+		std::uint32_t element_size = 0;
+		std::vector<std::size_t> order_of_dimension;
+
+		inline std::size_t size() const noexcept
+		{
+			return std::accumulate(order_of_dimension.begin(), order_of_dimension.end(), std::size_t{ 1 }, std::multiplies<std::size_t>());
+		}
+
+		// Offset of the first element from the start of the header.
+		//
+		inline std::size_t data_offset() const noexcept
+		{
+			const std::size_t fields = 16 + 8 * order_of_dimension.size();
+			return (fields + tensor_file_alignment - 1) / tensor_file_alignment * tensor_file_alignment;
+		}
+	};
+
+	namespace tensor_lib_internal
+	{
+		template <typename Unsigned>
+		inline void _store_little_endian(unsigned char* destination, Unsigned value) noexcept
+		{
+			for (std::size_t byte = 0; byte < sizeof(Unsigned); byte++)
+			{
+				destination[byte] = static_cast<unsigned char>(value >> (8 * byte));
+			}
+		}
+
+		template <typename Unsigned>
+		inline Unsigned _load_little_endian(const unsigned char* source) noexcept
+		{
+			Unsigned value = 0;
+
+			for (std::size_t byte = 0; byte < sizeof(Unsigned); byte++)
+			{
+				value |= static_cast<Unsigned>(source[byte]) << (8 * byte);
+			}
+
+			return value;
+		}
+
+		// Whether 'offset' bytes followed by the elements of a tensor of the given dimensions fit in a stream, without the count wrapping around.
+		//
+		template <typename Sizes>
+		inline bool _byte_size_fits(const Sizes& order_of_dimension, const std::size_t element_size, const std::size_t offset = 0) noexcept
+		{
+			const std::size_t limit = static_cast<std::size_t>(std::numeric_limits<std::streamsize>::max());
+
+			if (offset > limit)
+			{
+				return false;
+			}
+
+			if (std::find(order_of_dimension.begin(), order_of_dimension.end(), std::size_t{ 0 }) != order_of_dimension.end())
+			{
+				return true;
+			}
+
+			std::size_t bytes = std::max(element_size, std::size_t{ 1 });
+
+			for (const std::size_t size : order_of_dimension)
+			{
+				if (bytes > (limit - offset) / size)
+				{
+					return false;
+				}
+
+				bytes *= size;
+			}
+
+			return true;
+		}
+
+		template <typename T>
+		inline void _byteswap_n(T* data, const std::size_t n) noexcept
+		{
+			for (std::size_t index = 0; index < n; index++)
+			{
+				unsigned char* bytes = reinterpret_cast<unsigned char*>(data + index);
+				std::reverse(bytes, bytes + sizeof(T));
+			}
+		}
+
+		// Throws unless the file holds elements of type T in a tensor of the given rank.
+		//
+		template <typename T, std::size_t Rank>
+		inline void _check_tensor_file_header(const tensor_file_header& header)
+		{
+			if (header.order_of_dimension.size() != Rank)
+			{
+				throw std::runtime_error("Rank of the tensor file doesn't match the rank of the tensor!");
+			}
+
+			if (header.type != dtype_of_v<T> || header.element_size != sizeof(T))
+			{
+				throw std::runtime_error("Element type of the tensor file doesn't match the element type of the tensor!");
+			}
+
+			if (header.byte_order != std::endian::native && dtype_of_v<T> == dtype::raw)
+			{
+				throw std::runtime_error("Can't convert the byte order of raw elements!");
+			}
+		}
+
+		template <typename Tensor>
+		using _element_t = std::remove_cvref_t<decltype(*std::declval<const Tensor&>().data())>;
+	}
+
+	inline void write_tensor_header(std::ostream& stream, const tensor_file_header& header)
+	{
+		std::vector<unsigned char> bytes(header.data_offset(), 0);
+
+		std::copy(tensor_file_magic.begin(), tensor_file_magic.end(), bytes.begin());
+		tensor_lib_internal::_store_little_endian(&bytes[4], header.version);
+		bytes[6] = static_cast<unsigned char>(header.type);
+		bytes[7] = (header.byte_order == std::endian::big) ? 1 : 0;
+		tensor_lib_internal::_store_little_endian(&bytes[8], static_cast<std::uint32_t>(header.order_of_dimension.size()));
+		tensor_lib_internal::_store_little_endian(&bytes[12], header.element_size);
+
+		for (std::size_t level = 0; level < header.order_of_dimension.size(); level++)
+		{
+			tensor_lib_internal::_store_little_endian(&bytes[16 + 8 * level], static_cast<std::uint64_t>(header.order_of_dimension[level]));
+		}
+
+		stream.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+
+		if (!stream)
+		{
+			throw std::runtime_error("Failed to write the tensor file header!");
+		}
+	}
+
+	// Reads a header and the padding after it, leaving the stream at the first element.
+	//
+	inline tensor_file_header read_tensor_header(std::istream& stream)
+	{
+		unsigned char fields[16];
+
+		if (!stream.read(reinterpret_cast<char*>(fields), sizeof(fields)))
+		{
+			throw std::runtime_error("Unexpected end of the tensor file!");
+		}
+
+		if (!std::equal(tensor_file_magic.begin(), tensor_file_magic.end(), fields, [](const char magic, const unsigned char byte) { return static_cast<unsigned char>(magic) == byte; }))
+		{
+			throw std::runtime_error("Not a tensor file!");
+		}
+
+		tensor_file_header header;
+		header.version = tensor_lib_internal::_load_little_endian<std::uint16_t>(&fields[4]);
+
+		if (header.version == 0 || header.version > tensor_file_version)
+		{
+			throw std::runtime_error("Unsupported tensor file version!");
+		}
+
+		if (fields[6] > static_cast<unsigned char>(dtype::boolean) || fields[7] > 1)
+		{
+			throw std::runtime_error("Corrupted tensor file header!");
+		}
+
+		header.type = static_cast<dtype>(fields[6]);
+		header.byte_order = fields[7] ? std::endian::big : std::endian::little;
+		header.element_size = tensor_lib_internal::_load_little_endian<std::uint32_t>(&fields[12]);
+
+		const std::uint32_t rank = tensor_lib_internal::_load_little_endian<std::uint32_t>(&fields[8]);
+
+		if (rank == 0 || rank > 255)
+		{
+			throw std::runtime_error("Corrupted tensor file header!");
+		}
+
+		header.order_of_dimension.resize(rank);
+
+		std::vector<unsigned char> rest(header.data_offset() - sizeof(fields));
+
+		if (!stream.read(reinterpret_cast<char*>(rest.data()), static_cast<std::streamsize>(rest.size())))
+		{
+			throw std::runtime_error("Unexpected end of the tensor file!");
+		}
+
+		for (std::size_t level = 0; level < rank; level++)
+		{
+			header.order_of_dimension[level] = static_cast<std::size_t>(tensor_lib_internal::_load_little_endian<std::uint64_t>(&rest[8 * level]));
+		}
+
+		if (!tensor_lib_internal::_byte_size_fits(header.order_of_dimension, header.element_size))
+		{
+			throw std::runtime_error("Corrupted tensor file header!");
+		}
+
+		return header;
+	}
+
+	// Writes the header and the elements of a tensor object (tensor, subdimension, static_tensor...) of trivially copyable elements.
+	//
+	template <typename Tensor> requires tensor_object<Tensor> && std::is_trivially_copyable_v<tensor_lib_internal::_element_t<Tensor>>
+	inline void save(std::ostream& stream, const Tensor& tsor)
+	{
+		using T = tensor_lib_internal::_element_t<Tensor>;
+
+		const auto ranks = tsor.get_ranks();
+
+		tensor_file_header header;
+		header.type = dtype_of_v<T>;
+		header.element_size = sizeof(T);
+		header.order_of_dimension.assign(ranks.begin(), ranks.end());
+
+		write_tensor_header(stream, header);
+
+		stream.write(reinterpret_cast<const char*>(tsor.data()), static_cast<std::streamsize>(tsor.size_of_current_tensor() * sizeof(T)));
+
+		if (!stream)
+		{
+			throw std::runtime_error("Failed to write the tensor file!");
+		}
+	}
+
+	template <typename Tensor> requires tensor_object<Tensor> && std::is_trivially_copyable_v<tensor_lib_internal::_element_t<Tensor>>
+	inline void save(const std::filesystem::path& path, const Tensor& tsor)
+	{
+		std::ofstream file(path, std::ios::binary | std::ios::trunc);
+
+		if (!file)
+		{
+			throw std::runtime_error("Can't open the tensor file for writing!");
+		}
+
+		save(file, tsor);
+	}
+
+	// Reads a tensor whose rank and element type must match the file. The elements are read with a single call straight into data().
+	//
+	template <typename T, std::size_t Rank, typename Allocator = std::allocator<T>> requires std::is_trivially_copyable_v<T>
+	inline tensor<T, Rank, Allocator> load(std::istream& stream, const Allocator& allocator = Allocator{})
+	{
+		const tensor_file_header header = read_tensor_header(stream);
+		tensor_lib_internal::_check_tensor_file_header<T, Rank>(header);
+
+		std::array<std::size_t, Rank> order_of_dimension;
+		std::copy_n(header.order_of_dimension.begin(), Rank, order_of_dimension.begin());
+
+		tensor<T, Rank, Allocator> result = std::apply([&allocator](const auto ... sizes)
+		{
+			return tensor<T, Rank, Allocator>(std::allocator_arg, allocator, sizes...);
+		}, order_of_dimension);
+
+		if (!stream.read(reinterpret_cast<char*>(result.data()), static_cast<std::streamsize>(result.size_of_current_tensor() * sizeof(T))))
+		{
+			throw std::runtime_error("Unexpected end of the tensor file!");
+		}
+
+		if (header.byte_order != std::endian::native)
+		{
+			tensor_lib_internal::_byteswap_n(result.data(), result.size_of_current_tensor());
+		}
+
+		return result;
+	}
+
+	template <typename T, std::size_t Rank, typename Allocator = std::allocator<T>> requires std::is_trivially_copyable_v<T>
+	inline tensor<T, Rank, Allocator> load(const std::filesystem::path& path, const Allocator& allocator = Allocator{})
+	{
+		std::ifstream file(path, std::ios::binary);
+
+		if (!file)
+		{
+			throw std::runtime_error("Can't open the tensor file for reading!");
+		}
+
+		return load<T, Rank, Allocator>(file, allocator);
+	}
+}
@@ -0,0 +1,1136 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <type_traits>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+	#define TENSORLIB_X86_KERNELS 1
+	#include <immintrin.h>
+	#if defined(_MSC_VER) && !defined(__clang__)
+		#include <intrin.h>
+	#endif
+#else
+	#define TENSORLIB_X86_KERNELS 0
+#endif
+
+// GCC and Clang only emit instructions of the ISAs enabled on the command line, unless the function asks for more.
+// MSVC always accepts the intrinsics, so there is nothing to annotate.
+//
+#if defined(__GNUC__) || defined(__clang__)
+	#define TENSORLIB_TARGET(isa) __attribute__((target(isa)))
+#else
+	#define TENSORLIB_TARGET(isa)
+#endif
+
+// Register tiles only stay in registers when the loops over them are fully unrolled, which -O2 doesn't always do on its own.
+//
+#if defined(__clang__)
+	#define TENSORLIB_UNROLL _Pragma("unroll")
+#elif defined(__GNUC__)
+	#define TENSORLIB_UNROLL _Pragma("GCC unroll 16")
+#else
+	#define TENSORLIB_UNROLL
+#endif
+
+namespace tensor_lib
+{
+	// Element-wise kernels working on raw contiguous buffers. float, double and int32_t get explicit SSE2, AVX2 and AVX-512 paths,
+	// picked at runtime from what the CPU supports; every other type (and every constant evaluated call) goes through the scalar loops.
+	// Buffers may be unaligned, but the output of a kernel must either be disjoint from its inputs or be exactly one of them.
+	//
+	namespace kernels
+	{
+		enum class instruction_set
+		{
+			scalar,
+			sse2,
+			avx2,
+			avx512
+		};
+
+		template <typename T>
+		static constexpr bool is_vectorizable_v = std::is_same_v<T, float> || std::is_same_v<T, double> || std::is_same_v<T, std::int32_t>;
+
+		// Same semantics as std::min / std::max, including the operand returned for NaNs and equal values.
+		//
+		struct minimum_operation
+		{
+			template <typename U>
+			inline constexpr U operator()(const U& lhs, const U& rhs) const
+			{
+				return (rhs < lhs) ? rhs : lhs;
+			}
+		};
+
+		struct maximum_operation
+		{
+			template <typename U>
+			inline constexpr U operator()(const U& lhs, const U& rhs) const
+			{
+				return (lhs < rhs) ? rhs : lhs;
+			}
+		};
+
+		template <typename Operation>
+		static constexpr bool is_kernel_operation_v = std::is_same_v<Operation, std::plus<>>
+			|| std::is_same_v<Operation, std::minus<>>
+			|| std::is_same_v<Operation, std::multiplies<>>
+			|| std::is_same_v<Operation, std::divides<>>
+			|| std::is_same_v<Operation, minimum_operation>
+			|| std::is_same_v<Operation, maximum_operation>;
+
+		// Operations reduce() folds with SIMD registers. They are associative, so lanes may be combined in any order.
+		//
+		template <typename Operation>
+		static constexpr bool is_reduction_operation_v = std::is_same_v<Operation, std::plus<>>
+			|| std::is_same_v<Operation, std::multiplies<>>
+			|| std::is_same_v<Operation, minimum_operation>
+			|| std::is_same_v<Operation, maximum_operation>;
+
+		// Floating point sums are pairwise: every accumulator adds at most '_pairwise_block' values in order, and the partial sums
+		// are added as a balanced tree, so the rounding error grows with log(n) instead of n.
+		//
+		template <typename Operation, typename T>
+		static constexpr bool _is_pairwise_sum_v = std::is_same_v<Operation, std::plus<>> && std::is_floating_point_v<T>;
+
+		static constexpr std::size_t _pairwise_block = 128;
+
+		inline instruction_set _detect_instruction_set() noexcept
+		{
+#if TENSORLIB_X86_KERNELS && (defined(__GNUC__) || defined(__clang__))
+			__builtin_cpu_init();
+
+			if (__builtin_cpu_supports("avx512f"))
+			{
+				return instruction_set::avx512;
+			}
+			if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+			{
+				return instruction_set::avx2;
+			}
+			if (__builtin_cpu_supports("sse2"))
+			{
+				return instruction_set::sse2;
+			}
+			return instruction_set::scalar;
+#elif TENSORLIB_X86_KERNELS && defined(_MSC_VER)
+			int info[4]{};
+
+			__cpuid(info, 0);
+			const int highest_leaf = info[0];
+
+			__cpuid(info, 1);
+			const bool sse2 = (info[3] & (1 << 26)) != 0;
+			const bool fma = (info[2] & (1 << 12)) != 0;
+			const bool os_saves_ymm = (info[2] & (1 << 27)) != 0 && (_xgetbv(0) & 0x06) == 0x06;
+			const bool os_saves_zmm = os_saves_ymm && (_xgetbv(0) & 0xE6) == 0xE6;
+
+			bool avx2 = false;
+			bool avx512 = false;
+
+			if (highest_leaf >= 7)
+			{
+				__cpuidex(info, 7, 0);
+				avx2 = (info[1] & (1 << 5)) != 0;
+				avx512 = (info[1] & (1 << 16)) != 0;
+			}
+
+			if (avx512 && os_saves_zmm)
+			{
+				return instruction_set::avx512;
+			}
+			if (avx2 && fma && os_saves_ymm)
+			{
+				return instruction_set::avx2;
+			}
+			return sse2 ? instruction_set::sse2 : instruction_set::scalar;
+#else
+			return instruction_set::scalar;
+#endif
+		}
+
+		inline instruction_set detected_instruction_set() noexcept
+		{
+			static const instruction_set detected = _detect_instruction_set();
+			return detected;
+		}
+
+		inline std::atomic<instruction_set>& _active_instruction_set() noexcept
+		{
+			static std::atomic<instruction_set> active{ detected_instruction_set() };
+			return active;
+		}
+
+		inline instruction_set active_instruction_set() noexcept
+		{
+			return _active_instruction_set().load(std::memory_order_relaxed);
+		}
+
+		// Restricts the kernels to a lower instruction set (ex: for testing or benchmarking every path on the same machine).
+		// Requests above what the CPU supports are clamped.
+		//
+		inline void set_instruction_set(const instruction_set isa) noexcept
+		{
+			_active_instruction_set().store(std::min(isa, detected_instruction_set()), std::memory_order_relaxed);
+		}
+
+		namespace _scalar
+		{
+			template <typename Operation, bool LhsScalar, bool RhsScalar, typename T>
+			inline constexpr void binary(const T* lhs, const T* rhs, T* out, const std::size_t n, std::size_t index = 0)
+			{
+				const Operation operation{};
+
+				for (; index < n; ++index)
+				{
+					out[index] = static_cast<T>(operation(lhs[LhsScalar ? 0 : index], rhs[RhsScalar ? 0 : index]));
+				}
+			}
+
+			template <bool AScalar, bool BScalar, bool CScalar, typename T>
+			inline constexpr void fma(const T* a, const T* b, const T* c, T* out, const std::size_t n, std::size_t index = 0)
+			{
+				for (; index < n; ++index)
+				{
+					out[index] = static_cast<T>(a[AScalar ? 0 : index] * b[BScalar ? 0 : index] + c[CScalar ? 0 : index]);
+				}
+			}
+
+			template <typename T>
+			inline constexpr bool equal(const T* lhs, const T* rhs, const std::size_t n, std::size_t index = 0)
+			{
+				for (; index < n; ++index)
+				{
+					if (!(lhs[index] == rhs[index]))
+					{
+						return false;
+					}
+				}
+				return true;
+			}
+
+			// Folds the n > 0 elements of 'data'.
+			//
+			template <typename Operation, typename T>
+			inline constexpr T reduce(const T* data, const std::size_t n)
+			{
+				if constexpr (_is_pairwise_sum_v<Operation, T>)
+				{
+					if (n > _pairwise_block)
+					{
+						const std::size_t half = n / 2;
+						return static_cast<T>(reduce<Operation>(data, half) + reduce<Operation>(data + half, n - half));
+					}
+				}
+
+				const Operation operation{};
+				T result = data[0];
+
+				for (std::size_t index = 1; index < n; ++index)
+				{
+					result = static_cast<T>(operation(result, data[index]));
+				}
+				return result;
+			}
+
+			// c = a * b, where a is m x k and b is k x n. Rows of 'c' are 'c_row_stride' apart, the elements of a row are contiguous.
+			// With 'Accumulate' the product is added to 'c' instead.
+			//
+			template <bool Accumulate = false, typename T>
+			inline constexpr void gemm(const std::size_t m, const std::size_t n, const std::size_t k,
+				const T* a, const std::size_t a_row_stride, const std::size_t a_column_stride,
+				const T* b, const std::size_t b_row_stride, const std::size_t b_column_stride,
+				T* c, const std::size_t c_row_stride)
+			{
+				for (std::size_t i = 0; i < m; ++i)
+				{
+					T* c_row = c + i * c_row_stride;
+
+					if constexpr (!Accumulate)
+					{
+						for (std::size_t j = 0; j < n; ++j)
+						{
+							c_row[j] = T{};
+						}
+					}
+
+					for (std::size_t p = 0; p < k; ++p)
+					{
+						const T a_value = a[i * a_row_stride + p * a_column_stride];
+						const T* b_row = b + p * b_row_stride;
+
+						for (std::size_t j = 0; j < n; ++j)
+						{
+							c_row[j] = static_cast<T>(c_row[j] + a_value * b_row[j * b_column_stride]);
+						}
+					}
+				}
+			}
+		}
+
+#if TENSORLIB_X86_KERNELS
+
+// The loops are identical for every instruction set, only the register traits they are compiled against
+// (and the target they are compiled for) differ. Each ISA namespace below defines '_register_traits' and then stamps these out.
+//
+#define TENSORLIB_DEFINE_KERNEL_LOOPS(TARGET)                                                                                           \
+		template <typename Operation, typename Traits>                                                                                      \
+		TARGET inline typename Traits::register_type _apply(const typename Traits::register_type a, const typename Traits::register_type b) \
+		{                                                                                                                                   \
+			if constexpr (std::is_same_v<Operation, std::plus<>>) return Traits::add(a, b);                                                 \
+			else if constexpr (std::is_same_v<Operation, std::minus<>>) return Traits::subtract(a, b);                                      \
+			else if constexpr (std::is_same_v<Operation, std::multiplies<>>) return Traits::multiply(a, b);                                 \
+			else if constexpr (std::is_same_v<Operation, std::divides<>>) return Traits::divide(a, b);                                      \
+			else if constexpr (std::is_same_v<Operation, minimum_operation>) return Traits::minimum(a, b);                                  \
+			else return Traits::maximum(a, b);                                                                                              \
+		}                                                                                                                                   \
+                                                                                                                                            \
+		template <typename Operation, bool LhsScalar, bool RhsScalar, typename T>                                                           \
+		TARGET inline void binary(const T* lhs, const T* rhs, T* out, const std::size_t n)                                                  \
+		{                                                                                                                                   \
+			using traits = _register_traits<T>;                                                                                             \
+			std::size_t index = 0;                                                                                                          \
+                                                                                                                                            \
+			if constexpr (!std::is_same_v<Operation, std::divides<>> || traits::has_divide)                                                 \
+			{                                                                                                                               \
+				typename traits::register_type a = traits::broadcast(LhsScalar ? *lhs : T{}), b = traits::broadcast(RhsScalar ? *rhs : T{});                            \
+                                                                                                                                            \
+				for (; index + traits::width <= n; index += traits::width)                                                                  \
+				{                                                                                                                           \
+					if constexpr (!LhsScalar) a = traits::load(lhs + index);                                                                \
+					if constexpr (!RhsScalar) b = traits::load(rhs + index);                                                                \
+					traits::store(out + index, _apply<Operation, traits>(a, b));                                                            \
+				}                                                                                                                           \
+			}                                                                                                                               \
+                                                                                                                                            \
+			_scalar::binary<Operation, LhsScalar, RhsScalar>(lhs, rhs, out, n, index);                                                      \
+		}                                                                                                                                   \
+                                                                                                                                            \
+		template <bool AScalar, bool BScalar, bool CScalar, typename T>                                                                     \
+		TARGET inline void fma(const T* a, const T* b, const T* c, T* out, const std::size_t n)                                             \
+		{                                                                                                                                   \
+			using traits = _register_traits<T>;                                                                                             \
+			std::size_t index = 0;                                                                                                          \
+			typename traits::register_type x = traits::broadcast(AScalar ? *a : T{}), y = traits::broadcast(BScalar ? *b : T{});            \
+			typename traits::register_type z = traits::broadcast(CScalar ? *c : T{});                                                      \
+                                                                                                                                            \
+			for (; index + traits::width <= n; index += traits::width)                                                                      \
+			{                                                                                                                               \
+				if constexpr (!AScalar) x = traits::load(a + index);                                                                        \
+				if constexpr (!BScalar) y = traits::load(b + index);                                                                        \
+				if constexpr (!CScalar) z = traits::load(c + index);                                                                        \
+				traits::store(out + index, traits::fmadd(x, y, z));                                                                         \
+			}                                                                                                                               \
+                                                                                                                                            \
+			_scalar::fma<AScalar, BScalar, CScalar>(a, b, c, out, n, index);                                                                \
+		}                                                                                                                                   \
+                                                                                                                                            \
+		template <typename T>                                                                                                               \
+		TARGET inline bool equal(const T* lhs, const T* rhs, const std::size_t n)                                                           \
+		{                                                                                                                                   \
+			using traits = _register_traits<T>;                                                                                             \
+			std::size_t index = 0;                                                                                                          \
+                                                                                                                                            \
+			for (; index + traits::width <= n; index += traits::width)                                                                      \
+			{                                                                                                                               \
+				if (!traits::all_equal(traits::load(lhs + index), traits::load(rhs + index)))                                               \
+				{                                                                                                                           \
+					return false;                                                                                                           \
+				}                                                                                                                           \
+			}                                                                                                                               \
+                                                                                                                                            \
+			return _scalar::equal(lhs, rhs, n, index);                                                                                      \
+		}                                                                                                                                   \
+                                                                                                                                            \
+		TARGET inline void copy_bytes(const unsigned char* source, unsigned char* destination, const std::size_t bytes)                     \
+		{                                                                                                                                   \
+			using traits = _register_traits<std::int32_t>;                                                                                  \
+			constexpr std::size_t step = traits::width * sizeof(std::int32_t);                                                             \
+			std::size_t index = 0;                                                                                                          \
+                                                                                                                                            \
+			for (; index + 4 * step <= bytes; index += 4 * step)                                                                            \
+			{                                                                                                                               \
+				const auto r0 = traits::load_bytes(source + index);                                                                         \
+				const auto r1 = traits::load_bytes(source + index + step);                                                                  \
+				const auto r2 = traits::load_bytes(source + index + 2 * step);                                                              \
+				const auto r3 = traits::load_bytes(source + index + 3 * step);                                                              \
+				traits::store_bytes(destination + index, r0);                                                                               \
+				traits::store_bytes(destination + index + step, r1);                                                                        \
+				traits::store_bytes(destination + index + 2 * step, r2);                                                                    \
+				traits::store_bytes(destination + index + 3 * step, r3);                                                                    \
+			}                                                                                                                               \
+			for (; index + step <= bytes; index += step)                                                                                    \
+			{                                                                                                                               \
+				traits::store_bytes(destination + index, traits::load_bytes(source + index));                                               \
+			}                                                                                                                               \
+                                                                                                                                            \
+			std::memcpy(destination + index, source + index, bytes - index);                                                                \
+		}                                                                                                                                   \
+                                                                                                                                            \
+		TARGET inline void fill_bytes(unsigned char* destination, const std::size_t bytes, const unsigned char* pattern)                    \
+		{                                                                                                                                   \
+			using traits = _register_traits<std::int32_t>;                                                                                  \
+			constexpr std::size_t step = traits::width * sizeof(std::int32_t);                                                              \
+                                                                                                                                            \
+			if (bytes < step)                                                                                                               \
+			{                                                                                                                               \
+				std::memcpy(destination, pattern, bytes);                                                                                   \
+				return;                                                                                                                     \
+			}                                                                                                                               \
+                                                                                                                                            \
+			const auto value = traits::load_bytes(pattern);                                                                                 \
+			std::size_t index = 0;                                                                                                          \
+                                                                                                                                            \
+			for (; index + step <= bytes; index += step)                                                                                    \
+			{                                                                                                                               \
+				traits::store_bytes(destination + index, value);                                                                            \
+			}                                                                                                                               \
+                                                                                                                                            \
+			std::memcpy(destination + index, pattern, bytes - index);                                                                       \
+		}                                                                                                                                   \
+                                                                                                                                            \
+		template <typename Operation, typename T>                                                                                           \
+		TARGET inline T reduce(const T* data, const std::size_t n)                                                                          \
+		{                                                                                                                                   \
+			using traits = _register_traits<T>;                                                                                             \
+			constexpr std::size_t step = 4 * traits::width;                                                                                 \
+                                                                                                                                            \
+			if (n < step)                                                                                                                   \
+			{                                                                                                                               \
+				return _scalar::reduce<Operation>(data, n);                                                                                 \
+			}                                                                                                                               \
+                                                                                                                                            \
+			if constexpr (_is_pairwise_sum_v<Operation, T>)                                                                                 \
+			{                                                                                                                               \
+				if (n > _pairwise_block * step)                                                                                             \
+				{                                                                                                                           \
+					const std::size_t half = n / 2;                                                                                         \
+					return static_cast<T>(reduce<Operation>(data, half) + reduce<Operation>(data + half, n - half));                        \
+				}                                                                                                                           \
+			}                                                                                                                               \
+                                                                                                                                            \
+			auto r0 = traits::load(data), r1 = traits::load(data + traits::width);                                                          \
+			auto r2 = traits::load(data + 2 * traits::width), r3 = traits::load(data + 3 * traits::width);                                  \
+			std::size_t index = step;                                                                                                       \
+                                                                                                                                            \
+			for (; index + step <= n; index += step)                                                                                        \
+			{                                                                                                                               \
+				r0 = _apply<Operation, traits>(r0, traits::load(data + index));                                                             \
+				r1 = _apply<Operation, traits>(r1, traits::load(data + index + traits::width));                                             \
+				r2 = _apply<Operation, traits>(r2, traits::load(data + index + 2 * traits::width));                                         \
+				r3 = _apply<Operation, traits>(r3, traits::load(data + index + 3 * traits::width));                                         \
+			}                                                                                                                               \
+                                                                                                                                            \
+			T lanes[traits::width];                                                                                                         \
+			traits::store(lanes, _apply<Operation, traits>(_apply<Operation, traits>(r0, r1), _apply<Operation, traits>(r2, r3)));          \
+                                                                                                                                            \
+			const T result = _scalar::reduce<Operation>(lanes, traits::width);                                                              \
+                                                                                                                                            \
+			return (index == n) ? result : static_cast<T>(Operation{}(result, _scalar::reduce<Operation>(data + index, n - index)));        \
+		}
+
+// GEMM micro-kernel: accumulates the product of a packed ROWS x depth panel of 'a' and a packed depth x (2 * width) panel of 'b'
+// into a tile of 'c', keeping the whole tile in registers for the entire depth. Partial tiles at the edges of 'c' go through a buffer.
+//
+#define TENSORLIB_DEFINE_GEMM_MICRO_KERNEL(TARGET, ROWS)                                                                               \
+		static constexpr std::size_t _gemm_rows = ROWS;                                                                                     \
+                                                                                                                                            \
+		template <typename T>                                                                                                               \
+		static constexpr std::size_t _gemm_columns = 2 * _register_traits<T>::width;                                                       \
+                                                                                                                                            \
+		template <typename T>                                                                                                               \
+		TARGET inline void gemm_micro_kernel(const std::size_t depth, const T* a, const T* b, T* c, const std::size_t c_row_stride,         \
+			const std::size_t rows, const std::size_t columns)                                                                              \
+		{                                                                                                                                   \
+			using traits = _register_traits<T>;                                                                                             \
+			constexpr std::size_t width = traits::width;                                                                                    \
+			typename traits::register_type low[ROWS], high[ROWS];                                                                           \
+                                                                                                                                            \
+			for (std::size_t i = 0; i < ROWS; ++i)                                                                                          \
+			{                                                                                                                               \
+				low[i] = traits::broadcast(T{});                                                                                            \
+				high[i] = traits::broadcast(T{});                                                                                           \
+			}                                                                                                                               \
+                                                                                                                                            \
+			for (std::size_t p = 0; p < depth; ++p, a += ROWS, b += 2 * width)                                                              \
+			{                                                                                                                               \
+				const auto b_low = traits::load(b);                                                                                         \
+				const auto b_high = traits::load(b + width);                                                                                \
+                                                                                                                                            \
+				TENSORLIB_UNROLL                                                                                                            \
+				for (std::size_t i = 0; i < ROWS; ++i)                                                                                      \
+				{                                                                                                                           \
+					const auto a_value = traits::broadcast(a[i]);                                                                           \
+					low[i] = traits::fmadd(a_value, b_low, low[i]);                                                                         \
+					high[i] = traits::fmadd(a_value, b_high, high[i]);                                                                      \
+				}                                                                                                                           \
+			}                                                                                                                               \
+                                                                                                                                            \
+			if (rows == ROWS && columns == 2 * width)                                                                                       \
+			{                                                                                                                               \
+				for (std::size_t i = 0; i < ROWS; ++i, c += c_row_stride)                                                                   \
+				{                                                                                                                           \
+					traits::store(c, traits::add(traits::load(c), low[i]));                                                                 \
+					traits::store(c + width, traits::add(traits::load(c + width), high[i]));                                                \
+				}                                                                                                                           \
+			}                                                                                                                               \
+			else                                                                                                                            \
+			{                                                                                                                               \
+				T tile[ROWS * 2 * width];                                                                                                   \
+                                                                                                                                            \
+				for (std::size_t i = 0; i < ROWS; ++i)                                                                                      \
+				{                                                                                                                           \
+					traits::store(tile + i * 2 * width, low[i]);                                                                            \
+					traits::store(tile + i * 2 * width + width, high[i]);                                                                   \
+				}                                                                                                                           \
+                                                                                                                                            \
+				for (std::size_t i = 0; i < rows; ++i)                                                                                      \
+				{                                                                                                                           \
+					for (std::size_t j = 0; j < columns; ++j)                                                                               \
+					{                                                                                                                       \
+						c[i * c_row_stride + j] += tile[i * 2 * width + j];                                                                 \
+					}                                                                                                                       \
+				}                                                                                                                           \
+			}                                                                                                                               \
+		}
+
+		namespace _sse2
+		{
+			template <typename T>
+			struct _register_traits;
+
+			template <>
+			struct _register_traits<float>
+			{
+				using register_type = __m128;
+				static constexpr std::size_t width = 4;
+				static constexpr bool has_divide = true;
+
+				TENSORLIB_TARGET("sse2") static inline register_type load(const float* p) { return _mm_loadu_ps(p); }
+				TENSORLIB_TARGET("sse2") static inline void store(float* p, const register_type a) { _mm_storeu_ps(p, a); }
+				TENSORLIB_TARGET("sse2") static inline register_type broadcast(const float value) { return _mm_set1_ps(value); }
+				TENSORLIB_TARGET("sse2") static inline register_type add(const register_type a, const register_type b) { return _mm_add_ps(a, b); }
+				TENSORLIB_TARGET("sse2") static inline register_type subtract(const register_type a, const register_type b) { return _mm_sub_ps(a, b); }
+				TENSORLIB_TARGET("sse2") static inline register_type multiply(const register_type a, const register_type b) { return _mm_mul_ps(a, b); }
+				TENSORLIB_TARGET("sse2") static inline register_type divide(const register_type a, const register_type b) { return _mm_div_ps(a, b); }
+				TENSORLIB_TARGET("sse2") static inline register_type minimum(const register_type a, const register_type b) { return _mm_min_ps(b, a); }
+				TENSORLIB_TARGET("sse2") static inline register_type maximum(const register_type a, const register_type b) { return _mm_max_ps(b, a); }
+				TENSORLIB_TARGET("sse2") static inline register_type fmadd(const register_type a, const register_type b, const register_type c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+				TENSORLIB_TARGET("sse2") static inline bool all_equal(const register_type a, const register_type b) { return _mm_movemask_ps(_mm_cmpeq_ps(a, b)) == 0xF; }
+			};
+
+			template <>
+			struct _register_traits<double>
+			{
+				using register_type = __m128d;
+				static constexpr std::size_t width = 2;
+				static constexpr bool has_divide = true;
+
+				TENSORLIB_TARGET("sse2") static inline register_type load(const double* p) { return _mm_loadu_pd(p); }
+				TENSORLIB_TARGET("sse2") static inline void store(double* p, const register_type a) { _mm_storeu_pd(p, a); }
+				TENSORLIB_TARGET("sse2") static inline register_type broadcast(const double value) { return _mm_set1_pd(value); }
+				TENSORLIB_TARGET("sse2") static inline register_type add(const register_type a, const register_type b) { return _mm_add_pd(a, b); }
+				TENSORLIB_TARGET("sse2") static inline register_type subtract(const register_type a, const register_type b) { return _mm_sub_pd(a, b); }
+				TENSORLIB_TARGET("sse2") static inline register_type multiply(const register_type a, const register_type b) { return _mm_mul_pd(a, b); }
+				TENSORLIB_TARGET("sse2") static inline register_type divide(const register_type a, const register_type b) { return _mm_div_pd(a, b); }
+				TENSORLIB_TARGET("sse2") static inline register_type minimum(const register_type a, const register_type b) { return _mm_min_pd(b, a); }
+				TENSORLIB_TARGET("sse2") static inline register_type maximum(const register_type a, const register_type b) { return _mm_max_pd(b, a); }
+				TENSORLIB_TARGET("sse2") static inline register_type fmadd(const register_type a, const register_type b, const register_type c) { return _mm_add_pd(_mm_mul_pd(a, b), c); }
+				TENSORLIB_TARGET("sse2") static inline bool all_equal(const register_type a, const register_type b) { return _mm_movemask_pd(_mm_cmpeq_pd(a, b)) == 0x3; }
+			};
+
+			template <>
+			struct _register_traits<std::int32_t>
+			{
+				using register_type = __m128i;
+				static constexpr std::size_t width = 4;
+				static constexpr bool has_divide = false;
+
+				TENSORLIB_TARGET("sse2") static inline register_type load_bytes(const void* p) { return _mm_loadu_si128(static_cast<const __m128i*>(p)); }
+				TENSORLIB_TARGET("sse2") static inline void store_bytes(void* p, const register_type a) { _mm_storeu_si128(static_cast<__m128i*>(p), a); }
+				TENSORLIB_TARGET("sse2") static inline register_type load(const std::int32_t* p) { return load_bytes(p); }
+				TENSORLIB_TARGET("sse2") static inline void store(std::int32_t* p, const register_type a) { store_bytes(p, a); }
+				TENSORLIB_TARGET("sse2") static inline register_type broadcast(const std::int32_t value) { return _mm_set1_epi32(value); }
+				TENSORLIB_TARGET("sse2") static inline register_type add(const register_type a, const register_type b) { return _mm_add_epi32(a, b); }
+				TENSORLIB_TARGET("sse2") static inline register_type subtract(const register_type a, const register_type b) { return _mm_sub_epi32(a, b); }
+
+				// SSE2 has no 32 bit lane multiplication, min or max. Multiply the even and odd lanes as 64 bit products and keep the low halves,
+				// compare and blend for min / max.
+				//
+				TENSORLIB_TARGET("sse2") static inline register_type multiply(const register_type a, const register_type b)
+				{
+					const __m128i even = _mm_mul_epu32(a, b);
+					const __m128i odd = _mm_mul_epu32(_mm_srli_si128(a, 4), _mm_srli_si128(b, 4));
+					return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)), _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+				}
+
+				TENSORLIB_TARGET("sse2") static inline register_type minimum(const register_type a, const register_type b)
+				{
+					const __m128i b_is_less = _mm_cmplt_epi32(b, a);
+					return _mm_or_si128(_mm_and_si128(b_is_less, b), _mm_andnot_si128(b_is_less, a));
+				}
+
+				TENSORLIB_TARGET("sse2") static inline register_type maximum(const register_type a, const register_type b)
+				{
+					const __m128i a_is_less = _mm_cmplt_epi32(a, b);
+					return _mm_or_si128(_mm_and_si128(a_is_less, b), _mm_andnot_si128(a_is_less, a));
+				}
+
+				TENSORLIB_TARGET("sse2") static inline register_type fmadd(const register_type a, const register_type b, const register_type c) { return add(multiply(a, b), c); }
+				TENSORLIB_TARGET("sse2") static inline bool all_equal(const register_type a, const register_type b) { return _mm_movemask_epi8(_mm_cmpeq_epi32(a, b)) == 0xFFFF; }
+			};
+
+			TENSORLIB_DEFINE_KERNEL_LOOPS(TENSORLIB_TARGET("sse2"))
+			TENSORLIB_DEFINE_GEMM_MICRO_KERNEL(TENSORLIB_TARGET("sse2"), 6)
+		}
+
+		namespace _avx2
+		{
+			template <typename T>
+			struct _register_traits;
+
+			template <>
+			struct _register_traits<float>
+			{
+				using register_type = __m256;
+				static constexpr std::size_t width = 8;
+				static constexpr bool has_divide = true;
+
+				TENSORLIB_TARGET("avx2,fma") static inline register_type load(const float* p) { return _mm256_loadu_ps(p); }
+				TENSORLIB_TARGET("avx2,fma") static inline void store(float* p, const register_type a) { _mm256_storeu_ps(p, a); }
+				TENSORLIB_TARGET("avx2,fma") static inline register_type broadcast(const float value) { return _mm256_set1_ps(value); }
+				TENSORLIB_TARGET("avx2,fma") static inline register_type add(const register_type a, const register_type b) { return _mm256_add_ps(a, b); }
+				TENSORLIB_TARGET("avx2,fma") static inline register_type subtract(const register_type a, const register_type b) { return _mm256_sub_ps(a, b); }
+				TENSORLIB_TARGET("avx2,fma") static inline register_type multiply(const register_type a, const register_type b) { return _mm256_mul_ps(a, b); }
+				TENSORLIB_TARGET("avx2,fma") static inline register_type divide(const register_type a, const register_type b) { return _mm256_div_ps(a, b); }
+				TENSORLIB_TARGET("avx2,fma") static inline register_type minimum(const register_type a, const register_type b) { return _mm256_min_ps(b, a); }
+				TENSORLIB_TARGET("avx2,fma") static inline register_type maximum(const register_type a, const register_type b) { return _mm256_max_ps(b, a); }
+				TENSORLIB_TARGET("avx2,fma") static inline register_type fmadd(const register_type a, const register_type b, const register_type c) { return _mm256_fmadd_ps(a, b, c); }
+				TENSORLIB_TARGET("avx2,fma") static inline bool all_equal(const register_type a, const register_type b) { return _mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_EQ_OQ)) == 0xFF; }
+			};
+
+			template <>
+			struct _register_traits<double>
+			{
+				using register_type = __m256d;
+				static constexpr std::size_t width = 4;
+				static constexpr bool has_divide = true;
+
+				TENSORLIB_TARGET("avx2,fma") static inline register_type load(const double* p) { return _mm256_loadu_pd(p); }
+				TENSORLIB_TARGET("avx2,fma") static inline void store(double* p, const register_type a) { _mm256_storeu_pd(p, a); }
+				TENSORLIB_TARGET("avx2,fma") static inline register_type broadcast(const double value) { return _mm256_set1_pd(value); }
+				TENSORLIB_TARGET("avx2,fma") static inline register_type add(const register_type a, const register_type b) { return _mm256_add_pd(a, b); }
+				TENSORLIB_TARGET("avx2,fma") static inline register_type subtract(const register_type a, const register_type b) { return _mm256_sub_pd(a, b); }
+				TENSORLIB_TARGET("avx2,fma") static inline register_type multiply(const register_type a, const register_type b) { return _mm256_mul_pd(a, b); }
+				TENSORLIB_TARGET("avx2,fma") static inline register_type divide(const register_type a, const register_type b) { return _mm256_div_pd(a, b); }
+				TENSORLIB_TARGET("avx2,fma") static inline register_type minimum(const register_type a, const register_type b) { return _mm256_min_pd(b, a); }
+				TENSORLIB_TARGET("avx2,fma") static inline register_type maximum(const register_type a, const register_type b) { return _mm256_max_pd(b, a); }
+				TENSORLIB_TARGET("avx2,fma") static inline register_type fmadd(const register_type a, const register_type b, const register_type c) { return _mm256_fmadd_pd(a, b, c); }
+				TENSORLIB_TARGET("avx2,fma") static inline bool all_equal(const register_type a, const register_type b) { return _mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_EQ_OQ)) == 0xF; }
+			};
+
+			template <>
+			struct _register_traits<std::int32_t>
+			{
+				using register_type = __m256i;
+				static constexpr std::size_t width = 8;
+				static constexpr bool has_divide = false;
+
+				TENSORLIB_TARGET("avx2,fma") static inline register_type load_bytes(const void* p) { return _mm256_loadu_si256(static_cast<const __m256i*>(p)); }
+				TENSORLIB_TARGET("avx2,fma") static inline void store_bytes(void* p, const register_type a) { _mm256_storeu_si256(static_cast<__m256i*>(p), a); }
+				TENSORLIB_TARGET("avx2,fma") static inline register_type load(const std::int32_t* p) { return load_bytes(p); }
+				TENSORLIB_TARGET("avx2,fma") static inline void store(std::int32_t* p, const register_type a) { store_bytes(p, a); }
+				TENSORLIB_TARGET("avx2,fma") static inline register_type broadcast(const std::int32_t value) { return _mm256_set1_epi32(value); }
+				TENSORLIB_TARGET("avx2,fma") static inline register_type add(const register_type a, const register_type b) { return _mm256_add_epi32(a, b); }
+				TENSORLIB_TARGET("avx2,fma") static inline register_type subtract(const register_type a, const register_type b) { return _mm256_sub_epi32(a, b); }
+				TENSORLIB_TARGET("avx2,fma") static inline register_type multiply(const register_type a, const register_type b) { return _mm256_mullo_epi32(a, b); }
+				TENSORLIB_TARGET("avx2,fma") static inline register_type minimum(const register_type a, const register_type b) { return _mm256_min_epi32(a, b); }
+				TENSORLIB_TARGET("avx2,fma") static inline register_type maximum(const register_type a, const register_type b) { return _mm256_max_epi32(a, b); }
+				TENSORLIB_TARGET("avx2,fma") static inline register_type fmadd(const register_type a, const register_type b, const register_type c) { return add(multiply(a, b), c); }
+				TENSORLIB_TARGET("avx2,fma") static inline bool all_equal(const register_type a, const register_type b) { return _mm256_movemask_epi8(_mm256_cmpeq_epi32(a, b)) == -1; }
+			};
+
+			TENSORLIB_DEFINE_KERNEL_LOOPS(TENSORLIB_TARGET("avx2,fma"))
+			TENSORLIB_DEFINE_GEMM_MICRO_KERNEL(TENSORLIB_TARGET("avx2,fma"), 6)
+		}
+
+		namespace _avx512
+		{
+			template <typename T>
+			struct _register_traits;
+
+			template <>
+			struct _register_traits<float>
+			{
+				using register_type = __m512;
+				static constexpr std::size_t width = 16;
+				static constexpr bool has_divide = true;
+
+				TENSORLIB_TARGET("avx512f") static inline register_type load(const float* p) { return _mm512_loadu_ps(p); }
+				TENSORLIB_TARGET("avx512f") static inline void store(float* p, const register_type a) { _mm512_storeu_ps(p, a); }
+				TENSORLIB_TARGET("avx512f") static inline register_type broadcast(const float value) { return _mm512_set1_ps(value); }
+				TENSORLIB_TARGET("avx512f") static inline register_type add(const register_type a, const register_type b) { return _mm512_add_ps(a, b); }
+				TENSORLIB_TARGET("avx512f") static inline register_type subtract(const register_type a, const register_type b) { return _mm512_sub_ps(a, b); }
+				TENSORLIB_TARGET("avx512f") static inline register_type multiply(const register_type a, const register_type b) { return _mm512_mul_ps(a, b); }
+				TENSORLIB_TARGET("avx512f") static inline register_type divide(const register_type a, const register_type b) { return _mm512_div_ps(a, b); }
+				TENSORLIB_TARGET("avx512f") static inline register_type minimum(const register_type a, const register_type b) { return _mm512_min_ps(b, a); }
+				TENSORLIB_TARGET("avx512f") static inline register_type maximum(const register_type a, const register_type b) { return _mm512_max_ps(b, a); }
+				TENSORLIB_TARGET("avx512f") static inline register_type fmadd(const register_type a, const register_type b, const register_type c) { return _mm512_fmadd_ps(a, b, c); }
+				TENSORLIB_TARGET("avx512f") static inline bool all_equal(const register_type a, const register_type b) { return _mm512_cmp_ps_mask(a, b, _CMP_EQ_OQ) == 0xFFFF; }
+			};
+
+			template <>
+			struct _register_traits<double>
+			{
+				using register_type = __m512d;
+				static constexpr std::size_t width = 8;
+				static constexpr bool has_divide = true;
+
+				TENSORLIB_TARGET("avx512f") static inline register_type load(const double* p) { return _mm512_loadu_pd(p); }
+				TENSORLIB_TARGET("avx512f") static inline void store(double* p, const register_type a) { _mm512_storeu_pd(p, a); }
+				TENSORLIB_TARGET("avx512f") static inline register_type broadcast(const double value) { return _mm512_set1_pd(value); }
+				TENSORLIB_TARGET("avx512f") static inline register_type add(const register_type a, const register_type b) { return _mm512_add_pd(a, b); }
+				TENSORLIB_TARGET("avx512f") static inline register_type subtract(const register_type a, const register_type b) { return _mm512_sub_pd(a, b); }
+				TENSORLIB_TARGET("avx512f") static inline register_type multiply(const register_type a, const register_type b) { return _mm512_mul_pd(a, b); }
+				TENSORLIB_TARGET("avx512f") static inline register_type divide(const register_type a, const register_type b) { return _mm512_div_pd(a, b); }
+				TENSORLIB_TARGET("avx512f") static inline register_type minimum(const register_type a, const register_type b) { return _mm512_min_pd(b, a); }
+				TENSORLIB_TARGET("avx512f") static inline register_type maximum(const register_type a, const register_type b) { return _mm512_max_pd(b, a); }
+				TENSORLIB_TARGET("avx512f") static inline register_type fmadd(const register_type a, const register_type b, const register_type c) { return _mm512_fmadd_pd(a, b, c); }
+				TENSORLIB_TARGET("avx512f") static inline bool all_equal(const register_type a, const register_type b) { return _mm512_cmp_pd_mask(a, b, _CMP_EQ_OQ) == 0xFF; }
+			};
+
+			template <>
+			struct _register_traits<std::int32_t>
+			{
+				using register_type = __m512i;
+				static constexpr std::size_t width = 16;
+				static constexpr bool has_divide = false;
+
+				TENSORLIB_TARGET("avx512f") static inline register_type load_bytes(const void* p) { return _mm512_loadu_si512(p); }
+				TENSORLIB_TARGET("avx512f") static inline void store_bytes(void* p, const register_type a) { _mm512_storeu_si512(p, a); }
+				TENSORLIB_TARGET("avx512f") static inline register_type load(const std::int32_t* p) { return load_bytes(p); }
+				TENSORLIB_TARGET("avx512f") static inline void store(std::int32_t* p, const register_type a) { store_bytes(p, a); }
+				TENSORLIB_TARGET("avx512f") static inline register_type broadcast(const std::int32_t value) { return _mm512_set1_epi32(value); }
+				TENSORLIB_TARGET("avx512f") static inline register_type add(const register_type a, const register_type b) { return _mm512_add_epi32(a, b); }
+				TENSORLIB_TARGET("avx512f") static inline register_type subtract(const register_type a, const register_type b) { return _mm512_sub_epi32(a, b); }
+				TENSORLIB_TARGET("avx512f") static inline register_type multiply(const register_type a, const register_type b) { return _mm512_mullo_epi32(a, b); }
+				TENSORLIB_TARGET("avx512f") static inline register_type minimum(const register_type a, const register_type b) { return _mm512_min_epi32(a, b); }
+				TENSORLIB_TARGET("avx512f") static inline register_type maximum(const register_type a, const register_type b) { return _mm512_max_epi32(a, b); }
+				TENSORLIB_TARGET("avx512f") static inline register_type fmadd(const register_type a, const register_type b, const register_type c) { return add(multiply(a, b), c); }
+				TENSORLIB_TARGET("avx512f") static inline bool all_equal(const register_type a, const register_type b) { return _mm512_cmpeq_epi32_mask(a, b) == 0xFFFF; }
+			};
+
+			TENSORLIB_DEFINE_KERNEL_LOOPS(TENSORLIB_TARGET("avx512f"))
+			TENSORLIB_DEFINE_GEMM_MICRO_KERNEL(TENSORLIB_TARGET("avx512f"), 12)
+		}
+
+#undef TENSORLIB_DEFINE_KERNEL_LOOPS
+#undef TENSORLIB_DEFINE_GEMM_MICRO_KERNEL
+
+#endif
+
+		// out[i] = lhs[i] op rhs[i]. A "Scalar" operand points to a single value broadcast over the whole range.
+		//
+		template <typename Operation, bool LhsScalar = false, bool RhsScalar = false, typename T>
+		inline constexpr void binary(const T* lhs, const T* rhs, T* out, const std::size_t n)
+		{
+			static_assert(is_kernel_operation_v<Operation>, "Operation has no kernel.");
+
+			if constexpr (is_vectorizable_v<T>)
+			{
+				if (!std::is_constant_evaluated())
+				{
+#if TENSORLIB_X86_KERNELS
+					switch (active_instruction_set())
+					{
+					case instruction_set::avx512:
+						_avx512::binary<Operation, LhsScalar, RhsScalar>(lhs, rhs, out, n);
+						return;
+					case instruction_set::avx2:
+						_avx2::binary<Operation, LhsScalar, RhsScalar>(lhs, rhs, out, n);
+						return;
+					case instruction_set::sse2:
+						_sse2::binary<Operation, LhsScalar, RhsScalar>(lhs, rhs, out, n);
+						return;
+					case instruction_set::scalar:
+						break;
+					}
+#endif
+				}
+			}
+
+			_scalar::binary<Operation, LhsScalar, RhsScalar>(lhs, rhs, out, n);
+		}
+
+		template <typename T>
+		inline constexpr void add(const T* lhs, const T* rhs, T* out, const std::size_t n)
+		{
+			binary<std::plus<>>(lhs, rhs, out, n);
+		}
+
+		template <typename T>
+		inline constexpr void subtract(const T* lhs, const T* rhs, T* out, const std::size_t n)
+		{
+			binary<std::minus<>>(lhs, rhs, out, n);
+		}
+
+		template <typename T>
+		inline constexpr void multiply(const T* lhs, const T* rhs, T* out, const std::size_t n)
+		{
+			binary<std::multiplies<>>(lhs, rhs, out, n);
+		}
+
+		template <typename T>
+		inline constexpr void divide(const T* lhs, const T* rhs, T* out, const std::size_t n)
+		{
+			binary<std::divides<>>(lhs, rhs, out, n);
+		}
+
+		template <typename T>
+		inline constexpr void minimum(const T* lhs, const T* rhs, T* out, const std::size_t n)
+		{
+			binary<minimum_operation>(lhs, rhs, out, n);
+		}
+
+		template <typename T>
+		inline constexpr void maximum(const T* lhs, const T* rhs, T* out, const std::size_t n)
+		{
+			binary<maximum_operation>(lhs, rhs, out, n);
+		}
+
+		// out[i] = a[i] * b[i] + c[i], fused into a single rounding on CPUs with FMA units.
+		//
+		template <bool AScalar = false, bool BScalar = false, bool CScalar = false, typename T>
+		inline constexpr void fma(const T* a, const T* b, const T* c, T* out, const std::size_t n)
+		{
+			if constexpr (is_vectorizable_v<T>)
+			{
+				if (!std::is_constant_evaluated())
+				{
+#if TENSORLIB_X86_KERNELS
+					switch (active_instruction_set())
+					{
+					case instruction_set::avx512:
+						_avx512::fma<AScalar, BScalar, CScalar>(a, b, c, out, n);
+						return;
+					case instruction_set::avx2:
+						_avx2::fma<AScalar, BScalar, CScalar>(a, b, c, out, n);
+						return;
+					case instruction_set::sse2:
+						_sse2::fma<AScalar, BScalar, CScalar>(a, b, c, out, n);
+						return;
+					case instruction_set::scalar:
+						break;
+					}
+#endif
+				}
+			}
+
+			_scalar::fma<AScalar, BScalar, CScalar>(a, b, c, out, n);
+		}
+
+		template <typename T>
+		inline constexpr bool equal(const T* lhs, const T* rhs, const std::size_t n)
+		{
+			if constexpr (is_vectorizable_v<T>)
+			{
+				if (!std::is_constant_evaluated())
+				{
+#if TENSORLIB_X86_KERNELS
+					switch (active_instruction_set())
+					{
+					case instruction_set::avx512:
+						return _avx512::equal(lhs, rhs, n);
+					case instruction_set::avx2:
+						return _avx2::equal(lhs, rhs, n);
+					case instruction_set::sse2:
+						return _sse2::equal(lhs, rhs, n);
+					case instruction_set::scalar:
+						break;
+					}
+#endif
+				}
+			}
+
+			return _scalar::equal(lhs, rhs, n);
+		}
+
+		// Folds the n > 0 elements of 'data' with 'Operation' (ex: reduce<std::plus<>>(data, n) is their sum).
+		//
+		template <typename Operation, typename T>
+		inline constexpr T reduce(const T* data, const std::size_t n)
+		{
+			static_assert(is_reduction_operation_v<Operation>, "Operation has no reduction kernel.");
+
+			if constexpr (is_vectorizable_v<T>)
+			{
+				if (!std::is_constant_evaluated())
+				{
+#if TENSORLIB_X86_KERNELS
+					switch (active_instruction_set())
+					{
+					case instruction_set::avx512:
+						return _avx512::reduce<Operation>(data, n);
+					case instruction_set::avx2:
+						return _avx2::reduce<Operation>(data, n);
+					case instruction_set::sse2:
+						return _sse2::reduce<Operation>(data, n);
+					case instruction_set::scalar:
+						break;
+					}
+#endif
+				}
+			}
+
+			return _scalar::reduce<Operation>(data, n);
+		}
+
+		// Copies are done on the bytes of the elements, so they are vectorized for every trivially copyable type.
+		//
+		template <typename T>
+		inline constexpr void copy(const T* source, T* destination, const std::size_t n)
+		{
+			if constexpr (std::is_trivially_copyable_v<T>)
+			{
+				if (!std::is_constant_evaluated())
+				{
+					const auto bytes = n * sizeof(T);
+
+					if (bytes == 0)
+					{
+						return;
+					}
+
+					const auto source_bytes = reinterpret_cast<const unsigned char*>(source);
+					const auto destination_bytes = reinterpret_cast<unsigned char*>(destination);
+#if TENSORLIB_X86_KERNELS
+					switch (active_instruction_set())
+					{
+					case instruction_set::avx512:
+						_avx512::copy_bytes(source_bytes, destination_bytes, bytes);
+						return;
+					case instruction_set::avx2:
+						_avx2::copy_bytes(source_bytes, destination_bytes, bytes);
+						return;
+					case instruction_set::sse2:
+						_sse2::copy_bytes(source_bytes, destination_bytes, bytes);
+						return;
+					case instruction_set::scalar:
+						break;
+					}
+#endif
+					std::memcpy(destination_bytes, source_bytes, bytes);
+					return;
+				}
+			}
+
+			std::copy_n(source, n, destination);
+		}
+
+		// Fills repeat a 64 byte pattern made out of copies of 'value', so every arithmetic type whose size divides 64 is vectorized.
+		//
+		template <typename T>
+		inline constexpr void fill(T* destination, const std::size_t n, const T& value)
+		{
+			if constexpr (std::is_arithmetic_v<T> && (64 % sizeof(T) == 0))
+			{
+				if (!std::is_constant_evaluated() && n != 0)
+				{
+#if TENSORLIB_X86_KERNELS
+					alignas(64) unsigned char pattern[64];
+
+					for (std::size_t offset = 0; offset < sizeof(pattern); offset += sizeof(T))
+					{
+						std::memcpy(pattern + offset, &value, sizeof(T));
+					}
+
+					const auto bytes = n * sizeof(T);
+					const auto destination_bytes = reinterpret_cast<unsigned char*>(destination);
+
+					switch (active_instruction_set())
+					{
+					case instruction_set::avx512:
+						_avx512::fill_bytes(destination_bytes, bytes, pattern);
+						return;
+					case instruction_set::avx2:
+						_avx2::fill_bytes(destination_bytes, bytes, pattern);
+						return;
+					case instruction_set::sse2:
+						_sse2::fill_bytes(destination_bytes, bytes, pattern);
+						return;
+					case instruction_set::scalar:
+						break;
+					}
+#endif
+				}
+			}
+
+			std::fill_n(destination, n, value);
+		}
+
+		// Cache blocking of the packed GEMM: a depth x column block of 'b' is packed once and stays in L3, a row x depth block of 'a' stays in L2,
+		// and every micro-kernel call streams a panel of each from L1. The row block is a multiple of the micro-kernel rows of every instruction set.
+		//
+		static constexpr std::size_t _gemm_row_block = 144;
+		static constexpr std::size_t _gemm_depth_block = 192;
+		static constexpr std::size_t _gemm_column_block = 2048;
+
+		// Below this many multiply-adds packing costs more than it saves.
+		//
+		static constexpr std::size_t _gemm_minimum_work = 16 * 16 * 16;
+
+		// Packs 'rows' x 'depth' of 'a' into panels of 'Rows' rows, each laid out depth-major, padding the last panel with zeros.
+		//
+		template <std::size_t Rows, typename T>
+		inline void _pack_gemm_rows(const std::size_t rows, const std::size_t depth, const T* a, const std::size_t row_stride, const std::size_t column_stride, T* packed)
+		{
+			for (std::size_t panel = 0; panel < rows; panel += Rows)
+			{
+				const std::size_t panel_rows = std::min(Rows, rows - panel);
+
+				for (std::size_t p = 0; p < depth; ++p, packed += Rows)
+				{
+					std::size_t i = 0;
+
+					for (; i < panel_rows; ++i)
+					{
+						packed[i] = a[(panel + i) * row_stride + p * column_stride];
+					}
+					for (; i < Rows; ++i)
+					{
+						packed[i] = T{};
+					}
+				}
+			}
+		}
+
+		// Packs 'depth' x 'columns' of 'b' into panels of 'Columns' columns, each laid out depth-major, padding the last panel with zeros.
+		//
+		template <std::size_t Columns, typename T>
+		inline void _pack_gemm_columns(const std::size_t depth, const std::size_t columns, const T* b, const std::size_t row_stride, const std::size_t column_stride, T* packed)
+		{
+			for (std::size_t panel = 0; panel < columns; panel += Columns)
+			{
+				const std::size_t panel_columns = std::min(Columns, columns - panel);
+
+				for (std::size_t p = 0; p < depth; ++p, packed += Columns)
+				{
+					const T* b_row = b + p * row_stride + panel * column_stride;
+					std::size_t j = 0;
+
+					for (; j < panel_columns; ++j)
+					{
+						packed[j] = b_row[j * column_stride];
+					}
+					for (; j < Columns; ++j)
+					{
+						packed[j] = T{};
+					}
+				}
+			}
+		}
+
+		template <std::size_t Rows, std::size_t Columns, bool Accumulate, typename T, typename MicroKernel>
+		inline void _blocked_gemm(const std::size_t m, const std::size_t n, const std::size_t k,
+			const T* a, const std::size_t a_row_stride, const std::size_t a_column_stride,
+			const T* b, const std::size_t b_row_stride, const std::size_t b_column_stride,
+			T* c, const std::size_t c_row_stride, const MicroKernel micro_kernel)
+		{
+			static_assert(_gemm_row_block % Rows == 0, "The row block must hold whole micro-kernel panels.");
+
+			// The micro-kernel adds its tile to 'c', so a plain product starts from zeros.
+			//
+			if constexpr (!Accumulate)
+			{
+				for (std::size_t i = 0; i < m; ++i)
+				{
+					std::fill_n(c + i * c_row_stride, n, T{});
+				}
+			}
+
+			// The packing buffers are kept around between calls, one pair per thread.
+			//
+			thread_local std::vector<T> a_panels, b_panels;
+
+			const std::size_t max_depth = std::min(k, _gemm_depth_block);
+			const std::size_t max_rows = (std::min(m, _gemm_row_block) + Rows - 1) / Rows * Rows;
+			const std::size_t max_columns = (std::min(n, _gemm_column_block) + Columns - 1) / Columns * Columns;
+
+			a_panels.resize(std::max(a_panels.size(), max_rows * max_depth));
+			b_panels.resize(std::max(b_panels.size(), max_depth * max_columns));
+
+			for (std::size_t jc = 0; jc < n; jc += _gemm_column_block)
+			{
+				const std::size_t nc = std::min(_gemm_column_block, n - jc);
+
+				for (std::size_t pc = 0; pc < k; pc += _gemm_depth_block)
+				{
+					const std::size_t kc = std::min(_gemm_depth_block, k - pc);
+
+					_pack_gemm_columns<Columns>(kc, nc, b + pc * b_row_stride + jc * b_column_stride, b_row_stride, b_column_stride, b_panels.data());
+
+					for (std::size_t ic = 0; ic < m; ic += _gemm_row_block)
+					{
+						const std::size_t mc = std::min(_gemm_row_block, m - ic);
+
+						_pack_gemm_rows<Rows>(mc, kc, a + ic * a_row_stride + pc * a_column_stride, a_row_stride, a_column_stride, a_panels.data());
+
+						for (std::size_t jr = 0; jr < nc; jr += Columns)
+						{
+							for (std::size_t ir = 0; ir < mc; ir += Rows)
+							{
+								micro_kernel(kc, a_panels.data() + ir * kc, b_panels.data() + jr * kc, c + (ic + ir) * c_row_stride + jc + jr, c_row_stride,
+									std::min(Rows, mc - ir), std::min(Columns, nc - jr));
+							}
+						}
+					}
+				}
+			}
+		}
+
+		// c = a * b, where 'a' is m x k, 'b' is k x n and 'c' is m x n. 'a' and 'b' may have any strides (a transposed operand is just
+		// a swap of its strides), the rows of 'c' must be contiguous and 'c' must not overlap either operand.
+		// gemm<true> adds the product to 'c' instead (c += a * b), to sum several products into one result without a temporary.
+		//
+		template <bool Accumulate = false, typename T>
+		inline constexpr void gemm(const std::size_t m, const std::size_t n, const std::size_t k,
+			const T* a, const std::size_t a_row_stride, const std::size_t a_column_stride,
+			const T* b, const std::size_t b_row_stride, const std::size_t b_column_stride,
+			T* c, const std::size_t c_row_stride)
+		{
+			if constexpr (is_vectorizable_v<T>)
+			{
+				if (!std::is_constant_evaluated() && m * n * k >= _gemm_minimum_work)
+				{
+#if TENSORLIB_X86_KERNELS
+					switch (active_instruction_set())
+					{
+					case instruction_set::avx512:
+						_blocked_gemm<_avx512::_gemm_rows, _avx512::_gemm_columns<T>, Accumulate>(m, n, k, a, a_row_stride, a_column_stride, b, b_row_stride, b_column_stride,
+							c, c_row_stride, &_avx512::gemm_micro_kernel<T>);
+						return;
+					case instruction_set::avx2:
+						_blocked_gemm<_avx2::_gemm_rows, _avx2::_gemm_columns<T>, Accumulate>(m, n, k, a, a_row_stride, a_column_stride, b, b_row_stride, b_column_stride,
+							c, c_row_stride, &_avx2::gemm_micro_kernel<T>);
+						return;
+					case instruction_set::sse2:
+						_blocked_gemm<_sse2::_gemm_rows, _sse2::_gemm_columns<T>, Accumulate>(m, n, k, a, a_row_stride, a_column_stride, b, b_row_stride, b_column_stride,
+							c, c_row_stride, &_sse2::gemm_micro_kernel<T>);
+						return;
+					case instruction_set::scalar:
+						break;
+					}
+#endif
+				}
+			}
+
+			_scalar::gemm<Accumulate>(m, n, k, a, a_row_stride, a_column_stride, b, b_row_stride, b_column_stride, c, c_row_stride);
+		}
+	}
+}
@@ -0,0 +1,1062 @@
+#pragma once
+
+#include "tensor.hpp"
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace tensor_lib
+{
+	// Storage layouts. A layout has a nested mapping<Rank>, built from the sizes of the dimensions, which gives the offset in the buffer
+	// of the element at some indices (like the layout mappings of std::mdspan):
+	//
+	//     struct my_layout
+	//     {
+	//         template <std::size_t Rank>
+	//         struct mapping
+	//         {
+	//             mapping(const std::array<std::size_t, Rank>& extents);
+	//             const std::array<std::size_t, Rank>& extents() const;
+	//             std::size_t required_span_size() const;                // number of elements of the buffer
+	//             std::size_t operator()(indices...) const;               // offset of the element at 'indices'
+	//         };
+	//     };
+	//
+	// Every offset below required_span_size() has to belong to exactly one element, so the buffer has no gaps and the iterators of a tensor
+	// visit each element once, in the order they are stored. Strided layouts also have stride(axis) and a static is_always_strided() returning true.
+	//
+	// tensor<T, Rank> is tensor<T, Rank, std::allocator<T>, layout_right>, the row-major tensor everything else is written for.
+	// Tensors of any other layout are defined below: they have the same shape, element access, iterators and resizing, but operator[] refers
+	// to elements through a small proxy instead of subdimensions and they aren't tensor objects. Strided ones are seen by view() as a tensor_view,
+	// and relayout() copies between layouts.
+	//
+
+	template <typename Layout, std::size_t Rank>
+	concept layout_policy = std::constructible_from<typename Layout::template mapping<Rank>, const std::array<std::size_t, Rank>&>
+		&& requires (const typename Layout::template mapping<Rank>& mapping, const std::array<std::size_t, Rank>& extents)
+	{
+		{ mapping.extents() } -> std::convertible_to<std::array<std::size_t, Rank>>;
+		{ mapping.required_span_size() } -> std::convertible_to<std::size_t>;
+		{ std::apply(mapping, extents) } -> std::convertible_to<std::size_t>;
+	};
+
+	template <typename Layout, std::size_t Rank>
+	concept strided_layout_policy = layout_policy<Layout, Rank> && requires (const typename Layout::template mapping<Rank>& mapping)
+	{
+		{ mapping.stride(std::size_t{}) } -> std::convertible_to<std::size_t>;
+		requires Layout::template mapping<Rank>::is_always_strided();
+	};
+
+	namespace tensor_lib_internal
+	{
+		// One tile of a tiled layout: the indices of its first element, its sizes (tiles on the far edges may be smaller) and the offset
+		// of its first element. The elements of a tile are stored together, in row-major order.
+		//
+		template <std::size_t Rank>
+		struct _tile_geometry
+		{
+			std::array<std::size_t, Rank> origin;
+			std::array<std::size_t, Rank> extents;
+			std::size_t offset;
+		};
+
+		template <typename Tensor>
+		class _tile_range;
+	}
+
+	// Layouts storing the elements by dense tiles (see "tensor_tiled.hpp"), their mapping numbers the tiles in storage order.
+	//
+	template <typename Layout, std::size_t Rank>
+	concept tiled_layout_policy = layout_policy<Layout, Rank> && requires (const typename Layout::template mapping<Rank>& mapping)
+	{
+		{ mapping.tile_count() } -> std::convertible_to<std::size_t>;
+		{ mapping.tile(std::size_t{}) } -> std::same_as<tensor_lib_internal::_tile_geometry<Rank>>;
+	};
+
+	// Layouts where the offset of an element is a sum of one term per index (as with strides, or the bits of a Morton code, see
+	// "tensor_morton.hpp"), their mapping gives each term. Copies into and out of them add up terms looked up in tables, by blocks.
+	//
+	template <typename Layout, std::size_t Rank>
+	concept separable_layout_policy = layout_policy<Layout, Rank> && requires (const typename Layout::template mapping<Rank>& mapping)
+	{
+		{ mapping.axis_offset(std::size_t{}, std::size_t{}) } -> std::convertible_to<std::size_t>;
+	};
+
+	namespace tensor_lib_internal
+	{
+		// Row-major (the last index is the fastest) or column-major (the first index is the fastest) strides.
+		//
+		template <std::size_t Rank, bool RowMajor>
+		class _strided_mapping
+		{
+		private:
+			std::array<std::size_t, Rank> _extents{};
+			std::array<std::size_t, Rank> _strides{};
+			std::size_t _size = 0;
+
+			template <std::size_t... Axes, typename... Indices>
+			inline constexpr std::size_t _offset(std::index_sequence<Axes...>, const Indices ... indices) const noexcept
+			{
+				return ((static_cast<std::size_t>(indices) * _strides[Axes]) + ...);
+			}
+
+		public:
+			static inline constexpr bool is_always_strided() noexcept
+			{
+				return true;
+			}
+
+			inline constexpr _strided_mapping() noexcept = default;
+
+			inline constexpr explicit _strided_mapping(const std::array<std::size_t, Rank>& extents) noexcept
+				: _extents{ extents }
+			{
+				std::size_t stride = 1;
+
+				for (std::size_t step = 0; step < Rank; step++)
+				{
+					const std::size_t axis = RowMajor ? Rank - 1 - step : step;
+					_strides[axis] = stride;
+					stride *= _extents[axis];
+				}
+
+				_size = stride;
+			}
+
+			inline constexpr const std::array<std::size_t, Rank>& extents() const noexcept
+			{
+				return _extents;
+			}
+
+			inline constexpr std::size_t required_span_size() const noexcept
+			{
+				return _size;
+			}
+
+			inline constexpr std::size_t stride(const std::size_t axis) const noexcept
+			{
+				return _strides[axis];
+			}
+
+			template <typename... Indices> requires (sizeof...(Indices) == Rank) && useful_concepts::integrals<Indices...>
+			inline constexpr std::size_t operator() (const Indices ... indices) const noexcept
+			{
+				return _offset(std::make_index_sequence<Rank>{}, indices...);
+			}
+		};
+
+		// Calls 'function' with the indices of every element of a tensor of the given sizes, in row-major order.
+		//
+		template <std::size_t Rank, typename Function>
+		inline constexpr void _for_each_index(const std::array<std::size_t, Rank>& extents, Function function)
+		{
+			if (std::find(extents.begin(), extents.end(), std::size_t{ 0 }) != extents.end())
+			{
+				return;
+			}
+
+			std::array<std::size_t, Rank> indices{};
+
+			for (;;)
+			{
+				function(std::as_const(indices));
+
+				std::size_t axis = Rank;
+
+				for (; axis > 0; axis--)
+				{
+					if (++indices[axis - 1] < extents[axis - 1])
+					{
+						break;
+					}
+
+					indices[axis - 1] = 0;
+				}
+
+				if (axis == 0)
+				{
+					return;
+				}
+			}
+		}
+
+		template <typename Source>
+		inline constexpr std::array<std::size_t, decltype(std::declval<const Source&>().get_ranks())::extent> _order_of_dimension_of(const Source& source) noexcept
+		{
+			std::array<std::size_t, decltype(std::declval<const Source&>().get_ranks())::extent> order_of_dimension;
+			const auto ranks = source.get_ranks();
+			std::copy(ranks.begin(), ranks.end(), order_of_dimension.begin());
+
+			return order_of_dimension;
+		}
+
+		template <typename U>
+		inline constexpr bool _is_tensor_with_layout_v = false;
+
+		template <typename T, std::size_t Rank, typename allocator_type, typename Layout>
+		inline constexpr bool _is_tensor_with_layout_v<tensor<T, Rank, allocator_type, Layout>> = true;
+
+		// What the elements of another tensor can be copied from: tensor objects and tensors of any layout.
+		//
+		template <typename Source, std::size_t Rank>
+		concept _relayout_source = (tensor_object<Source> || _is_tensor_with_layout_v<std::remove_cvref_t<Source>>)
+			&& (decltype(std::declval<const Source&>().get_ranks())::extent == Rank);
+
+		// operator[] of tensors that aren't row-major: each index is kept until the last one, which gives the element.
+		//
+		template <typename Tensor, std::size_t Remaining>
+		class _layout_subscript
+		{
+		private:
+			static constexpr std::size_t rank = decltype(std::declval<const Tensor&>().get_ranks())::extent;
+
+			Tensor& _tensor;
+			std::array<std::size_t, rank> _indices;
+
+		public:
+			inline constexpr _layout_subscript(Tensor& tsor, const std::array<std::size_t, rank>& indices) noexcept
+				: _tensor{ tsor }
+				, _indices{ indices }
+			{
+
+			}
+
+			inline constexpr decltype(auto) operator[] (const std::size_t index) const noexcept
+			{
+				std::array<std::size_t, rank> indices = _indices;
+				indices[rank - Remaining] = index;
+
+				if constexpr (Remaining == 1u)
+				{
+					return std::apply(_tensor, indices);
+				}
+				else
+				{
+					return _layout_subscript<Tensor, Remaining - 1>(_tensor, indices);
+				}
+			}
+		};
+	}
+
+	struct layout_right
+	{
+		template <std::size_t Rank>
+		using mapping = tensor_lib_internal::_strided_mapping<Rank, true>;
+	};
+
+	// Column-major, as Fortran, BLAS and LAPACK expect matrices to be.
+	//
+	struct layout_left
+	{
+		template <std::size_t Rank>
+		using mapping = tensor_lib_internal::_strided_mapping<Rank, false>;
+	};
+
+	namespace tensor_lib_internal
+	{
+		// Sources whose elements are found with strides: tensor objects, which are row-major, and tensors of a strided layout.
+		//
+		template <typename Source>
+		concept _strided_source = tensor_object<Source> || requires (const Source& source) { { source.stride(std::size_t{}) } -> std::convertible_to<std::size_t>; };
+
+		template <typename Source>
+		concept _tiled_source = requires { typename Source::layout_type; }
+			&& tiled_layout_policy<typename Source::layout_type, decltype(std::declval<const Source&>().get_ranks())::extent>;
+
+		template <typename Source>
+		concept _separable_source = requires { typename Source::layout_type; }
+			&& separable_layout_policy<typename Source::layout_type, decltype(std::declval<const Source&>().get_ranks())::extent>;
+
+		template <std::size_t Rank>
+		inline constexpr std::array<std::size_t, Rank> _row_major_strides(const std::array<std::size_t, Rank>& extents) noexcept
+		{
+			const layout_right::mapping<Rank> row_major(extents);
+			std::array<std::size_t, Rank> strides;
+
+			for (std::size_t axis = 0; axis < Rank; axis++)
+			{
+				strides[axis] = row_major.stride(axis);
+			}
+
+			return strides;
+		}
+
+		template <std::size_t Rank>
+		inline constexpr std::size_t _strided_offset(const std::array<std::size_t, Rank>& indices, const std::array<std::size_t, Rank>& strides) noexcept
+		{
+			return std::inner_product(indices.begin(), indices.end(), strides.begin(), std::size_t{ 0 });
+		}
+
+		template <typename Source> requires _strided_source<Source>
+		inline constexpr auto _strides_of(const Source& source) noexcept
+		{
+			constexpr std::size_t Rank = decltype(source.get_ranks())::extent;
+
+			if constexpr (tensor_object<Source>)
+			{
+				return _row_major_strides(_order_of_dimension_of(source));
+			}
+			else
+			{
+				std::array<std::size_t, Rank> strides;
+
+				for (std::size_t axis = 0; axis < Rank; axis++)
+				{
+					strides[axis] = source.stride(axis);
+				}
+
+				return strides;
+			}
+		}
+
+		// Copies between two strided buffers of the same shape. The last two axes are copied by blocks, so even when one buffer is read along
+		// its rows and the other along its columns (a transpose) only a few cache lines of each are in use at a time.
+		//
+		template <typename T, std::size_t Rank>
+		inline constexpr void _copy_strided(const std::array<std::size_t, Rank>& extents, const T* source, const std::array<std::size_t, Rank>& source_strides,
+			T* destination, const std::array<std::size_t, Rank>& destination_strides)
+		{
+			if constexpr (Rank == 1u)
+			{
+				for (std::size_t i = 0; i < extents[0]; i++)
+				{
+					destination[i * destination_strides[0]] = source[i * source_strides[0]];
+				}
+			}
+			else
+			{
+				constexpr std::size_t block = 32;
+
+				const std::size_t rows = extents[Rank - 2];
+				const std::size_t columns = extents[Rank - 1];
+
+				std::array<std::size_t, Rank> outer_extents = extents;
+				outer_extents[Rank - 2] = 1;
+				outer_extents[Rank - 1] = 1;
+
+				_for_each_index(outer_extents, [&](const std::array<std::size_t, Rank>& indices)
+				{
+					std::size_t source_offset = 0;
+					std::size_t destination_offset = 0;
+
+					for (std::size_t axis = 0; axis + 2 < Rank; axis++)
+					{
+						source_offset += indices[axis] * source_strides[axis];
+						destination_offset += indices[axis] * destination_strides[axis];
+					}
+
+					for (std::size_t row_block = 0; row_block < rows; row_block += block)
+					{
+						for (std::size_t column_block = 0; column_block < columns; column_block += block)
+						{
+							for (std::size_t row = row_block; row < std::min(rows, row_block + block); row++)
+							{
+								const T* source_row = source + source_offset + row * source_strides[Rank - 2];
+								T* destination_row = destination + destination_offset + row * destination_strides[Rank - 2];
+
+								for (std::size_t column = column_block; column < std::min(columns, column_block + block); column++)
+								{
+									destination_row[column * destination_strides[Rank - 1]] = source_row[column * source_strides[Rank - 1]];
+								}
+							}
+						}
+					}
+				});
+			}
+		}
+
+		// The term each index adds to the offset of an element, for every index along every axis.
+		//
+		template <std::size_t Rank>
+		using _axis_offsets = std::array<std::vector<std::size_t>, Rank>;
+
+		template <std::size_t Rank>
+		inline constexpr _axis_offsets<Rank> _strided_axis_offsets(const std::array<std::size_t, Rank>& extents, const std::array<std::size_t, Rank>& strides)
+		{
+			_axis_offsets<Rank> offsets;
+
+			for (std::size_t axis = 0; axis < Rank; axis++)
+			{
+				offsets[axis].resize(extents[axis]);
+
+				for (std::size_t index = 0; index < extents[axis]; index++)
+				{
+					offsets[axis][index] = index * strides[axis];
+				}
+			}
+
+			return offsets;
+		}
+
+		template <typename Mapping>
+		inline constexpr auto _mapping_axis_offsets(const Mapping& mapping)
+		{
+			constexpr std::size_t Rank = std::tuple_size_v<std::remove_cvref_t<decltype(mapping.extents())>>;
+
+			_axis_offsets<Rank> offsets;
+
+			for (std::size_t axis = 0; axis < Rank; axis++)
+			{
+				offsets[axis].resize(mapping.extents()[axis]);
+
+				for (std::size_t index = 0; index < mapping.extents()[axis]; index++)
+				{
+					offsets[axis][index] = static_cast<std::size_t>(mapping.axis_offset(axis, index));
+				}
+			}
+
+			return offsets;
+		}
+
+		// Copies between two buffers of the same shape whose offsets are sums of per-axis terms. Every axis is copied by blocks,
+		// small enough for the elements of a block to stay in cache on both sides whatever the order they are stored in.
+		//
+		template <typename T, std::size_t Rank>
+		inline constexpr void _copy_separable(const std::array<std::size_t, Rank>& extents, const T* source, const _axis_offsets<Rank>& source_offsets,
+			T* destination, const _axis_offsets<Rank>& destination_offsets)
+		{
+			constexpr std::size_t block = Rank == 1u ? 4096 : (Rank == 2u ? 64 : 16);
+
+			std::array<std::size_t, Rank> blocks;
+
+			for (std::size_t axis = 0; axis < Rank; axis++)
+			{
+				blocks[axis] = (extents[axis] + block - 1) / block;
+			}
+
+			_for_each_index(blocks, [&](const std::array<std::size_t, Rank>& block_indices)
+			{
+				std::array<std::size_t, Rank> first;
+				std::array<std::size_t, Rank> rows;
+
+				for (std::size_t axis = 0; axis < Rank; axis++)
+				{
+					first[axis] = block_indices[axis] * block;
+					rows[axis] = std::min(block, extents[axis] - first[axis]);
+				}
+
+				const std::size_t columns = rows[Rank - 1];
+				rows[Rank - 1] = 1;
+
+				const std::size_t* source_columns = source_offsets[Rank - 1].data() + first[Rank - 1];
+				const std::size_t* destination_columns = destination_offsets[Rank - 1].data() + first[Rank - 1];
+
+				_for_each_index(rows, [&](const std::array<std::size_t, Rank>& indices)
+				{
+					std::size_t source_offset = 0;
+					std::size_t destination_offset = 0;
+
+					for (std::size_t axis = 0; axis + 1 < Rank; axis++)
+					{
+						source_offset += source_offsets[axis][first[axis] + indices[axis]];
+						destination_offset += destination_offsets[axis][first[axis] + indices[axis]];
+					}
+
+					for (std::size_t column = 0; column < columns; column++)
+					{
+						destination[destination_offset + destination_columns[column]] = source[source_offset + source_columns[column]];
+					}
+				});
+			});
+		}
+
+		// Copies the elements of 'source' into 'destination', a buffer of the same shape stored with a separable 'mapping'.
+		//
+		template <typename Source, typename T, typename Mapping>
+		inline constexpr void _copy_into_separable(const Source& source, T* destination, const Mapping& mapping)
+		{
+			constexpr std::size_t Rank = decltype(source.get_ranks())::extent;
+
+			if constexpr (_strided_source<Source>)
+			{
+				_copy_separable(mapping.extents(), source.data(), _strided_axis_offsets(mapping.extents(), _strides_of(source)), destination, _mapping_axis_offsets(mapping));
+			}
+			else if constexpr (_separable_source<Source>)
+			{
+				_copy_separable(mapping.extents(), source.data(), _mapping_axis_offsets(source.mapping()), destination, _mapping_axis_offsets(mapping));
+			}
+			else
+			{
+				_for_each_index(_order_of_dimension_of(source), [&source, destination, &mapping](const std::array<std::size_t, Rank>& indices)
+				{
+					destination[std::apply(mapping, indices)] = std::apply(source, indices);
+				});
+			}
+		}
+
+		// Copies the elements of 'source' into 'destination', a buffer of the same shape with the given strides.
+		// Strided and separable sources are copied by blocks and tiled ones tile by tile, anything else element by element.
+		//
+		template <typename Source, typename T, std::size_t Rank>
+		inline constexpr void _copy_into_strided(const Source& source, T* destination, const std::array<std::size_t, Rank>& strides)
+		{
+			if constexpr (_strided_source<Source>)
+			{
+				_copy_strided(_order_of_dimension_of(source), source.data(), _strides_of(source), destination, strides);
+			}
+			else if constexpr (_separable_source<Source>)
+			{
+				_copy_separable(source.mapping().extents(), source.data(), _mapping_axis_offsets(source.mapping()), destination, _strided_axis_offsets(source.mapping().extents(), strides));
+			}
+			else if constexpr (_tiled_source<Source>)
+			{
+				for (std::size_t index = 0; index < source.mapping().tile_count(); index++)
+				{
+					const auto tile = source.mapping().tile(index);
+					_copy_strided(tile.extents, source.data() + tile.offset, _row_major_strides(tile.extents), destination + _strided_offset(tile.origin, strides), strides);
+				}
+			}
+			else
+			{
+				_for_each_index(_order_of_dimension_of(source), [&source, destination, &strides](const std::array<std::size_t, Rank>& indices)
+				{
+					destination[_strided_offset(indices, strides)] = std::apply(source, indices);
+				});
+			}
+		}
+
+		// Copies the elements of 'source' into 'destination', a buffer of the same shape stored by tiles with 'mapping'.
+		//
+		template <typename Source, typename T, typename Mapping>
+		inline constexpr void _copy_into_tiled(const Source& source, T* destination, const Mapping& mapping)
+		{
+			constexpr std::size_t Rank = decltype(source.get_ranks())::extent;
+
+			if constexpr (_strided_source<Source>)
+			{
+				const auto strides = _strides_of(source);
+
+				for (std::size_t index = 0; index < mapping.tile_count(); index++)
+				{
+					const auto tile = mapping.tile(index);
+					_copy_strided(tile.extents, source.data() + _strided_offset(tile.origin, strides), strides, destination + tile.offset, _row_major_strides(tile.extents));
+				}
+			}
+			else
+			{
+				_for_each_index(_order_of_dimension_of(source), [&source, destination, &mapping](const std::array<std::size_t, Rank>& indices)
+				{
+					destination[std::apply(mapping, indices)] = std::apply(source, indices);
+				});
+			}
+		}
+	}
+
+	template <typename T, std::size_t Rank, typename Layout, typename allocator_type = std::allocator<T>>
+	using layout_tensor = tensor<T, Rank, allocator_type, Layout>;
+
+	template <typename T, typename allocator_type = std::allocator<T>>
+	using column_major_matrix = tensor<T, 2, allocator_type, layout_left>;
+
+	template <typename T, std::size_t Rank, typename allocator_type, typename Layout> requires (Rank != 0u)
+	class tensor : public _tensor_common<T>, private allocator_type
+	{
+		static_assert(not std::same_as<T, void>,							"T cannot be void.");
+		static_assert(not std::is_const_v<T>,								"T cannot be const qualified.");
+		static_assert(not std::is_volatile_v<T>,							"T cannot be volatile qualified.");
+		static_assert(not std::is_reference_v<T>,							"T cannot be a reference.");
+		static_assert(std::is_copy_constructible_v<T>,						"T must be copy constructible.");
+		static_assert(std::is_copy_assignable_v<T>,							"T must be copy assignable.");
+		static_assert(std::same_as<T, typename allocator_type::value_type>,	"allocator_type::value_type must match T.");
+		static_assert(layout_policy<Layout, Rank>,							"Layout must have a mapping<Rank> (see layout_policy).");
+
+	public:
+		using layout_type = Layout;
+		using mapping_type = typename Layout::template mapping<Rank>;
+		using iterator = typename _tensor_common<T>::iterator;
+		using const_iterator = typename _tensor_common<T>::const_iterator;
+		using value_type = T;
+		using size_type = std::size_t;
+		using difference_type = std::ptrdiff_t;
+		using reference = T&;
+		using const_reference = const T&;
+
+		static constexpr std::size_t alignment = allocator_alignment_v<allocator_type>;
+
+	private:
+		using allocator_type_traits = std::allocator_traits<allocator_type>;
+
+		// Sizes of the dimensions and where each element is stored.
+		//
+		mapping_type _mapping{ std::array<std::size_t, Rank>{} };
+
+		T* _data = nullptr;
+
+		// Number of elements the buffer has room for, only the first size_of_current_tensor() are constructed.
+		//
+		std::size_t _capacity = 0;
+
+		constexpr allocator_type& _allocator() noexcept
+		{
+			return *static_cast<allocator_type*>(this);
+		}
+
+		constexpr const allocator_type& _allocator() const noexcept
+		{
+			return *static_cast<const allocator_type*>(this);
+		}
+
+		static inline constexpr std::size_t _checked_size(const mapping_type& mapping)
+		{
+			const auto& extents = mapping.extents();
+			const std::size_t size = std::accumulate(extents.begin(), extents.end(), std::size_t{ 1 }, std::multiplies<std::size_t>());
+
+			if (static_cast<std::size_t>(mapping.required_span_size()) != size)
+			{
+				throw std::runtime_error("Layout mapping must store every element of the tensor at its own offset, without gaps!");
+			}
+
+			return size;
+		}
+
+		inline constexpr void _release() noexcept
+		{
+			if (_data)
+			{
+				std::destroy_n(_data, size_of_current_tensor());
+				allocator_type_traits::deallocate(_allocator(), _data, _capacity);
+			}
+
+			_mapping = mapping_type{ std::array<std::size_t, Rank>{} };
+			_data = nullptr;
+			_capacity = 0;
+		}
+
+		inline constexpr T* _allocate_value_constructed(const std::size_t size)
+		{
+			T* buffer = allocator_type_traits::allocate(_allocator(), size);
+
+			try
+			{
+				tensor_lib_internal::_constexpr_uninitialized_value_construct_n(buffer, size);
+			}
+			catch (...)
+			{
+				allocator_type_traits::deallocate(_allocator(), buffer, size);
+				throw;
+			}
+
+			return buffer;
+		}
+
+		// Gives the tensor the new sizes with value initialized elements, the previous elements are discarded.
+		//
+		inline constexpr void _assign_shape(const std::array<std::size_t, Rank>& order_of_dimension)
+		{
+			const mapping_type mapping{ order_of_dimension };
+			const std::size_t size = _checked_size(mapping);
+
+			if (size > _capacity)
+			{
+				T* buffer = _allocate_value_constructed(size);
+				_release();
+				_data = buffer;
+				_capacity = size;
+			}
+			else
+			{
+				std::destroy_n(_data, size_of_current_tensor());
+				_mapping = mapping_type{ std::array<std::size_t, Rank>{} };
+				tensor_lib_internal::_constexpr_uninitialized_value_construct_n(_data, size);
+			}
+
+			_mapping = mapping;
+		}
+
+		template <typename Source>
+		inline constexpr void _copy_elements(const Source& source)
+		{
+			if constexpr (strided_layout_policy<Layout, Rank>)
+			{
+				tensor_lib_internal::_copy_into_strided(source, _data, tensor_lib_internal::_strides_of(*this));
+			}
+			else if constexpr (tiled_layout_policy<Layout, Rank>)
+			{
+				tensor_lib_internal::_copy_into_tiled(source, _data, _mapping);
+			}
+			else if constexpr (separable_layout_policy<Layout, Rank>)
+			{
+				tensor_lib_internal::_copy_into_separable(source, _data, _mapping);
+			}
+			else
+			{
+				tensor_lib_internal::_for_each_index(_mapping.extents(), [this, &source](const std::array<std::size_t, Rank>& indices)
+				{
+					_data[std::apply(_mapping, indices)] = std::apply(source, indices);
+				});
+			}
+		}
+
+	public:
+		inline constexpr tensor(const allocator_type& allocator = allocator_type{}) noexcept
+			: allocator_type{ allocator }
+		{
+
+		}
+
+		template <typename... Sizes> requires (sizeof...(Sizes) == Rank) && useful_concepts::integrals<Sizes...>
+		inline constexpr tensor(const Sizes ... sizes)
+			: tensor(std::allocator_arg, allocator_type{}, sizes...)
+		{
+
+		}
+
+		template <typename... Sizes> requires (sizeof...(Sizes) == Rank) && useful_concepts::integrals<Sizes...>
+		inline constexpr tensor(std::allocator_arg_t, const allocator_type& allocator, const Sizes ... sizes)
+			: allocator_type{ allocator }
+		{
+			_assign_shape({ static_cast<std::size_t>(sizes)... });
+		}
+
+		// Copies the elements of a tensor object or of a tensor of another layout, each to its place in this layout.
+		// Ex: column_major_matrix<double> fortran(row_major);
+		//
+		template <typename Source> requires tensor_lib_internal::_relayout_source<Source, Rank> && (!std::same_as<std::remove_cvref_t<Source>, tensor>)
+		inline constexpr explicit tensor(const Source& source, const allocator_type& allocator = allocator_type{})
+			: allocator_type{ allocator }
+		{
+			_assign_shape(tensor_lib_internal::_order_of_dimension_of(source));
+			_copy_elements(source);
+		}
+
+		inline constexpr tensor(const tensor& other)
+			: allocator_type{ allocator_type_traits::select_on_container_copy_construction(other._allocator()) }
+		{
+			const std::size_t size = other.size_of_current_tensor();
+
+			if (size)
+			{
+				_data = allocator_type_traits::allocate(_allocator(), size);
+
+				try
+				{
+					tensor_lib_internal::_uninitialized_copy_n(other._data, size, _data);
+				}
+				catch (...)
+				{
+					allocator_type_traits::deallocate(_allocator(), _data, size);
+					_data = nullptr;
+					throw;
+				}
+
+				_capacity = size;
+			}
+
+			_mapping = other._mapping;
+		}
+
+		inline constexpr tensor(tensor&& other) noexcept
+			: allocator_type{ other._allocator() }
+			, _mapping{ std::exchange(other._mapping, mapping_type{ std::array<std::size_t, Rank>{} }) }
+			, _data{ std::exchange(other._data, nullptr) }
+			, _capacity{ std::exchange(other._capacity, 0) }
+		{
+
+		}
+
+		inline constexpr tensor& operator= (const tensor& other)
+		{
+			if (this == &other)
+			{
+				return *this;
+			}
+
+			if constexpr (allocator_type_traits::propagate_on_container_copy_assignment::value)
+			{
+				// Our buffer can only be reused if the allocator we're taking over is able to release it.
+				//
+				if constexpr (!allocator_type_traits::is_always_equal::value)
+				{
+					if (_allocator() != other._allocator())
+					{
+						_release();
+					}
+				}
+
+				_allocator() = other._allocator();
+			}
+
+			_assign_shape(other._mapping.extents());
+			_copy_elements(other);
+
+			return *this;
+		}
+
+		// The buffer of 'other' is taken over when our allocator can release it, otherwise its elements are copied.
+		//
+		inline constexpr tensor& operator= (tensor&& other)
+		{
+			if (this == &other)
+			{
+				return *this;
+			}
+
+			if constexpr (allocator_type_traits::propagate_on_container_move_assignment::value)
+			{
+				_release();
+				_allocator() = other._allocator();
+			}
+			else if (!(_allocator() == other._allocator()))
+			{
+				return *this = std::as_const(other);
+			}
+			else
+			{
+				_release();
+			}
+
+			_mapping = std::exchange(other._mapping, mapping_type{ std::array<std::size_t, Rank>{} });
+			_data = std::exchange(other._data, nullptr);
+			_capacity = std::exchange(other._capacity, 0);
+
+			return *this;
+		}
+
+		inline constexpr ~tensor()
+		{
+			_release();
+		}
+
+		friend inline constexpr void swap(tensor& left, tensor& right) noexcept
+		{
+			if constexpr (allocator_type_traits::propagate_on_container_swap::value)
+			{
+				std::swap(left._allocator(), right._allocator());
+			}
+
+			std::swap(left._mapping, right._mapping);
+			std::swap(left._data, right._data);
+			std::swap(left._capacity, right._capacity);
+		}
+
+		// Tensors of the same layout are equal when they have the same shape and the same elements.
+		//
+		friend inline constexpr bool operator== (const tensor& left, const tensor& right)
+		{
+			const auto& left_extents = left._mapping.extents();
+			const auto& right_extents = right._mapping.extents();
+
+			return std::equal(left_extents.begin(), left_extents.end(), right_extents.begin(), right_extents.end())
+				&& std::equal(left._data, left._data + left.size_of_current_tensor(), right._data);
+		}
+
+		template <typename... Indices> requires (sizeof...(Indices) == Rank) && useful_concepts::integrals<Indices...>
+		inline constexpr T& operator() (const Indices ... indices) noexcept
+		{
+			return _data[_mapping(indices...)];
+		}
+
+		template <typename... Indices> requires (sizeof...(Indices) == Rank) && useful_concepts::integrals<Indices...>
+		inline constexpr const T& operator() (const Indices ... indices) const noexcept
+		{
+			return _data[_mapping(indices...)];
+		}
+
+		// t[i][j][k] refers to the same element as t(i, j, k).
+		//
+		inline constexpr decltype(auto) operator[] (const std::size_t index) noexcept
+		{
+			if constexpr (Rank == 1u)
+			{
+				return (*this)(index);
+			}
+			else
+			{
+				return tensor_lib_internal::_layout_subscript<tensor, Rank>(*this, {})[index];
+			}
+		}
+
+		inline constexpr decltype(auto) operator[] (const std::size_t index) const noexcept
+		{
+			if constexpr (Rank == 1u)
+			{
+				return (*this)(index);
+			}
+			else
+			{
+				return tensor_lib_internal::_layout_subscript<const tensor, Rank>(*this, {})[index];
+			}
+		}
+
+#if defined(__cpp_multidimensional_subscript)
+		template <typename... Indices> requires (sizeof...(Indices) == Rank) && (Rank > 1u) && useful_concepts::integrals<Indices...>
+		inline constexpr T& operator[] (const Indices ... indices) noexcept
+		{
+			return (*this)(indices...);
+		}
+
+		template <typename... Indices> requires (sizeof...(Indices) == Rank) && (Rank > 1u) && useful_concepts::integrals<Indices...>
+		inline constexpr const T& operator[] (const Indices ... indices) const noexcept
+		{
+			return (*this)(indices...);
+		}
+#endif
+
+		// The iterators walk the buffer, so they visit the elements in the order the layout stores them.
+		//
+		inline constexpr iterator begin() noexcept
+		{
+			return iterator(_data);
+		}
+
+		inline constexpr const_iterator begin() const noexcept
+		{
+			return const_iterator(_data);
+		}
+
+		inline constexpr const_iterator cbegin() const noexcept
+		{
+			return const_iterator(_data);
+		}
+
+		inline constexpr iterator end() noexcept
+		{
+			return iterator(_data + size_of_current_tensor());
+		}
+
+		inline constexpr const_iterator end() const noexcept
+		{
+			return const_iterator(_data + size_of_current_tensor());
+		}
+
+		inline constexpr const_iterator cend() const noexcept
+		{
+			return const_iterator(_data + size_of_current_tensor());
+		}
+
+		// Gives the tensor the new sizes with value initialized elements, the previous elements are discarded.
+		// The buffer is kept when it has room for the new elements.
+		//
+		template <typename... Sizes> requires (sizeof...(Sizes) == Rank) && useful_concepts::integrals<Sizes...>
+		inline constexpr void resize(const Sizes ... new_sizes)
+		{
+			_assign_shape({ static_cast<std::size_t>(new_sizes)... });
+		}
+
+		// Gives the tensor the new sizes while keeping every element whose indices are still in range at the same indices,
+		// new elements are value initialized. The elements are placed where the layout maps them for the new sizes.
+		// If an element can't be copied the tensor is left unchanged.
+		//
+		template <typename... Sizes> requires (sizeof...(Sizes) == Rank) && useful_concepts::integrals<Sizes...>
+		inline constexpr void resize_preserve(const Sizes ... new_sizes)
+		{
+			tensor result(std::allocator_arg, _allocator(), new_sizes...);
+
+			std::array<std::size_t, Rank> overlap{ static_cast<std::size_t>(new_sizes)... };
+			const auto& extents = _mapping.extents();
+
+			for (std::size_t axis = 0; axis < Rank; axis++)
+			{
+				overlap[axis] = std::min(overlap[axis], extents[axis]);
+			}
+
+			tensor_lib_internal::_for_each_index(overlap, [this, &result](const std::array<std::size_t, Rank>& indices)
+			{
+				std::apply(result, indices) = std::move_if_noexcept(std::apply(*this, indices));
+			});
+
+			swap(*this, result);
+		}
+
+		inline constexpr const mapping_type& mapping() const noexcept
+		{
+			return _mapping;
+		}
+
+		inline constexpr std::size_t stride(const std::size_t axis) const noexcept requires strided_layout_policy<Layout, Rank>
+		{
+			return _mapping.stride(axis);
+		}
+
+		// The tiles of a tiled layout in storage order, each a dense row-major tensor object (see "tensor_tiled.hpp").
+		//
+		inline constexpr auto tiles() noexcept requires tiled_layout_policy<Layout, Rank>
+		{
+			return tensor_lib_internal::_tile_range<tensor>(*this);
+		}
+
+		inline constexpr auto tiles() const noexcept requires tiled_layout_policy<Layout, Rank>
+		{
+			return tensor_lib_internal::_tile_range<const tensor>(*this);
+		}
+
+		inline constexpr auto get_ranks() const noexcept
+		{
+			return std::span<const std::size_t, Rank>(_mapping.extents());
+		}
+
+		inline constexpr std::size_t order_of_dimension(const std::size_t& index) const noexcept
+		{
+			return _mapping.extents()[index];
+		}
+
+		inline constexpr std::size_t order_of_current_dimension() const noexcept
+		{
+			return _mapping.extents()[0];
+		}
+
+		inline constexpr std::size_t size_of_current_tensor() const noexcept
+		{
+			return static_cast<std::size_t>(_mapping.required_span_size());
+		}
+
+		inline constexpr bool empty() const noexcept
+		{
+			return size_of_current_tensor() == 0;
+		}
+
+		inline constexpr std::size_t capacity() const noexcept
+		{
+			return _capacity;
+		}
+
+		inline constexpr T* data() noexcept
+		{
+			return std::assume_aligned<alignment>(_data);
+		}
+
+		inline constexpr const T* data() const noexcept
+		{
+			return std::assume_aligned<alignment>(_data);
+		}
+
+		inline constexpr allocator_type get_allocator() const noexcept
+		{
+			return _allocator();
+		}
+	};
+
+	// Copies a tensor object, or a tensor of any layout, into a new tensor stored with NewLayout.
+	// Ex: relayout<layout_left>(m) is the column-major copy of a matrix, relayout<layout_right>(fortran) the row-major tensor back.
+	//
+	template <typename NewLayout, typename Source> requires tensor_lib_internal::_relayout_source<Source, decltype(std::declval<const Source&>().get_ranks())::extent>
+	inline constexpr auto relayout(const Source& source)
+	{
+		using T = std::remove_cvref_t<decltype(*source.data())>;
+		constexpr std::size_t Rank = decltype(source.get_ranks())::extent;
+
+		if constexpr (std::same_as<NewLayout, layout_right>)
+		{
+			tensor<T, Rank> result = std::apply([](const auto ... sizes) { return tensor<T, Rank>(sizes...); }, tensor_lib_internal::_order_of_dimension_of(source));
+
+			tensor_lib_internal::_copy_into_strided(source, result.data(), tensor_lib_internal::_strides_of(result));
+
+			return result;
+		}
+		else
+		{
+			return tensor<T, Rank, std::allocator<T>, NewLayout>(source);
+		}
+	}
+}
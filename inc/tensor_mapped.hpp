@@ -0,0 +1,329 @@
+#pragma once
+
+#include "tensor.hpp"
+#include "tensor_io.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace tensor_lib
+{
+	// read_only:      the mapping can only be read, pages are shared with every other process mapping the file.
+	// read_write:     writes go to the file (and are visible to other processes mapping it).
+	// copy_on_write:  writes go to private copies of the pages they touch, the file is never modified.
+	//
+	enum class map_mode
+	{
+		read_only,
+		read_write,
+		copy_on_write
+	};
+
+	// Tensor backed by a memory mapping of a file in the format of "tensor_io.hpp", so opening one costs a header read and pages
+	// are loaded on first access instead of copying the whole file to the heap. Elements are reached through the const_subdimension
+	// returned by view() and the subdimension returned by writable_view(), which work with everything that takes a tensor object.
+	//
+	// The views refer to the sizes stored in the mapped_tensor object, so they are invalidated when it is moved or destroyed.
+	//
+	template <typename T, std::size_t Rank> requires (Rank != 0u) && std::is_trivially_copyable_v<T>
+	class mapped_tensor
+	{
+	private:
+		std::array<std::size_t, Rank>   _order_of_dimension{};
+		std::array<std::size_t, Rank>   _size_of_subdimension{};
+		T*                              _data = nullptr;
+		void*                           _mapping = nullptr;
+		std::size_t                     _mapping_size = 0;
+		map_mode                        _mode = map_mode::read_only;
+
+		inline void _map(const std::filesystem::path& path, const std::size_t size)
+		{
+#if defined(_WIN32)
+			const DWORD access = (_mode == map_mode::read_write) ? (GENERIC_READ | GENERIC_WRITE) : GENERIC_READ;
+			const DWORD protection = (_mode == map_mode::read_only) ? PAGE_READONLY : (_mode == map_mode::read_write) ? PAGE_READWRITE : PAGE_WRITECOPY;
+			const DWORD view_access = (_mode == map_mode::read_only) ? FILE_MAP_READ : (_mode == map_mode::read_write) ? FILE_MAP_WRITE : FILE_MAP_COPY;
+
+			const HANDLE file = CreateFileW(path.c_str(), access, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+			if (file == INVALID_HANDLE_VALUE)
+			{
+				throw std::runtime_error("Can't open the tensor file for mapping!");
+			}
+
+			const HANDLE mapping = CreateFileMappingW(file, nullptr, protection, 0, 0, nullptr);
+			CloseHandle(file);
+
+			if (mapping == nullptr)
+			{
+				throw std::runtime_error("Can't map the tensor file!");
+			}
+
+			_mapping = MapViewOfFile(mapping, view_access, 0, 0, size);
+			CloseHandle(mapping);
+
+			if (_mapping == nullptr)
+			{
+				throw std::runtime_error("Can't map the tensor file!");
+			}
+#else
+			const int file = ::open(path.c_str(), (_mode == map_mode::read_write) ? O_RDWR : O_RDONLY);
+
+			if (file < 0)
+			{
+				throw std::runtime_error("Can't open the tensor file for mapping!");
+			}
+
+			const int protection = (_mode == map_mode::read_only) ? PROT_READ : (PROT_READ | PROT_WRITE);
+			const int flags = (_mode == map_mode::copy_on_write) ? MAP_PRIVATE : MAP_SHARED;
+
+			void* mapping = ::mmap(nullptr, size, protection, flags, file, 0);
+			::close(file);
+
+			if (mapping == MAP_FAILED)
+			{
+				throw std::runtime_error("Can't map the tensor file!");
+			}
+
+			_mapping = mapping;
+#endif
+			_mapping_size = size;
+		}
+
+		inline void _open(const std::filesystem::path& path, const std::size_t offset, const std::array<std::size_t, Rank>& order_of_dimension)
+		{
+			if (offset % alignof(T) != 0)
+			{
+				throw std::runtime_error("Can't map misaligned elements!");
+			}
+
+			if (!tensor_lib_internal::_byte_size_fits(order_of_dimension, sizeof(T), offset))
+			{
+				throw std::runtime_error("Size of the mapped tensor is out of range!");
+			}
+
+			std::array<std::size_t, Rank> size_of_subdimension;
+			std::partial_sum(order_of_dimension.crbegin(), order_of_dimension.crend(), size_of_subdimension.rbegin(), std::multiplies<std::size_t>());
+
+			const std::size_t size = offset + size_of_subdimension[0] * sizeof(T);
+
+			if (std::filesystem::file_size(path) < size)
+			{
+				throw std::runtime_error("Unexpected end of the tensor file!");
+			}
+
+			_map(path, size);
+
+			_order_of_dimension = order_of_dimension;
+			_size_of_subdimension = size_of_subdimension;
+			_data = reinterpret_cast<T*>(static_cast<unsigned char*>(_mapping) + offset);
+		}
+
+		inline void _unmap() noexcept
+		{
+			if (_mapping)
+			{
+#if defined(_WIN32)
+				UnmapViewOfFile(_mapping);
+#else
+				::munmap(_mapping, _mapping_size);
+#endif
+				_mapping = nullptr;
+				_data = nullptr;
+				_mapping_size = 0;
+			}
+		}
+
+	public:
+		using value_type = T;
+		using size_type = std::size_t;
+
+		inline mapped_tensor() noexcept = default;
+
+		// Maps a tensor file whose rank and element type must match, written on a machine of the same byte order.
+		//
+		inline explicit mapped_tensor(const std::filesystem::path& path, const map_mode mode = map_mode::read_only)
+			: _mode{ mode }
+		{
+			std::ifstream file(path, std::ios::binary);
+
+			if (!file)
+			{
+				throw std::runtime_error("Can't open the tensor file for mapping!");
+			}
+
+			const tensor_file_header header = read_tensor_header(file);
+			tensor_lib_internal::_check_tensor_file_header<T, Rank>(header);
+
+			if (header.byte_order != std::endian::native)
+			{
+				throw std::runtime_error("Can't map a tensor file of a different byte order!");
+			}
+
+			file.close();
+
+			std::array<std::size_t, Rank> order_of_dimension;
+			std::copy_n(header.order_of_dimension.begin(), Rank, order_of_dimension.begin());
+
+			_open(path, header.data_offset(), order_of_dimension);
+		}
+
+		// Maps row-major elements of native byte order stored 'offset' bytes into any file (ex: the body of a .npy file).
+		//
+		inline mapped_tensor(const std::filesystem::path& path, const std::size_t offset, const std::array<std::size_t, Rank>& order_of_dimension, const map_mode mode = map_mode::read_only)
+			: _mode{ mode }
+		{
+			_open(path, offset, order_of_dimension);
+		}
+
+		mapped_tensor(const mapped_tensor&) = delete;
+		mapped_tensor& operator=(const mapped_tensor&) = delete;
+
+		inline mapped_tensor(mapped_tensor&& other) noexcept
+			: _order_of_dimension{ std::exchange(other._order_of_dimension, {}) }
+			, _size_of_subdimension{ std::exchange(other._size_of_subdimension, {}) }
+			, _data{ std::exchange(other._data, nullptr) }
+			, _mapping{ std::exchange(other._mapping, nullptr) }
+			, _mapping_size{ std::exchange(other._mapping_size, 0) }
+			, _mode{ other._mode }
+		{
+
+		}
+
+		inline mapped_tensor& operator=(mapped_tensor&& other) noexcept
+		{
+			if (this != std::addressof(other))
+			{
+				_unmap();
+
+				_order_of_dimension = std::exchange(other._order_of_dimension, {});
+				_size_of_subdimension = std::exchange(other._size_of_subdimension, {});
+				_data = std::exchange(other._data, nullptr);
+				_mapping = std::exchange(other._mapping, nullptr);
+				_mapping_size = std::exchange(other._mapping_size, 0);
+				_mode = other._mode;
+			}
+
+			return *this;
+		}
+
+		inline ~mapped_tensor()
+		{
+			_unmap();
+		}
+
+		inline const_subdimension<T, Rank> view() const noexcept
+		{
+			return const_subdimension<T, Rank>(std::span<const std::size_t, Rank>(_order_of_dimension), std::span<const std::size_t, Rank>(_size_of_subdimension), std::span<const T>(_data, size_of_current_tensor()));
+		}
+
+		// Writable view of the elements, only available for read_write and copy_on_write mappings.
+		//
+		inline subdimension<T, Rank> writable_view()
+		{
+			if (_mode == map_mode::read_only)
+			{
+				throw std::runtime_error("Can't write to a read only mapping!");
+			}
+
+			return subdimension<T, Rank>(std::span<std::size_t, Rank>(_order_of_dimension), std::span<std::size_t, Rank>(_size_of_subdimension), std::span<T>(_data, size_of_current_tensor()));
+		}
+
+		inline decltype(auto) operator[] (const std::size_t index) const noexcept
+		{
+			return view()[index];
+		}
+
+		template <typename... Indices> requires (sizeof...(Indices) == Rank) && useful_concepts::integrals<Indices...>
+		inline const T& operator() (const Indices ... indices) const noexcept
+		{
+			return _data[tensor_lib_internal::_flat_offset(_size_of_subdimension, indices...)];
+		}
+
+		// Writes the modified pages of a read_write mapping back to the file.
+		//
+		inline void flush() const
+		{
+			if (_mode != map_mode::read_write || !_mapping)
+			{
+				return;
+			}
+
+#if defined(_WIN32)
+			const bool flushed = FlushViewOfFile(_mapping, _mapping_size) != 0;
+#else
+			const bool flushed = ::msync(_mapping, _mapping_size, MS_SYNC) == 0;
+#endif
+
+			if (!flushed)
+			{
+				throw std::runtime_error("Failed to flush the tensor file!");
+			}
+		}
+
+		inline const T* data() const noexcept
+		{
+			return _data;
+		}
+
+		inline auto begin() const noexcept
+		{
+			return _data;
+		}
+
+		inline auto end() const noexcept
+		{
+			return _data + size_of_current_tensor();
+		}
+
+		inline auto get_ranks() const noexcept
+		{
+			return std::span<const std::size_t, Rank>(_order_of_dimension);
+		}
+
+		inline auto get_sizes() const noexcept
+		{
+			return std::span<const std::size_t, Rank>(_size_of_subdimension);
+		}
+
+		inline std::size_t order_of_dimension(const std::size_t index) const noexcept
+		{
+			return _order_of_dimension[index];
+		}
+
+		inline std::size_t size_of_current_tensor() const noexcept
+		{
+			return _size_of_subdimension[0];
+		}
+
+		inline bool empty() const noexcept
+		{
+			return _size_of_subdimension[0] == 0;
+		}
+
+		inline map_mode mode() const noexcept
+		{
+			return _mode;
+		}
+	};
+}
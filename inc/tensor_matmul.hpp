@@ -0,0 +1,145 @@
+#pragma once
+
+#include "tensor.hpp"
+#include "tensor_execution.hpp"
+#include "tensor_expressions.hpp"
+#include "tensor_kernels.hpp"
+
+#include <array>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+
+namespace tensor_lib
+{
+	// Matrix products of rank 2 tensor objects. Any operand may be a matrix, a subdimension or a const_subdimension (ex: "my_cube[2]"),
+	// they are all read in place by the packed GEMM in "tensor_kernels.hpp".
+	//
+
+	template <typename U>
+	concept matrix_object = tensor_object<U> && (tensor_lib_internal::_rank_of<std::remove_cvref_t<U>> == 2u);
+
+	namespace tensor_lib_internal
+	{
+		template <typename Lhs, typename Rhs>
+		concept _multipliable_matrices = matrix_object<Lhs> && matrix_object<Rhs>
+			&& std::same_as<_element_type_of<std::remove_cvref_t<Lhs>>, _element_type_of<std::remove_cvref_t<Rhs>>>;
+
+		template <typename Lhs, typename Rhs>
+		inline constexpr void _check_matmul_sizes(const Lhs& a, const Rhs& b)
+		{
+			if (a.order_of_dimension(1) != b.order_of_dimension(0))
+			{
+				throw std::runtime_error("Number of columns of the left matrix doesn't match the number of rows of the right matrix!");
+			}
+		}
+
+		// Parallel products give every task a band of whole rows of the result (at least one row block of the GEMM),
+		// so the tasks never write to the same rows and each packs its own band of 'a'.
+		//
+		template <typename Policy, typename U, typename Lhs, typename Rhs>
+		inline constexpr void _matmul(const Policy&, U* out, const Lhs& a, const Rhs& b)
+		{
+			const std::size_t rows = a.order_of_dimension(0);
+			const std::size_t columns = b.order_of_dimension(1);
+			const std::size_t depth = a.order_of_dimension(1);
+			const auto* a_data = a.data();
+			const auto* b_data = b.data();
+
+			auto multiply_rows = [=](const std::size_t first, const std::size_t last)
+			{
+				kernels::gemm(last - first, columns, depth, a_data + first * depth, depth, std::size_t{ 1 }, b_data, columns, std::size_t{ 1 }, out + first * columns, columns);
+			};
+
+			if constexpr (execution::is_parallel_policy_v<Policy>)
+			{
+				const std::size_t row_work = std::max<std::size_t>(1, columns * depth);
+				const std::size_t grain = std::max(kernels::_gemm_row_block, execution::grain_size() / row_work);
+
+				execution::default_pool().parallel_for(rows, grain, multiply_rows);
+			}
+			else
+			{
+				multiply_rows(0, rows);
+			}
+		}
+
+		template <typename Lhs, typename Rhs>
+		inline bool _overlap(const Lhs& lhs, const Rhs& rhs) noexcept
+		{
+			const void* lhs_first = lhs.data();
+			const void* lhs_last = lhs.data() + lhs.size_of_current_tensor();
+			const void* rhs_first = rhs.data();
+			const void* rhs_last = rhs.data() + rhs.size_of_current_tensor();
+
+			return std::less<const void*>()(lhs_first, rhs_last) && std::less<const void*>()(rhs_first, lhs_last);
+		}
+	}
+
+	// Returns the (rows of a) x (columns of b) product as a new matrix.
+	//
+	template <typename Policy, typename Lhs, typename Rhs> requires execution::execution_policy<Policy> && tensor_lib_internal::_multipliable_matrices<Lhs, Rhs>
+	inline constexpr auto matmul(const Policy& policy, const Lhs& a, const Rhs& b)
+	{
+		tensor_lib_internal::_check_matmul_sizes(a, b);
+
+		tensor<tensor_lib_internal::_element_type_of<Lhs>, 2> result(a.order_of_dimension(0), b.order_of_dimension(1));
+
+		if (!result.empty())
+		{
+			tensor_lib_internal::_matmul(policy, result.data(), a, b);
+		}
+
+		return result;
+	}
+
+	template <typename Lhs, typename Rhs> requires tensor_lib_internal::_multipliable_matrices<Lhs, Rhs>
+	inline constexpr auto matmul(const Lhs& a, const Rhs& b)
+	{
+		return matmul(execution::seq, a, b);
+	}
+
+	// Writes the product into 'out'. A matrix of a different shape is resized to fit, a subdimension has to match it exactly.
+	// The kernel writes 'out' while it still reads the operands, so a destination overlapping one of them gets the product through a temporary.
+	//
+	template <typename Policy, typename Out, typename Lhs, typename Rhs>
+		requires execution::execution_policy<Policy> && _assignable_tensor_object<Out> && matrix_object<Out> && tensor_lib_internal::_multipliable_matrices<Lhs, Rhs>
+		&& std::same_as<tensor_lib_internal::_element_type_of<std::remove_cvref_t<Out>>, tensor_lib_internal::_element_type_of<Lhs>>
+	inline constexpr void matmul_into(const Policy& policy, Out&& out, const Lhs& a, const Rhs& b)
+	{
+		tensor_lib_internal::_check_matmul_sizes(a, b);
+
+		const std::array<std::size_t, 2> shape{ a.order_of_dimension(0), b.order_of_dimension(1) };
+		bool aliased = false;
+
+		if (!std::is_constant_evaluated())
+		{
+			aliased = tensor_lib_internal::_overlap(out, a) || tensor_lib_internal::_overlap(out, b);
+		}
+
+		if (aliased)
+		{
+			const auto product = matmul(policy, a, b);
+
+			tensor_lib_internal::_fit_shape(out, std::span<const std::size_t, 2>(shape));
+			tensor_lib_internal::_copy_n(product.data(), product.size_of_current_tensor(), out.data());
+		}
+		else
+		{
+			tensor_lib_internal::_fit_shape(out, std::span<const std::size_t, 2>(shape));
+
+			if (!out.empty())
+			{
+				tensor_lib_internal::_matmul(policy, out.data(), a, b);
+			}
+		}
+	}
+
+	template <typename Out, typename Lhs, typename Rhs>
+		requires _assignable_tensor_object<Out> && matrix_object<Out> && tensor_lib_internal::_multipliable_matrices<Lhs, Rhs>
+		&& std::same_as<tensor_lib_internal::_element_type_of<std::remove_cvref_t<Out>>, tensor_lib_internal::_element_type_of<Lhs>>
+	inline constexpr void matmul_into(Out&& out, const Lhs& a, const Rhs& b)
+	{
+		matmul_into(execution::seq, std::forward<Out>(out), a, b);
+	}
+}
@@ -0,0 +1,349 @@
+#pragma once
+
+#include "tensor.hpp"
+#include "tensor_kernels.hpp"
+#include "tensor_layout.hpp"
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+// BMI2 has pdep and pext, which spread the bits of an index over the bits of a Morton code (and gather them back) in one instruction.
+// They are used when the build enables BMI2 (-mbmi2, -march=haswell or newer; every CPU with AVX2 has it, so /arch:AVX2 with MSVC),
+// otherwise the bits are spread with shifts and masks, which is a few more instructions.
+//
+#if TENSORLIB_X86_KERNELS && (defined(__x86_64__) || defined(_M_X64)) && (defined(__BMI2__) || (defined(_MSC_VER) && defined(__AVX2__)))
+	#define TENSORLIB_MORTON_BMI2 1
+#else
+	#define TENSORLIB_MORTON_BMI2 0
+#endif
+
+namespace tensor_lib
+{
+	namespace tensor_lib_internal
+	{
+		// Bits of a Morton code that belong to each axis: the last axis has the lowest bit, the first the highest of each group of Rank bits.
+		//
+		template <std::size_t Rank>
+		inline constexpr std::array<std::uint64_t, Rank> _morton_masks = []()
+		{
+			std::array<std::uint64_t, Rank> masks{};
+
+			for (std::size_t bit = 0; bit < 64; bit++)
+			{
+				masks[Rank - 1 - bit % Rank] |= std::uint64_t{ 1 } << bit;
+			}
+
+			return masks;
+		}();
+
+		// Puts the bits of 'index' Rank bits apart, starting from the lowest one.
+		//
+		template <std::size_t Rank>
+		inline constexpr std::uint64_t _morton_spread(std::uint64_t index) noexcept
+		{
+			if constexpr (Rank == 2)
+			{
+				index &= 0x00000000FFFFFFFF;
+				index = (index | (index << 16)) & 0x0000FFFF0000FFFF;
+				index = (index | (index << 8)) & 0x00FF00FF00FF00FF;
+				index = (index | (index << 4)) & 0x0F0F0F0F0F0F0F0F;
+				index = (index | (index << 2)) & 0x3333333333333333;
+				index = (index | (index << 1)) & 0x5555555555555555;
+			}
+			else
+			{
+				index &= 0x00000000001FFFFF;
+				index = (index | (index << 32)) & 0x001F00000000FFFF;
+				index = (index | (index << 16)) & 0x001F0000FF0000FF;
+				index = (index | (index << 8)) & 0x100F00F00F00F00F;
+				index = (index | (index << 4)) & 0x10C30C30C30C30C3;
+				index = (index | (index << 2)) & 0x1249249249249249;
+			}
+
+			return index;
+		}
+
+		// Inverse of _morton_spread, gathers every Rank-th bit starting from the lowest one.
+		//
+		template <std::size_t Rank>
+		inline constexpr std::uint64_t _morton_compact(std::uint64_t code) noexcept
+		{
+			if constexpr (Rank == 2)
+			{
+				code &= 0x5555555555555555;
+				code = (code | (code >> 1)) & 0x3333333333333333;
+				code = (code | (code >> 2)) & 0x0F0F0F0F0F0F0F0F;
+				code = (code | (code >> 4)) & 0x00FF00FF00FF00FF;
+				code = (code | (code >> 8)) & 0x0000FFFF0000FFFF;
+				code = (code | (code >> 16)) & 0x00000000FFFFFFFF;
+			}
+			else
+			{
+				code &= 0x1249249249249249;
+				code = (code | (code >> 2)) & 0x10C30C30C30C30C3;
+				code = (code | (code >> 4)) & 0x100F00F00F00F00F;
+				code = (code | (code >> 8)) & 0x001F0000FF0000FF;
+				code = (code | (code >> 16)) & 0x001F00000000FFFF;
+				code = (code | (code >> 32)) & 0x00000000001FFFFF;
+			}
+
+			return code;
+		}
+
+		template <std::size_t Rank>
+		inline constexpr std::uint64_t _morton_deposit(const std::uint64_t index, const std::size_t axis) noexcept
+		{
+#if TENSORLIB_MORTON_BMI2
+			if (!std::is_constant_evaluated())
+			{
+				return _pdep_u64(index, _morton_masks<Rank>[axis]);
+			}
+#endif
+			return _morton_spread<Rank>(index) << (Rank - 1 - axis);
+		}
+
+		template <std::size_t Rank>
+		inline constexpr std::uint64_t _morton_extract(const std::uint64_t code, const std::size_t axis) noexcept
+		{
+#if TENSORLIB_MORTON_BMI2
+			if (!std::is_constant_evaluated())
+			{
+				return _pext_u64(code, _morton_masks<Rank>[axis]);
+			}
+#endif
+			return _morton_compact<Rank>(code >> (Rank - 1 - axis));
+		}
+	}
+
+	// Morton code of the element at 'indices': their bits interleaved, the first index giving the highest bit of each group.
+	// Ex: morton_encode(1, 0, 1) == 0b101, morton_encode(0, 2, 0) == 0b010'000.
+	//
+	template <typename... Indices> requires (sizeof...(Indices) == 2 || sizeof...(Indices) == 3) && useful_concepts::integrals<Indices...>
+	inline constexpr std::size_t morton_encode(const Indices ... indices) noexcept
+	{
+		constexpr std::size_t Rank = sizeof...(Indices);
+
+		std::size_t axis = 0;
+		std::uint64_t code = 0;
+
+		((code |= tensor_lib_internal::_morton_deposit<Rank>(static_cast<std::uint64_t>(indices), axis++)), ...);
+
+		return static_cast<std::size_t>(code);
+	}
+
+	template <std::size_t Rank> requires (Rank == 2 || Rank == 3)
+	inline constexpr std::array<std::size_t, Rank> morton_decode(const std::size_t code) noexcept
+	{
+		std::array<std::size_t, Rank> indices;
+
+		for (std::size_t axis = 0; axis < Rank; axis++)
+		{
+			indices[axis] = static_cast<std::size_t>(tensor_lib_internal::_morton_extract<Rank>(static_cast<std::uint64_t>(code), axis));
+		}
+
+		return indices;
+	}
+
+	// Morton (Z-order) storage for square matrices and cubes whose size is a power of two. The offset of an element is the Morton code
+	// of its indices, so every aligned 2x2x2, 4x4x4, ... block is contiguous, at any scale: the elements around one are close in memory
+	// in every direction, which suits octrees, voxels and other random lookups of 3D neighbourhoods.
+	//
+	struct layout_morton
+	{
+		template <std::size_t Rank>
+		class mapping
+		{
+			static_assert(Rank == 2 || Rank == 3, "layout_morton stores matrices and cubes.");
+
+		private:
+			std::array<std::size_t, Rank> _extents{};
+
+			// Bits of the codes in use, every offset and step is kept within them.
+			//
+			std::uint64_t _used = 0;
+
+		public:
+			inline constexpr mapping() noexcept = default;
+
+			inline constexpr explicit mapping(const std::array<std::size_t, Rank>& extents)
+				: _extents{ extents }
+			{
+				const std::size_t size = extents[0];
+
+				for (const std::size_t extent : extents)
+				{
+					if (extent != size || (size != 0 && !std::has_single_bit(size)))
+					{
+						throw std::runtime_error("Morton layout needs the same power of two as the size of every dimension!");
+					}
+				}
+
+				if (size != 0 && std::countr_zero(size) * Rank >= 64)
+				{
+					throw std::runtime_error("Morton layout can't index a tensor this large!");
+				}
+
+				_used = size ? (std::uint64_t{ 1 } << (std::countr_zero(size) * Rank)) - 1 : 0;
+			}
+
+			inline constexpr const std::array<std::size_t, Rank>& extents() const noexcept
+			{
+				return _extents;
+			}
+
+			inline constexpr std::size_t required_span_size() const noexcept
+			{
+				return static_cast<std::size_t>(_used + (_extents[0] != 0));
+			}
+
+			template <typename... Indices> requires (sizeof...(Indices) == Rank) && useful_concepts::integrals<Indices...>
+			inline constexpr std::size_t operator() (const Indices ... indices) const noexcept
+			{
+				return morton_encode(indices...);
+			}
+
+			// Bits 'index' puts in the offset along 'axis', the offset is the sum (and the bitwise or) of those of every index.
+			//
+			inline constexpr std::size_t axis_offset(const std::size_t axis, const std::size_t index) const noexcept
+			{
+				return static_cast<std::size_t>(tensor_lib_internal::_morton_deposit<Rank>(static_cast<std::uint64_t>(index), axis));
+			}
+
+			// Indices of the element stored at 'offset'.
+			//
+			inline constexpr std::array<std::size_t, Rank> indices(const std::size_t offset) const noexcept
+			{
+				return morton_decode<Rank>(offset);
+			}
+
+			// Offset of the element one step (step is 1 or -1) along 'axis' from the one at 'offset', without decoding it:
+			// the bits of the axis are incremented or decremented in place, the carries skipping over the bits of the other axes.
+			// The neighbour has to be inside the tensor, stepping out of it wraps around to the other side.
+			//
+			inline constexpr std::size_t step(const std::size_t offset, const std::size_t axis, const int step) const noexcept
+			{
+				const std::uint64_t mask = tensor_lib_internal::_morton_masks<Rank>[axis] & _used;
+				const std::uint64_t code = static_cast<std::uint64_t>(offset);
+				const std::uint64_t moved = step > 0 ? ((code | ~mask) + 1) & mask : ((code & mask) - 1) & mask;
+
+				return static_cast<std::size_t>((code & ~mask) | moved);
+			}
+		};
+	};
+
+	template <typename T, typename allocator_type = std::allocator<T>>
+	using morton_matrix = tensor<T, 2, allocator_type, layout_morton>;
+
+	template <typename T, typename allocator_type = std::allocator<T>>
+	using morton_cube = tensor<T, 3, allocator_type, layout_morton>;
+
+	namespace tensor_lib_internal
+	{
+		template <typename Tensor>
+		concept _morton_tensor = _is_tensor_with_layout_v<std::remove_const_t<Tensor>> && std::same_as<typename std::remove_const_t<Tensor>::layout_type, layout_morton>;
+
+		// Calls function(indices, element) for the elements at 'index' + 'offsets' (each offset -1, 0 or 1 along every axis, not all 0)
+		// that are inside the tensor, 'Diagonals' says whether offsets may move along several axes at once.
+		//
+		template <bool Diagonals, typename Tensor, std::size_t Rank, typename Function>
+		inline constexpr void _for_each_morton_neighbor(Tensor& tsor, const std::array<std::size_t, Rank>& index, Function& function)
+		{
+			const auto& mapping = tsor.mapping();
+			const auto data = tsor.data();
+			const std::size_t size = mapping.extents()[0];
+			const std::size_t center = std::apply(mapping, index);
+
+			// The neighbours differ from the center only in the bits of the axes they moved along, so the offset of each is put together
+			// from the bits of its three candidates along every axis, computed once: parts[axis][move] for move 0 (-1), 1 (none) and 2 (+1).
+			//
+			std::array<std::array<std::size_t, 3>, Rank> parts;
+			std::array<std::size_t, Rank> first;
+			std::array<std::size_t, Rank> last;
+
+			for (std::size_t axis = 0; axis < Rank; axis++)
+			{
+				const std::size_t mask = static_cast<std::size_t>(_morton_masks<Rank>[axis]);
+
+				parts[axis] = { mapping.step(center, axis, -1) & mask, center & mask, mapping.step(center, axis, 1) & mask };
+				first[axis] = index[axis] > 0 ? 0 : 1;
+				last[axis] = index[axis] + 1 < size ? 2 : 1;
+			}
+
+			if constexpr (!Diagonals)
+			{
+				for (std::size_t axis = 0; axis < Rank; axis++)
+				{
+					const std::size_t others = center & ~parts[axis][1];
+
+					for (std::size_t move = 0; move <= 2; move += 2)
+					{
+						if (first[axis] <= move && move <= last[axis])
+						{
+							std::array<std::size_t, Rank> neighbor = index;
+							neighbor[axis] = index[axis] + move - 1;
+
+							function(std::as_const(neighbor), data[others | parts[axis][move]]);
+						}
+					}
+				}
+			}
+			else if constexpr (Rank == 2)
+			{
+				for (std::size_t i = first[0]; i <= last[0]; i++)
+				{
+					for (std::size_t j = first[1]; j <= last[1]; j++)
+					{
+						if (i != 1 || j != 1)
+						{
+							std::array<std::size_t, 2> neighbor{ index[0] + i - 1, index[1] + j - 1 };
+
+							function(std::as_const(neighbor), data[parts[0][i] | parts[1][j]]);
+						}
+					}
+				}
+			}
+			else
+			{
+				for (std::size_t i = first[0]; i <= last[0]; i++)
+				{
+					for (std::size_t j = first[1]; j <= last[1]; j++)
+					{
+						const std::size_t row = parts[0][i] | parts[1][j];
+
+						for (std::size_t k = first[2]; k <= last[2]; k++)
+						{
+							if (i != 1 || j != 1 || k != 1)
+							{
+								std::array<std::size_t, 3> neighbor{ index[0] + i - 1, index[1] + j - 1, index[2] + k - 1 };
+
+								function(std::as_const(neighbor), data[row | parts[2][k]]);
+							}
+						}
+					}
+				}
+			}
+		}
+	}
+
+	// Calls function(indices, element) for every element of a Morton tensor next to the one at 'index', diagonals included
+	// (up to 8 in a matrix, 26 in a cube), and for_each_face_neighbor() for those sharing a face with it (up to 4 and 6).
+	// Elements on the border have fewer neighbours, nothing outside the tensor is visited. The element is const for a const tensor.
+	// Ex: for_each_face_neighbor(voxels, { x, y, z }, [&](const auto&, const float value) { sum += value; });
+	//
+	template <typename Tensor, typename Function> requires tensor_lib_internal::_morton_tensor<Tensor>
+	inline constexpr void for_each_neighbor(Tensor& tsor, const std::array<std::size_t, decltype(std::declval<const Tensor&>().get_ranks())::extent>& index, Function function)
+	{
+		tensor_lib_internal::_for_each_morton_neighbor<true>(tsor, index, function);
+	}
+
+	template <typename Tensor, typename Function> requires tensor_lib_internal::_morton_tensor<Tensor>
+	inline constexpr void for_each_face_neighbor(Tensor& tsor, const std::array<std::size_t, decltype(std::declval<const Tensor&>().get_ranks())::extent>& index, Function function)
+	{
+		tensor_lib_internal::_for_each_morton_neighbor<false>(tsor, index, function);
+	}
+}
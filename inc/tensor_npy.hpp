@@ -0,0 +1,868 @@
+#pragma once
+
+#include "tensor.hpp"
+#include "tensor_io.hpp"
+#include "tensor_mapped.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <istream>
+#include <memory>
+#include <numeric>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace tensor_lib
+{
+	// NumPy files. A .npy file starts with the magic "\x93NUMPY", a format version and the length of the header that follows,
+	// a Python dict literal such as {'descr': '<f4', 'fortran_order': False, 'shape': (3, 4), } padded with spaces so the array
+	// data starts at a multiple of 64 bytes. A .npz file is a zip archive of .npy files, one per array.
+	//
+
+	struct npy_header
+	{
+		dtype type = dtype::raw;
+		std::uint32_t element_size = 0;
+		std::endian byte_order = std::endian::native;
+		bool fortran_order = false;
+		std::vector<std::size_t> shape;
+
+		// Offset of the array data from the start of the file.
+		//
+		std::size_t data_offset = 0;
+
+		inline std::size_t size() const noexcept
+		{
+			return std::accumulate(shape.begin(), shape.end(), std::size_t{ 1 }, std::multiplies<std::size_t>());
+		}
+	};
+
+	namespace tensor_lib_internal
+	{
+		inline constexpr std::string_view _npy_magic{ "\x93NUMPY", 6 };
+
+		// Descriptor of the element type, ex: '<f4' for little endian 4 byte floats, '|u1' for bytes.
+		//
+		inline std::string _npy_descr(const npy_header& header)
+		{
+			const char order = (header.element_size == 1) ? '|' : (header.byte_order == std::endian::little) ? '<' : '>';
+			char kind;
+
+			switch (header.type)
+			{
+			case dtype::boolean:
+				kind = 'b';
+				break;
+			case dtype::float32:
+			case dtype::float64:
+				kind = 'f';
+				break;
+			case dtype::raw:
+				throw std::runtime_error("Element type has no .npy equivalent!");
+			default:
+				kind = ((static_cast<int>(header.type) - static_cast<int>(dtype::int8)) % 2) ? 'u' : 'i';
+				break;
+			}
+
+			return std::string{ order, kind } + std::to_string(header.element_size);
+		}
+
+		inline void _parse_npy_descr(const std::string_view descr, npy_header& header)
+		{
+			if (descr.size() < 3 || std::string_view("<>|=").find(descr[0]) == std::string_view::npos)
+			{
+				throw std::runtime_error("Unsupported .npy dtype!");
+			}
+
+			const std::string_view digits = descr.substr(2);
+
+			if (!std::all_of(digits.begin(), digits.end(), [](const char digit) { return digit >= '0' && digit <= '9'; }))
+			{
+				throw std::runtime_error("Unsupported .npy dtype!");
+			}
+
+			header.element_size = static_cast<std::uint32_t>(std::stoul(std::string(digits)));
+			header.byte_order = (descr[0] == '<') ? std::endian::little : (descr[0] == '>') ? std::endian::big : std::endian::native;
+
+			const std::uint32_t size = header.element_size;
+			const bool integral_size = (size == 1 || size == 2 || size == 4 || size == 8);
+
+			if (descr[1] == 'b' && size == 1)
+			{
+				header.type = dtype::boolean;
+			}
+			else if (descr[1] == 'f' && (size == 4 || size == 8))
+			{
+				header.type = (size == 4) ? dtype::float32 : dtype::float64;
+			}
+			else if ((descr[1] == 'i' || descr[1] == 'u') && integral_size)
+			{
+				const int level = std::bit_width(size) - 1;
+				header.type = static_cast<dtype>(static_cast<int>(dtype::int8) + 2 * level + (descr[1] == 'u' ? 1 : 0));
+			}
+			else
+			{
+				throw std::runtime_error("Unsupported .npy dtype!");
+			}
+		}
+
+		// Text following "'key':" in the header dict.
+		//
+		inline std::string_view _npy_field(const std::string_view dict, const std::string_view key)
+		{
+			for (const char quote : { '\'', '"' })
+			{
+				const std::string quoted = quote + std::string(key) + quote;
+				std::size_t position = dict.find(quoted);
+
+				if (position != std::string_view::npos)
+				{
+					position = dict.find(':', position + quoted.size());
+
+					if (position != std::string_view::npos)
+					{
+						position = dict.find_first_not_of(' ', position + 1);
+					}
+
+					if (position != std::string_view::npos)
+					{
+						return dict.substr(position);
+					}
+				}
+			}
+
+			throw std::runtime_error("Corrupted .npy header!");
+		}
+
+		inline void _parse_npy_dict(const std::string_view dict, npy_header& header)
+		{
+			const std::string_view descr = _npy_field(dict, "descr");
+			const std::size_t descr_end = descr.find(descr.front(), 1);
+
+			if ((descr.front() != '\'' && descr.front() != '"') || descr_end == std::string_view::npos)
+			{
+				throw std::runtime_error("Corrupted .npy header!");
+			}
+
+			_parse_npy_descr(descr.substr(1, descr_end - 1), header);
+
+			const std::string_view fortran_order = _npy_field(dict, "fortran_order");
+
+			if (fortran_order.starts_with("True"))
+			{
+				header.fortran_order = true;
+			}
+			else if (!fortran_order.starts_with("False"))
+			{
+				throw std::runtime_error("Corrupted .npy header!");
+			}
+
+			std::string_view shape = _npy_field(dict, "shape");
+			const std::size_t shape_end = shape.find(')');
+
+			if (shape.front() != '(' || shape_end == std::string_view::npos)
+			{
+				throw std::runtime_error("Corrupted .npy header!");
+			}
+
+			shape = shape.substr(1, shape_end - 1);
+
+			while (!shape.empty())
+			{
+				const std::size_t comma = std::min(shape.find(','), shape.size());
+				const std::string_view dimension = shape.substr(0, comma);
+				const std::size_t first = dimension.find_first_not_of(' ');
+
+				if (first != std::string_view::npos)
+				{
+					const std::size_t last = dimension.find_last_not_of(' ');
+					const std::string_view digits = dimension.substr(first, last - first + 1);
+
+					if (!std::all_of(digits.begin(), digits.end(), [](const char digit) { return digit >= '0' && digit <= '9'; }))
+					{
+						throw std::runtime_error("Corrupted .npy header!");
+					}
+
+					try
+					{
+						header.shape.push_back(static_cast<std::size_t>(std::stoull(std::string(digits))));
+					}
+					catch (const std::out_of_range&)
+					{
+						throw std::runtime_error("Corrupted .npy header!");
+					}
+				}
+
+				shape.remove_prefix(std::min(comma + 1, shape.size()));
+			}
+
+			if (!_byte_size_fits(header.shape, header.element_size))
+			{
+				throw std::runtime_error("Corrupted .npy header!");
+			}
+		}
+
+		// Throws unless the array holds elements of type T in a tensor of the given rank.
+		//
+		template <typename T, std::size_t Rank>
+		inline void _check_npy_header(const npy_header& header)
+		{
+			if (header.shape.size() != Rank)
+			{
+				throw std::runtime_error("Rank of the .npy array doesn't match the rank of the tensor!");
+			}
+
+			if (header.type != dtype_of_v<T> || header.element_size != sizeof(T))
+			{
+				throw std::runtime_error("Element type of the .npy array doesn't match the element type of the tensor!");
+			}
+		}
+
+		// Reorders the elements of a column-major array into row-major order.
+		//
+		template <typename T, std::size_t Rank>
+		inline void _from_fortran_order(const T* source, const std::array<std::size_t, Rank>& order_of_dimension, T* destination)
+		{
+			const std::size_t size = std::accumulate(order_of_dimension.begin(), order_of_dimension.end(), std::size_t{ 1 }, std::multiplies<std::size_t>());
+
+			std::array<std::size_t, Rank> stride;
+			std::array<std::size_t, Rank> index{};
+			std::exclusive_scan(order_of_dimension.begin(), order_of_dimension.end(), stride.begin(), std::size_t{ 1 }, std::multiplies<std::size_t>());
+
+			std::size_t offset = 0;
+
+			for (std::size_t element = 0; element < size; element++)
+			{
+				destination[element] = source[offset];
+
+				for (std::size_t level = Rank; level-- > 0;)
+				{
+					if (++index[level] < order_of_dimension[level])
+					{
+						offset += stride[level];
+						break;
+					}
+
+					offset -= (order_of_dimension[level] - 1) * stride[level];
+					index[level] = 0;
+				}
+			}
+		}
+
+		inline constexpr std::array<std::uint32_t, 256> _crc32_table = []()
+		{
+			std::array<std::uint32_t, 256> table{};
+
+			for (std::uint32_t byte = 0; byte < 256; byte++)
+			{
+				std::uint32_t crc = byte;
+
+				for (int bit = 0; bit < 8; bit++)
+				{
+					crc = (crc & 1) ? (0xEDB88320u ^ (crc >> 1)) : (crc >> 1);
+				}
+
+				table[byte] = crc;
+			}
+
+			return table;
+		}();
+
+		// Continues the CRC-32 of a zip member over 'size' more bytes, starting from 0 for a new member.
+		//
+		inline std::uint32_t _crc32(std::uint32_t crc, const void* data, const std::size_t size) noexcept
+		{
+			const unsigned char* bytes = static_cast<const unsigned char*>(data);
+			crc = ~crc;
+
+			for (std::size_t index = 0; index < size; index++)
+			{
+				crc = _crc32_table[(crc ^ bytes[index]) & 0xFFu] ^ (crc >> 8);
+			}
+
+			return ~crc;
+		}
+
+		inline std::vector<unsigned char> _read_bytes(std::istream& stream, const std::uint64_t offset, const std::size_t size)
+		{
+			std::vector<unsigned char> bytes(size);
+			stream.seekg(static_cast<std::streamoff>(offset));
+
+			if (!stream.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(size)))
+			{
+				throw std::runtime_error("Corrupted .npz file!");
+			}
+
+			return bytes;
+		}
+
+		// Offset of the .npy file stored as 'name' (or 'name'.npy) in a zip archive. Members must be stored without compression.
+		//
+		inline std::uint64_t _npz_member_offset(std::istream& stream, const std::string_view name)
+		{
+			stream.seekg(0, std::ios::end);
+			const std::uint64_t file_size = static_cast<std::uint64_t>(stream.tellg());
+
+			if (file_size < 22)
+			{
+				throw std::runtime_error("Corrupted .npz file!");
+			}
+
+			// The end of central directory record is the last 22 bytes, followed by a comment of up to 65535 bytes.
+			//
+			const std::size_t tail_size = static_cast<std::size_t>(std::min<std::uint64_t>(file_size, 22 + 65535));
+			const std::vector<unsigned char> tail = _read_bytes(stream, file_size - tail_size, tail_size);
+
+			std::size_t end_record = tail_size - 22;
+
+			while (_load_little_endian<std::uint32_t>(&tail[end_record]) != 0x06054b50u)
+			{
+				if (end_record-- == 0)
+				{
+					throw std::runtime_error("Corrupted .npz file!");
+				}
+			}
+
+			std::uint64_t entries = _load_little_endian<std::uint16_t>(&tail[end_record + 10]);
+			std::uint64_t directory_size = _load_little_endian<std::uint32_t>(&tail[end_record + 12]);
+			std::uint64_t directory_offset = _load_little_endian<std::uint32_t>(&tail[end_record + 16]);
+
+			if (entries == 0xFFFFu || directory_size == 0xFFFFFFFFu || directory_offset == 0xFFFFFFFFu)
+			{
+				// Zip64 archives keep the real values in a record found through the locator just before the end record.
+				//
+				const std::uint64_t locator_offset = file_size - tail_size + end_record - 20;
+				const std::vector<unsigned char> locator = _read_bytes(stream, locator_offset, 20);
+
+				if (_load_little_endian<std::uint32_t>(&locator[0]) != 0x07064b50u)
+				{
+					throw std::runtime_error("Corrupted .npz file!");
+				}
+
+				const std::vector<unsigned char> record = _read_bytes(stream, _load_little_endian<std::uint64_t>(&locator[8]), 56);
+
+				if (_load_little_endian<std::uint32_t>(&record[0]) != 0x06064b50u)
+				{
+					throw std::runtime_error("Corrupted .npz file!");
+				}
+
+				entries = _load_little_endian<std::uint64_t>(&record[32]);
+				directory_size = _load_little_endian<std::uint64_t>(&record[40]);
+				directory_offset = _load_little_endian<std::uint64_t>(&record[48]);
+			}
+
+			const std::vector<unsigned char> directory = _read_bytes(stream, directory_offset, static_cast<std::size_t>(directory_size));
+			std::size_t position = 0;
+
+			for (std::uint64_t entry = 0; entry < entries; entry++)
+			{
+				if (position + 46 > directory.size() || _load_little_endian<std::uint32_t>(&directory[position]) != 0x02014b50u)
+				{
+					throw std::runtime_error("Corrupted .npz file!");
+				}
+
+				const std::uint16_t method = _load_little_endian<std::uint16_t>(&directory[position + 10]);
+				const std::uint32_t compressed_size = _load_little_endian<std::uint32_t>(&directory[position + 20]);
+				const std::uint32_t uncompressed_size = _load_little_endian<std::uint32_t>(&directory[position + 24]);
+				const std::uint16_t name_length = _load_little_endian<std::uint16_t>(&directory[position + 28]);
+				const std::uint16_t extra_length = _load_little_endian<std::uint16_t>(&directory[position + 30]);
+				const std::uint16_t comment_length = _load_little_endian<std::uint16_t>(&directory[position + 32]);
+				std::uint64_t local_offset = _load_little_endian<std::uint32_t>(&directory[position + 42]);
+
+				if (position + 46 + name_length + extra_length > directory.size())
+				{
+					throw std::runtime_error("Corrupted .npz file!");
+				}
+
+				const std::string_view member(reinterpret_cast<const char*>(&directory[position + 46]), name_length);
+
+				if (member == name || (member.size() == name.size() + 4 && member.starts_with(name) && member.ends_with(".npy")))
+				{
+					if (method != 0)
+					{
+						throw std::runtime_error("Compressed .npz members aren't supported, save them with numpy.savez instead of numpy.savez_compressed!");
+					}
+
+					if (local_offset == 0xFFFFFFFFu)
+					{
+						// The zip64 extra field lists the 8 byte values of the fields that overflowed, in this order.
+						//
+						std::size_t extra = position + 46 + name_length;
+						const std::size_t extra_end = extra + extra_length;
+
+						while (extra + 4 <= extra_end && _load_little_endian<std::uint16_t>(&directory[extra]) != 0x0001u)
+						{
+							extra += 4 + _load_little_endian<std::uint16_t>(&directory[extra + 2]);
+						}
+
+						if (extra + 4 > extra_end)
+						{
+							throw std::runtime_error("Corrupted .npz file!");
+						}
+
+						const std::size_t skipped = 8 * ((uncompressed_size == 0xFFFFFFFFu) + (compressed_size == 0xFFFFFFFFu));
+
+						if (extra + 4 + skipped + 8 > extra_end)
+						{
+							throw std::runtime_error("Corrupted .npz file!");
+						}
+
+						local_offset = _load_little_endian<std::uint64_t>(&directory[extra + 4 + skipped]);
+					}
+
+					const std::vector<unsigned char> local = _read_bytes(stream, local_offset, 30);
+
+					if (_load_little_endian<std::uint32_t>(&local[0]) != 0x04034b50u)
+					{
+						throw std::runtime_error("Corrupted .npz file!");
+					}
+
+					return local_offset + 30 + _load_little_endian<std::uint16_t>(&local[26]) + _load_little_endian<std::uint16_t>(&local[28]);
+				}
+
+				position += 46 + name_length + extra_length + comment_length;
+			}
+
+			throw std::runtime_error("No array of that name in the .npz file!");
+		}
+	}
+
+	// Reads the header of a .npy file that starts at the current position of the stream, leaving the stream at the array data.
+	// data_offset is counted from that position.
+	//
+	inline npy_header read_npy_header(std::istream& stream)
+	{
+		char preamble[8];
+
+		if (!stream.read(preamble, sizeof(preamble)) || std::string_view(preamble, 6) != tensor_lib_internal::_npy_magic)
+		{
+			throw std::runtime_error("Not a .npy file!");
+		}
+
+		const unsigned char major = static_cast<unsigned char>(preamble[6]);
+		unsigned char length_bytes[4] = {};
+		const std::size_t length_size = (major == 1) ? 2 : 4;
+
+		if (major < 1 || major > 3)
+		{
+			throw std::runtime_error("Unsupported .npy version!");
+		}
+
+		if (!stream.read(reinterpret_cast<char*>(length_bytes), static_cast<std::streamsize>(length_size)))
+		{
+			throw std::runtime_error("Unexpected end of the .npy file!");
+		}
+
+		const std::size_t length = (major == 1) ? tensor_lib_internal::_load_little_endian<std::uint16_t>(length_bytes) : tensor_lib_internal::_load_little_endian<std::uint32_t>(length_bytes);
+		std::string dict(length, '\0');
+
+		if (!stream.read(dict.data(), static_cast<std::streamsize>(length)))
+		{
+			throw std::runtime_error("Unexpected end of the .npy file!");
+		}
+
+		npy_header header;
+		tensor_lib_internal::_parse_npy_dict(dict, header);
+		header.data_offset = sizeof(preamble) + length_size + length;
+
+		return header;
+	}
+
+	inline void write_npy_header(std::ostream& stream, const npy_header& header)
+	{
+		std::string dict = "{'descr': '" + tensor_lib_internal::_npy_descr(header) + "', 'fortran_order': " + (header.fortran_order ? "True" : "False") + ", 'shape': (";
+
+		for (const std::size_t dimension : header.shape)
+		{
+			dict += std::to_string(dimension) + ", ";
+		}
+
+		// Python writes a one element tuple as "(5,)".
+		//
+		dict.resize(dict.size() - ((header.shape.size() > 1) ? 2 : 1));
+		dict += "), }";
+
+		// Version 1.0 stores the length in 2 bytes, longer headers need version 2.0.
+		//
+		const std::size_t length_size = (dict.size() + 64 < 65536) ? 2 : 4;
+		const std::size_t unpadded = 8 + length_size + dict.size() + 1;
+		dict.append((64 - unpadded % 64) % 64, ' ');
+		dict += '\n';
+
+		std::string preamble(tensor_lib_internal::_npy_magic);
+		preamble += static_cast<char>(length_size == 2 ? 1 : 2);
+		preamble += '\0';
+
+		unsigned char length_bytes[4];
+		tensor_lib_internal::_store_little_endian(length_bytes, static_cast<std::uint32_t>(dict.size()));
+		preamble.append(reinterpret_cast<const char*>(length_bytes), length_size);
+
+		stream.write(preamble.data(), static_cast<std::streamsize>(preamble.size()));
+		stream.write(dict.data(), static_cast<std::streamsize>(dict.size()));
+
+		if (!stream)
+		{
+			throw std::runtime_error("Failed to write the .npy header!");
+		}
+	}
+
+	template <typename Tensor>
+	inline npy_header make_npy_header(const Tensor& tsor)
+	{
+		using T = tensor_lib_internal::_element_t<Tensor>;
+
+		const auto ranks = tsor.get_ranks();
+
+		npy_header header;
+		header.type = dtype_of_v<T>;
+		header.element_size = sizeof(T);
+		header.shape.assign(ranks.begin(), ranks.end());
+
+		return header;
+	}
+
+	// Writes a tensor object of arithmetic elements as a C ordered array.
+	//
+	template <typename Tensor> requires tensor_object<Tensor> && (dtype_of_v<tensor_lib_internal::_element_t<Tensor>> != dtype::raw)
+	inline void save_npy(std::ostream& stream, const Tensor& tsor)
+	{
+		using T = tensor_lib_internal::_element_t<Tensor>;
+
+		write_npy_header(stream, make_npy_header(tsor));
+		stream.write(reinterpret_cast<const char*>(tsor.data()), static_cast<std::streamsize>(tsor.size_of_current_tensor() * sizeof(T)));
+
+		if (!stream)
+		{
+			throw std::runtime_error("Failed to write the .npy file!");
+		}
+	}
+
+	template <typename Tensor> requires tensor_object<Tensor> && (dtype_of_v<tensor_lib_internal::_element_t<Tensor>> != dtype::raw)
+	inline void save_npy(const std::filesystem::path& path, const Tensor& tsor)
+	{
+		std::ofstream file(path, std::ios::binary | std::ios::trunc);
+
+		if (!file)
+		{
+			throw std::runtime_error("Can't open the .npy file for writing!");
+		}
+
+		save_npy(file, tsor);
+	}
+
+	// Reads an array whose rank and dtype must match the template parameters. C ordered arrays of native byte order are read
+	// with a single call straight into data(), Fortran ordered arrays are transposed and other byte orders swapped.
+	//
+	template <typename T, std::size_t Rank, typename Allocator = std::allocator<T>> requires (dtype_of_v<T> != dtype::raw)
+	inline tensor<T, Rank, Allocator> load_npy(std::istream& stream, const Allocator& allocator = Allocator{})
+	{
+		const npy_header header = read_npy_header(stream);
+		tensor_lib_internal::_check_npy_header<T, Rank>(header);
+
+		std::array<std::size_t, Rank> order_of_dimension;
+		std::copy_n(header.shape.begin(), Rank, order_of_dimension.begin());
+
+		tensor<T, Rank, Allocator> result = std::apply([&allocator](const auto ... sizes)
+		{
+			return tensor<T, Rank, Allocator>(std::allocator_arg, allocator, sizes...);
+		}, order_of_dimension);
+
+		const std::size_t size = result.size_of_current_tensor();
+		const std::streamsize bytes = static_cast<std::streamsize>(size * sizeof(T));
+
+		if (header.fortran_order && Rank > 1)
+		{
+			const std::unique_ptr<T[]> column_major = std::make_unique_for_overwrite<T[]>(size);
+
+			if (!stream.read(reinterpret_cast<char*>(column_major.get()), bytes))
+			{
+				throw std::runtime_error("Unexpected end of the .npy file!");
+			}
+
+			if (size)
+			{
+				tensor_lib_internal::_from_fortran_order(column_major.get(), order_of_dimension, result.data());
+			}
+		}
+		else if (!stream.read(reinterpret_cast<char*>(result.data()), bytes))
+		{
+			throw std::runtime_error("Unexpected end of the .npy file!");
+		}
+
+		if (header.byte_order != std::endian::native && sizeof(T) > 1)
+		{
+			tensor_lib_internal::_byteswap_n(result.data(), size);
+		}
+
+		return result;
+	}
+
+	template <typename T, std::size_t Rank, typename Allocator = std::allocator<T>> requires (dtype_of_v<T> != dtype::raw)
+	inline tensor<T, Rank, Allocator> load_npy(const std::filesystem::path& path, const Allocator& allocator = Allocator{})
+	{
+		std::ifstream file(path, std::ios::binary);
+
+		if (!file)
+		{
+			throw std::runtime_error("Can't open the .npy file for reading!");
+		}
+
+		return load_npy<T, Rank, Allocator>(file, allocator);
+	}
+
+	namespace tensor_lib_internal
+	{
+		template <typename T, std::size_t Rank>
+		inline mapped_tensor<T, Rank> _map_npy(const std::filesystem::path& path, std::ifstream& file, const std::uint64_t offset, const map_mode mode)
+		{
+			const npy_header header = read_npy_header(file);
+			_check_npy_header<T, Rank>(header);
+
+			if (header.fortran_order && Rank > 1)
+			{
+				throw std::runtime_error("Can't map a Fortran ordered array!");
+			}
+
+			if (header.byte_order != std::endian::native && sizeof(T) > 1)
+			{
+				throw std::runtime_error("Can't map an array of a different byte order!");
+			}
+
+			std::array<std::size_t, Rank> order_of_dimension;
+			std::copy_n(header.shape.begin(), Rank, order_of_dimension.begin());
+			file.close();
+
+			return mapped_tensor<T, Rank>(path, static_cast<std::size_t>(offset + header.data_offset), order_of_dimension, mode);
+		}
+	}
+
+	// Maps a C ordered array of native byte order without copying it, see mapped_tensor.
+	//
+	template <typename T, std::size_t Rank> requires (dtype_of_v<T> != dtype::raw)
+	inline mapped_tensor<T, Rank> map_npy(const std::filesystem::path& path, const map_mode mode = map_mode::read_only)
+	{
+		std::ifstream file(path, std::ios::binary);
+
+		if (!file)
+		{
+			throw std::runtime_error("Can't open the .npy file for reading!");
+		}
+
+		return tensor_lib_internal::_map_npy<T, Rank>(path, file, 0, mode);
+	}
+
+	// Reads the array saved as 'name' by numpy.savez (or npz_writer). Compressed archives aren't supported.
+	//
+	template <typename T, std::size_t Rank, typename Allocator = std::allocator<T>> requires (dtype_of_v<T> != dtype::raw)
+	inline tensor<T, Rank, Allocator> load_npz(const std::filesystem::path& path, const std::string_view name, const Allocator& allocator = Allocator{})
+	{
+		std::ifstream file(path, std::ios::binary);
+
+		if (!file)
+		{
+			throw std::runtime_error("Can't open the .npz file for reading!");
+		}
+
+		file.seekg(static_cast<std::streamoff>(tensor_lib_internal::_npz_member_offset(file, name)));
+
+		return load_npy<T, Rank, Allocator>(file, allocator);
+	}
+
+	// Maps the array saved as 'name' inside an uncompressed .npz file, its data must be aligned for T within the file.
+	//
+	template <typename T, std::size_t Rank> requires (dtype_of_v<T> != dtype::raw)
+	inline mapped_tensor<T, Rank> map_npz(const std::filesystem::path& path, const std::string_view name, const map_mode mode = map_mode::read_only)
+	{
+		std::ifstream file(path, std::ios::binary);
+
+		if (!file)
+		{
+			throw std::runtime_error("Can't open the .npz file for reading!");
+		}
+
+		const std::uint64_t offset = tensor_lib_internal::_npz_member_offset(file, name);
+		file.seekg(static_cast<std::streamoff>(offset));
+
+		return tensor_lib_internal::_map_npy<T, Rank>(path, file, offset, mode);
+	}
+
+	// Writes an uncompressed .npz archive that numpy.load reads as a dict of arrays, one add() per array, each aligned to 64 bytes.
+	// The archive is completed by close() or by the destructor. Members of 4 GiB or more aren't supported (they would need zip64).
+	//
+	class npz_writer
+	{
+	private:
+		struct _member
+		{
+			std::string     name;
+			std::uint32_t   crc;
+			std::uint32_t   size;
+			std::uint32_t   offset;
+		};
+
+		std::ofstream           _file;
+		std::vector<_member>    _members;
+		bool                    _closed = false;
+
+		inline void _write(const std::vector<unsigned char>& bytes)
+		{
+			_file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+		}
+
+		// Local file header (signature 0x04034b50) or central directory header (signature 0x02014b50) of a stored member.
+		//
+		static inline std::vector<unsigned char> _record(const _member& member, const bool central)
+		{
+			std::vector<unsigned char> record(central ? 46 : 30, 0);
+			unsigned char* fields = record.data() + (central ? 2 : 0);
+
+			tensor_lib_internal::_store_little_endian(&record[0], central ? 0x02014b50u : 0x04034b50u);
+
+			if (central)
+			{
+				tensor_lib_internal::_store_little_endian(&record[4], std::uint16_t{ 20 });
+			}
+
+			tensor_lib_internal::_store_little_endian(&fields[4], std::uint16_t{ 20 });
+			tensor_lib_internal::_store_little_endian(&fields[12], std::uint16_t{ 0x21 });
+			tensor_lib_internal::_store_little_endian(&fields[14], member.crc);
+			tensor_lib_internal::_store_little_endian(&fields[18], member.size);
+			tensor_lib_internal::_store_little_endian(&fields[22], member.size);
+			tensor_lib_internal::_store_little_endian(&fields[26], static_cast<std::uint16_t>(member.name.size()));
+
+			if (central)
+			{
+				tensor_lib_internal::_store_little_endian(&record[42], member.offset);
+			}
+
+			record.insert(record.end(), member.name.begin(), member.name.end());
+
+			// The local header is padded with an extra field so that the array data starts at a multiple of 64 bytes,
+			// which keeps the members mappable with map_npz.
+			//
+			if (!central)
+			{
+				const std::size_t padding = (64 - (member.offset + record.size() + 4) % 64) % 64;
+
+				tensor_lib_internal::_store_little_endian(&record[28], static_cast<std::uint16_t>(4 + padding));
+				record.resize(record.size() + 4 + padding, 0);
+				tensor_lib_internal::_store_little_endian(&record[record.size() - padding - 4], std::uint16_t{ 0xD935 });
+				tensor_lib_internal::_store_little_endian(&record[record.size() - padding - 2], static_cast<std::uint16_t>(padding));
+			}
+
+			return record;
+		}
+
+	public:
+		inline explicit npz_writer(const std::filesystem::path& path)
+			: _file(path, std::ios::binary | std::ios::trunc)
+		{
+			if (!_file)
+			{
+				throw std::runtime_error("Can't open the .npz file for writing!");
+			}
+		}
+
+		npz_writer(const npz_writer&) = delete;
+		npz_writer& operator=(const npz_writer&) = delete;
+
+		template <typename Tensor> requires tensor_object<Tensor> && (dtype_of_v<tensor_lib_internal::_element_t<Tensor>> != dtype::raw)
+		inline void add(const std::string_view name, const Tensor& tsor)
+		{
+			using T = tensor_lib_internal::_element_t<Tensor>;
+
+			if (_closed)
+			{
+				throw std::runtime_error("Can't add an array to a closed .npz file!");
+			}
+
+			std::ostringstream header;
+			write_npy_header(header, make_npy_header(tsor));
+
+			const std::string header_bytes = header.str();
+			const std::uint64_t data_size = tsor.size_of_current_tensor() * sizeof(T);
+			const std::uint64_t size = header_bytes.size() + data_size;
+			const std::uint64_t offset = static_cast<std::uint64_t>(_file.tellp());
+
+			if (size >= 0xFFFFFFFFu || offset >= 0xFFFFFFFFu)
+			{
+				throw std::runtime_error("Arrays of 4 GiB or more can't be stored in an .npz file without zip64!");
+			}
+
+			_member member{ std::string(name) + ".npy", 0, static_cast<std::uint32_t>(size), static_cast<std::uint32_t>(offset) };
+			member.crc = tensor_lib_internal::_crc32(0, header_bytes.data(), header_bytes.size());
+			member.crc = tensor_lib_internal::_crc32(member.crc, tsor.data(), static_cast<std::size_t>(data_size));
+
+			_write(_record(member, false));
+			_file.write(header_bytes.data(), static_cast<std::streamsize>(header_bytes.size()));
+			_file.write(reinterpret_cast<const char*>(tsor.data()), static_cast<std::streamsize>(data_size));
+
+			if (!_file)
+			{
+				throw std::runtime_error("Failed to write the .npz file!");
+			}
+
+			_members.push_back(std::move(member));
+		}
+
+		// Writes the central directory, after which no array can be added.
+		//
+		inline void close()
+		{
+			if (_closed)
+			{
+				return;
+			}
+
+			_closed = true;
+
+			const std::uint64_t directory_offset = static_cast<std::uint64_t>(_file.tellp());
+
+			for (const _member& member : _members)
+			{
+				_write(_record(member, true));
+			}
+
+			const std::uint64_t directory_size = static_cast<std::uint64_t>(_file.tellp()) - directory_offset;
+
+			std::vector<unsigned char> end_record(22, 0);
+			tensor_lib_internal::_store_little_endian(&end_record[0], 0x06054b50u);
+			tensor_lib_internal::_store_little_endian(&end_record[8], static_cast<std::uint16_t>(_members.size()));
+			tensor_lib_internal::_store_little_endian(&end_record[10], static_cast<std::uint16_t>(_members.size()));
+			tensor_lib_internal::_store_little_endian(&end_record[12], static_cast<std::uint32_t>(directory_size));
+			tensor_lib_internal::_store_little_endian(&end_record[16], static_cast<std::uint32_t>(directory_offset));
+			_write(end_record);
+
+			_file.close();
+
+			if (!_file)
+			{
+				throw std::runtime_error("Failed to write the .npz file!");
+			}
+		}
+
+		inline ~npz_writer()
+		{
+			try
+			{
+				close();
+			}
+			catch (...)
+			{
+
+			}
+		}
+	};
+}
@@ -0,0 +1,592 @@
+#pragma once
+
+#include "tensor.hpp"
+#include "tensor_execution.hpp"
+#include "tensor_expressions.hpp"
+#include "tensor_kernels.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace tensor_lib
+{
+	// Reductions of tensor objects, either over all of their elements (returning a single value) or along one axis (returning a tensor
+	// of one rank less, ex: the sum of a matrix along axis 0 is the vector of the sums of its columns).
+	//
+	// Along axis k the elements are seen as [outer][order_of_dimension(k)][inner], where inner = size_of_subdimension(k + 1), so the
+	// rows of 'inner' contiguous elements that are combined together lie 'inner' elements apart and are streamed straight from the buffer,
+	// without building any subdimension. Reductions along the last axis fold contiguous runs of elements instead.
+	//
+	// Floating point sums are pairwise (see kernels::reduce()), so they stay accurate over hundreds of millions of elements.
+	// The operation given to reduce() has to be associative and commutative, the order in which the elements are combined is unspecified.
+	//
+
+	namespace tensor_lib_internal
+	{
+		// Most result columns one task reduces at once, so the result row and the pairwise scratch rows stay in cache.
+		//
+		static constexpr std::size_t _reduction_columns = 2048;
+
+		template <std::size_t Rank>
+		inline constexpr void _check_axis(const std::size_t axis)
+		{
+			if (axis >= Rank)
+			{
+				throw std::runtime_error("Axis of the reduction is out of range!");
+			}
+		}
+
+		template <typename Tensor>
+		inline constexpr void _check_not_empty(const Tensor& tsor)
+		{
+			if (tsor.empty())
+			{
+				throw std::runtime_error("Cannot reduce an empty tensor!");
+			}
+		}
+
+		template <typename T, typename Operation>
+		inline T _fold(const T* data, const std::size_t n, const Operation& operation)
+		{
+			if constexpr (kernels::is_reduction_operation_v<Operation>)
+			{
+				return kernels::reduce<Operation>(data, n);
+			}
+			else
+			{
+				T result = data[0];
+
+				for (std::size_t index = 1; index < n; index++)
+				{
+					result = static_cast<T>(operation(result, data[index]));
+				}
+
+				return result;
+			}
+		}
+
+		template <typename T, typename Operation>
+		inline void _combine(T* out, const T* row, const std::size_t columns, const Operation& operation)
+		{
+			if constexpr (kernels::is_reduction_operation_v<Operation>)
+			{
+				kernels::binary<Operation>(out, row, out, columns);
+			}
+			else
+			{
+				for (std::size_t column = 0; column < columns; column++)
+				{
+					out[column] = static_cast<T>(operation(out[column], row[column]));
+				}
+			}
+		}
+
+		// Number of scratch rows _reduce_rows() needs to reduce 'rows' rows.
+		//
+		template <typename T, typename Operation>
+		inline constexpr std::size_t _scratch_rows(std::size_t rows) noexcept
+		{
+			std::size_t levels = 0;
+
+			if constexpr (kernels::_is_pairwise_sum_v<Operation, T>)
+			{
+				for (; rows > kernels::_pairwise_block; rows -= rows / 2)
+				{
+					levels++;
+				}
+			}
+
+			return levels;
+		}
+
+		// out[j] = rows[0][j] op rows[1][j] op ... for j < columns, where the rows are 'row_stride' elements apart.
+		// Pairwise sums reduce both halves of the rows separately, the second one into the first row of 'scratch'.
+		//
+		template <typename T, typename Operation>
+		inline void _reduce_rows(const T* first, const std::size_t rows, const std::size_t row_stride, const std::size_t columns, T* out, T* scratch, const Operation& operation)
+		{
+			if constexpr (kernels::_is_pairwise_sum_v<Operation, T>)
+			{
+				if (rows > kernels::_pairwise_block)
+				{
+					const std::size_t half = rows / 2;
+
+					_reduce_rows(first, half, row_stride, columns, out, scratch + columns, operation);
+					_reduce_rows(first + half * row_stride, rows - half, row_stride, columns, scratch, scratch + columns, operation);
+					_combine(out, scratch, columns, operation);
+					return;
+				}
+			}
+
+			_copy_n(first, columns, out);
+
+			for (std::size_t row = 1; row < rows; row++)
+			{
+				_combine(out, first + row * row_stride, columns, operation);
+			}
+		}
+
+		// Index of the first element of 'data' no other element 'compare's better than.
+		//
+		template <typename T, typename Compare>
+		inline std::size_t _arg_fold(const T* data, const std::size_t n, const Compare& compare)
+		{
+			std::size_t best = 0;
+
+			for (std::size_t index = 1; index < n; index++)
+			{
+				if (compare(data[index], data[best]))
+				{
+					best = index;
+				}
+			}
+
+			return best;
+		}
+
+		template <typename T, typename Compare>
+		inline void _arg_rows(const T* first, const std::size_t rows, const std::size_t row_stride, const std::size_t columns, std::size_t* out, T* best, const Compare& compare)
+		{
+			_copy_n(first, columns, best);
+			std::fill_n(out, columns, std::size_t{ 0 });
+
+			for (std::size_t row = 1; row < rows; row++)
+			{
+				const T* values = first + row * row_stride;
+
+				for (std::size_t column = 0; column < columns; column++)
+				{
+					if (compare(values[column], best[column]))
+					{
+						best[column] = values[column];
+						out[column] = row;
+					}
+				}
+			}
+		}
+
+		// A tensor with the shape of 'tsor' without 'axis'.
+		//
+		template <typename T, std::size_t Rank, typename Tensor>
+		inline tensor<T, Rank - 1> _reduced_tensor(const Tensor& tsor, const std::size_t axis)
+		{
+			std::array<std::size_t, Rank - 1> sizes;
+
+			for (std::size_t level = 0, index = 0; level < Rank; level++)
+			{
+				if (level != axis)
+				{
+					sizes[index++] = tsor.order_of_dimension(level);
+				}
+			}
+
+			return std::apply([](const auto ... new_sizes) { return tensor<T, Rank - 1>(new_sizes...); }, sizes);
+		}
+
+		// Splits a reduction of the non-empty 'tsor' along 'axis' into blocks of at most '_reduction_columns' results and calls
+		// function(source, rows, row_stride, columns, offset) for each of them, which reduces the 'rows' rows of 'columns' elements
+		// at 'source' into the results starting at 'offset'. A row stride of 1 means that every result folds a contiguous run of 'rows' elements.
+		//
+		template <typename Policy, typename Tensor, typename Function>
+		inline void _for_each_axis_block(const Policy&, const Tensor& tsor, const std::size_t axis, const Function& function)
+		{
+			constexpr std::size_t rank = _rank_of<Tensor>;
+
+			const std::size_t rows = tsor.order_of_dimension(axis);
+			const std::size_t inner = (axis + 1 < rank) ? tsor.size_of_subdimension(axis + 1) : 1;
+			const std::size_t outer = tsor.size_of_current_tensor() / (rows * inner);
+			const std::size_t columns = std::min(inner, _reduction_columns);
+			const std::size_t blocks_per_outer = (inner + columns - 1) / columns;
+			const auto* data = tsor.data();
+
+			auto reduce_blocks = [=, &function](const std::size_t first, const std::size_t last)
+			{
+				for (std::size_t block = first; block < last; block++)
+				{
+					const std::size_t index = block / blocks_per_outer;
+					const std::size_t column = (block % blocks_per_outer) * columns;
+
+					function(data + index * rows * inner + column, rows, inner, std::min(columns, inner - column), index * inner + column);
+				}
+			};
+
+			if constexpr (execution::is_parallel_policy_v<std::remove_cvref_t<Policy>>)
+			{
+				execution::default_pool().parallel_for(outer * blocks_per_outer, std::max<std::size_t>(1, execution::grain_size() / (rows * columns)), reduce_blocks);
+			}
+			else
+			{
+				reduce_blocks(0, outer * blocks_per_outer);
+			}
+		}
+
+		template <typename Policy, typename Tensor, typename Operation>
+		inline auto _reduce_all(const Policy&, const Tensor& tsor, const Operation& operation)
+		{
+			using T = _element_type_of<Tensor>;
+
+			_check_not_empty(tsor);
+
+			const std::size_t size = tsor.size_of_current_tensor();
+			const T* data = tsor.data();
+
+			if constexpr (execution::is_parallel_policy_v<std::remove_cvref_t<Policy>>)
+			{
+				const std::size_t grain = execution::grain_size();
+
+				if (size > grain)
+				{
+					// Fixed blocks make the result independent of the number of threads.
+					//
+					std::vector<T> partials((size + grain - 1) / grain);
+
+					execution::default_pool().parallel_for(partials.size(), 1, [&partials, &operation, data, size, grain](const std::size_t first, const std::size_t last)
+					{
+						for (std::size_t block = first; block < last; block++)
+						{
+							partials[block] = _fold(data + block * grain, std::min(grain, size - block * grain), operation);
+						}
+					});
+
+					return _fold(partials.data(), partials.size(), operation);
+				}
+			}
+
+			return _fold(data, size, operation);
+		}
+
+		template <typename Policy, typename Tensor, typename Operation>
+		inline auto _reduce_axis(const Policy& policy, const Tensor& tsor, const std::size_t axis, const Operation& operation)
+		{
+			using T = _element_type_of<Tensor>;
+			constexpr std::size_t rank = _rank_of<Tensor>;
+
+			_check_axis<rank>(axis);
+
+			auto result = _reduced_tensor<T, rank>(tsor, axis);
+			T* out = result.data();
+
+			if (!tsor.empty())
+			{
+				_for_each_axis_block(policy, tsor, axis, [out, &operation](const T* source, const std::size_t rows, const std::size_t row_stride, const std::size_t columns, const std::size_t offset)
+				{
+					if (row_stride == 1)
+					{
+						out[offset] = _fold(source, rows, operation);
+						return;
+					}
+
+					std::vector<T> scratch(_scratch_rows<T, Operation>(rows) * columns);
+					_reduce_rows(source, rows, row_stride, columns, out + offset, scratch.data(), operation);
+				});
+			}
+
+			return result;
+		}
+
+		template <typename Policy, typename Tensor, typename Compare>
+		inline std::size_t _arg_reduce_all(const Policy&, const Tensor& tsor, const Compare& compare)
+		{
+			using T = _element_type_of<Tensor>;
+
+			_check_not_empty(tsor);
+
+			const std::size_t size = tsor.size_of_current_tensor();
+			const T* data = tsor.data();
+
+			if constexpr (execution::is_parallel_policy_v<std::remove_cvref_t<Policy>>)
+			{
+				const std::size_t grain = execution::grain_size();
+
+				if (size > grain)
+				{
+					std::vector<std::size_t> partials((size + grain - 1) / grain);
+
+					execution::default_pool().parallel_for(partials.size(), 1, [&partials, &compare, data, size, grain](const std::size_t first, const std::size_t last)
+					{
+						for (std::size_t block = first; block < last; block++)
+						{
+							partials[block] = block * grain + _arg_fold(data + block * grain, std::min(grain, size - block * grain), compare);
+						}
+					});
+
+					std::size_t best = partials[0];
+
+					for (const std::size_t index : partials)
+					{
+						if (compare(data[index], data[best]))
+						{
+							best = index;
+						}
+					}
+
+					return best;
+				}
+			}
+
+			return _arg_fold(data, size, compare);
+		}
+
+		template <typename Policy, typename Tensor, typename Compare>
+		inline auto _arg_reduce_axis(const Policy& policy, const Tensor& tsor, const std::size_t axis, const Compare& compare)
+		{
+			using T = _element_type_of<Tensor>;
+			constexpr std::size_t rank = _rank_of<Tensor>;
+
+			_check_axis<rank>(axis);
+
+			auto result = _reduced_tensor<std::size_t, rank>(tsor, axis);
+			std::size_t* out = result.data();
+
+			if (!tsor.empty())
+			{
+				_for_each_axis_block(policy, tsor, axis, [out, &compare](const T* source, const std::size_t rows, const std::size_t row_stride, const std::size_t columns, const std::size_t offset)
+				{
+					if (row_stride == 1)
+					{
+						out[offset] = _arg_fold(source, rows, compare);
+						return;
+					}
+
+					std::vector<T> best(columns);
+					_arg_rows(source, rows, row_stride, columns, out + offset, best.data(), compare);
+				});
+			}
+
+			return result;
+		}
+
+		template <typename Tensor>
+		concept _reducible_along_axis = tensor_object<Tensor> && (_rank_of<Tensor> > 1u);
+
+		template <typename Tensor>
+		concept _floating_point_tensor_object = tensor_object<Tensor> && std::is_floating_point_v<_element_type_of<Tensor>>;
+	}
+
+	// Folds all the elements of 'tsor' with 'operation'. Throws for empty tensors.
+	//
+	template <typename Policy, typename Tensor, typename Operation> requires execution::execution_policy<Policy> && tensor_object<Tensor>
+	inline auto reduce(const Policy& policy, const Tensor& tsor, const Operation& operation)
+	{
+		return tensor_lib_internal::_reduce_all(policy, tsor, operation);
+	}
+
+	template <typename Tensor, typename Operation> requires tensor_object<Tensor>
+	inline auto reduce(const Tensor& tsor, const Operation& operation)
+	{
+		return tensor_lib_internal::_reduce_all(execution::seq, tsor, operation);
+	}
+
+	// Folds the elements of 'tsor' along 'Axis' with 'operation' (ex: reduce<0>(my_matrix, std::plus<>{}) sums its columns).
+	//
+	template <std::size_t Axis, typename Policy, typename Tensor, typename Operation>
+		requires execution::execution_policy<Policy> && tensor_lib_internal::_reducible_along_axis<Tensor> && (Axis < tensor_lib_internal::_rank_of<Tensor>)
+	inline auto reduce(const Policy& policy, const Tensor& tsor, const Operation& operation)
+	{
+		return tensor_lib_internal::_reduce_axis(policy, tsor, Axis, operation);
+	}
+
+	template <std::size_t Axis, typename Tensor, typename Operation>
+		requires tensor_lib_internal::_reducible_along_axis<Tensor> && (Axis < tensor_lib_internal::_rank_of<Tensor>)
+	inline auto reduce(const Tensor& tsor, const Operation& operation)
+	{
+		return tensor_lib_internal::_reduce_axis(execution::seq, tsor, Axis, operation);
+	}
+
+	// The sum of an empty tensor is 0.
+	//
+	template <typename Policy, typename Tensor> requires execution::execution_policy<Policy> && tensor_object<Tensor>
+	inline auto sum(const Policy& policy, const Tensor& tsor)
+	{
+		return tsor.empty() ? tensor_lib_internal::_element_type_of<Tensor>{} : tensor_lib_internal::_reduce_all(policy, tsor, std::plus<>{});
+	}
+
+	template <typename Tensor> requires tensor_object<Tensor>
+	inline auto sum(const Tensor& tsor)
+	{
+		return sum(execution::seq, tsor);
+	}
+
+	template <typename Policy, typename Tensor> requires execution::execution_policy<Policy> && tensor_lib_internal::_reducible_along_axis<Tensor>
+	inline auto sum(const Policy& policy, const Tensor& tsor, const std::size_t axis)
+	{
+		return tensor_lib_internal::_reduce_axis(policy, tsor, axis, std::plus<>{});
+	}
+
+	template <typename Tensor> requires tensor_lib_internal::_reducible_along_axis<Tensor>
+	inline auto sum(const Tensor& tsor, const std::size_t axis)
+	{
+		return sum(execution::seq, tsor, axis);
+	}
+
+	// The product of an empty tensor is 1.
+	//
+	template <typename Policy, typename Tensor> requires execution::execution_policy<Policy> && tensor_object<Tensor>
+	inline auto prod(const Policy& policy, const Tensor& tsor)
+	{
+		return tsor.empty() ? tensor_lib_internal::_element_type_of<Tensor>{ 1 } : tensor_lib_internal::_reduce_all(policy, tsor, std::multiplies<>{});
+	}
+
+	template <typename Tensor> requires tensor_object<Tensor>
+	inline auto prod(const Tensor& tsor)
+	{
+		return prod(execution::seq, tsor);
+	}
+
+	template <typename Policy, typename Tensor> requires execution::execution_policy<Policy> && tensor_lib_internal::_reducible_along_axis<Tensor>
+	inline auto prod(const Policy& policy, const Tensor& tsor, const std::size_t axis)
+	{
+		return tensor_lib_internal::_reduce_axis(policy, tsor, axis, std::multiplies<>{});
+	}
+
+	template <typename Tensor> requires tensor_lib_internal::_reducible_along_axis<Tensor>
+	inline auto prod(const Tensor& tsor, const std::size_t axis)
+	{
+		return prod(execution::seq, tsor, axis);
+	}
+
+	template <typename Policy, typename Tensor> requires execution::execution_policy<Policy> && tensor_object<Tensor>
+	inline auto min(const Policy& policy, const Tensor& tsor)
+	{
+		return tensor_lib_internal::_reduce_all(policy, tsor, kernels::minimum_operation{});
+	}
+
+	template <typename Tensor> requires tensor_object<Tensor>
+	inline auto min(const Tensor& tsor)
+	{
+		return min(execution::seq, tsor);
+	}
+
+	template <typename Policy, typename Tensor> requires execution::execution_policy<Policy> && tensor_lib_internal::_reducible_along_axis<Tensor>
+	inline auto min(const Policy& policy, const Tensor& tsor, const std::size_t axis)
+	{
+		return tensor_lib_internal::_reduce_axis(policy, tsor, axis, kernels::minimum_operation{});
+	}
+
+	template <typename Tensor> requires tensor_lib_internal::_reducible_along_axis<Tensor>
+	inline auto min(const Tensor& tsor, const std::size_t axis)
+	{
+		return min(execution::seq, tsor, axis);
+	}
+
+	template <typename Policy, typename Tensor> requires execution::execution_policy<Policy> && tensor_object<Tensor>
+	inline auto max(const Policy& policy, const Tensor& tsor)
+	{
+		return tensor_lib_internal::_reduce_all(policy, tsor, kernels::maximum_operation{});
+	}
+
+	template <typename Tensor> requires tensor_object<Tensor>
+	inline auto max(const Tensor& tsor)
+	{
+		return max(execution::seq, tsor);
+	}
+
+	template <typename Policy, typename Tensor> requires execution::execution_policy<Policy> && tensor_lib_internal::_reducible_along_axis<Tensor>
+	inline auto max(const Policy& policy, const Tensor& tsor, const std::size_t axis)
+	{
+		return tensor_lib_internal::_reduce_axis(policy, tsor, axis, kernels::maximum_operation{});
+	}
+
+	template <typename Tensor> requires tensor_lib_internal::_reducible_along_axis<Tensor>
+	inline auto max(const Tensor& tsor, const std::size_t axis)
+	{
+		return max(execution::seq, tsor, axis);
+	}
+
+	// Means are only defined for floating point elements. Throws for empty tensors.
+	//
+	template <typename Policy, typename Tensor> requires execution::execution_policy<Policy> && tensor_lib_internal::_floating_point_tensor_object<Tensor>
+	inline auto mean(const Policy& policy, const Tensor& tsor)
+	{
+		using T = tensor_lib_internal::_element_type_of<Tensor>;
+
+		return tensor_lib_internal::_reduce_all(policy, tsor, std::plus<>{}) / static_cast<T>(tsor.size_of_current_tensor());
+	}
+
+	template <typename Tensor> requires tensor_lib_internal::_floating_point_tensor_object<Tensor>
+	inline auto mean(const Tensor& tsor)
+	{
+		return mean(execution::seq, tsor);
+	}
+
+	template <typename Policy, typename Tensor>
+		requires execution::execution_policy<Policy> && tensor_lib_internal::_reducible_along_axis<Tensor> && tensor_lib_internal::_floating_point_tensor_object<Tensor>
+	inline auto mean(const Policy& policy, const Tensor& tsor, const std::size_t axis)
+	{
+		using T = tensor_lib_internal::_element_type_of<Tensor>;
+
+		auto result = tensor_lib_internal::_reduce_axis(policy, tsor, axis, std::plus<>{});
+
+		if (!result.empty())
+		{
+			const T rows = static_cast<T>(tsor.order_of_dimension(axis));
+			kernels::binary<std::divides<>, false, true>(result.data(), &rows, result.data(), result.size_of_current_tensor());
+		}
+
+		return result;
+	}
+
+	template <typename Tensor> requires tensor_lib_internal::_reducible_along_axis<Tensor> && tensor_lib_internal::_floating_point_tensor_object<Tensor>
+	inline auto mean(const Tensor& tsor, const std::size_t axis)
+	{
+		return mean(execution::seq, tsor, axis);
+	}
+
+	// Flat index of the first smallest / largest element. Throws for empty tensors.
+	//
+	template <typename Policy, typename Tensor> requires execution::execution_policy<Policy> && tensor_object<Tensor>
+	inline std::size_t argmin(const Policy& policy, const Tensor& tsor)
+	{
+		return tensor_lib_internal::_arg_reduce_all(policy, tsor, std::less<>{});
+	}
+
+	template <typename Tensor> requires tensor_object<Tensor>
+	inline std::size_t argmin(const Tensor& tsor)
+	{
+		return argmin(execution::seq, tsor);
+	}
+
+	// Indices along 'axis' of the first smallest / largest elements, as a tensor<std::size_t, Rank - 1>.
+	//
+	template <typename Policy, typename Tensor> requires execution::execution_policy<Policy> && tensor_lib_internal::_reducible_along_axis<Tensor>
+	inline auto argmin(const Policy& policy, const Tensor& tsor, const std::size_t axis)
+	{
+		return tensor_lib_internal::_arg_reduce_axis(policy, tsor, axis, std::less<>{});
+	}
+
+	template <typename Tensor> requires tensor_lib_internal::_reducible_along_axis<Tensor>
+	inline auto argmin(const Tensor& tsor, const std::size_t axis)
+	{
+		return argmin(execution::seq, tsor, axis);
+	}
+
+	template <typename Policy, typename Tensor> requires execution::execution_policy<Policy> && tensor_object<Tensor>
+	inline std::size_t argmax(const Policy& policy, const Tensor& tsor)
+	{
+		return tensor_lib_internal::_arg_reduce_all(policy, tsor, std::greater<>{});
+	}
+
+	template <typename Tensor> requires tensor_object<Tensor>
+	inline std::size_t argmax(const Tensor& tsor)
+	{
+		return argmax(execution::seq, tsor);
+	}
+
+	template <typename Policy, typename Tensor> requires execution::execution_policy<Policy> && tensor_lib_internal::_reducible_along_axis<Tensor>
+	inline auto argmax(const Policy& policy, const Tensor& tsor, const std::size_t axis)
+	{
+		return tensor_lib_internal::_arg_reduce_axis(policy, tsor, axis, std::greater<>{});
+	}
+
+	template <typename Tensor> requires tensor_lib_internal::_reducible_along_axis<Tensor>
+	inline auto argmax(const Tensor& tsor, const std::size_t axis)
+	{
+		return argmax(execution::seq, tsor, axis);
+	}
+}
@@ -0,0 +1,1014 @@
+#pragma once
+
+#include "tensor.hpp"
+#include "tensor_execution.hpp"
+#include "tensor_expressions.hpp"
+#include "tensor_layout.hpp"
+#include "tensor_matmul.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace tensor_lib
+{
+	// Sparse storage for tensors that are mostly zeros, only the elements that are stored take memory and time.
+	// sparse_tensor<T, Rank> is in coordinate (COO) form: the indices and value of every stored element, in row-major order.
+	// csr_matrix<T> is in compressed sparse row (CSR) form: the column and value of every stored element, row after row,
+	// and where each row starts, which is what products read.
+	//
+	// Both are made from a dense tensor object (its non-zero elements) or from unsorted (indices, value) triplets, where elements
+	// given several times get the sum of their values, and to_dense() gives the tensor back. Elements that aren't stored are zero.
+	//
+	template <typename T, std::size_t Rank, typename allocator_type = std::allocator<T>> requires (Rank != 0u)
+	class sparse_tensor;
+
+	template <typename T, typename allocator_type = std::allocator<T>>
+	class csr_matrix;
+
+	namespace tensor_lib_internal
+	{
+		template <typename U>
+		inline constexpr bool _is_sparse_v = false;
+
+		template <typename T, std::size_t Rank, typename allocator_type>
+		inline constexpr bool _is_sparse_v<sparse_tensor<T, Rank, allocator_type>> = true;
+
+		template <typename T, typename allocator_type>
+		inline constexpr bool _is_sparse_v<csr_matrix<T, allocator_type>> = true;
+
+		template <typename U>
+		concept _sparse_object = _is_sparse_v<std::remove_cvref_t<U>>;
+
+		// Dense tensor objects of the same rank and element type as a sparse tensor.
+		//
+		template <typename Dense, typename T, std::size_t Rank>
+		concept _dense_operand_of = tensor_object<Dense> && (_rank_of<std::remove_cvref_t<Dense>> == Rank) && std::same_as<_element_type_of<std::remove_cvref_t<Dense>>, T>;
+
+		template <std::size_t Rank>
+		inline constexpr std::array<std::size_t, Rank> _sparse_strides(const std::array<std::size_t, Rank>& order_of_dimension)
+		{
+			std::array<std::size_t, Rank> strides;
+			std::size_t size = 1;
+
+			for (std::size_t axis = Rank; axis > 0; axis--)
+			{
+				strides[axis - 1] = size;
+
+				if (order_of_dimension[axis - 1] != 0 && size > std::numeric_limits<std::size_t>::max() / order_of_dimension[axis - 1])
+				{
+					throw std::runtime_error("Sparse tensor has too many elements to be indexed!");
+				}
+
+				size *= order_of_dimension[axis - 1];
+			}
+
+			return strides;
+		}
+
+		// The row-major offset of the element at each of 'indices', paired with its position in 'indices', sorted.
+		// An index outside 'order_of_dimension' throws with 'out_of_range_message'.
+		// With a parallel policy every task sorts a slice, a few slices per thread to even out the load, then the slices are merged pairwise,
+		// the merges of each round in parallel.
+		//
+		template <typename Policy, std::size_t Rank>
+		inline std::vector<std::pair<std::size_t, std::size_t>> _sorted_sparse_keys(const Policy&, const std::array<std::size_t, Rank>& order_of_dimension,
+			const std::span<const std::array<std::size_t, Rank>> indices, const char* const out_of_range_message)
+		{
+			using key_type = std::pair<std::size_t, std::size_t>;
+
+			const std::array<std::size_t, Rank> strides = _sparse_strides(order_of_dimension);
+			const std::size_t count = indices.size();
+
+			std::vector<key_type> keys(count);
+
+			auto sort_slice = [&](const std::size_t first, const std::size_t last)
+			{
+				for (std::size_t position = first; position < last; position++)
+				{
+					std::size_t key = 0;
+
+					for (std::size_t axis = 0; axis < Rank; axis++)
+					{
+						if (indices[position][axis] >= order_of_dimension[axis])
+						{
+							throw std::runtime_error(out_of_range_message);
+						}
+
+						key += indices[position][axis] * strides[axis];
+					}
+
+					keys[position] = { key, position };
+				}
+
+				std::sort(keys.begin() + first, keys.begin() + last);
+			};
+
+			if constexpr (execution::is_parallel_policy_v<std::remove_cvref_t<Policy>>)
+			{
+				auto& pool = execution::default_pool();
+				const std::size_t slice = std::max(execution::grain_size(), (count + 4 * pool.size() - 1) / (4 * pool.size()));
+				const std::size_t slices = (count + slice - 1) / slice;
+
+				pool.parallel_for(slices, 1, [&sort_slice, slice, count](const std::size_t first, const std::size_t last)
+				{
+					for (std::size_t index = first; index < last; index++)
+					{
+						sort_slice(index * slice, std::min(count, (index + 1) * slice));
+					}
+				});
+
+				if (slices > 1)
+				{
+					std::vector<key_type> merged(count);
+
+					for (std::size_t width = slice; width < count; width *= 2)
+					{
+						pool.parallel_for((count + 2 * width - 1) / (2 * width), 1, [&keys, &merged, width, count](const std::size_t first, const std::size_t last)
+						{
+							for (std::size_t pair = first; pair < last; pair++)
+							{
+								const std::size_t begin = pair * 2 * width;
+								const std::size_t middle = std::min(count, begin + width);
+								const std::size_t end = std::min(count, begin + 2 * width);
+
+								std::merge(keys.begin() + begin, keys.begin() + middle, keys.begin() + middle, keys.begin() + end, merged.begin() + begin);
+							}
+						});
+
+						keys.swap(merged);
+					}
+				}
+			}
+			else
+			{
+				sort_slice(0, count);
+			}
+
+			return keys;
+		}
+
+		// Calls function(position, value) once for each distinct key, in order, with the position of its first triplet and the sum of its values.
+		// Keys are sorted with their positions, so duplicates are summed in the order they were given, whatever the policy.
+		//
+		template <typename T, typename Function>
+		inline void _coalesce_sparse_keys(const std::vector<std::pair<std::size_t, std::size_t>>& keys, const std::span<const T> values, Function function)
+		{
+			for (std::size_t first = 0; first < keys.size();)
+			{
+				T sum = values[keys[first].second];
+				std::size_t last = first + 1;
+
+				for (; last < keys.size() && keys[last].first == keys[first].first; last++)
+				{
+					sum = static_cast<T>(sum + values[keys[last].second]);
+				}
+
+				function(keys[first].second, std::move(sum));
+				first = last;
+			}
+		}
+
+		template <typename Sparse, typename Dense>
+		inline void _check_sparse_dense_shapes(const Sparse& sparse, const Dense& dense)
+		{
+			const auto sparse_ranks = sparse.get_ranks();
+			const auto dense_ranks = dense.get_ranks();
+
+			if (!std::equal(sparse_ranks.begin(), sparse_ranks.end(), dense_ranks.begin(), dense_ranks.end()))
+			{
+				throw std::runtime_error("Sparse and dense operands must have the same shape!");
+			}
+		}
+	}
+
+	template <typename T, std::size_t Rank, typename allocator_type> requires (Rank != 0u)
+	class sparse_tensor
+	{
+	private:
+		using index_allocator_type = typename std::allocator_traits<allocator_type>::template rebind_alloc<std::size_t>;
+
+		std::array<std::size_t, Rank> _order_of_dimension{};
+
+		// Rank indices per stored element, the elements one after the other in row-major order, each of them once.
+		//
+		std::vector<std::size_t, index_allocator_type> _indices;
+		std::vector<T, allocator_type> _values;
+
+		// Position of the stored element at 'index', nonzeros() if it isn't stored.
+		//
+		inline std::size_t _find(const std::array<std::size_t, Rank>& index) const noexcept
+		{
+			std::size_t first = 0;
+			std::size_t count = nonzeros();
+
+			while (count > 0)
+			{
+				const std::size_t step = count / 2;
+				const auto middle = _indices.begin() + (first + step) * Rank;
+
+				if (std::lexicographical_compare(middle, middle + Rank, index.begin(), index.end()))
+				{
+					first += step + 1;
+					count -= step + 1;
+				}
+				else
+				{
+					count = step;
+				}
+			}
+
+			if (first < nonzeros() && std::equal(index.begin(), index.end(), _indices.begin() + first * Rank))
+			{
+				return first;
+			}
+
+			return nonzeros();
+		}
+
+	public:
+		using value_type = T;
+
+		inline sparse_tensor(const allocator_type& allocator = allocator_type{})
+			: _indices(index_allocator_type(allocator))
+			, _values(allocator)
+		{
+
+		}
+
+		// A tensor of the given sizes with no element stored, all zeros.
+		//
+		template <typename... Sizes> requires (sizeof...(Sizes) == Rank) && useful_concepts::integrals<Sizes...>
+		inline explicit sparse_tensor(const Sizes ... sizes)
+			: _order_of_dimension{ static_cast<std::size_t>(sizes)... }
+		{
+
+		}
+
+		// The element at indices[n] is values[n], the others are zero. Indices don't have to be sorted, the values of repeated ones are added.
+		// Ex: sparse_tensor<float, 2> ratings(execution::par, { users, items }, indices, values);
+		//
+		template <typename Policy> requires execution::execution_policy<Policy>
+		inline sparse_tensor(const Policy& policy, const std::array<std::size_t, Rank>& order_of_dimension, const std::span<const std::array<std::size_t, Rank>> indices,
+			const std::span<const T> values, const allocator_type& allocator = allocator_type{})
+			: _order_of_dimension{ order_of_dimension }
+			, _indices(index_allocator_type(allocator))
+			, _values(allocator)
+		{
+			if (indices.size() != values.size())
+			{
+				throw std::runtime_error("Sparse tensor needs one value for each index!");
+			}
+
+			const auto keys = tensor_lib_internal::_sorted_sparse_keys(policy, _order_of_dimension, indices, "Index of a sparse tensor element is out of range!");
+
+			tensor_lib_internal::_coalesce_sparse_keys(keys, values, [this, indices](const std::size_t position, T&& value)
+			{
+				_indices.insert(_indices.end(), indices[position].begin(), indices[position].end());
+				_values.push_back(std::move(value));
+			});
+		}
+
+		inline sparse_tensor(const std::array<std::size_t, Rank>& order_of_dimension, const std::span<const std::array<std::size_t, Rank>> indices,
+			const std::span<const T> values, const allocator_type& allocator = allocator_type{})
+			: sparse_tensor(execution::seq, order_of_dimension, indices, values, allocator)
+		{
+
+		}
+
+		// Stores the non-zero elements of a dense tensor object.
+		//
+		template <typename Dense> requires tensor_lib_internal::_dense_operand_of<Dense, T, Rank>
+		inline explicit sparse_tensor(const Dense& dense, const allocator_type& allocator = allocator_type{})
+			: _order_of_dimension{ tensor_lib_internal::_order_of_dimension_of(dense) }
+			, _indices(index_allocator_type(allocator))
+			, _values(allocator)
+		{
+			const T* element = dense.data();
+
+			tensor_lib_internal::_for_each_index(_order_of_dimension, [this, &element](const std::array<std::size_t, Rank>& index)
+			{
+				if (*element != T{})
+				{
+					_indices.insert(_indices.end(), index.begin(), index.end());
+					_values.push_back(*element);
+				}
+
+				++element;
+			});
+		}
+
+		inline explicit sparse_tensor(const csr_matrix<T, allocator_type>& matrix) requires (Rank == 2u)
+			: _order_of_dimension{ matrix.order_of_dimension(0), matrix.order_of_dimension(1) }
+			, _indices(index_allocator_type(matrix.get_allocator()))
+			, _values(matrix.values().begin(), matrix.values().end(), matrix.get_allocator())
+		{
+			_indices.reserve(2 * matrix.nonzeros());
+
+			for (std::size_t row = 0; row < _order_of_dimension[0]; row++)
+			{
+				for (std::size_t position = matrix.row_offsets()[row]; position < matrix.row_offsets()[row + 1]; position++)
+				{
+					_indices.push_back(row);
+					_indices.push_back(matrix.column_indices()[position]);
+				}
+			}
+		}
+
+		inline tensor<T, Rank> to_dense() const
+		{
+			tensor<T, Rank> result = std::apply([](const auto ... sizes) { return tensor<T, Rank>(sizes...); }, _order_of_dimension);
+
+			std::fill(result.begin(), result.end(), T{});
+
+			const auto strides = tensor_lib_internal::_row_major_strides(_order_of_dimension);
+
+			for (std::size_t position = 0; position < nonzeros(); position++)
+			{
+				result.data()[tensor_lib_internal::_strided_offset(index(position), strides)] = _values[position];
+			}
+
+			return result;
+		}
+
+		// The element at the given indices, zero if it isn't stored.
+		//
+		template <typename... Indices> requires (sizeof...(Indices) == Rank) && useful_concepts::integrals<Indices...>
+		inline T operator() (const Indices ... indices) const
+		{
+			const std::size_t position = _find({ static_cast<std::size_t>(indices)... });
+
+			return position < nonzeros() ? _values[position] : T{};
+		}
+
+		// Pointer to the stored element at the given indices, nullptr if it isn't stored.
+		//
+		template <typename... Indices> requires (sizeof...(Indices) == Rank) && useful_concepts::integrals<Indices...>
+		inline T* find(const Indices ... indices) noexcept
+		{
+			const std::size_t position = _find({ static_cast<std::size_t>(indices)... });
+
+			return position < nonzeros() ? _values.data() + position : nullptr;
+		}
+
+		template <typename... Indices> requires (sizeof...(Indices) == Rank) && useful_concepts::integrals<Indices...>
+		inline const T* find(const Indices ... indices) const noexcept
+		{
+			const std::size_t position = _find({ static_cast<std::size_t>(indices)... });
+
+			return position < nonzeros() ? _values.data() + position : nullptr;
+		}
+
+		// Calls function(indices, value) for every stored element, in row-major order.
+		//
+		template <typename Function>
+		inline void for_each_nonzero(Function function)
+		{
+			std::array<std::size_t, Rank> index;
+
+			for (std::size_t position = 0; position < nonzeros(); position++)
+			{
+				std::copy_n(_indices.begin() + position * Rank, Rank, index.begin());
+				function(std::as_const(index), _values[position]);
+			}
+		}
+
+		template <typename Function>
+		inline void for_each_nonzero(Function function) const
+		{
+			std::array<std::size_t, Rank> index;
+
+			for (std::size_t position = 0; position < nonzeros(); position++)
+			{
+				std::copy_n(_indices.begin() + position * Rank, Rank, index.begin());
+				function(std::as_const(index), _values[position]);
+			}
+		}
+
+		inline std::array<std::size_t, Rank> index(const std::size_t position) const noexcept
+		{
+			std::array<std::size_t, Rank> result;
+			std::copy_n(_indices.begin() + position * Rank, Rank, result.begin());
+
+			return result;
+		}
+
+		// Indices of the stored elements, Rank per element.
+		//
+		inline std::span<const std::size_t> indices() const noexcept
+		{
+			return _indices;
+		}
+
+		inline std::span<T> values() noexcept
+		{
+			return _values;
+		}
+
+		inline std::span<const T> values() const noexcept
+		{
+			return _values;
+		}
+
+		inline std::size_t nonzeros() const noexcept
+		{
+			return _values.size();
+		}
+
+		inline std::size_t order_of_dimension(const std::size_t index) const noexcept
+		{
+			return _order_of_dimension[index];
+		}
+
+		inline auto get_ranks() const noexcept
+		{
+			return std::span<const std::size_t, Rank>(_order_of_dimension);
+		}
+
+		inline allocator_type get_allocator() const noexcept
+		{
+			return _values.get_allocator();
+		}
+
+		friend inline bool operator== (const sparse_tensor& left, const sparse_tensor& right)
+		{
+			return left._order_of_dimension == right._order_of_dimension && left._indices == right._indices && left._values == right._values;
+		}
+	};
+
+	template <typename T, typename allocator_type>
+	class csr_matrix
+	{
+	private:
+		using index_allocator_type = typename std::allocator_traits<allocator_type>::template rebind_alloc<std::size_t>;
+
+		std::array<std::size_t, 2> _order_of_dimension{};
+
+		// The stored elements of row i are at [_row_offsets[i], _row_offsets[i + 1]) of _column_indices and _values, by column.
+		//
+		std::vector<std::size_t, index_allocator_type> _row_offsets;
+		std::vector<std::size_t, index_allocator_type> _column_indices;
+		std::vector<T, allocator_type> _values;
+
+		// Turns the number of elements of each row, kept at _row_offsets[row + 1], into where each row starts.
+		//
+		inline void _count_to_offsets() noexcept
+		{
+			for (std::size_t row = 0; row < _order_of_dimension[0]; row++)
+			{
+				_row_offsets[row + 1] += _row_offsets[row];
+			}
+		}
+
+	public:
+		using value_type = T;
+
+		inline csr_matrix(const allocator_type& allocator = allocator_type{})
+			: _row_offsets(1, 0, index_allocator_type(allocator))
+			, _column_indices(index_allocator_type(allocator))
+			, _values(allocator)
+		{
+
+		}
+
+		inline csr_matrix(const std::size_t rows, const std::size_t columns, const allocator_type& allocator = allocator_type{})
+			: _order_of_dimension{ rows, columns }
+			, _row_offsets(rows + 1, 0, index_allocator_type(allocator))
+			, _column_indices(index_allocator_type(allocator))
+			, _values(allocator)
+		{
+
+		}
+
+		// The element at indices[n] (row, column) is values[n], the others are zero. Triplets don't have to be sorted, the values of repeated ones are added.
+		// Ex: csr_matrix<float> features(execution::par, { users, items }, indices, values);
+		//
+		template <typename Policy> requires execution::execution_policy<Policy>
+		inline csr_matrix(const Policy& policy, const std::array<std::size_t, 2>& order_of_dimension, const std::span<const std::array<std::size_t, 2>> indices,
+			const std::span<const T> values, const allocator_type& allocator = allocator_type{})
+			: csr_matrix(order_of_dimension[0], order_of_dimension[1], allocator)
+		{
+			if (indices.size() != values.size())
+			{
+				throw std::runtime_error("Sparse tensor needs one value for each index!");
+			}
+
+			const auto keys = tensor_lib_internal::_sorted_sparse_keys(policy, _order_of_dimension, indices, "Index of a sparse tensor element is out of range!");
+
+			tensor_lib_internal::_coalesce_sparse_keys(keys, values, [this, indices](const std::size_t position, T&& value)
+			{
+				_row_offsets[indices[position][0] + 1]++;
+				_column_indices.push_back(indices[position][1]);
+				_values.push_back(std::move(value));
+			});
+
+			_count_to_offsets();
+		}
+
+		inline csr_matrix(const std::array<std::size_t, 2>& order_of_dimension, const std::span<const std::array<std::size_t, 2>> indices,
+			const std::span<const T> values, const allocator_type& allocator = allocator_type{})
+			: csr_matrix(execution::seq, order_of_dimension, indices, values, allocator)
+		{
+
+		}
+
+		// Stores the non-zero elements of a dense matrix object.
+		//
+		template <typename Dense> requires tensor_lib_internal::_dense_operand_of<Dense, T, 2>
+		inline explicit csr_matrix(const Dense& dense, const allocator_type& allocator = allocator_type{})
+			: csr_matrix(dense.order_of_dimension(0), dense.order_of_dimension(1), allocator)
+		{
+			const T* element = dense.data();
+
+			for (std::size_t row = 0; row < _order_of_dimension[0]; row++)
+			{
+				for (std::size_t column = 0; column < _order_of_dimension[1]; column++, element++)
+				{
+					if (*element != T{})
+					{
+						_column_indices.push_back(column);
+						_values.push_back(*element);
+					}
+				}
+
+				_row_offsets[row + 1] = _values.size();
+			}
+		}
+
+		inline explicit csr_matrix(const sparse_tensor<T, 2, allocator_type>& coordinates)
+			: csr_matrix(coordinates.order_of_dimension(0), coordinates.order_of_dimension(1), coordinates.get_allocator())
+		{
+			const auto indices = coordinates.indices();
+
+			_column_indices.reserve(coordinates.nonzeros());
+			_values.assign(coordinates.values().begin(), coordinates.values().end());
+
+			for (std::size_t position = 0; position < coordinates.nonzeros(); position++)
+			{
+				_row_offsets[indices[2 * position] + 1]++;
+				_column_indices.push_back(indices[2 * position + 1]);
+			}
+
+			_count_to_offsets();
+		}
+
+		inline tensor<T, 2> to_dense() const
+		{
+			tensor<T, 2> result(_order_of_dimension[0], _order_of_dimension[1]);
+			std::fill(result.begin(), result.end(), T{});
+
+			for (std::size_t row = 0; row < _order_of_dimension[0]; row++)
+			{
+				T* result_row = result.data() + row * _order_of_dimension[1];
+
+				for (std::size_t position = _row_offsets[row]; position < _row_offsets[row + 1]; position++)
+				{
+					result_row[_column_indices[position]] = _values[position];
+				}
+			}
+
+			return result;
+		}
+
+		// The element at (row, column), zero if it isn't stored.
+		//
+		inline T operator() (const std::size_t row, const std::size_t column) const
+		{
+			const T* element = find(row, column);
+
+			return element ? *element : T{};
+		}
+
+		inline T* find(const std::size_t row, const std::size_t column) noexcept
+		{
+			return const_cast<T*>(std::as_const(*this).find(row, column));
+		}
+
+		inline const T* find(const std::size_t row, const std::size_t column) const noexcept
+		{
+			const auto first = _column_indices.begin() + _row_offsets[row];
+			const auto last = _column_indices.begin() + _row_offsets[row + 1];
+			const auto found = std::lower_bound(first, last, column);
+
+			return (found != last && *found == column) ? _values.data() + (found - _column_indices.begin()) : nullptr;
+		}
+
+		// Calls function(indices, value) for every stored element, row after row.
+		//
+		template <typename Function>
+		inline void for_each_nonzero(Function function)
+		{
+			for (std::size_t row = 0; row < _order_of_dimension[0]; row++)
+			{
+				for (std::size_t position = _row_offsets[row]; position < _row_offsets[row + 1]; position++)
+				{
+					function(std::array<std::size_t, 2>{ row, _column_indices[position] }, _values[position]);
+				}
+			}
+		}
+
+		template <typename Function>
+		inline void for_each_nonzero(Function function) const
+		{
+			for (std::size_t row = 0; row < _order_of_dimension[0]; row++)
+			{
+				for (std::size_t position = _row_offsets[row]; position < _row_offsets[row + 1]; position++)
+				{
+					function(std::array<std::size_t, 2>{ row, _column_indices[position] }, _values[position]);
+				}
+			}
+		}
+
+		inline std::span<const std::size_t> row_offsets() const noexcept
+		{
+			return _row_offsets;
+		}
+
+		inline std::span<const std::size_t> column_indices() const noexcept
+		{
+			return _column_indices;
+		}
+
+		inline std::span<T> values() noexcept
+		{
+			return _values;
+		}
+
+		inline std::span<const T> values() const noexcept
+		{
+			return _values;
+		}
+
+		inline std::size_t nonzeros() const noexcept
+		{
+			return _values.size();
+		}
+
+		inline std::size_t order_of_dimension(const std::size_t index) const noexcept
+		{
+			return _order_of_dimension[index];
+		}
+
+		inline auto get_ranks() const noexcept
+		{
+			return std::span<const std::size_t, 2>(_order_of_dimension);
+		}
+
+		inline allocator_type get_allocator() const noexcept
+		{
+			return _values.get_allocator();
+		}
+
+		friend inline bool operator== (const csr_matrix& left, const csr_matrix& right)
+		{
+			return left._order_of_dimension == right._order_of_dimension && left._row_offsets == right._row_offsets
+				&& left._column_indices == right._column_indices && left._values == right._values;
+		}
+	};
+
+	namespace tensor_lib_internal
+	{
+		// Rows of the result go to different tasks with a parallel policy, 'row_work' is about the number of multiply-adds of one row.
+		//
+		template <typename Policy, typename Function>
+		inline void _for_each_sparse_row(const Policy&, const std::size_t rows, const std::size_t row_work, const Function& function)
+		{
+			if constexpr (execution::is_parallel_policy_v<std::remove_cvref_t<Policy>>)
+			{
+				execution::default_pool().parallel_for(rows, std::max<std::size_t>(1, execution::grain_size() / std::max<std::size_t>(1, row_work)), function);
+			}
+			else
+			{
+				function(std::size_t{ 0 }, rows);
+			}
+		}
+	}
+
+	// Sparse times dense products: a csr_matrix times a dense matrix (SpMM) or vector (SpMV), and a dense matrix times a csr_matrix.
+	// Only the stored elements are read, and the result is dense.
+	//
+	template <typename Policy, typename T, typename allocator_type, typename Dense>
+		requires execution::execution_policy<Policy> && tensor_lib_internal::_dense_operand_of<Dense, T, 2>
+	inline tensor<T, 2> matmul(const Policy& policy, const csr_matrix<T, allocator_type>& a, const Dense& b)
+	{
+		tensor_lib_internal::_check_matmul_sizes(a, b);
+
+		const std::size_t rows = a.order_of_dimension(0);
+		const std::size_t columns = b.order_of_dimension(1);
+
+		tensor<T, 2> result(rows, columns);
+
+		const auto offsets = a.row_offsets();
+		const auto column_indices = a.column_indices();
+		const auto values = a.values();
+		const T* b_data = b.data();
+		T* result_data = result.data();
+
+		tensor_lib_internal::_for_each_sparse_row(policy, rows, columns * (a.nonzeros() / std::max<std::size_t>(1, rows) + 1), [=](const std::size_t first, const std::size_t last)
+		{
+			for (std::size_t row = first; row < last; row++)
+			{
+				T* result_row = result_data + row * columns;
+				std::fill_n(result_row, columns, T{});
+
+				for (std::size_t position = offsets[row]; position < offsets[row + 1]; position++)
+				{
+					const T value = values[position];
+					const T* b_row = b_data + column_indices[position] * columns;
+
+					for (std::size_t column = 0; column < columns; column++)
+					{
+						result_row[column] = static_cast<T>(result_row[column] + value * b_row[column]);
+					}
+				}
+			}
+		});
+
+		return result;
+	}
+
+	template <typename Policy, typename T, typename allocator_type, typename Vector>
+		requires execution::execution_policy<Policy> && tensor_lib_internal::_dense_operand_of<Vector, T, 1>
+	inline tensor<T, 1> matmul(const Policy& policy, const csr_matrix<T, allocator_type>& a, const Vector& x)
+	{
+		if (a.order_of_dimension(1) != x.order_of_dimension(0))
+		{
+			throw std::runtime_error("Number of columns of the matrix doesn't match the size of the vector!");
+		}
+
+		const std::size_t rows = a.order_of_dimension(0);
+
+		tensor<T, 1> result(rows);
+
+		const auto offsets = a.row_offsets();
+		const auto column_indices = a.column_indices();
+		const auto values = a.values();
+		const T* x_data = x.data();
+		T* result_data = result.data();
+
+		tensor_lib_internal::_for_each_sparse_row(policy, rows, a.nonzeros() / std::max<std::size_t>(1, rows) + 1, [=](const std::size_t first, const std::size_t last)
+		{
+			for (std::size_t row = first; row < last; row++)
+			{
+				T sum{};
+
+				for (std::size_t position = offsets[row]; position < offsets[row + 1]; position++)
+				{
+					sum = static_cast<T>(sum + values[position] * x_data[column_indices[position]]);
+				}
+
+				result_data[row] = sum;
+			}
+		});
+
+		return result;
+	}
+
+	template <typename Policy, typename Dense, typename T, typename allocator_type>
+		requires execution::execution_policy<Policy> && tensor_lib_internal::_dense_operand_of<Dense, T, 2>
+	inline tensor<T, 2> matmul(const Policy& policy, const Dense& a, const csr_matrix<T, allocator_type>& b)
+	{
+		tensor_lib_internal::_check_matmul_sizes(a, b);
+
+		const std::size_t rows = a.order_of_dimension(0);
+		const std::size_t depth = a.order_of_dimension(1);
+		const std::size_t columns = b.order_of_dimension(1);
+
+		tensor<T, 2> result(rows, columns);
+
+		const auto offsets = b.row_offsets();
+		const auto column_indices = b.column_indices();
+		const auto values = b.values();
+		const T* a_data = a.data();
+		T* result_data = result.data();
+
+		tensor_lib_internal::_for_each_sparse_row(policy, rows, b.nonzeros() + 1, [=](const std::size_t first, const std::size_t last)
+		{
+			for (std::size_t row = first; row < last; row++)
+			{
+				T* result_row = result_data + row * columns;
+				std::fill_n(result_row, columns, T{});
+
+				for (std::size_t inner = 0; inner < depth; inner++)
+				{
+					const T a_value = a_data[row * depth + inner];
+
+					if (a_value == T{})
+					{
+						continue;
+					}
+
+					for (std::size_t position = offsets[inner]; position < offsets[inner + 1]; position++)
+					{
+						result_row[column_indices[position]] = static_cast<T>(result_row[column_indices[position]] + a_value * values[position]);
+					}
+				}
+			}
+		});
+
+		return result;
+	}
+
+	template <typename T, typename allocator_type, typename Dense> requires tensor_lib_internal::_dense_operand_of<Dense, T, 2> || tensor_lib_internal::_dense_operand_of<Dense, T, 1>
+	inline auto matmul(const csr_matrix<T, allocator_type>& a, const Dense& b)
+	{
+		return matmul(execution::seq, a, b);
+	}
+
+	template <typename Dense, typename T, typename allocator_type> requires tensor_lib_internal::_dense_operand_of<Dense, T, 2>
+	inline tensor<T, 2> matmul(const Dense& a, const csr_matrix<T, allocator_type>& b)
+	{
+		return matmul(execution::seq, a, b);
+	}
+
+	namespace tensor_lib_internal
+	{
+		template <typename Sparse>
+		using _sparse_value_t = typename std::remove_cvref_t<Sparse>::value_type;
+
+		template <typename Sparse>
+		static constexpr std::size_t _sparse_rank = decltype(std::declval<const Sparse&>().get_ranks())::extent;
+
+		template <typename Sparse, typename Dense>
+		concept _sparse_dense_operands = _sparse_object<Sparse> && _dense_operand_of<Dense, _sparse_value_t<Sparse>, _sparse_rank<std::remove_cvref_t<Sparse>>>;
+
+		template <typename Sparse, typename Scalar>
+		concept _sparse_scalar_operands = _sparse_object<Sparse> && !_sparse_object<Scalar> && !expression_operand<Scalar>
+			&& std::is_convertible_v<const Scalar&, _sparse_value_t<Sparse>>;
+
+		// Calls function(stored value, dense element) for every stored element of 'sparse' and the element of 'dense' at its indices.
+		//
+		template <typename Sparse, typename Dense, typename Function>
+		inline void _for_each_sparse_dense_pair(Sparse& sparse, Dense& dense, Function function)
+		{
+			_check_sparse_dense_shapes(sparse, dense);
+
+			const auto strides = _row_major_strides(_order_of_dimension_of(dense));
+			auto* data = dense.data();
+
+			sparse.for_each_nonzero([&function, &strides, data](const auto& index, auto& value)
+			{
+				function(value, data[_strided_offset(index, strides)]);
+			});
+		}
+	}
+
+	// Element-wise operations with dense operands of the same shape. Sums and differences are dense tensors, products and quotients
+	// keep the stored elements of the sparse operand (the others stay zero) and are sparse, as are products and quotients with scalars.
+	// Ex: tensor<float, 2> shifted = ratings + bias; auto masked = ratings * weights;
+	//
+	template <typename Sparse, typename Dense> requires tensor_lib_internal::_sparse_dense_operands<Sparse, Dense>
+	inline auto operator+(const Sparse& sparse, const Dense& dense)
+	{
+		using T = tensor_lib_internal::_sparse_value_t<Sparse>;
+
+		tensor_lib_internal::_check_sparse_dense_shapes(sparse, dense);
+
+		tensor<T, tensor_lib_internal::_sparse_rank<Sparse>> result(dense);
+		tensor_lib_internal::_for_each_sparse_dense_pair(sparse, result, [](const T& value, T& element) { element = static_cast<T>(element + value); });
+
+		return result;
+	}
+
+	template <typename Dense, typename Sparse> requires tensor_lib_internal::_sparse_dense_operands<Sparse, Dense>
+	inline auto operator+(const Dense& dense, const Sparse& sparse)
+	{
+		return sparse + dense;
+	}
+
+	template <typename Sparse, typename Dense> requires tensor_lib_internal::_sparse_dense_operands<Sparse, Dense>
+	inline auto operator-(const Sparse& sparse, const Dense& dense)
+	{
+		using T = tensor_lib_internal::_sparse_value_t<Sparse>;
+
+		tensor_lib_internal::_check_sparse_dense_shapes(sparse, dense);
+
+		tensor<T, tensor_lib_internal::_sparse_rank<Sparse>> result(dense);
+
+		for (T& element : result)
+		{
+			element = static_cast<T>(-element);
+		}
+
+		tensor_lib_internal::_for_each_sparse_dense_pair(sparse, result, [](const T& value, T& element) { element = static_cast<T>(element + value); });
+
+		return result;
+	}
+
+	template <typename Dense, typename Sparse> requires tensor_lib_internal::_sparse_dense_operands<Sparse, Dense>
+	inline auto operator-(const Dense& dense, const Sparse& sparse)
+	{
+		using T = tensor_lib_internal::_sparse_value_t<Sparse>;
+
+		tensor_lib_internal::_check_sparse_dense_shapes(sparse, dense);
+
+		tensor<T, tensor_lib_internal::_sparse_rank<Sparse>> result(dense);
+		tensor_lib_internal::_for_each_sparse_dense_pair(sparse, result, [](const T& value, T& element) { element = static_cast<T>(element - value); });
+
+		return result;
+	}
+
+	template <typename Sparse, typename Dense> requires tensor_lib_internal::_sparse_dense_operands<Sparse, Dense>
+	inline auto operator*(const Sparse& sparse, const Dense& dense)
+	{
+		using T = tensor_lib_internal::_sparse_value_t<Sparse>;
+
+		std::remove_cvref_t<Sparse> result = sparse;
+
+		tensor_lib_internal::_for_each_sparse_dense_pair(result, dense, [](T& value, const T& element) { value = static_cast<T>(value * element); });
+
+		return result;
+	}
+
+	template <typename Dense, typename Sparse> requires tensor_lib_internal::_sparse_dense_operands<Sparse, Dense>
+	inline auto operator*(const Dense& dense, const Sparse& sparse)
+	{
+		using T = tensor_lib_internal::_sparse_value_t<Sparse>;
+
+		std::remove_cvref_t<Sparse> result = sparse;
+
+		tensor_lib_internal::_for_each_sparse_dense_pair(result, dense, [](T& value, const T& element) { value = static_cast<T>(element * value); });
+
+		return result;
+	}
+
+	template <typename Sparse, typename Dense> requires tensor_lib_internal::_sparse_dense_operands<Sparse, Dense>
+	inline auto operator/(const Sparse& sparse, const Dense& dense)
+	{
+		using T = tensor_lib_internal::_sparse_value_t<Sparse>;
+
+		std::remove_cvref_t<Sparse> result = sparse;
+
+		tensor_lib_internal::_for_each_sparse_dense_pair(result, dense, [](T& value, const T& element) { value = static_cast<T>(value / element); });
+
+		return result;
+	}
+
+	template <typename Sparse, typename Scalar> requires tensor_lib_internal::_sparse_scalar_operands<Sparse, Scalar>
+	inline auto operator*(const Sparse& sparse, const Scalar& scalar)
+	{
+		using T = tensor_lib_internal::_sparse_value_t<Sparse>;
+
+		std::remove_cvref_t<Sparse> result = sparse;
+
+		for (T& value : result.values())
+		{
+			value = static_cast<T>(value * static_cast<T>(scalar));
+		}
+
+		return result;
+	}
+
+	template <typename Scalar, typename Sparse> requires tensor_lib_internal::_sparse_scalar_operands<Sparse, Scalar>
+	inline auto operator*(const Scalar& scalar, const Sparse& sparse)
+	{
+		using T = tensor_lib_internal::_sparse_value_t<Sparse>;
+
+		std::remove_cvref_t<Sparse> result = sparse;
+
+		for (T& value : result.values())
+		{
+			value = static_cast<T>(static_cast<T>(scalar) * value);
+		}
+
+		return result;
+	}
+
+	template <typename Sparse, typename Scalar> requires tensor_lib_internal::_sparse_scalar_operands<Sparse, Scalar>
+	inline auto operator/(const Sparse& sparse, const Scalar& scalar)
+	{
+		using T = tensor_lib_internal::_sparse_value_t<Sparse>;
+
+		std::remove_cvref_t<Sparse> result = sparse;
+
+		for (T& value : result.values())
+		{
+			value = static_cast<T>(value / static_cast<T>(scalar));
+		}
+
+		return result;
+	}
+
+	template <typename Sparse> requires tensor_lib_internal::_sparse_object<Sparse>
+	inline auto operator-(const Sparse& sparse)
+	{
+		using T = tensor_lib_internal::_sparse_value_t<Sparse>;
+
+		std::remove_cvref_t<Sparse> result = sparse;
+
+		for (T& value : result.values())
+		{
+			value = static_cast<T>(-value);
+		}
+
+		return result;
+	}
+}
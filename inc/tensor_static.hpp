@@ -0,0 +1,472 @@
+#pragma once
+
+#include "tensor.hpp"
+#include "tensor_expressions.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace tensor_lib
+{
+	// Tensors whose shape is part of their type: static_tensor<float, 4, 4> keeps its 16 elements inline (no allocation, no size metadata
+	// per object) and every stride is a compile time constant, so indexing through operator[] or operator() folds to a single constant offset.
+	// static_tensor and its static_subdimensions are tensor objects, they work with expressions, matmul, reductions and views like any tensor.
+	//
+
+	template <typename T, std::size_t... Extents> requires (sizeof...(Extents) != 0u) && ((Extents != 0u) && ...)
+	class static_tensor;
+
+	template <typename T, std::size_t... Extents> requires (sizeof...(Extents) != 0u) && ((Extents != 0u) && ...)
+	class static_subdimension;
+
+	template <typename U, std::size_t... Extents>
+	struct is_tensor_object <static_tensor<U, Extents...>> : std::true_type {};
+
+	template <typename U, std::size_t... Extents>
+	struct is_tensor_object <static_subdimension<U, Extents...>> : std::true_type {};
+
+	template <typename T, std::size_t Rows, std::size_t Columns>
+	using static_matrix = static_tensor<T, Rows, Columns>;
+
+	namespace tensor_lib_internal
+	{
+		template <std::size_t... Extents>
+		struct _static_shape
+		{
+			static constexpr std::size_t rank = sizeof...(Extents);
+
+			static constexpr std::array<std::size_t, rank> order_of_dimension{ Extents... };
+
+			static constexpr std::array<std::size_t, rank> size_of_subdimension = []()
+			{
+				std::array<std::size_t, rank> sizes{};
+				std::partial_sum(order_of_dimension.crbegin(), order_of_dimension.crend(), sizes.rbegin(), std::multiplies<std::size_t>());
+				return sizes;
+			}();
+
+			static constexpr std::size_t size = size_of_subdimension[0];
+
+			// Distance between consecutive indices of each dimension.
+			//
+			static constexpr std::array<std::size_t, rank> strides = []()
+			{
+				std::array<std::size_t, rank> result{};
+				for (std::size_t level = 0; level < rank; level++)
+				{
+					result[level] = (level + 1 < rank) ? size_of_subdimension[level + 1] : 1;
+				}
+				return result;
+			}();
+
+			template <std::size_t... Levels, typename... Indices>
+			static inline constexpr std::size_t _offset(std::index_sequence<Levels...>, const Indices ... indices) noexcept
+			{
+				return ((static_cast<std::size_t>(indices) * strides[Levels]) + ...);
+			}
+
+			template <typename... Indices>
+			static inline constexpr std::size_t offset(const Indices ... indices) noexcept
+			{
+				return _offset(std::make_index_sequence<rank>{}, indices...);
+			}
+		};
+
+		// What indexing the leading dimension gives: a static_subdimension of the remaining extents, or an element for the last one.
+		//
+		template <typename T, std::size_t First, std::size_t... Rest>
+		struct _static_subdimension_of
+		{
+			using type = static_subdimension<T, Rest...>;
+		};
+
+		template <typename T, std::size_t Last>
+		struct _static_subdimension_of<T, Last>
+		{
+			using type = T&;
+		};
+
+		template <typename T, std::size_t... Extents>
+		using _static_subdimension_t = typename _static_subdimension_of<T, Extents...>::type;
+
+		template <typename Source, std::size_t... Extents>
+		inline constexpr void _check_static_shape(const Source& source)
+		{
+			const auto ranks = source.get_ranks();
+
+			if (!std::equal(ranks.begin(), ranks.end(), _static_shape<Extents...>::order_of_dimension.begin(), _static_shape<Extents...>::order_of_dimension.end()))
+			{
+				throw std::runtime_error("Size of the source doesn't match the extents of the static tensor!");
+			}
+		}
+
+		template <typename T, std::size_t Rank>
+		inline constexpr void _copy_nested_initializer_list(T*& destination, const useful_specializations::nested_initializer_list_t<T, Rank>& data, const std::size_t* extents)
+		{
+			if (data.size() != *extents)
+			{
+				throw std::runtime_error("Initializer list doesn't match the extents of the static tensor!");
+			}
+
+			if constexpr (Rank == 1u)
+			{
+				std::copy_n(data.begin(), data.size(), destination);
+				destination += data.size();
+			}
+			else
+			{
+				for (const auto& nested : data)
+				{
+					_copy_nested_initializer_list<T, Rank - 1>(destination, nested, extents + 1);
+				}
+			}
+		}
+	}
+
+	template <typename T, std::size_t... Extents> requires (sizeof...(Extents) != 0u) && ((Extents != 0u) && ...)
+	class static_tensor
+	{
+	private:
+		using _shape = tensor_lib_internal::_static_shape<Extents...>;
+
+		static constexpr std::size_t Rank = _shape::rank;
+
+		T _data[_shape::size]{};
+
+	public:
+		using value_type = T;
+		using iterator = T*;
+		using const_iterator = const T*;
+		using subdimension_type = tensor_lib_internal::_static_subdimension_t<T, Extents...>;
+		using const_subdimension_type = tensor_lib_internal::_static_subdimension_t<const T, Extents...>;
+
+		// Elements are value initialized (zero for arithmetic types).
+		//
+		inline constexpr static_tensor() = default;
+
+		inline constexpr explicit static_tensor(const T& value)
+		{
+			std::fill_n(_data, _shape::size, value);
+		}
+
+		inline constexpr static_tensor(const useful_specializations::nested_initializer_list_t<T, Rank>& data)
+		{
+			T* destination = _data;
+			tensor_lib_internal::_copy_nested_initializer_list<T, Rank>(destination, data, _shape::order_of_dimension.data());
+		}
+
+		template <typename Expression> requires (tensor_expression<Expression> && (Expression::rank == Rank))
+		inline constexpr static_tensor(const Expression& expression)
+		{
+			(*this) = expression;
+		}
+
+		// Copies any tensor object of the same shape, ex: a dynamically sized matrix<float> that happens to be 4 x 4.
+		//
+		template <typename Tensor> requires tensor_object<Tensor> && (!std::same_as<std::remove_cvref_t<Tensor>, static_tensor>)
+			&& std::same_as<tensor_lib_internal::_element_type_of<std::remove_cvref_t<Tensor>>, T>
+		inline constexpr explicit static_tensor(const Tensor& other)
+		{
+			(*this) = other;
+		}
+
+		template <typename Expression> requires (tensor_expression<Expression> && (Expression::rank == Rank))
+		inline constexpr auto& operator=(const Expression& expression)
+		{
+			tensor_lib_internal::_check_static_shape<Expression, Extents...>(expression);
+			tensor_lib_internal::_assign_expression(_data, expression);
+
+			return (*this);
+		}
+
+		template <typename Tensor> requires tensor_object<Tensor> && (!std::same_as<std::remove_cvref_t<Tensor>, static_tensor>)
+			&& std::same_as<tensor_lib_internal::_element_type_of<std::remove_cvref_t<Tensor>>, T>
+		inline constexpr auto& operator=(const Tensor& other)
+		{
+			tensor_lib_internal::_check_static_shape<Tensor, Extents...>(other);
+			std::copy_n(other.data(), _shape::size, _data);
+
+			return (*this);
+		}
+
+		inline constexpr auto operator[](const std::size_t index) noexcept requires (Rank > 1u)
+		{
+			return subdimension_type(_data + index * _shape::strides[0]);
+		}
+
+		inline constexpr auto operator[](const std::size_t index) const noexcept requires (Rank > 1u)
+		{
+			return const_subdimension_type(_data + index * _shape::strides[0]);
+		}
+
+		inline constexpr T& operator[](const std::size_t index) noexcept requires (Rank == 1u)
+		{
+			return _data[index];
+		}
+
+		inline constexpr const T& operator[](const std::size_t index) const noexcept requires (Rank == 1u)
+		{
+			return _data[index];
+		}
+
+		template <typename... Indices> requires (sizeof...(Indices) == Rank) && useful_concepts::integrals<Indices...>
+		inline constexpr T& operator()(const Indices ... indices) noexcept
+		{
+			return _data[_shape::offset(indices...)];
+		}
+
+		template <typename... Indices> requires (sizeof...(Indices) == Rank) && useful_concepts::integrals<Indices...>
+		inline constexpr const T& operator()(const Indices ... indices) const noexcept
+		{
+			return _data[_shape::offset(indices...)];
+		}
+
+		inline constexpr iterator begin() noexcept
+		{
+			return _data;
+		}
+
+		inline constexpr iterator end() noexcept
+		{
+			return _data + _shape::size;
+		}
+
+		inline constexpr const_iterator begin() const noexcept
+		{
+			return _data;
+		}
+
+		inline constexpr const_iterator end() const noexcept
+		{
+			return _data + _shape::size;
+		}
+
+		inline constexpr const_iterator cbegin() const noexcept
+		{
+			return _data;
+		}
+
+		inline constexpr const_iterator cend() const noexcept
+		{
+			return _data + _shape::size;
+		}
+
+		inline constexpr T* data() noexcept
+		{
+			return _data;
+		}
+
+		inline constexpr const T* data() const noexcept
+		{
+			return _data;
+		}
+
+		static inline constexpr std::size_t order_of_dimension(const std::size_t index) noexcept
+		{
+			return _shape::order_of_dimension[index];
+		}
+
+		static inline constexpr std::size_t size_of_subdimension(const std::size_t index) noexcept
+		{
+			return _shape::size_of_subdimension[index];
+		}
+
+		static inline constexpr std::size_t order_of_current_dimension() noexcept
+		{
+			return _shape::order_of_dimension[0];
+		}
+
+		static inline constexpr std::size_t size_of_current_tensor() noexcept
+		{
+			return _shape::size;
+		}
+
+		static inline constexpr auto get_sizes() noexcept
+		{
+			return std::span<const std::size_t, Rank>(_shape::size_of_subdimension);
+		}
+
+		static inline constexpr auto get_ranks() noexcept
+		{
+			return std::span<const std::size_t, Rank>(_shape::order_of_dimension);
+		}
+
+		static inline constexpr bool empty() noexcept
+		{
+			return false;
+		}
+
+		static inline consteval bool is_matrix() noexcept
+		{
+			return (Rank == 2);
+		}
+
+		static inline constexpr bool is_square_matrix() noexcept requires (Rank == 2u)
+		{
+			return (_shape::order_of_dimension[0] == _shape::order_of_dimension[1]);
+		}
+	};
+
+	// What operator[] of a static_tensor returns: a pointer to the first element, the shape comes from the type.
+	// 'T' is const for the subdimensions of const static tensors.
+	//
+	template <typename T, std::size_t... Extents> requires (sizeof...(Extents) != 0u) && ((Extents != 0u) && ...)
+	class static_subdimension
+	{
+	private:
+		using _shape = tensor_lib_internal::_static_shape<Extents...>;
+		using _value_type = std::remove_const_t<T>;
+
+		static constexpr std::size_t Rank = _shape::rank;
+
+		T* _data;
+
+	public:
+		using value_type = _value_type;
+		using iterator = T*;
+		using const_iterator = const T*;
+		using subdimension_type = tensor_lib_internal::_static_subdimension_t<T, Extents...>;
+
+		inline constexpr explicit static_subdimension(T* data) noexcept
+			: _data{ data }
+		{
+
+		}
+
+		inline constexpr static_subdimension(const static_subdimension&) noexcept = default;
+
+		// Assignments copy elements into the viewed subdimension, they never rebind it.
+		//
+		inline constexpr auto& operator=(const static_subdimension& other) requires (!std::is_const_v<T>)
+		{
+			std::copy_n(other._data, _shape::size, _data);
+
+			return (*this);
+		}
+
+		template <typename Expression> requires (!std::is_const_v<T>) && (tensor_expression<Expression> && (Expression::rank == Rank))
+		inline constexpr auto& operator=(const Expression& expression)
+		{
+			tensor_lib_internal::_check_static_shape<Expression, Extents...>(expression);
+			tensor_lib_internal::_assign_expression(_data, expression);
+
+			return (*this);
+		}
+
+		template <typename Tensor> requires (!std::is_const_v<T>) && tensor_object<Tensor> && (!std::same_as<std::remove_cvref_t<Tensor>, static_subdimension>)
+			&& std::same_as<tensor_lib_internal::_element_type_of<std::remove_cvref_t<Tensor>>, _value_type>
+		inline constexpr auto& operator=(const Tensor& other)
+		{
+			tensor_lib_internal::_check_static_shape<Tensor, Extents...>(other);
+			std::copy_n(other.data(), _shape::size, _data);
+
+			return (*this);
+		}
+
+		inline constexpr auto operator[](const std::size_t index) const noexcept requires (Rank > 1u)
+		{
+			return subdimension_type(_data + index * _shape::strides[0]);
+		}
+
+		inline constexpr T& operator[](const std::size_t index) const noexcept requires (Rank == 1u)
+		{
+			return _data[index];
+		}
+
+		template <typename... Indices> requires (sizeof...(Indices) == Rank) && useful_concepts::integrals<Indices...>
+		inline constexpr T& operator()(const Indices ... indices) const noexcept
+		{
+			return _data[_shape::offset(indices...)];
+		}
+
+		inline constexpr iterator begin() const noexcept
+		{
+			return _data;
+		}
+
+		inline constexpr iterator end() const noexcept
+		{
+			return _data + _shape::size;
+		}
+
+		inline constexpr const_iterator cbegin() const noexcept
+		{
+			return _data;
+		}
+
+		inline constexpr const_iterator cend() const noexcept
+		{
+			return _data + _shape::size;
+		}
+
+		inline constexpr T* data() const noexcept
+		{
+			return _data;
+		}
+
+		static inline constexpr std::size_t order_of_dimension(const std::size_t index) noexcept
+		{
+			return _shape::order_of_dimension[index];
+		}
+
+		static inline constexpr std::size_t size_of_subdimension(const std::size_t index) noexcept
+		{
+			return _shape::size_of_subdimension[index];
+		}
+
+		static inline constexpr std::size_t order_of_current_dimension() noexcept
+		{
+			return _shape::order_of_dimension[0];
+		}
+
+		static inline constexpr std::size_t size_of_current_tensor() noexcept
+		{
+			return _shape::size;
+		}
+
+		static inline constexpr auto get_sizes() noexcept
+		{
+			return std::span<const std::size_t, Rank>(_shape::size_of_subdimension);
+		}
+
+		static inline constexpr auto get_ranks() noexcept
+		{
+			return std::span<const std::size_t, Rank>(_shape::order_of_dimension);
+		}
+
+		static inline constexpr bool empty() noexcept
+		{
+			return false;
+		}
+	};
+
+	// Products of static matrices are computed inline into a static matrix, without touching the heap or the GEMM kernels.
+	//
+	template <typename T, std::size_t Rows, std::size_t Depth, std::size_t Columns>
+	inline constexpr static_matrix<T, Rows, Columns> matmul(const static_matrix<T, Rows, Depth>& a, const static_matrix<T, Depth, Columns>& b) noexcept
+	{
+		static_matrix<T, Rows, Columns> result;
+
+		for (std::size_t i = 0; i < Rows; i++)
+		{
+			for (std::size_t p = 0; p < Depth; p++)
+			{
+				const T a_value = a(i, p);
+
+				for (std::size_t j = 0; j < Columns; j++)
+				{
+					result(i, j) += a_value * b(p, j);
+				}
+			}
+		}
+
+		return result;
+	}
+}
@@ -0,0 +1,476 @@
+#pragma once
+
+#include "tensor.hpp"
+#include "tensor_io.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace tensor_lib
+{
+	namespace tensor_lib_internal
+	{
+		// Thread running one task at a time in the background. wait() blocks until the task is done and rethrows what it threw,
+		// submit() waits for the previous task first.
+		//
+		class _background_worker
+		{
+		private:
+			std::mutex                  _mutex;
+			std::condition_variable     _condition;
+			std::function<void()>       _task;
+			std::exception_ptr          _exception;
+			bool                        _busy = false;
+			bool                        _stop = false;
+			std::thread                 _thread;
+
+			inline void _run()
+			{
+				std::unique_lock<std::mutex> lock(_mutex);
+
+				while (true)
+				{
+					_condition.wait(lock, [this]() { return _stop || _task; });
+
+					if (!_task)
+					{
+						return;
+					}
+
+					std::function<void()> task = std::move(_task);
+					_task = nullptr;
+					lock.unlock();
+
+					try
+					{
+						task();
+					}
+					catch (...)
+					{
+						lock.lock();
+						_exception = std::current_exception();
+						lock.unlock();
+					}
+
+					lock.lock();
+					_busy = false;
+					_condition.notify_all();
+				}
+			}
+
+		public:
+			inline _background_worker()
+				: _thread([this]() { _run(); })
+			{
+
+			}
+
+			_background_worker(const _background_worker&) = delete;
+			_background_worker& operator=(const _background_worker&) = delete;
+
+			inline void submit(std::function<void()> task)
+			{
+				wait();
+
+				std::lock_guard<std::mutex> lock(_mutex);
+				_task = std::move(task);
+				_busy = true;
+				_condition.notify_all();
+			}
+
+			inline void wait()
+			{
+				std::unique_lock<std::mutex> lock(_mutex);
+				_condition.wait(lock, [this]() { return !_busy; });
+
+				if (_exception)
+				{
+					std::rethrow_exception(std::exchange(_exception, nullptr));
+				}
+			}
+
+			inline ~_background_worker()
+			{
+				{
+					std::unique_lock<std::mutex> lock(_mutex);
+					_condition.wait(lock, [this]() { return !_busy; });
+					_stop = true;
+					_condition.notify_all();
+				}
+
+				_thread.join();
+			}
+		};
+	}
+
+	// Reads a tensor file (see "tensor_io.hpp") one slab of 'slab_rows' rows of the first dimension at a time, so tensors larger
+	// than memory are processed with two slabs worth of it:
+	//
+	//	for (auto slab : tensor_stream<float, 2>("features.tnsr", 4096))
+	//		total += sum(slab);
+	//
+	// Each slab is a subdimension of rank Rank into one of two reusable buffers, the last one may have fewer rows. While a slab is
+	// processed the next one is read into the other buffer by a background thread, so a slab is only valid until the iterator
+	// is incremented. A tensor_stream is an input range, it can be iterated once.
+	//
+	template <typename T, std::size_t Rank> requires (Rank != 0u) && std::is_trivially_copyable_v<T>
+	class tensor_stream
+	{
+	private:
+		std::ifstream                       _file;
+		std::array<std::size_t, Rank>       _order_of_dimension{};
+		std::endian                         _byte_order = std::endian::native;
+		std::size_t                         _slab_rows = 0;
+		std::array<tensor<T, Rank>, 2>      _buffers;
+		std::size_t                         _current = 1;
+		std::size_t                         _current_row = 0;
+		std::size_t                         _next_row = 0;
+		std::size_t                         _prefetched_row = 0;
+		bool                                _pending = false;
+		bool                                _finished = false;
+		tensor_lib_internal::_background_worker _worker;
+
+		// Starts reading the slab after the last one requested into the buffer that isn't current.
+		//
+		inline void _prefetch()
+		{
+			if (_next_row >= _order_of_dimension[0])
+			{
+				return;
+			}
+
+			const std::size_t rows = std::min(_slab_rows, _order_of_dimension[0] - _next_row);
+			tensor<T, Rank>& buffer = _buffers[1 - _current];
+
+			if (buffer.order_of_dimension(0) != rows)
+			{
+				std::apply([&buffer, rows](const auto, const auto ... sizes) { buffer.resize_preserve(rows, sizes...); }, _order_of_dimension);
+			}
+
+			_prefetched_row = _next_row;
+			_next_row += rows;
+			_pending = true;
+
+			_worker.submit([this, &buffer]()
+			{
+				const std::size_t size = buffer.size_of_current_tensor();
+
+				if (!_file.read(reinterpret_cast<char*>(buffer.data()), static_cast<std::streamsize>(size * sizeof(T))))
+				{
+					throw std::runtime_error("Unexpected end of the tensor file!");
+				}
+
+				if (_byte_order != std::endian::native)
+				{
+					tensor_lib_internal::_byteswap_n(buffer.data(), size);
+				}
+			});
+		}
+
+		inline void _advance()
+		{
+			if (!_pending)
+			{
+				_finished = true;
+				return;
+			}
+
+			_worker.wait();
+
+			_current = 1 - _current;
+			_current_row = _prefetched_row;
+			_pending = false;
+
+			_prefetch();
+		}
+
+	public:
+		class iterator
+		{
+		private:
+			tensor_stream* _stream = nullptr;
+
+		public:
+			using iterator_concept = std::input_iterator_tag;
+			using value_type = subdimension<T, Rank>;
+			using difference_type = std::ptrdiff_t;
+
+			inline iterator() noexcept = default;
+
+			inline explicit iterator(tensor_stream* stream) noexcept
+				: _stream{ stream }
+			{
+
+			}
+
+			inline subdimension<T, Rank> operator*() const noexcept
+			{
+				return subdimension<T, Rank>(_stream->_buffers[_stream->_current]);
+			}
+
+			inline iterator& operator++()
+			{
+				_stream->_advance();
+				return *this;
+			}
+
+			inline void operator++(int)
+			{
+				++*this;
+			}
+
+			inline bool operator==(std::default_sentinel_t) const noexcept
+			{
+				return _stream->_finished;
+			}
+		};
+
+		// Opens a tensor file whose rank and element type must match and starts reading the first slab.
+		//
+		inline tensor_stream(const std::filesystem::path& path, const std::size_t slab_rows)
+			: _file(path, std::ios::binary)
+			, _slab_rows{ slab_rows }
+		{
+			if (!_file)
+			{
+				throw std::runtime_error("Can't open the tensor file for reading!");
+			}
+
+			if (slab_rows == 0)
+			{
+				throw std::runtime_error("Slabs must have at least one row!");
+			}
+
+			const tensor_file_header header = read_tensor_header(_file);
+			tensor_lib_internal::_check_tensor_file_header<T, Rank>(header);
+
+			std::copy_n(header.order_of_dimension.begin(), Rank, _order_of_dimension.begin());
+			_byte_order = header.byte_order;
+
+			if (header.size() == 0)
+			{
+				_order_of_dimension[0] = 0;
+			}
+
+			_prefetch();
+		}
+
+		tensor_stream(const tensor_stream&) = delete;
+		tensor_stream& operator=(const tensor_stream&) = delete;
+
+		// Waits for the first slab, the stream can only be iterated once.
+		//
+		inline iterator begin()
+		{
+			_advance();
+			return iterator(this);
+		}
+
+		inline std::default_sentinel_t end() const noexcept
+		{
+			return std::default_sentinel;
+		}
+
+		// Index along the first dimension of the first row of the current slab.
+		//
+		inline std::size_t current_row() const noexcept
+		{
+			return _current_row;
+		}
+
+		// Sizes of the whole tensor in the file.
+		//
+		inline auto get_ranks() const noexcept
+		{
+			return std::span<const std::size_t, Rank>(_order_of_dimension);
+		}
+
+		inline std::size_t slab_rows() const noexcept
+		{
+			return _slab_rows;
+		}
+	};
+
+	// Writes a tensor file one slab at a time, without knowing the size of the first dimension in advance. slab() is a subdimension
+	// of 'slab_rows' rows into a free buffer, commit(rows) hands its first rows to a background thread for writing and makes the other
+	// buffer the free one, so filling a slab overlaps with writing the previous one:
+	//
+	//	tensor_stream_writer<float, 2> out("features.tnsr", 4096, columns);
+	//	while (...)
+	//	{
+	//		auto slab = out.slab();
+	//		const std::size_t rows = fill(slab);
+	//		out.commit(rows);
+	//	}
+	//	out.close();
+	//
+	// close() (or the destructor) waits for the last write and stores the final size of the first dimension in the header.
+	//
+	template <typename T, std::size_t Rank> requires (Rank != 0u) && std::is_trivially_copyable_v<T>
+	class tensor_stream_writer
+	{
+	private:
+		std::ofstream                       _file;
+		std::array<std::size_t, Rank>       _order_of_dimension{};
+		std::size_t                         _slab_rows = 0;
+		std::array<tensor<T, Rank>, 2>      _buffers;
+		std::size_t                         _current = 0;
+		bool                                _closed = false;
+		tensor_lib_internal::_background_worker _worker;
+
+		// The header of the rows committed so far.
+		//
+		inline tensor_file_header _header() const
+		{
+			tensor_file_header header;
+			header.type = dtype_of_v<T>;
+			header.element_size = sizeof(T);
+			header.order_of_dimension.assign(_order_of_dimension.begin(), _order_of_dimension.end());
+
+			return header;
+		}
+
+	public:
+		template <typename... Sizes> requires (sizeof...(Sizes) == Rank - 1) && useful_concepts::integrals<Sizes...>
+		inline tensor_stream_writer(const std::filesystem::path& path, const std::size_t slab_rows, const Sizes ... sizes)
+			: _file(path, std::ios::binary | std::ios::trunc)
+			, _order_of_dimension{ 0, static_cast<std::size_t>(sizes)... }
+			, _slab_rows{ slab_rows }
+			, _buffers{ tensor<T, Rank>(slab_rows, sizes...), tensor<T, Rank>(slab_rows, sizes...) }
+		{
+			if (!_file)
+			{
+				throw std::runtime_error("Can't open the tensor file for writing!");
+			}
+
+			if (slab_rows == 0 || !(sizes && ...))
+			{
+				throw std::runtime_error("Slabs must have at least one element!");
+			}
+
+			write_tensor_header(_file, _header());
+		}
+
+		tensor_stream_writer(const tensor_stream_writer&) = delete;
+		tensor_stream_writer& operator=(const tensor_stream_writer&) = delete;
+
+		// The free buffer, valid until the next commit().
+		//
+		inline subdimension<T, Rank> slab() noexcept
+		{
+			return subdimension<T, Rank>(_buffers[_current]);
+		}
+
+		// Writes the first 'rows' rows of slab() in the background.
+		//
+		inline void commit(const std::size_t rows)
+		{
+			if (_closed)
+			{
+				throw std::runtime_error("Can't write to a closed tensor stream!");
+			}
+
+			if (rows > _slab_rows)
+			{
+				throw std::runtime_error("Can't commit more rows than a slab holds!");
+			}
+
+			const T* data = _buffers[_current].data();
+			const std::size_t bytes = rows * _buffers[_current].size_of_subdimension(0) / _slab_rows * sizeof(T);
+
+			// Waits for the write of the other buffer, which becomes the free one.
+			//
+			_worker.submit([this, data, bytes]()
+			{
+				if (!_file.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(bytes)))
+				{
+					throw std::runtime_error("Failed to write the tensor file!");
+				}
+			});
+
+			_order_of_dimension[0] += rows;
+			_current = 1 - _current;
+		}
+
+		// Writes the rows of a tensor object of rank Rank whose trailing sizes match, through the slab buffers.
+		//
+		template <typename Tensor> requires tensor_object<Tensor>
+			&& (decltype(std::declval<const Tensor&>().get_ranks())::extent == Rank)
+			&& std::same_as<std::remove_cvref_t<decltype(*std::declval<const Tensor&>().data())>, T>
+		inline void write(const Tensor& rows)
+		{
+			const auto ranks = rows.get_ranks();
+
+			if (!std::equal(ranks.begin() + 1, ranks.end(), _order_of_dimension.begin() + 1))
+			{
+				throw std::runtime_error("Can't write rows of a different size to a tensor stream!");
+			}
+
+			const std::size_t row_size = _buffers[_current].size_of_subdimension(0) / _slab_rows;
+
+			for (std::size_t row = 0; row < ranks[0]; row += _slab_rows)
+			{
+				const std::size_t count = std::min(_slab_rows, ranks[0] - row);
+
+				tensor_lib_internal::_copy_n(rows.data() + row * row_size, count * row_size, _buffers[_current].data());
+				commit(count);
+			}
+		}
+
+		// Number of rows committed so far.
+		//
+		inline std::size_t rows() const noexcept
+		{
+			return _order_of_dimension[0];
+		}
+
+		inline void close()
+		{
+			if (_closed)
+			{
+				return;
+			}
+
+			_closed = true;
+			_worker.wait();
+
+			// Same rank, so the header has the same size and only the first dimension changes.
+			//
+			_file.seekp(0);
+			write_tensor_header(_file, _header());
+			_file.close();
+
+			if (!_file)
+			{
+				throw std::runtime_error("Failed to write the tensor file!");
+			}
+		}
+
+		inline ~tensor_stream_writer()
+		{
+			try
+			{
+				close();
+			}
+			catch (...)
+			{
+
+			}
+		}
+	};
+}
@@ -0,0 +1,360 @@
+#pragma once
+
+#include "tensor.hpp"
+#include "tensor_execution.hpp"
+#include "tensor_layout.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+namespace tensor_lib
+{
+	// Tiled storage: layout_tiled<8, 8> stores a matrix as 8x8 tiles and layout_tiled<16, 16, 16> a volume as 16x16x16 tiles.
+	// Each tile is a dense row-major block and the tiles follow each other in row-major order, so the neighbours of an element
+	// in every direction are usually in the same few cache lines, where a row-major buffer puts the next row (or plane) a whole row
+	// (or plane) away. Tiles on the far edges are cut to the sizes of the tensor and stored just as densely, the buffer has no padding.
+	//
+	// t.tiles() goes over the tiles in storage order. Each tile is a tensor_tile, a row-major tensor object over its own elements,
+	// so expressions, reductions, matmul and views work on it unchanged, and for_each_tile() runs a kernel on every tile, in parallel if asked.
+	//
+	template <std::size_t... TileExtents> requires (sizeof...(TileExtents) != 0u) && ((TileExtents != 0u) && ...)
+	struct layout_tiled
+	{
+		template <std::size_t Rank>
+		class mapping
+		{
+			static_assert(Rank == sizeof...(TileExtents), "layout_tiled needs one tile size for each dimension.");
+
+		private:
+			static constexpr std::array<std::size_t, Rank> _tile_extents{ TileExtents... };
+
+			std::array<std::size_t, Rank> _extents{};
+
+			// Number of tiles along each dimension.
+			//
+			std::array<std::size_t, Rank> _tiles{};
+
+			// Number of elements of the tensor after one step along each dimension, with every following dimension whole.
+			//
+			std::array<std::size_t, Rank> _trailing{};
+
+			std::size_t _size = 0;
+
+			// Sizes of the tile starting at 'origin', the last tile along a dimension may be cut short.
+			//
+			inline constexpr std::size_t _tile_extent(const std::size_t axis, const std::size_t origin) const noexcept
+			{
+				return std::min(_tile_extents[axis], _extents[axis] - origin);
+			}
+
+			// Offset of the first element of the tile with the given indices. Tiles before it along the first dimension are slabs
+			// of whole trailing dimensions, within the slab tiles before it along the second dimension are slabs as tall as the tile, and so on.
+			//
+			inline constexpr std::size_t _tile_offset(const std::array<std::size_t, Rank>& origin) const noexcept
+			{
+				std::size_t offset = 0;
+				std::size_t leading = 1;
+
+				for (std::size_t axis = 0; axis < Rank; axis++)
+				{
+					offset += origin[axis] * leading * _trailing[axis];
+					leading *= _tile_extent(axis, origin[axis]);
+				}
+
+				return offset;
+			}
+
+		public:
+			inline constexpr mapping() noexcept = default;
+
+			inline constexpr explicit mapping(const std::array<std::size_t, Rank>& extents) noexcept
+				: _extents{ extents }
+			{
+				std::size_t trailing = 1;
+
+				for (std::size_t axis = Rank; axis > 0; axis--)
+				{
+					_trailing[axis - 1] = trailing;
+					_tiles[axis - 1] = (_extents[axis - 1] + _tile_extents[axis - 1] - 1) / _tile_extents[axis - 1];
+					trailing *= _extents[axis - 1];
+				}
+
+				_size = trailing;
+			}
+
+			inline constexpr const std::array<std::size_t, Rank>& extents() const noexcept
+			{
+				return _extents;
+			}
+
+			inline constexpr std::size_t required_span_size() const noexcept
+			{
+				return _size;
+			}
+
+			template <typename... Indices> requires (sizeof...(Indices) == Rank) && useful_concepts::integrals<Indices...>
+			inline constexpr std::size_t operator() (const Indices ... indices) const noexcept
+			{
+				const std::array<std::size_t, Rank> index{ static_cast<std::size_t>(indices)... };
+
+				std::size_t offset = 0;
+				std::size_t leading = 1;
+				std::size_t within = 0;
+
+				for (std::size_t axis = 0; axis < Rank; axis++)
+				{
+					const std::size_t origin = index[axis] - index[axis] % _tile_extents[axis];
+					const std::size_t extent = _tile_extent(axis, origin);
+
+					offset += origin * leading * _trailing[axis];
+					leading *= extent;
+					within = within * extent + (index[axis] - origin);
+				}
+
+				return offset + within;
+			}
+
+			inline constexpr std::size_t tile_count() const noexcept
+			{
+				std::size_t count = 1;
+
+				for (const std::size_t tiles : _tiles)
+				{
+					count *= tiles;
+				}
+
+				return count;
+			}
+
+			// The tile numbered 'index' in storage order.
+			//
+			inline constexpr tensor_lib_internal::_tile_geometry<Rank> tile(std::size_t index) const noexcept
+			{
+				tensor_lib_internal::_tile_geometry<Rank> geometry;
+
+				for (std::size_t axis = Rank; axis > 0; axis--)
+				{
+					geometry.origin[axis - 1] = (index % _tiles[axis - 1]) * _tile_extents[axis - 1];
+					index /= _tiles[axis - 1];
+				}
+
+				for (std::size_t axis = 0; axis < Rank; axis++)
+				{
+					geometry.extents[axis] = _tile_extent(axis, geometry.origin[axis]);
+				}
+
+				geometry.offset = _tile_offset(geometry.origin);
+
+				return geometry;
+			}
+		};
+	};
+
+	template <typename T, std::size_t TileRows = 16, std::size_t TileColumns = 16, typename allocator_type = std::allocator<T>>
+	using tiled_matrix = tensor<T, 2, allocator_type, layout_tiled<TileRows, TileColumns>>;
+
+	template <typename T, std::size_t TileDepth = 16, std::size_t TileRows = 16, std::size_t TileColumns = 16, typename allocator_type = std::allocator<T>>
+	using tiled_cube = tensor<T, 3, allocator_type, layout_tiled<TileDepth, TileRows, TileColumns>>;
+
+	// One tile of a tiled tensor: a subdimension (View) over its elements, which knows the indices of its first element in the tensor.
+	// tile[i][j] is the element at (origin(0) + i, origin(1) + j) of the tensor.
+	//
+	template <typename View>
+	class tensor_tile : public reshaped_view<View>
+	{
+		static constexpr std::size_t Rank = tensor_lib_internal::_subdimension_rank<View>::value;
+
+	private:
+		std::array<std::size_t, Rank> _origin;
+
+	public:
+		using reshaped_view<View>::operator=;
+
+		template <typename Data>
+		inline constexpr tensor_tile(const Data data, const tensor_lib_internal::_tile_geometry<Rank>& geometry) noexcept
+			: reshaped_view<View>(data, geometry.extents)
+			, _origin{ geometry.origin }
+		{
+
+		}
+
+		inline constexpr const std::array<std::size_t, Rank>& origin() const noexcept
+		{
+			return _origin;
+		}
+
+		inline constexpr std::size_t origin(const std::size_t axis) const noexcept
+		{
+			return _origin[axis];
+		}
+	};
+
+	template <typename View>
+	struct is_tensor_object <tensor_tile<View>> : std::true_type {};
+
+	namespace tensor_lib_internal
+	{
+		// Where the tiles of a tensor are described: the mapping of a tiled layout, or the block index of a block sparse matrix.
+		//
+		template <typename Tensor>
+		inline constexpr decltype(auto) _tiling_of(Tensor& tsor) noexcept
+		{
+			if constexpr (requires { tsor.block_index(); })
+			{
+				return tsor.block_index();
+			}
+			else
+			{
+				return tsor.mapping();
+			}
+		}
+
+		// What tensor::tiles() returns, the tiles of a tiled tensor (const for a const tensor) by their number in storage order.
+		//
+		template <typename Tensor>
+		class _tile_range
+		{
+		private:
+			using element_type = std::remove_reference_t<decltype(*std::declval<Tensor&>().data())>;
+			using value_type = std::remove_const_t<element_type>;
+
+			static constexpr std::size_t rank = decltype(std::declval<const Tensor&>().get_ranks())::extent;
+
+			using view_type = std::conditional_t<std::is_const_v<element_type>, const_subdimension<value_type, rank>, subdimension<value_type, rank>>;
+
+			Tensor* _tensor;
+
+		public:
+			using tile_type = tensor_tile<view_type>;
+
+			class iterator
+			{
+			private:
+				const _tile_range* _range = nullptr;
+				std::size_t _index = 0;
+
+			public:
+				using iterator_category = std::input_iterator_tag;
+				using iterator_concept = std::forward_iterator_tag;
+				using value_type = tile_type;
+				using difference_type = std::ptrdiff_t;
+
+				inline constexpr iterator() noexcept = default;
+
+				inline constexpr iterator(const _tile_range* range, const std::size_t index) noexcept
+					: _range{ range }
+					, _index{ index }
+				{
+
+				}
+
+				inline constexpr tile_type operator* () const noexcept
+				{
+					return (*_range)[_index];
+				}
+
+				inline constexpr iterator& operator++ () noexcept
+				{
+					++_index;
+					return *this;
+				}
+
+				inline constexpr iterator operator++ (int) noexcept
+				{
+					iterator previous = *this;
+					++_index;
+					return previous;
+				}
+
+				inline constexpr bool operator== (const iterator& other) const noexcept
+				{
+					return _index == other._index;
+				}
+			};
+
+			inline constexpr explicit _tile_range(Tensor& tsor) noexcept
+				: _tensor{ &tsor }
+			{
+
+			}
+
+			inline constexpr std::size_t size() const noexcept
+			{
+				return _tiling_of(*_tensor).tile_count();
+			}
+
+			inline constexpr tile_type operator[] (const std::size_t index) const noexcept
+			{
+				const auto geometry = _tiling_of(*_tensor).tile(index);
+
+				std::size_t count = 1;
+
+				for (const std::size_t extent : geometry.extents)
+				{
+					count *= extent;
+				}
+
+				return tile_type(std::span<element_type>(_tensor->data() + geometry.offset, count), geometry);
+			}
+
+			inline constexpr iterator begin() const noexcept
+			{
+				return iterator(this, 0);
+			}
+
+			inline constexpr iterator end() const noexcept
+			{
+				return iterator(this, size());
+			}
+		};
+	}
+
+	// Calls function(tile) for every tile of a tiled tensor. With a parallel policy the tiles are shared among the threads of the pool,
+	// tiles are disjoint so 'function' may write to its own tile freely.
+	//
+	template <typename Tensor, typename Function> requires requires (Tensor& tsor) { tsor.tiles(); }
+	inline void for_each_tile(Tensor& tsor, Function&& function)
+	{
+		for (auto tile : tsor.tiles())
+		{
+			function(tile);
+		}
+	}
+
+	template <typename Policy, typename Tensor, typename Function> requires execution::execution_policy<Policy> && requires (Tensor& tsor) { tsor.tiles(); }
+	inline void for_each_tile(const Policy&, Tensor& tsor, const Function& function)
+	{
+		const auto tiles = tsor.tiles();
+
+		if constexpr (!execution::is_parallel_policy_v<std::remove_cvref_t<Policy>>)
+		{
+			for (auto tile : tiles)
+			{
+				function(tile);
+			}
+		}
+		else
+		{
+			if (tiles.size() == 0)
+			{
+				return;
+			}
+
+			const std::size_t grain = std::max<std::size_t>(1, execution::grain_size() / std::max<std::size_t>(1, tiles[0].size_of_current_tensor()));
+
+			execution::default_pool().parallel_for(tiles.size(), grain, [&tiles, &function](const std::size_t first, const std::size_t last)
+			{
+				for (std::size_t index = first; index < last; index++)
+				{
+					auto tile = tiles[index];
+					function(tile);
+				}
+			});
+		}
+	}
+}
@@ -0,0 +1,522 @@
+#pragma once
+
+#include "tensor.hpp"
+#include "tensor_expressions.hpp"
+#include "tensor_kernels.hpp"
+#include "tensor_layout.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace tensor_lib
+{
+	// Non-owning view of the elements of a tensor object with an explicit extent and stride (in elements) for each axis.
+	// Unlike a subdimension it can describe any strided layout, so transposes, permutations, slices with a step and diagonals
+	// all refer to the original buffer instead of copying it. Views of const tensor objects are views of const elements.
+	//
+	// The viewed tensor has to outlive the view, and resizing it invalidates the view.
+	//
+	template <typename T, std::size_t Rank> requires (Rank != 0u)
+	class tensor_view
+	{
+	private:
+		T*                                  _data;
+		std::array<std::size_t, Rank>       _extents;
+		std::array<std::size_t, Rank>       _strides;
+
+		// Calls function(first, stride, count) for every run of elements along the last axis, in row-major order.
+		// A dense view is a single run.
+		//
+		template <typename Function>
+		inline constexpr void _for_each_run(const Function& function) const
+		{
+			if (empty())
+			{
+				return;
+			}
+
+			if (is_contiguous())
+			{
+				function(_data, std::size_t{ 1 }, size());
+				return;
+			}
+
+			std::array<std::size_t, Rank> index{};
+			T* first = _data;
+
+			while (true)
+			{
+				function(first, _strides[Rank - 1], _extents[Rank - 1]);
+
+				std::size_t axis = Rank - 1;
+
+				while (true)
+				{
+					if (axis == 0)
+					{
+						return;
+					}
+
+					--axis;
+
+					if (++index[axis] < _extents[axis])
+					{
+						first += _strides[axis];
+						break;
+					}
+
+					first -= (_extents[axis] - 1) * _strides[axis];
+					index[axis] = 0;
+				}
+			}
+		}
+
+	public:
+		using value_type = std::remove_const_t<T>;
+		using element_type = T;
+
+		// Walks the elements of the view in row-major order. Iterators point into the view they come from, so it has to outlive them.
+		//
+		class iterator
+		{
+		private:
+			const tensor_view*                  _view;
+			T*                                  _current;
+			std::array<std::size_t, Rank>       _index;
+			std::size_t                         _position;
+
+		public:
+			using iterator_category = std::forward_iterator_tag;
+			using value_type = std::remove_const_t<T>;
+			using difference_type = std::ptrdiff_t;
+			using pointer = T*;
+			using reference = T&;
+
+			inline constexpr iterator() noexcept
+				: _view{ nullptr }
+				, _current{ nullptr }
+				, _index{}
+				, _position{ 0 }
+			{
+
+			}
+
+			inline constexpr iterator(const tensor_view* view, const std::size_t position) noexcept
+				: _view{ view }
+				, _current{ view->_data }
+				, _index{}
+				, _position{ position }
+			{
+
+			}
+
+			inline constexpr reference operator*() const noexcept
+			{
+				return *_current;
+			}
+
+			inline constexpr pointer operator->() const noexcept
+			{
+				return _current;
+			}
+
+			inline constexpr iterator& operator++() noexcept
+			{
+				++_position;
+
+				for (std::size_t axis = Rank; axis-- > 0;)
+				{
+					if (++_index[axis] < _view->_extents[axis])
+					{
+						_current += _view->_strides[axis];
+						return *this;
+					}
+
+					_current -= (_view->_extents[axis] - 1) * _view->_strides[axis];
+					_index[axis] = 0;
+				}
+
+				return *this;
+			}
+
+			inline constexpr iterator operator++(int) noexcept
+			{
+				iterator temp = *this;
+				++(*this);
+				return temp;
+			}
+
+			inline constexpr bool operator==(const iterator& other) const noexcept
+			{
+				return _position == other._position;
+			}
+		};
+
+		inline constexpr tensor_view() noexcept
+			: _data{ nullptr }
+			, _extents{}
+			, _strides{}
+		{
+
+		}
+
+		inline constexpr tensor_view(T* data, const std::array<std::size_t, Rank>& extents, const std::array<std::size_t, Rank>& strides) noexcept
+			: _data{ data }
+			, _extents{ extents }
+			, _strides{ strides }
+		{
+
+		}
+
+		// A dense view of a tensor, subdimension or const_subdimension.
+		//
+		template <typename Tensor> requires tensor_object<Tensor> && (tensor_lib_internal::_rank_of<std::remove_cvref_t<Tensor>> == Rank)
+			&& std::is_convertible_v<decltype(std::declval<Tensor&>().data()), T*>
+		inline constexpr tensor_view(Tensor& tsor) noexcept
+			: _data{ tsor.data() }
+			, _extents{}
+			, _strides{}
+		{
+			for (std::size_t axis = 0; axis < Rank; axis++)
+			{
+				_extents[axis] = tsor.order_of_dimension(axis);
+				_strides[axis] = (axis + 1 < Rank) ? tsor.size_of_subdimension(axis + 1) : 1;
+			}
+		}
+
+		template <typename U> requires (!std::is_same_v<U, T>) && std::is_convertible_v<U*, T*>
+		inline constexpr tensor_view(const tensor_view<U, Rank>& other) noexcept
+			: _data{ other.data() }
+			, _extents{ other.extents() }
+			, _strides{ other.strides() }
+		{
+
+		}
+
+		inline constexpr std::size_t extent(const std::size_t axis) const noexcept
+		{
+			return _extents[axis];
+		}
+
+		inline constexpr std::size_t stride(const std::size_t axis) const noexcept
+		{
+			return _strides[axis];
+		}
+
+		inline constexpr const std::array<std::size_t, Rank>& extents() const noexcept
+		{
+			return _extents;
+		}
+
+		inline constexpr const std::array<std::size_t, Rank>& strides() const noexcept
+		{
+			return _strides;
+		}
+
+		inline constexpr std::size_t size() const noexcept
+		{
+			std::size_t size = 1;
+
+			for (const auto extent : _extents)
+			{
+				size *= extent;
+			}
+
+			return size;
+		}
+
+		inline constexpr bool empty() const noexcept
+		{
+			return size() == 0;
+		}
+
+		// Pointer to the first element of the view. Only the elements reachable through the strides belong to it.
+		//
+		inline constexpr T* data() const noexcept
+		{
+			return _data;
+		}
+
+		// True when the elements form one row-major contiguous block starting at data(), so they can be handed to the contiguous kernels.
+		// Axes of extent 1 don't affect the layout, their strides are ignored.
+		//
+		inline constexpr bool is_contiguous() const noexcept
+		{
+			std::size_t expected = 1;
+
+			for (std::size_t axis = Rank; axis-- > 0;)
+			{
+				if (_extents[axis] != 1 && _strides[axis] != expected)
+				{
+					return false;
+				}
+
+				expected *= _extents[axis];
+			}
+
+			return true;
+		}
+
+		template <typename... Indices> requires (sizeof...(Indices) == Rank) && useful_concepts::integrals<Indices...>
+		inline constexpr T& operator()(const Indices ... indices) const noexcept
+		{
+			const std::array<std::size_t, Rank> index{ static_cast<std::size_t>(indices)... };
+			std::size_t offset = 0;
+
+			for (std::size_t axis = 0; axis < Rank; axis++)
+			{
+				offset += index[axis] * _strides[axis];
+			}
+
+			return _data[offset];
+		}
+
+		inline constexpr auto operator[](const std::size_t index) const noexcept requires (Rank > 1u)
+		{
+			std::array<std::size_t, Rank - 1> extents, strides;
+
+			std::copy_n(_extents.begin() + 1, Rank - 1, extents.begin());
+			std::copy_n(_strides.begin() + 1, Rank - 1, strides.begin());
+
+			return tensor_view<T, Rank - 1>(_data + index * _strides[0], extents, strides);
+		}
+
+		inline constexpr T& operator[](const std::size_t index) const noexcept requires (Rank == 1u)
+		{
+			return _data[index * _strides[0]];
+		}
+
+		inline constexpr iterator begin() const noexcept
+		{
+			return iterator(this, 0);
+		}
+
+		inline constexpr iterator end() const noexcept
+		{
+			return iterator(this, size());
+		}
+
+		// Reverses the order of the axes (the transpose of a matrix).
+		//
+		inline constexpr tensor_view transpose() const noexcept
+		{
+			tensor_view result = *this;
+
+			std::reverse(result._extents.begin(), result._extents.end());
+			std::reverse(result._strides.begin(), result._strides.end());
+
+			return result;
+		}
+
+		// Axis i of the result is axis Axes[i] of this view (ex: permute<1, 0, 2>() swaps the first two axes).
+		//
+		template <std::size_t... Axes> requires (sizeof...(Axes) == Rank)
+		inline constexpr tensor_view permute() const noexcept
+		{
+			static_assert([]()
+			{
+				std::array<bool, Rank> used{};
+				for (const std::size_t axis : { Axes... })
+				{
+					if (axis >= Rank || used[axis])
+						return false;
+					used[axis] = true;
+				}
+				return true;
+			}(), "permute() needs every axis exactly once.");
+
+			return tensor_view(_data, { _extents[Axes]... }, { _strides[Axes]... });
+		}
+
+		// Elements begin, begin + step, ... (up to, but without, end) along 'axis'.
+		//
+		inline constexpr tensor_view slice(const std::size_t axis, const std::size_t begin, const std::size_t end, const std::size_t step = 1) const
+		{
+			if (axis >= Rank || begin > end || end > _extents[axis] || step == 0)
+			{
+				throw std::runtime_error("Slice is out of range!");
+			}
+
+			tensor_view result = *this;
+
+			result._extents[axis] = (end - begin + step - 1) / step;
+
+			if (result._extents[axis] != 0)
+			{
+				result._data += begin * _strides[axis];
+				result._strides[axis] *= step;
+			}
+
+			return result;
+		}
+
+		inline constexpr tensor_view<T, 1> diagonal() const noexcept requires (Rank == 2u)
+		{
+			return tensor_view<T, 1>(_data, { std::min(_extents[0], _extents[1]) }, { _strides[0] + _strides[1] });
+		}
+
+		inline constexpr void fill(const value_type& value) const requires (!std::is_const_v<T>)
+		{
+			_for_each_run([&value](T* first, const std::size_t stride, const std::size_t count)
+			{
+				if (stride == 1)
+				{
+					kernels::fill(first, count, value);
+					return;
+				}
+
+				for (std::size_t index = 0; index < count; index++)
+				{
+					first[index * stride] = value;
+				}
+			});
+		}
+
+		// Copies the elements of 'source', a tensor object or a view of the same shape, into the viewed elements.
+		// Source and view may not overlap.
+		//
+		template <typename Source> requires (!std::is_const_v<T>)
+		inline constexpr void assign(const Source& source) const
+		{
+			const tensor_view<const value_type, Rank> source_view(source);
+
+			if (source_view.extents() != _extents)
+			{
+				throw std::runtime_error("Size of the source doesn't match size of view!");
+			}
+
+			if (source_view.is_contiguous())
+			{
+				const value_type* next = source_view.data();
+
+				_for_each_run([&next](T* first, const std::size_t stride, const std::size_t count)
+				{
+					if (stride == 1)
+					{
+						tensor_lib_internal::_copy_n(next, count, first);
+					}
+					else
+					{
+						for (std::size_t index = 0; index < count; index++)
+						{
+							first[index * stride] = next[index];
+						}
+					}
+
+					next += count;
+				});
+			}
+			else
+			{
+				auto next = source_view.begin();
+
+				_for_each_run([&next](T* first, const std::size_t stride, const std::size_t count)
+				{
+					for (std::size_t index = 0; index < count; index++, ++next)
+					{
+						first[index * stride] = *next;
+					}
+				});
+			}
+		}
+
+		// Copies the viewed elements into a new, dense tensor.
+		//
+		inline constexpr tensor<value_type, Rank> to_tensor() const
+		{
+			auto result = std::apply([](const auto ... extents) { return tensor<value_type, Rank>(extents...); }, _extents);
+			value_type* next = result.data();
+
+			_for_each_run([&next](T* first, const std::size_t stride, const std::size_t count)
+			{
+				if (stride == 1)
+				{
+					tensor_lib_internal::_copy_n(static_cast<const value_type*>(first), count, next);
+				}
+				else
+				{
+					for (std::size_t index = 0; index < count; index++)
+					{
+						next[index] = first[index * stride];
+					}
+				}
+
+				next += count;
+			});
+
+			return result;
+		}
+	};
+
+	namespace tensor_lib_internal
+	{
+		template <typename Tensor>
+		using _view_of = tensor_view<std::remove_pointer_t<decltype(std::declval<Tensor&>().data())>, _rank_of<std::remove_cvref_t<Tensor>>>;
+	}
+
+	// Dense view of a tensor object, the starting point of the strided views below.
+	//
+	template <typename Tensor> requires tensor_object<Tensor>
+	inline constexpr auto view(Tensor&& tsor) noexcept
+	{
+		return tensor_lib_internal::_view_of<Tensor>(tsor);
+	}
+
+	// View of a tensor with another strided layout (ex: layout_left), with the strides of its layout.
+	//
+	template <typename T, std::size_t Rank, typename allocator_type, typename Layout> requires (!std::same_as<Layout, layout_right>) && strided_layout_policy<Layout, Rank>
+	inline constexpr tensor_view<T, Rank> view(tensor<T, Rank, allocator_type, Layout>& tsor) noexcept
+	{
+		std::array<std::size_t, Rank> strides;
+
+		for (std::size_t axis = 0; axis < Rank; axis++)
+		{
+			strides[axis] = tsor.stride(axis);
+		}
+
+		return tensor_view<T, Rank>(tsor.data(), tsor.mapping().extents(), strides);
+	}
+
+	template <typename T, std::size_t Rank, typename allocator_type, typename Layout> requires (!std::same_as<Layout, layout_right>) && strided_layout_policy<Layout, Rank>
+	inline constexpr tensor_view<const T, Rank> view(const tensor<T, Rank, allocator_type, Layout>& tsor) noexcept
+	{
+		std::array<std::size_t, Rank> strides;
+
+		for (std::size_t axis = 0; axis < Rank; axis++)
+		{
+			strides[axis] = tsor.stride(axis);
+		}
+
+		return tensor_view<const T, Rank>(tsor.data(), tsor.mapping().extents(), strides);
+	}
+
+	template <typename Tensor> requires tensor_object<Tensor>
+	inline constexpr auto transpose(Tensor&& tsor) noexcept
+	{
+		return view(tsor).transpose();
+	}
+
+	template <std::size_t... Axes, typename Tensor> requires tensor_object<Tensor>
+	inline constexpr auto permute(Tensor&& tsor) noexcept
+	{
+		return view(tsor).template permute<Axes...>();
+	}
+
+	template <typename Tensor> requires tensor_object<Tensor>
+	inline constexpr auto slice(Tensor&& tsor, const std::size_t axis, const std::size_t begin, const std::size_t end, const std::size_t step = 1)
+	{
+		return view(tsor).slice(axis, begin, end, step);
+	}
+
+	template <typename Tensor> requires tensor_object<Tensor> && (tensor_lib_internal::_rank_of<std::remove_cvref_t<Tensor>> == 2u)
+	inline constexpr auto diagonal(Tensor&& tsor) noexcept
+	{
+		return view(tsor).diagonal();
+	}
+}
@@ -1,9 +1,32 @@
 #pragma once
 
 #include "../../../inc/tensor.hpp"
-
+#include "../../../inc/tensor_allocators.hpp"
+#include "../../../inc/tensor_block_sparse.hpp"
+#include "../../../inc/tensor_einsum.hpp"
+#include "../../../inc/tensor_expressions.hpp"
+#include "../../../inc/tensor_io.hpp"
+#include "../../../inc/tensor_layout.hpp"
+#include "../../../inc/tensor_mapped.hpp"
+#include "../../../inc/tensor_morton.hpp"
+#include "../../../inc/tensor_npy.hpp"
+#include "../../../inc/tensor_matmul.hpp"
+#include "../../../inc/tensor_reductions.hpp"
+#include "../../../inc/tensor_sparse.hpp"
+#include "../../../inc/tensor_static.hpp"
+#include "../../../inc/tensor_stream.hpp"
+#include "../../../inc/tensor_tiled.hpp"
+
+#include <algorithm>
 #include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
 #include <iostream>
+#include <numeric>
+#include <sstream>
+#include <utility>
 #include <vector>
 
 namespace benchmark
@@ -231,6 +254,7 @@ namespace benchmark
 	void BENCHMARK_RANDOM_ACCESS()
 	{
 		long long tensor_average_time = 0;
+		long long tensor_call_average_time = 0;
 		long long vector_average_time = 0;
 		tensor<int, 4> tsor(5, 4, 3, 2);
 		tsor = nested_initializer_list;
@@ -255,6 +279,12 @@ namespace benchmark
 
 			tensor_average_time += (stop - start).count();
 
+			start = std::chrono::high_resolution_clock::now();
+			tsor(i, j, k, l) = val;
+			stop = std::chrono::high_resolution_clock::now();
+
+			tensor_call_average_time += (stop - start).count();
+
 			start = std::chrono::high_resolution_clock::now();
 			vec[i][j][k][l] = val;
 			stop = std::chrono::high_resolution_clock::now();
@@ -263,9 +293,11 @@ namespace benchmark
 		}
 
 		tensor_average_time /= ITERATIONS;
+		tensor_call_average_time /= ITERATIONS;
 		vector_average_time /= ITERATIONS;
 
 		std::cout << "\tTensor average random access time: " << tensor_average_time << "\n";
+		std::cout << "\tTensor average random access time through operator(): " << tensor_call_average_time << "\n";
 		std::cout << "\tVector average random access time: " << vector_average_time << "\n";
 		std::cout << '\n';
 	}
@@ -410,6 +442,8 @@ namespace benchmark
 	{
 		long long tensor_average_time = 0;
 		long long vector_average_time = 0;
+		long long tensor_assignment_average_time = 0;
+		long long vector_assignment_average_time = 0;
 		tensor<int, 4> tsor(5, 4, 3, 2), destination_tsor(5, 4, 3, 2);
 		tsor = nested_initializer_list;
 		destination_tsor = empty_nested_initializer_list;
@@ -430,13 +464,29 @@ namespace benchmark
 			stop = std::chrono::high_resolution_clock::now();
 
 			vector_average_time += (stop - start).count();
+
+			start = std::chrono::high_resolution_clock::now();
+			destination_tsor = tsor;
+			stop = std::chrono::high_resolution_clock::now();
+
+			tensor_assignment_average_time += (stop - start).count();
+
+			start = std::chrono::high_resolution_clock::now();
+			destination_vec = vec;
+			stop = std::chrono::high_resolution_clock::now();
+
+			vector_assignment_average_time += (stop - start).count();
 		}
 
 		tensor_average_time /= ITERATIONS;
 		vector_average_time /= ITERATIONS;
+		tensor_assignment_average_time /= ITERATIONS;
+		vector_assignment_average_time /= ITERATIONS;
 
 		std::cout << "\tTensor average copy time: " << tensor_average_time << "\n";
 		std::cout << "\tVector average copy time: " << vector_average_time << "\n";
+		std::cout << "\tTensor average copy assignment time: " << tensor_assignment_average_time << "\n";
+		std::cout << "\tVector average copy assignment time: " << vector_assignment_average_time << "\n";
 		std::cout << '\n';
 	}
 
@@ -514,6 +564,970 @@ namespace benchmark
 		std::cout << '\n';
 	}
 
+	void BENCHMARK_ROW_GROWTH()
+	{
+		long long tensor_average_time = 0;
+		long long vector_average_time = 0;
+		long long push_back_average_time = 0;
+		std::chrono::high_resolution_clock::time_point start, stop;
+
+		constexpr unsigned int iterations = 20;
+		constexpr std::size_t rows = 2000, columns = 64;
+
+		for (unsigned int it = 0; it < iterations; it++)
+		{
+			tensor<float, 2> tsor;
+			std::vector<float> vec;
+
+			start = std::chrono::high_resolution_clock::now();
+			for (std::size_t row = 1; row <= rows; row++)
+				tsor.resize_preserve(row, columns);
+			stop = std::chrono::high_resolution_clock::now();
+
+			tensor_average_time += (stop - start).count();
+
+			start = std::chrono::high_resolution_clock::now();
+			for (std::size_t row = 1; row <= rows; row++)
+				vec.resize(row * columns);
+			stop = std::chrono::high_resolution_clock::now();
+
+			vector_average_time += (stop - start).count();
+
+			tensor<float, 2> pushed;
+			const tensor<float, 1> row(columns, 1.0f);
+
+			start = std::chrono::high_resolution_clock::now();
+			for (std::size_t count = 0; count < rows; count++)
+				pushed.push_back(row);
+			stop = std::chrono::high_resolution_clock::now();
+
+			push_back_average_time += (stop - start).count();
+		}
+
+		tensor_average_time /= iterations;
+		vector_average_time /= iterations;
+		push_back_average_time /= iterations;
+
+		std::cout << "\tTensor average row by row growth time: " << tensor_average_time << "\n";
+		std::cout << "\tTensor average row by row push_back time: " << push_back_average_time << "\n";
+		std::cout << "\tVector average row by row growth time: " << vector_average_time << "\n";
+		std::cout << '\n';
+	}
+
+	void BENCHMARK_FUSED_EXPRESSION()
+	{
+		long long tensor_average_time = 0;
+		long long vector_average_time = 0;
+		constexpr unsigned int iterations = ITERATIONS / 200;
+		tensor<float, 2> a(64, 1024), b(64, 1024, 1.5f), c(64, 1024, 2.0f), d(64, 1024, 0.5f);
+		std::vector<float> vec_a(64 * 1024), vec_b(64 * 1024, 1.5f), vec_c(64 * 1024, 2.0f), vec_d(64 * 1024, 0.5f);
+		std::chrono::high_resolution_clock::time_point start, stop;
+
+		for (unsigned int it = 0; it < iterations; it++)
+		{
+			start = std::chrono::high_resolution_clock::now();
+			a = b * c + d;
+			stop = std::chrono::high_resolution_clock::now();
+
+			tensor_average_time += (stop - start).count();
+
+			start = std::chrono::high_resolution_clock::now();
+			std::vector<float> temp(vec_b.size());
+			std::transform(vec_b.cbegin(), vec_b.cend(), vec_c.cbegin(), temp.begin(), std::multiplies<float>());
+			std::transform(temp.cbegin(), temp.cend(), vec_d.cbegin(), vec_a.begin(), std::plus<float>());
+			stop = std::chrono::high_resolution_clock::now();
+
+			vector_average_time += (stop - start).count();
+		}
+
+		tensor_average_time /= iterations;
+		vector_average_time /= iterations;
+
+		std::cout << "\tTensor average fused 'a = b * c + d' time: " << tensor_average_time << "\n";
+		std::cout << "\tVector average 'a = b * c + d' time (with temporary): " << vector_average_time << "\n";
+		std::cout << '\n';
+	}
+
+	void BENCHMARK_BROADCASTING()
+	{
+		long long broadcast_average_time = 0;
+		long long expanded_average_time = 0;
+		constexpr unsigned int iterations = ITERATIONS / 200;
+		tensor<float, 2> activations(256, 1024, 1.5f), expanded(256, 1024), out(256, 1024);
+		tensor<float, 1> bias(1024, 0.25f);
+		std::chrono::high_resolution_clock::time_point start, stop;
+
+		// Adding a bias row to every row, against expanding the bias with replace() first.
+		//
+		for (unsigned int it = 0; it < iterations; it++)
+		{
+			start = std::chrono::high_resolution_clock::now();
+			out = activations + bias;
+			stop = std::chrono::high_resolution_clock::now();
+
+			broadcast_average_time += (stop - start).count();
+
+			start = std::chrono::high_resolution_clock::now();
+			for (std::size_t row = 0; row < expanded.order_of_dimension(0); row++)
+				expanded[row].replace(bias);
+			out = activations + expanded;
+			stop = std::chrono::high_resolution_clock::now();
+
+			expanded_average_time += (stop - start).count();
+		}
+
+		broadcast_average_time /= iterations;
+		expanded_average_time /= iterations;
+
+		std::cout << "\tTensor average broadcast 'out = activations + bias' time: " << broadcast_average_time << "\n";
+		std::cout << "\tTensor average expanded 'out = activations + bias' time: " << expanded_average_time << "\n";
+		std::cout << '\n';
+	}
+
+	void BENCHMARK_RESHAPE()
+	{
+		long long copy_average_time = 0;
+		long long view_average_time = 0;
+		long long steal_average_time = 0;
+		constexpr unsigned int iterations = ITERATIONS / 200;
+		tensor<float, 2> images(4096, 1024, 1.0f);
+		std::chrono::high_resolution_clock::time_point start, stop;
+
+		// Turning a 4096x1024 tensor into 1024x4096: copying into a new tensor, viewing it, and moving its buffer into a new tensor.
+		//
+		for (unsigned int it = 0; it < iterations; it++)
+		{
+			start = std::chrono::high_resolution_clock::now();
+			tensor<float, 2> copied(1024, 4096);
+			std::copy(images.begin(), images.end(), copied.begin());
+			stop = std::chrono::high_resolution_clock::now();
+
+			copy_average_time += (stop - start).count();
+
+			start = std::chrono::high_resolution_clock::now();
+			auto viewed = images.reshape<2>(1024, 4096);
+			stop = std::chrono::high_resolution_clock::now();
+
+			view_average_time += (stop - start).count();
+
+			if (viewed[1023][4095] != copied[1023][4095])
+				std::cout << "\tUnexpected reshape result!\n";
+
+			start = std::chrono::high_resolution_clock::now();
+			tensor<float, 2> stolen = std::move(images).reshape<2>(1024, 4096);
+			stop = std::chrono::high_resolution_clock::now();
+
+			steal_average_time += (stop - start).count();
+
+			images = std::move(stolen).reshape<2>(4096, 1024);
+		}
+
+		copy_average_time /= iterations;
+		view_average_time /= iterations;
+		steal_average_time /= iterations;
+
+		std::cout << "\tTensor average copying reshape time: " << copy_average_time << "\n";
+		std::cout << "\tTensor average reshape view time: " << view_average_time << "\n";
+		std::cout << "\tTensor average rvalue reshape time: " << steal_average_time << "\n";
+		std::cout << '\n';
+	}
+
+	void BENCHMARK_LAYOUT()
+	{
+		long long row_major_average_time = 0;
+		long long column_major_average_time = 0;
+		constexpr unsigned int iterations = ITERATIONS / 200;
+		constexpr std::size_t n = 2048;
+		tensor<double, 2> row_major(n, n, 1.0);
+		column_major_matrix<double> column_major(row_major);
+		std::vector<double> column_sums(n);
+		std::chrono::high_resolution_clock::time_point start, stop;
+
+		// Walking down the columns, as a column-major solver does: a row-major matrix has to be transposed first, a column-major one is read as it is.
+		//
+		for (unsigned int it = 0; it < iterations; it++)
+		{
+			start = std::chrono::high_resolution_clock::now();
+			const column_major_matrix<double> transposed(row_major);
+			for (std::size_t j = 0; j < n; j++)
+				column_sums[j] = std::accumulate(transposed.data() + j * n, transposed.data() + (j + 1) * n, 0.0);
+			stop = std::chrono::high_resolution_clock::now();
+
+			row_major_average_time += (stop - start).count();
+
+			start = std::chrono::high_resolution_clock::now();
+			for (std::size_t j = 0; j < n; j++)
+				column_sums[j] = std::accumulate(column_major.data() + j * n, column_major.data() + (j + 1) * n, 0.0);
+			stop = std::chrono::high_resolution_clock::now();
+
+			column_major_average_time += (stop - start).count();
+
+			if (column_sums[n - 1] != static_cast<double>(n))
+				std::cout << "\tUnexpected column sum result!\n";
+		}
+
+		row_major_average_time /= iterations;
+		column_major_average_time /= iterations;
+
+		std::cout << "\tTensor average row-major transposed column sums time: " << row_major_average_time << "\n";
+		std::cout << "\tTensor average column-major column sums time: " << column_major_average_time << "\n";
+		std::cout << '\n';
+	}
+
+	void BENCHMARK_TILED()
+	{
+		long long row_major_average_time = 0;
+		long long tiled_average_time = 0;
+		constexpr unsigned int iterations = ITERATIONS / 200;
+		constexpr std::size_t n = 128;
+		tensor<float, 3> row_major(n, n, n, 1.0f);
+		tiled_cube<float> tiled(row_major);
+		tensor<float, 2> depth_sums(n, n);
+		std::chrono::high_resolution_clock::time_point start, stop;
+
+		// Summing a volume along its depth, one column at a time as a stencil walking in depth does: in a row-major volume
+		// every step is a whole plane away, in a tiled one the columns of a tile are walked while the tile is in cache.
+		//
+		for (unsigned int it = 0; it < iterations; it++)
+		{
+			start = std::chrono::high_resolution_clock::now();
+			for (std::size_t j = 0; j < n; j++)
+				for (std::size_t k = 0; k < n; k++)
+				{
+					float sum = 0.0f;
+					for (std::size_t i = 0; i < n; i++)
+						sum += row_major.data()[(i * n + j) * n + k];
+					depth_sums.data()[j * n + k] = sum;
+				}
+			stop = std::chrono::high_resolution_clock::now();
+
+			row_major_average_time += (stop - start).count();
+
+			start = std::chrono::high_resolution_clock::now();
+			std::fill(depth_sums.begin(), depth_sums.end(), 0.0f);
+			for (const auto tile : std::as_const(tiled).tiles())
+			{
+				const std::size_t depth = tile.order_of_dimension(0), rows = tile.order_of_dimension(1), columns = tile.order_of_dimension(2);
+				for (std::size_t j = 0; j < rows; j++)
+					for (std::size_t k = 0; k < columns; k++)
+					{
+						float sum = 0.0f;
+						for (std::size_t i = 0; i < depth; i++)
+							sum += tile.data()[(i * rows + j) * columns + k];
+						depth_sums.data()[(tile.origin(1) + j) * n + tile.origin(2) + k] += sum;
+					}
+			}
+			stop = std::chrono::high_resolution_clock::now();
+
+			tiled_average_time += (stop - start).count();
+
+			if (depth_sums[n - 1][n - 1] != static_cast<float>(n))
+				std::cout << "\tUnexpected depth sum result!\n";
+		}
+
+		row_major_average_time /= iterations;
+		tiled_average_time /= iterations;
+
+		std::cout << "\tTensor average row-major depth sums time: " << row_major_average_time << "\n";
+		std::cout << "\tTensor average tiled depth sums time: " << tiled_average_time << "\n";
+		std::cout << '\n';
+	}
+
+	void BENCHMARK_MORTON()
+	{
+		long long row_major_brick_average_time = 0;
+		long long morton_brick_average_time = 0;
+		long long row_major_neighbour_average_time = 0;
+		long long morton_neighbour_average_time = 0;
+		constexpr unsigned int iterations = ITERATIONS / 200;
+		constexpr std::size_t n = 256;
+		constexpr std::size_t brick = 8;
+		constexpr std::size_t lookups = 4096;
+		tensor<float, 3> row_major(n, n, n, 1.0f);
+		morton_cube<float> morton(row_major);
+		std::vector<std::array<std::size_t, 3>> voxels(lookups);
+		std::chrono::high_resolution_clock::time_point start, stop;
+
+		for (auto& voxel : voxels)
+			voxel = { static_cast<std::size_t>(std::rand()) % (n / brick) * brick, static_cast<std::size_t>(std::rand()) % (n / brick) * brick, static_cast<std::size_t>(std::rand()) % (n / brick) * brick };
+
+		for (unsigned int it = 0; it < iterations; it++)
+		{
+			float row_major_sum = 0.0f;
+			float morton_sum = 0.0f;
+
+			// Summing random 8x8x8 bricks, as an octree node does: 64 rows of 8 elements in a row-major cube, 512 contiguous elements in Z order.
+			//
+			start = std::chrono::high_resolution_clock::now();
+			for (const auto& voxel : voxels)
+				for (std::size_t i = 0; i < brick; i++)
+					for (std::size_t j = 0; j < brick; j++)
+					{
+						const float* row = row_major.data() + ((voxel[0] + i) * n + voxel[1] + j) * n + voxel[2];
+						row_major_sum = std::accumulate(row, row + brick, row_major_sum);
+					}
+			stop = std::chrono::high_resolution_clock::now();
+
+			row_major_brick_average_time += (stop - start).count();
+
+			start = std::chrono::high_resolution_clock::now();
+			for (const auto& voxel : voxels)
+			{
+				const float* block = morton.data() + morton_encode(voxel[0], voxel[1], voxel[2]);
+				morton_sum = std::accumulate(block, block + brick * brick * brick, morton_sum);
+			}
+			stop = std::chrono::high_resolution_clock::now();
+
+			morton_brick_average_time += (stop - start).count();
+
+			if (row_major_sum != morton_sum)
+				std::cout << "\tUnexpected brick sum result!\n";
+
+			row_major_sum = 0.0f;
+			morton_sum = 0.0f;
+
+			// Summing the 26 neighbours of the same voxels.
+			//
+			start = std::chrono::high_resolution_clock::now();
+			for (const auto& voxel : voxels)
+				for (std::size_t i = voxel[0] ? voxel[0] - 1 : 0; i <= std::min(voxel[0] + 1, n - 1); i++)
+					for (std::size_t j = voxel[1] ? voxel[1] - 1 : 0; j <= std::min(voxel[1] + 1, n - 1); j++)
+						for (std::size_t k = voxel[2] ? voxel[2] - 1 : 0; k <= std::min(voxel[2] + 1, n - 1); k++)
+							if (i != voxel[0] || j != voxel[1] || k != voxel[2])
+								row_major_sum += row_major.data()[(i * n + j) * n + k];
+			stop = std::chrono::high_resolution_clock::now();
+
+			row_major_neighbour_average_time += (stop - start).count();
+
+			start = std::chrono::high_resolution_clock::now();
+			for (const auto& voxel : voxels)
+				for_each_neighbor(std::as_const(morton), voxel, [&morton_sum](const std::array<std::size_t, 3>&, const float value) { morton_sum += value; });
+			stop = std::chrono::high_resolution_clock::now();
+
+			morton_neighbour_average_time += (stop - start).count();
+
+			if (row_major_sum != morton_sum)
+				std::cout << "\tUnexpected neighbour sum result!\n";
+		}
+
+		row_major_brick_average_time /= iterations;
+		morton_brick_average_time /= iterations;
+		row_major_neighbour_average_time /= iterations;
+		morton_neighbour_average_time /= iterations;
+
+		std::cout << "\tTensor average row-major brick sums time: " << row_major_brick_average_time << "\n";
+		std::cout << "\tTensor average Morton brick sums time: " << morton_brick_average_time << "\n";
+		std::cout << "\tTensor average row-major neighbour lookups time: " << row_major_neighbour_average_time << "\n";
+		std::cout << "\tTensor average Morton neighbour lookups time: " << morton_neighbour_average_time << "\n";
+		std::cout << '\n';
+	}
+
+	void BENCHMARK_SPARSE()
+	{
+		long long dense_vector_average_time = 0;
+		long long sparse_vector_average_time = 0;
+		long long dense_matrix_average_time = 0;
+		long long sparse_matrix_average_time = 0;
+		constexpr unsigned int iterations = ITERATIONS / 200;
+		constexpr std::size_t n = 1024;
+		constexpr std::size_t columns = 16;
+		tensor<float, 2> dense(n, n, 0.0f);
+		tensor<float, 2> b(n, columns, 1.0f);
+		tensor<float, 1> x(n, 1.0f);
+		tensor<float, 1> y(n);
+		std::chrono::high_resolution_clock::time_point start, stop;
+
+		// About one element in a thousand is non-zero, as in the adjacency matrix of a sparse graph.
+		//
+		for (std::size_t nonzero = 0; nonzero < n * n / 1000; nonzero++)
+			dense[static_cast<std::size_t>(std::rand()) % n][static_cast<std::size_t>(std::rand()) % n] = 1.0f;
+
+		const csr_matrix<float> sparse(dense);
+
+		for (unsigned int it = 0; it < iterations; it++)
+		{
+			start = std::chrono::high_resolution_clock::now();
+			for (std::size_t i = 0; i < n; i++)
+				y(i) = std::inner_product(dense.data() + i * n, dense.data() + (i + 1) * n, x.data(), 0.0f);
+			stop = std::chrono::high_resolution_clock::now();
+
+			dense_vector_average_time += (stop - start).count();
+
+			start = std::chrono::high_resolution_clock::now();
+			const tensor<float, 1> sparse_y = matmul(sparse, x);
+			stop = std::chrono::high_resolution_clock::now();
+
+			sparse_vector_average_time += (stop - start).count();
+
+			if (sparse_y != y)
+				std::cout << "\tUnexpected SpMV result!\n";
+
+			start = std::chrono::high_resolution_clock::now();
+			const tensor<float, 2> dense_c = matmul(dense, b);
+			stop = std::chrono::high_resolution_clock::now();
+
+			dense_matrix_average_time += (stop - start).count();
+
+			start = std::chrono::high_resolution_clock::now();
+			const tensor<float, 2> sparse_c = matmul(sparse, b);
+			stop = std::chrono::high_resolution_clock::now();
+
+			sparse_matrix_average_time += (stop - start).count();
+
+			if (sparse_c != dense_c)
+				std::cout << "\tUnexpected SpMM result!\n";
+		}
+
+		dense_vector_average_time /= iterations;
+		sparse_vector_average_time /= iterations;
+		dense_matrix_average_time /= iterations;
+		sparse_matrix_average_time /= iterations;
+
+		std::cout << "\tTensor average dense matrix-vector product time: " << dense_vector_average_time << "\n";
+		std::cout << "\tTensor average CSR matrix-vector product time: " << sparse_vector_average_time << "\n";
+		std::cout << "\tTensor average dense 1024x16 matmul time: " << dense_matrix_average_time << "\n";
+		std::cout << "\tTensor average CSR 1024x16 matmul time: " << sparse_matrix_average_time << "\n";
+		std::cout << '\n';
+	}
+
+	void BENCHMARK_BLOCK_SPARSE()
+	{
+		long long dense_average_time = 0;
+		long long csr_average_time = 0;
+		long long block_sparse_average_time = 0;
+		constexpr unsigned int iterations = ITERATIONS / 2000;
+		constexpr std::size_t n = 1024;
+		constexpr std::size_t block = 32;
+		constexpr std::size_t columns = 64;
+		tensor<float, 2> weights(n, n, 0.0f);
+		tensor<float, 2> x(n, columns, 1.0f);
+		std::chrono::high_resolution_clock::time_point start, stop;
+
+		// Weights pruned 32x32 block by 32x32 block, about one block in ten is kept.
+		//
+		for (std::size_t block_row = 0; block_row < n / block; block_row++)
+			for (std::size_t block_column = 0; block_column < n / block; block_column++)
+				if (std::rand() % 10 == 0)
+					for (std::size_t i = 0; i < block; i++)
+						for (std::size_t j = 0; j < block; j++)
+							weights[block_row * block + i][block_column * block + j] = 0.5f;
+
+		const csr_matrix<float> csr(weights);
+		const block_sparse_matrix<float, block, block> blocks(weights);
+
+		for (unsigned int it = 0; it < iterations; it++)
+		{
+			start = std::chrono::high_resolution_clock::now();
+			const tensor<float, 2> dense_y = matmul(weights, x);
+			stop = std::chrono::high_resolution_clock::now();
+
+			dense_average_time += (stop - start).count();
+
+			start = std::chrono::high_resolution_clock::now();
+			const tensor<float, 2> csr_y = matmul(csr, x);
+			stop = std::chrono::high_resolution_clock::now();
+
+			csr_average_time += (stop - start).count();
+
+			start = std::chrono::high_resolution_clock::now();
+			const tensor<float, 2> block_y = matmul(blocks, x);
+			stop = std::chrono::high_resolution_clock::now();
+
+			block_sparse_average_time += (stop - start).count();
+
+			if (csr_y != dense_y || block_y != dense_y)
+				std::cout << "\tUnexpected block sparse matmul result!\n";
+		}
+
+		dense_average_time /= iterations;
+		csr_average_time /= iterations;
+		block_sparse_average_time /= iterations;
+
+		std::cout << "\tTensor average dense 1024x64 matmul time: " << dense_average_time << "\n";
+		std::cout << "\tTensor average CSR 1024x64 matmul time: " << csr_average_time << "\n";
+		std::cout << "\tTensor average block sparse 1024x64 matmul time: " << block_sparse_average_time << "\n";
+		std::cout << '\n';
+	}
+
+	void BENCHMARK_MATMUL()
+	{
+		long long tensor_average_time = 0;
+		long long vector_average_time = 0;
+		constexpr unsigned int iterations = 5;
+		constexpr std::size_t n = 512;
+		tensor<float, 2> a(n, n, 0.5f), b(n, n, 2.0f), c(n, n);
+		std::vector<std::vector<float>> vec_a(n, std::vector<float>(n, 0.5f)), vec_b(n, std::vector<float>(n, 2.0f)), vec_c(n, std::vector<float>(n));
+		std::chrono::high_resolution_clock::time_point start, stop;
+
+		for (unsigned int it = 0; it < iterations; it++)
+		{
+			start = std::chrono::high_resolution_clock::now();
+			matmul_into(c, a, b);
+			stop = std::chrono::high_resolution_clock::now();
+
+			tensor_average_time += (stop - start).count();
+
+			start = std::chrono::high_resolution_clock::now();
+			for (std::size_t i = 0; i < n; i++)
+			{
+				std::fill(vec_c[i].begin(), vec_c[i].end(), 0.0f);
+
+				for (std::size_t p = 0; p < n; p++)
+					for (std::size_t j = 0; j < n; j++)
+						vec_c[i][j] += vec_a[i][p] * vec_b[p][j];
+			}
+			stop = std::chrono::high_resolution_clock::now();
+
+			vector_average_time += (stop - start).count();
+		}
+
+		tensor_average_time /= iterations;
+		vector_average_time /= iterations;
+
+		const double flops = 2.0 * n * n * n;
+
+		std::cout << "	Tensor average 512x512 float matmul time: " << tensor_average_time << " (" << flops / static_cast<double>(tensor_average_time) << " GFLOP/s)\n";
+		std::cout << "	Vector average 512x512 float i-k-j loop time: " << vector_average_time << " (" << flops / static_cast<double>(vector_average_time) << " GFLOP/s)\n";
+		std::cout << '\n';
+	}
+
+	void BENCHMARK_EINSUM()
+	{
+		long long einsum_average_time = 0;
+		long long loops_average_time = 0;
+		constexpr unsigned int iterations = 5;
+		constexpr std::size_t n = 16;
+		tensor<float, 4> a(n, n, n, n, 0.5f), b(n, n, n, n, 2.0f), c(n, n, n, n);
+		std::chrono::high_resolution_clock::time_point start, stop;
+
+		// Rank 4 contraction over two axes taken in opposite orders, planned as one GEMM against nested operator[] loops.
+		//
+		for (unsigned int it = 0; it < iterations; it++)
+		{
+			start = std::chrono::high_resolution_clock::now();
+			const auto contracted = einsum<"ijkl,lkmn->ijmn">(a, b);
+			stop = std::chrono::high_resolution_clock::now();
+
+			einsum_average_time += (stop - start).count();
+
+			start = std::chrono::high_resolution_clock::now();
+			std::fill(c.begin(), c.end(), 0.0f);
+			for (std::size_t i = 0; i < n; i++)
+				for (std::size_t j = 0; j < n; j++)
+					for (std::size_t k = 0; k < n; k++)
+						for (std::size_t l = 0; l < n; l++)
+							for (std::size_t m = 0; m < n; m++)
+								for (std::size_t p = 0; p < n; p++)
+									c[i][j][m][p] += a[i][j][k][l] * b[l][k][m][p];
+			stop = std::chrono::high_resolution_clock::now();
+
+			loops_average_time += (stop - start).count();
+
+			if (contracted != c)
+				std::cout << "\tUnexpected contraction result!\n";
+		}
+
+		einsum_average_time /= iterations;
+		loops_average_time /= iterations;
+
+		std::cout << "\tTensor average 16^4 float einsum time: " << einsum_average_time << "\n";
+		std::cout << "\tTensor average 16^4 float nested loops time: " << loops_average_time << "\n";
+		std::cout << '\n';
+	}
+
+	void BENCHMARK_REDUCTIONS()
+	{
+		long long tensor_average_time = 0, tensor_axis_average_time = 0;
+		long long vector_average_time = 0, vector_axis_average_time = 0;
+		constexpr unsigned int iterations = 20;
+		constexpr std::size_t rows = 1024, columns = 4096;
+		tensor<float, 2> a(rows, columns, 0.1f);
+		std::vector<std::vector<float>> vec_a(rows, std::vector<float>(columns, 0.1f));
+		std::chrono::high_resolution_clock::time_point start, stop;
+		float tensor_total = 0.0f, vector_total = 0.0f;
+
+		for (unsigned int it = 0; it < iterations; it++)
+		{
+			start = std::chrono::high_resolution_clock::now();
+			tensor_total = sum(a);
+			stop = std::chrono::high_resolution_clock::now();
+
+			tensor_average_time += (stop - start).count();
+
+			start = std::chrono::high_resolution_clock::now();
+			const auto column_sums = sum(a, 0);
+			stop = std::chrono::high_resolution_clock::now();
+
+			tensor_axis_average_time += (stop - start).count();
+
+			start = std::chrono::high_resolution_clock::now();
+			vector_total = 0.0f;
+			for (const auto& row : vec_a)
+				vector_total = std::accumulate(row.cbegin(), row.cend(), vector_total);
+			stop = std::chrono::high_resolution_clock::now();
+
+			vector_average_time += (stop - start).count();
+
+			start = std::chrono::high_resolution_clock::now();
+			std::vector<float> vec_column_sums(columns, 0.0f);
+			for (const auto& row : vec_a)
+				std::transform(row.cbegin(), row.cend(), vec_column_sums.cbegin(), vec_column_sums.begin(), std::plus<float>());
+			stop = std::chrono::high_resolution_clock::now();
+
+			vector_axis_average_time += (stop - start).count();
+		}
+
+		tensor_average_time /= iterations;
+		tensor_axis_average_time /= iterations;
+		vector_average_time /= iterations;
+		vector_axis_average_time /= iterations;
+
+		const double exact = static_cast<double>(0.1f) * rows * columns;
+
+		std::cout << "\tTensor average 1024x4096 float sum time: " << tensor_average_time << " (relative error " << std::abs(tensor_total - exact) / exact << ")\n";
+		std::cout << "\tVector average 1024x4096 float accumulate time: " << vector_average_time << " (relative error " << std::abs(vector_total - exact) / exact << ")\n";
+		std::cout << "\tTensor average column sums time: " << tensor_axis_average_time << "\n";
+		std::cout << "\tVector average column sums time: " << vector_axis_average_time << "\n";
+		std::cout << '\n';
+	}
+
+	void BENCHMARK_SMALL_MATRICES()
+	{
+		long long static_average_time = 0;
+		long long dynamic_average_time = 0;
+		constexpr unsigned int iterations = 5;
+		constexpr std::size_t count = 1000000;
+		const static_matrix<float, 4, 4> static_transform(0.25f);
+		const matrix<float> dynamic_transform(4, 4, 0.25f);
+		std::chrono::high_resolution_clock::time_point start, stop;
+		float static_checksum = 0.0f, dynamic_checksum = 0.0f;
+
+		for (unsigned int it = 0; it < iterations; it++)
+		{
+			start = std::chrono::high_resolution_clock::now();
+			for (std::size_t index = 0; index < count; index++)
+			{
+				static_matrix<float, 4, 4> point(static_cast<float>(index % 7));
+				point = matmul(static_transform, point);
+				static_checksum += point(3, 3);
+			}
+			stop = std::chrono::high_resolution_clock::now();
+
+			static_average_time += (stop - start).count();
+
+			start = std::chrono::high_resolution_clock::now();
+			for (std::size_t index = 0; index < count; index++)
+			{
+				matrix<float> point(4, 4, static_cast<float>(index % 7));
+				point = matmul(dynamic_transform, point);
+				dynamic_checksum += point[3][3];
+			}
+			stop = std::chrono::high_resolution_clock::now();
+
+			dynamic_average_time += (stop - start).count();
+		}
+
+		static_average_time /= iterations;
+		dynamic_average_time /= iterations;
+
+		std::cout << "\tStatic 4x4 average time for a million products: " << static_average_time << " (checksum " << static_checksum << ")\n";
+		std::cout << "\tDynamic 4x4 average time for a million products: " << dynamic_average_time << " (checksum " << dynamic_checksum << ")\n";
+		std::cout << '\n';
+	}
+
+	void BENCHMARK_ARENA_TEMPORARIES()
+	{
+		long long default_average_time = 0;
+		long long arena_average_time = 0;
+		constexpr unsigned int iterations = 5;
+		constexpr std::size_t batches = 10000;
+		arena scratch(std::size_t{ 1 } << 20);
+		std::chrono::high_resolution_clock::time_point start, stop;
+		std::size_t default_checksum = 0, arena_checksum = 0;
+
+		// Intermediate results of varying shapes, allocated and released once per batch.
+		//
+		for (unsigned int it = 0; it < iterations; it++)
+		{
+			start = std::chrono::high_resolution_clock::now();
+			for (std::size_t batch = 0; batch < batches; batch++)
+			{
+				tensor<float, 2> hidden(64, 32 + batch % 32), gate(64, 48 + batch % 16), scores(128, 40 + batch % 8), output(256, 20 + batch % 5);
+				default_checksum += hidden.size_of_current_tensor() + gate.size_of_current_tensor() + scores.size_of_current_tensor() + output.size_of_current_tensor();
+			}
+			stop = std::chrono::high_resolution_clock::now();
+
+			default_average_time += (stop - start).count();
+
+			start = std::chrono::high_resolution_clock::now();
+			for (std::size_t batch = 0; batch < batches; batch++)
+			{
+				{
+					const arena_allocator<float> allocator(scratch);
+					arena_tensor<float, 2> hidden(std::allocator_arg, allocator, 64, 32 + batch % 32), gate(std::allocator_arg, allocator, 64, 48 + batch % 16),
+						scores(std::allocator_arg, allocator, 128, 40 + batch % 8), output(std::allocator_arg, allocator, 256, 20 + batch % 5);
+					arena_checksum += hidden.size_of_current_tensor() + gate.size_of_current_tensor() + scores.size_of_current_tensor() + output.size_of_current_tensor();
+				}
+
+				scratch.reset();
+			}
+			stop = std::chrono::high_resolution_clock::now();
+
+			arena_average_time += (stop - start).count();
+		}
+
+		default_average_time /= iterations;
+		arena_average_time /= iterations;
+
+		std::cout << "\tDefault allocator average time for 10k batches of temporaries: " << default_average_time << " (checksum " << default_checksum << ")\n";
+		std::cout << "\tArena average time for 10k batches of temporaries: " << arena_average_time << " (checksum " << arena_checksum << ")\n";
+		std::cout << '\n';
+	}
+
+	template <typename Tensor>
+	float RANDOM_GATHER(const Tensor& tsor, const std::size_t count)
+	{
+		const float* data = tsor.data();
+		const std::size_t size = tsor.size_of_current_tensor();
+		std::uint64_t state = 1;
+		float sum = 0.0f;
+
+		for (std::size_t index = 0; index < count; index++)
+		{
+			state = state * 6364136223846793005ull + 1442695040888963407ull;
+			sum += data[(state >> 20) % size];
+		}
+
+		return sum;
+	}
+
+	void BENCHMARK_HUGE_PAGES()
+	{
+		long long default_average_time = 0;
+		long long huge_page_average_time = 0;
+		constexpr unsigned int iterations = 3;
+		constexpr std::size_t count = 4000000;
+		const tensor<float, 1> regular(std::size_t{ 1 } << 25, 1.0f);
+		const huge_page_tensor<float, 1> huge(std::size_t{ 1 } << 25, 1.0f);
+		std::chrono::high_resolution_clock::time_point start, stop;
+		float default_checksum = 0.0f, huge_page_checksum = 0.0f;
+
+		for (unsigned int it = 0; it < iterations; it++)
+		{
+			start = std::chrono::high_resolution_clock::now();
+			default_checksum += RANDOM_GATHER(regular, count);
+			stop = std::chrono::high_resolution_clock::now();
+
+			default_average_time += (stop - start).count();
+
+			start = std::chrono::high_resolution_clock::now();
+			huge_page_checksum += RANDOM_GATHER(huge, count);
+			stop = std::chrono::high_resolution_clock::now();
+
+			huge_page_average_time += (stop - start).count();
+		}
+
+		default_average_time /= iterations;
+		huge_page_average_time /= iterations;
+
+		std::cout << "\tDefault allocator average time for 4M random reads in 128 MiB: " << default_average_time << " (checksum " << default_checksum << ")\n";
+		std::cout << "\tHuge page allocator average time for 4M random reads in 128 MiB: " << huge_page_average_time << " (checksum " << huge_page_checksum << ")\n";
+		std::cout << '\n';
+	}
+
+	void BENCHMARK_SERIALIZATION()
+	{
+		long long binary_average_time = 0;
+		long long text_average_time = 0;
+		std::chrono::high_resolution_clock::time_point start, stop;
+
+		constexpr unsigned int iterations = 5;
+
+		tensor<float, 2> tsor(1024, 1024);
+		std::iota(tsor.begin(), tsor.end(), 0.5f);
+
+		// Binary round trip against the text dump through operator<< it replaces.
+		//
+		for (unsigned int it = 0; it < iterations; it++)
+		{
+			std::stringstream binary;
+
+			start = std::chrono::high_resolution_clock::now();
+			save(binary, tsor);
+			const tensor<float, 2> loaded = load<float, 2>(binary);
+			stop = std::chrono::high_resolution_clock::now();
+
+			binary_average_time += (stop - start).count();
+
+			std::stringstream text;
+			std::vector<float> parsed(tsor.size_of_current_tensor());
+
+			start = std::chrono::high_resolution_clock::now();
+			for (const float value : tsor)
+				text << value << ' ';
+			for (float& value : parsed)
+				text >> value;
+			stop = std::chrono::high_resolution_clock::now();
+
+			text_average_time += (stop - start).count();
+
+			if (loaded[1023][1023] != tsor[1023][1023])
+				std::cout << "\tUnexpected round trip result!\n";
+		}
+
+		binary_average_time /= iterations;
+		text_average_time /= iterations;
+
+		std::cout << "\tTensor average binary save and load time: " << binary_average_time << "\n";
+		std::cout << "\tAverage text save and load time: " << text_average_time << "\n";
+		std::cout << '\n';
+	}
+
+	void BENCHMARK_MAPPED_LOAD()
+	{
+		long long load_average_time = 0;
+		long long mapped_average_time = 0;
+		std::chrono::high_resolution_clock::time_point start, stop;
+
+		constexpr unsigned int iterations = 5;
+
+		const std::filesystem::path path = std::filesystem::temp_directory_path() / "benchmark_mapped_load.tnsr";
+		save(path, tensor<float, 2>(4096, 4096, 1.0f));
+
+		// Opening the file and reading every element once, with the file in the page cache.
+		//
+		for (unsigned int it = 0; it < iterations; it++)
+		{
+			start = std::chrono::high_resolution_clock::now();
+			const tensor<float, 2> loaded = load<float, 2>(path);
+			volatile float loaded_sum = sum(loaded);
+			stop = std::chrono::high_resolution_clock::now();
+
+			load_average_time += (stop - start).count();
+
+			start = std::chrono::high_resolution_clock::now();
+			const mapped_tensor<float, 2> mapped(path);
+			volatile float mapped_sum = sum(mapped.view());
+			stop = std::chrono::high_resolution_clock::now();
+
+			mapped_average_time += (stop - start).count();
+
+			static_cast<void>(loaded_sum);
+			static_cast<void>(mapped_sum);
+		}
+
+		std::filesystem::remove(path);
+
+		load_average_time /= iterations;
+		mapped_average_time /= iterations;
+
+		std::cout << "\tTensor average load and read time: " << load_average_time << "\n";
+		std::cout << "\tMapped tensor average open and read time: " << mapped_average_time << "\n";
+		std::cout << '\n';
+	}
+
+	void BENCHMARK_NPY_LOAD()
+	{
+		long long npy_average_time = 0;
+		long long csv_average_time = 0;
+		std::chrono::high_resolution_clock::time_point start, stop;
+
+		constexpr unsigned int iterations = 5;
+		constexpr std::size_t rows = 1024, columns = 1024;
+
+		tensor<float, 2> tsor(rows, columns);
+		std::iota(tsor.begin(), tsor.end(), 0.25f);
+
+		std::stringstream npy, csv;
+		save_npy(npy, tsor);
+
+		for (std::size_t row = 0; row < rows; row++)
+			for (std::size_t column = 0; column < columns; column++)
+				csv << tsor(row, column) << (column + 1 < columns ? ',' : '\n');
+
+		for (unsigned int it = 0; it < iterations; it++)
+		{
+			npy.clear();
+			npy.seekg(0);
+
+			start = std::chrono::high_resolution_clock::now();
+			const tensor<float, 2> loaded = load_npy<float, 2>(npy);
+			stop = std::chrono::high_resolution_clock::now();
+
+			npy_average_time += (stop - start).count();
+
+			csv.clear();
+			csv.seekg(0);
+			std::vector<float> parsed(rows * columns);
+
+			start = std::chrono::high_resolution_clock::now();
+			for (float& value : parsed)
+			{
+				csv >> value;
+				csv.ignore(1);
+			}
+			stop = std::chrono::high_resolution_clock::now();
+
+			csv_average_time += (stop - start).count();
+
+			// Text loses precision (that is one of the reasons to move away from it), only the shapes are compared.
+			//
+			if (loaded.size_of_current_tensor() != parsed.size())
+				std::cout << "\tUnexpected load result!\n";
+		}
+
+		npy_average_time /= iterations;
+		csv_average_time /= iterations;
+
+		std::cout << "\tTensor average .npy load time: " << npy_average_time << "\n";
+		std::cout << "\tAverage CSV load time: " << csv_average_time << "\n";
+		std::cout << '\n';
+	}
+
+	void BENCHMARK_STREAMING()
+	{
+		long long load_average_time = 0;
+		long long stream_average_time = 0;
+		std::chrono::high_resolution_clock::time_point start, stop;
+
+		constexpr unsigned int iterations = 5;
+
+		const std::filesystem::path path = std::filesystem::temp_directory_path() / "benchmark_streaming.tnsr";
+		save(path, tensor<float, 2>(4096, 4096, 1.0f));
+
+		// Loading the whole tensor before reducing it against reducing 256 row slabs while the next one is read.
+		//
+		for (unsigned int it = 0; it < iterations; it++)
+		{
+			start = std::chrono::high_resolution_clock::now();
+			volatile float loaded_sum = sum(load<float, 2>(path));
+			stop = std::chrono::high_resolution_clock::now();
+
+			load_average_time += (stop - start).count();
+
+			start = std::chrono::high_resolution_clock::now();
+			float total = 0.0f;
+			for (auto slab : tensor_stream<float, 2>(path, 256))
+				total += sum(slab);
+			volatile float streamed_sum = total;
+			stop = std::chrono::high_resolution_clock::now();
+
+			stream_average_time += (stop - start).count();
+
+			static_cast<void>(loaded_sum);
+			static_cast<void>(streamed_sum);
+		}
+
+		std::filesystem::remove(path);
+
+		load_average_time /= iterations;
+		stream_average_time /= iterations;
+
+		std::cout << "\tTensor average load and reduce time: " << load_average_time << "\n";
+		std::cout << "\tTensor average streamed reduce time: " << stream_average_time << "\n";
+		std::cout << '\n';
+	}
+
 	void BENCHMARK_AGAINST_VECTOR()
 	{
 		std::cout << "\nBenchmarking against vector...\n\n";
@@ -529,7 +1543,26 @@ namespace benchmark
 		BENCHMARK_ASSIGN_ONE_DIMENSION();
 		BENCHMARK_COPY();
 		BENCHMARK_RESIZE();
+		BENCHMARK_ROW_GROWTH();
 		BENCHMARK_EMPLACE_INITIALIZATION();
+		BENCHMARK_FUSED_EXPRESSION();
+		BENCHMARK_MATMUL();
+		BENCHMARK_REDUCTIONS();
+		BENCHMARK_SMALL_MATRICES();
+		BENCHMARK_ARENA_TEMPORARIES();
+		BENCHMARK_HUGE_PAGES();
+		BENCHMARK_SERIALIZATION();
+		BENCHMARK_MAPPED_LOAD();
+		BENCHMARK_NPY_LOAD();
+		BENCHMARK_STREAMING();
+		BENCHMARK_EINSUM();
+		BENCHMARK_BROADCASTING();
+		BENCHMARK_RESHAPE();
+		BENCHMARK_LAYOUT();
+		BENCHMARK_TILED();
+		BENCHMARK_MORTON();
+		BENCHMARK_SPARSE();
+		BENCHMARK_BLOCK_SPARSE();
 
 		std::cout << '\n';
 	}
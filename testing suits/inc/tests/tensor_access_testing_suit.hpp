@@ -0,0 +1,86 @@
+#pragma once
+
+#include "../../../inc/tensor.hpp"
+
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+
+namespace tensor_access_testing_suit
+{
+	using namespace tensor_lib;
+
+	static_assert([]()
+	{
+		tensor<int, 3> cube(2, 3, 4);
+		std::iota(cube.begin(), cube.end(), 0);
+
+		return cube(1, 2, 3) == 23 && cube[1](2, 3) == 23 && cube[1][2](3) == 23;
+	}());
+
+	void TEST_1()
+	{
+		tensor<int, 4> tsor(5, 4, 3, 2);
+		std::iota(tsor.begin(), tsor.end(), 0);
+
+		for (std::size_t i = 0; i < 5; i++)
+			for (std::size_t j = 0; j < 4; j++)
+				for (std::size_t k = 0; k < 3; k++)
+					for (std::size_t l = 0; l < 2; l++)
+						if (&tsor(i, j, k, l) != &tsor[i][j][k][l] || &tsor[i](j, k, l) != &tsor[i][j][k][l] || &tsor[i][j](k, l) != &tsor[i][j][k][l])
+							throw std::runtime_error("TEST_1 in 'tensor_access_testing_suit' failed!\n");
+
+		// Any integral type works as an index.
+		//
+		tsor(4u, 3, static_cast<short>(2), 1ull) = -1;
+
+		if (tsor[4][3][2][1] != -1 || tsor.data()[tsor.size_of_current_tensor() - 1] != -1)
+			throw std::runtime_error("TEST_1 in 'tensor_access_testing_suit' failed!\n");
+
+		tsor[2][1](0, 1) = -2;
+
+		if (tsor[2][1][0][1] != -2)
+			throw std::runtime_error("TEST_1 in 'tensor_access_testing_suit' failed!\n");
+
+		std::cout << "\tTEST 1 PASSED.\n";
+	}
+
+	void TEST_2()
+	{
+		tensor<double, 3> cube(3, 5, 7);
+		std::iota(cube.begin(), cube.end(), 0.0);
+
+		const tensor<double, 3>& const_cube = cube;
+
+		for (std::size_t i = 0; i < 3; i++)
+			for (std::size_t j = 0; j < 5; j++)
+				for (std::size_t k = 0; k < 7; k++)
+					if (const_cube(i, j, k) != static_cast<double>((i * 5 + j) * 7 + k) || const_cube[i](j, k) != const_cube[i][j][k])
+						throw std::runtime_error("TEST_2 in 'tensor_access_testing_suit' failed!\n");
+
+		tensor<double, 1> line(6);
+		std::iota(line.begin(), line.end(), 0.0);
+
+		if (line(5) != 5.0)
+			throw std::runtime_error("TEST_2 in 'tensor_access_testing_suit' failed!\n");
+
+#if defined(__cpp_multidimensional_subscript)
+		cube[2, 4, 6] = -1.0;
+
+		if (cube(2, 4, 6) != -1.0 || const_cube[1][2, 3] != const_cube(1, 2, 3))
+			throw std::runtime_error("TEST_2 in 'tensor_access_testing_suit' failed!\n");
+#endif
+
+		std::cout << "\tTEST 2 PASSED.\n";
+	}
+
+	void RUN_ALL()
+	{
+		std::cout << "Running tensor access tests...\n\n";
+
+		TEST_1();
+		TEST_2();
+
+		std::cout << "\n";
+	}
+}
@@ -0,0 +1,250 @@
+#pragma once
+
+#include "../../../inc/tensor.hpp"
+#include "../../../inc/tensor_allocators.hpp"
+#include "../../../inc/tensor_expressions.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <memory_resource>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+
+namespace tensor_allocators_testing_suit
+{
+	using namespace tensor_lib;
+
+	static_assert(tensor<float, 2>::alignment == alignof(float));
+	static_assert(aligned_tensor<float, 2>::alignment == 64 && aligned_tensor<char, 1, 128>::alignment == 128);
+	static_assert(huge_page_tensor<double, 3>::alignment == 64);
+
+	// Counts the calls that reach the upstream resource.
+	//
+	class COUNTING_RESOURCE : public std::pmr::memory_resource
+	{
+	public:
+		std::size_t allocations = 0;
+		std::size_t deallocations = 0;
+
+	private:
+		void* do_allocate(const std::size_t bytes, const std::size_t alignment) override
+		{
+			++allocations;
+			return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+		}
+
+		void do_deallocate(void* pointer, const std::size_t bytes, const std::size_t alignment) override
+		{
+			++deallocations;
+			std::pmr::new_delete_resource()->deallocate(pointer, bytes, alignment);
+		}
+
+		bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+		{
+			return this == &other;
+		}
+	};
+
+	void TEST_1()
+	{
+		COUNTING_RESOURCE upstream;
+
+		{
+			arena scratch(256, &upstream);
+
+			void* first = scratch.allocate(3, 1);
+			void* second = scratch.allocate(8, 64);
+
+			if (reinterpret_cast<std::uintptr_t>(second) % 64 != 0 || second <= first || scratch.used() != 11 || upstream.allocations != 1)
+				throw std::runtime_error("TEST_1 in 'tensor_allocators_testing_suit' failed!\n");
+
+			// Rewinding hands out the same memory again.
+			//
+			scratch.reset();
+
+			if (scratch.allocate(3, 1) != first || scratch.used() != 3)
+				throw std::runtime_error("TEST_1 in 'tensor_allocators_testing_suit' failed!\n");
+
+			// A batch that outgrows the first chunk is merged into a single chunk after the reset.
+			//
+			static_cast<void>(scratch.allocate(1000, 8));
+
+			if (upstream.allocations != 2)
+				throw std::runtime_error("TEST_1 in 'tensor_allocators_testing_suit' failed!\n");
+
+			const std::size_t capacity = scratch.capacity();
+			scratch.reset();
+			static_cast<void>(scratch.allocate(1000, 8));
+
+			if (upstream.allocations != 3 || upstream.deallocations != 2 || scratch.capacity() != capacity)
+				throw std::runtime_error("TEST_1 in 'tensor_allocators_testing_suit' failed!\n");
+
+			scratch.reset();
+			static_cast<void>(scratch.allocate(1000, 8));
+
+			if (upstream.allocations != 3)
+				throw std::runtime_error("TEST_1 in 'tensor_allocators_testing_suit' failed!\n");
+		}
+
+		if (upstream.deallocations != upstream.allocations)
+			throw std::runtime_error("TEST_1 in 'tensor_allocators_testing_suit' failed!\n");
+
+		std::cout << "\tTEST 1 PASSED.\n";
+	}
+
+	void TEST_2()
+	{
+		COUNTING_RESOURCE upstream;
+		arena scratch(1 << 16, &upstream);
+
+		for (int batch = 0; batch < 10; batch++)
+		{
+			pmr::tensor<float, 2> a(std::allocator_arg, &scratch, 30, 40);
+			pmr::tensor<float, 2> b(std::allocator_arg, &scratch, 30, 40, 2.0f);
+			std::iota(a.begin(), a.end(), static_cast<float>(batch));
+
+			pmr::tensor<float, 2> c(a * b + a, &scratch);
+
+			if (c[29][39] != 3.0f * (batch + 1199.0f) || c.get_allocator().resource() != &scratch)
+				throw std::runtime_error("TEST_2 in 'tensor_allocators_testing_suit' failed!\n");
+
+			scratch.reset();
+		}
+
+		if (upstream.allocations != 1)
+			throw std::runtime_error("TEST_2 in 'tensor_allocators_testing_suit' failed!\n");
+
+		// Moving between tensors of the same resource takes over the buffer, between different resources it copies.
+		//
+		pmr::tensor<int, 2> source(std::allocator_arg, &scratch, 4, 5, 7);
+		const int* buffer = source.data();
+
+		pmr::tensor<int, 2> moved(std::move(source), &scratch);
+
+		if (moved.data() != buffer || !source.empty())
+			throw std::runtime_error("TEST_2 in 'tensor_allocators_testing_suit' failed!\n");
+
+		COUNTING_RESOURCE other_resource;
+		pmr::tensor<int, 2> elsewhere(std::allocator_arg, &other_resource, 1, 1);
+
+		elsewhere = std::move(moved);
+
+		if (elsewhere.data() == buffer || elsewhere.get_allocator().resource() != &other_resource || elsewhere[3][4] != 7 || other_resource.allocations != 2)
+			throw std::runtime_error("TEST_2 in 'tensor_allocators_testing_suit' failed!\n");
+
+		// Copies don't inherit the resource, they use the default one.
+		//
+		const pmr::tensor<int, 2> copy(elsewhere);
+
+		if (copy.get_allocator().resource() != std::pmr::get_default_resource() || !(copy == elsewhere))
+			throw std::runtime_error("TEST_2 in 'tensor_allocators_testing_suit' failed!\n");
+
+		std::cout << "\tTEST 2 PASSED.\n";
+	}
+
+	void TEST_3()
+	{
+		arena scratch(1024);
+		const arena_allocator<double> allocator(scratch);
+
+		arena_tensor<double, 3> cube(std::allocator_arg, allocator, 2, 3, 4);
+		std::iota(cube.begin(), cube.end(), 0.0);
+
+		arena_tensor<double, 3> filled(std::allocator_arg, allocator, 2, 3, 4, 1.0);
+		filled = cube + filled;
+
+		if (filled(1, 2, 3) != 24.0 || scratch.used() != 2 * 24 * sizeof(double))
+			throw std::runtime_error("TEST_3 in 'tensor_allocators_testing_suit' failed!\n");
+
+		// The arena travels with the buffer on move assignment.
+		//
+		arena other_scratch(1024);
+		arena_tensor<double, 3> target(std::allocator_arg, arena_allocator<double>(other_scratch), 1, 1, 1);
+		const double* buffer = filled.data();
+
+		target = std::move(filled);
+
+		if (target.data() != buffer || target.get_allocator().resource() != &scratch)
+			throw std::runtime_error("TEST_3 in 'tensor_allocators_testing_suit' failed!\n");
+
+		const arena_tensor<double, 3> copy(cube);
+
+		if (!(copy == cube) || copy.get_allocator() != allocator)
+			throw std::runtime_error("TEST_3 in 'tensor_allocators_testing_suit' failed!\n");
+
+		std::cout << "\tTEST 3 PASSED.\n";
+	}
+
+	template <typename Tensor>
+	bool IS_ALIGNED(const Tensor& tsor, const std::size_t alignment)
+	{
+		return reinterpret_cast<std::uintptr_t>(tsor.data()) % alignment == 0;
+	}
+
+	void TEST_4()
+	{
+		for (std::size_t columns = 1; columns < 40; columns += 3)
+		{
+			aligned_tensor<float, 2> matrix(3, columns, 1.0f);
+			aligned_tensor<char, 2, 256> bytes(3, columns);
+
+			if (!IS_ALIGNED(matrix, 64) || !IS_ALIGNED(bytes, 256))
+				throw std::runtime_error("TEST_4 in 'tensor_allocators_testing_suit' failed!\n");
+
+			// Results of expressions and copies keep the allocator, and with it the alignment.
+			//
+			const aligned_tensor<float, 2> doubled = matrix + matrix;
+			const aligned_tensor<float, 2> copy(doubled);
+
+			if (!IS_ALIGNED(doubled, 64) || !IS_ALIGNED(copy, 64) || copy[2][columns - 1] != 2.0f)
+				throw std::runtime_error("TEST_4 in 'tensor_allocators_testing_suit' failed!\n");
+		}
+
+		std::cout << "\tTEST 4 PASSED.\n";
+	}
+
+	void TEST_5()
+	{
+		// Small buffers come from the aligned operator new, large ones from huge page aligned mappings.
+		//
+		huge_page_tensor<double, 2> small(10, 10, 1.0);
+		huge_page_tensor<double, 2> large(1024, 1024, 2.0);
+
+		if (!IS_ALIGNED(small, 64) || !IS_ALIGNED(large, 64))
+			throw std::runtime_error("TEST_5 in 'tensor_allocators_testing_suit' failed!\n");
+
+#if defined(__linux__)
+		if (!IS_ALIGNED(large, std::size_t{ 2 } << 20))
+			throw std::runtime_error("TEST_5 in 'tensor_allocators_testing_suit' failed!\n");
+#endif
+
+		large[1023][1023] = 3.0;
+		large.resize(1500, 1500);
+		std::fill(large.begin(), large.end(), 4.0);
+
+		if (large[1499][1499] != 4.0 || small[9][9] != 1.0)
+			throw std::runtime_error("TEST_5 in 'tensor_allocators_testing_suit' failed!\n");
+
+		huge_page_tensor<double, 2> moved(std::move(large));
+
+		if (!large.empty() || moved(1000, 1000) != 4.0)
+			throw std::runtime_error("TEST_5 in 'tensor_allocators_testing_suit' failed!\n");
+
+		std::cout << "\tTEST 5 PASSED.\n";
+	}
+
+	void RUN_ALL()
+	{
+		std::cout << "Running tensor allocators tests...\n\n";
+
+		TEST_1();
+		TEST_2();
+		TEST_3();
+		TEST_4();
+		TEST_5();
+
+		std::cout << "\n";
+	}
+}
@@ -0,0 +1,190 @@
+#pragma once
+
+#include "../../../inc/tensor.hpp"
+
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace tensor_append_testing_suit
+{
+	using namespace tensor_lib;
+
+	// Copy construction throws once 'copies_left' reaches zero, moves never throw.
+	//
+	struct THROWING_COPY
+	{
+		static inline int copies_left = 1000;
+
+		int value = 0;
+
+		THROWING_COPY() = default;
+
+		THROWING_COPY(const int init) : value{ init } {}
+
+		THROWING_COPY(const THROWING_COPY& other) : value{ other.value }
+		{
+			if (--copies_left < 0)
+				throw std::runtime_error("Copy failed!");
+		}
+
+		THROWING_COPY(THROWING_COPY&& other) noexcept = default;
+
+		THROWING_COPY& operator=(const THROWING_COPY& other) = default;
+	};
+
+	void TEST_1()
+	{
+		// Rows come in one at a time, the buffer only moves a logarithmic number of times.
+		//
+		tensor<float, 2> samples;
+		tensor<float, 1> row(16);
+		std::size_t reallocations = 0;
+
+		for (std::size_t index = 0; index < 1000; index++)
+		{
+			std::iota(row.begin(), row.end(), static_cast<float>(index * 16));
+
+			const float* buffer = samples.data();
+			samples.push_back(row);
+
+			reallocations += samples.data() != buffer;
+		}
+
+		if (samples.order_of_dimension(0) != 1000 || samples.order_of_dimension(1) != 16 || reallocations > 11 || samples.capacity() < 16000)
+			throw std::runtime_error("TEST_1 in 'tensor_append_testing_suit' failed!\n");
+
+		for (std::size_t index = 0; index < samples.size_of_current_tensor(); index++)
+			if (samples.data()[index] != static_cast<float>(index))
+				throw std::runtime_error("TEST_1 in 'tensor_append_testing_suit' failed!\n");
+
+		// Subdimensions of other tensors work as rows too, rows of the wrong size are rejected.
+		//
+		const tensor<float, 3> cube(2, 3, 16, 5.0f);
+		samples.push_back(cube[1][2]);
+
+		bool thrown = false;
+
+		try
+		{
+			samples.push_back(tensor<float, 1>(15));
+		}
+		catch (const std::runtime_error&)
+		{
+			thrown = true;
+		}
+
+		if (!thrown || samples.order_of_dimension(0) != 1001 || samples(1000, 15) != 5.0f)
+			throw std::runtime_error("TEST_1 in 'tensor_append_testing_suit' failed!\n");
+
+		// An empty tensor takes the shape of what it's given, whatever sizes it had.
+		//
+		tensor<float, 2> no_columns = tensor<float, 1>().reshape<2>(5, 0);
+		no_columns.push_back(tensor<float, 1>(3, 2.0f));
+
+		if (no_columns.order_of_dimension(0) != 1 || no_columns.order_of_dimension(1) != 3 || no_columns.size_of_current_tensor() != 3 || no_columns(0, 2) != 2.0f)
+			throw std::runtime_error("TEST_1 in 'tensor_append_testing_suit' failed!\n");
+
+		std::cout << "\tTEST 1 PASSED.\n";
+	}
+
+	void TEST_2()
+	{
+		tensor<int, 1> values;
+
+		for (int value = 0; value < 100; value++)
+			values.push_back(value);
+
+		int& last = values.emplace_back(100);
+
+		if (values.order_of_dimension(0) != 101 || last != 100 || values[50] != 50)
+			throw std::runtime_error("TEST_2 in 'tensor_append_testing_suit' failed!\n");
+
+		// A slice of the current trailing sizes with every element constructed from the arguments.
+		//
+		tensor<std::string, 2> words(2, 3, std::string("a"));
+		auto row = words.emplace_back(4, 'b');
+
+		if (words.order_of_dimension(0) != 3 || row[2] != "bbbb" || words[0][0] != "a")
+			throw std::runtime_error("TEST_2 in 'tensor_append_testing_suit' failed!\n");
+
+		// Appending a tensor to itself, and moving the elements of another one.
+		//
+		words.append(words);
+		words.shrink_to_fit();
+		words.push_back(words[5]);
+
+		tensor<std::string, 2> more(2, 3, std::string(40, 'c'));
+		const char* buffer = more(1, 2).data();
+
+		words.append(std::move(more));
+
+		if (words.order_of_dimension(0) != 9 || words(5, 1) != "bbbb" || words(6, 1) != "bbbb" || words(8, 2) != std::string(40, 'c') || words(8, 2).data() != buffer)
+			throw std::runtime_error("TEST_2 in 'tensor_append_testing_suit' failed!\n");
+
+		tensor<int, 3> stack;
+		const tensor<int, 3> cube(2, 2, 2, 7);
+
+		stack.append(cube);
+		stack.push_back(cube[1]);
+
+		if (stack.order_of_dimension(0) != 3 || stack(1, 1, 1) != 7)
+			throw std::runtime_error("TEST_2 in 'tensor_append_testing_suit' failed!\n");
+
+		std::cout << "\tTEST 2 PASSED.\n";
+	}
+
+	void TEST_3()
+	{
+		// A copy that fails halfway leaves the tensor as it was, whether the buffer had room or not.
+		//
+		tensor<THROWING_COPY, 2> rows(2, 4);
+		const tensor<THROWING_COPY, 1> row(4, 9);
+
+		for (std::size_t index = 0; index < 8; index++)
+			rows.data()[index] = static_cast<int>(index);
+
+		for (int attempt = 0; attempt < 2; attempt++)
+		{
+			bool thrown = false;
+
+			THROWING_COPY::copies_left = 2;
+
+			try
+			{
+				rows.push_back(row);
+			}
+			catch (const std::runtime_error&)
+			{
+				thrown = true;
+			}
+
+			THROWING_COPY::copies_left = 1000;
+
+			if (!thrown || rows.order_of_dimension(0) != 2 || rows(1, 3).value != 7)
+				throw std::runtime_error("TEST_3 in 'tensor_append_testing_suit' failed!\n");
+
+			rows.reserve(100);
+		}
+
+		rows.push_back(row);
+
+		if (rows.order_of_dimension(0) != 3 || rows(2, 0).value != 9)
+			throw std::runtime_error("TEST_3 in 'tensor_append_testing_suit' failed!\n");
+
+		std::cout << "\tTEST 3 PASSED.\n";
+	}
+
+	void RUN_ALL()
+	{
+		std::cout << "Running tensor append tests...\n\n";
+
+		TEST_1();
+		TEST_2();
+		TEST_3();
+
+		std::cout << "\n";
+	}
+}
@@ -0,0 +1,236 @@
+#pragma once
+
+#include "../../../inc/tensor.hpp"
+#include "../../../inc/tensor_block_sparse.hpp"
+#include "../../../inc/tensor_execution.hpp"
+#include "../../../inc/tensor_kernels.hpp"
+#include "../../../inc/tensor_matmul.hpp"
+#include "../../../inc/tensor_reductions.hpp"
+#include "../../../inc/tensor_tiled.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace tensor_block_sparse_testing_suit
+{
+	using namespace tensor_lib;
+
+	void TEST_1()
+	{
+		// An 8x12 matrix in 4x4 blocks, two of the six blocks hold non-zero elements.
+		//
+		tensor<int, 2> m(8, 12);
+		std::fill(m.begin(), m.end(), 0);
+		m[1][9] = 3;
+		m[6][2] = 7;
+		m[7][0] = -1;
+
+		const block_sparse_matrix<int, 4, 4> blocks(m);
+
+		const std::array<std::size_t, 3> expected_offsets{ 0, 1, 2 };
+		const std::array<std::size_t, 2> expected_columns{ 2, 0 };
+
+		if (blocks.block_count() != 2 || !std::ranges::equal(blocks.block_row_offsets(), expected_offsets) || !std::ranges::equal(blocks.block_columns(), expected_columns)
+			|| blocks.data()[1 * 4 + 1] != 3 || blocks.data()[16 + 2 * 4 + 2] != 7 || blocks.to_dense() != m)
+			throw std::runtime_error("TEST_1 in 'tensor_block_sparse_testing_suit' failed!\n");
+
+		for (std::size_t i = 0; i < 8; i++)
+			for (std::size_t j = 0; j < 12; j++)
+				if (blocks(i, j) != m[i][j] || (blocks.find(i, j) != nullptr) != ((i < 4 && j >= 8) || (i >= 4 && j < 4)))
+					throw std::runtime_error("TEST_1 in 'tensor_block_sparse_testing_suit' failed!\n");
+
+		// Blocks given by their indices start as zeros, each stored once.
+		//
+		const std::vector<std::array<std::size_t, 2>> kept{ { 3, 1 }, { 0, 2 }, { 3, 1 }, { 1, 0 } };
+		block_sparse_matrix<double, 8, 8> weights(execution::par, { 32, 24 }, kept);
+
+		if (weights.block_count() != 3 || weights(25, 9) != 0.0 || weights.find(25, 9) == nullptr || weights.find(0, 0) != nullptr)
+			throw std::runtime_error("TEST_1 in 'tensor_block_sparse_testing_suit' failed!\n");
+
+		*weights.find(25, 9) = 2.5;
+
+		if (weights(25, 9) != 2.5 || weights.data()[2 * 64 + 1 * 8 + 1] != 2.5)
+			throw std::runtime_error("TEST_1 in 'tensor_block_sparse_testing_suit' failed!\n");
+
+		// Sizes have to be multiples of the block sizes.
+		//
+		bool caught = false;
+
+		try
+		{
+			block_sparse_matrix<float, 4, 8> wrong(8, 12);
+		}
+		catch (const std::runtime_error&)
+		{
+			caught = true;
+		}
+
+		if (!caught)
+			throw std::runtime_error("TEST_1 in 'tensor_block_sparse_testing_suit' failed!\n");
+
+		// Block indices count blocks and not elements, and have to be inside the matrix.
+		//
+		const std::vector<std::array<std::size_t, 2>> outside{ { 0, 0 }, { 4, 0 } };
+		std::string message;
+
+		try
+		{
+			block_sparse_matrix<double, 8, 8> wrong(execution::par, { 32, 24 }, outside);
+		}
+		catch (const std::runtime_error& error)
+		{
+			message = error.what();
+		}
+
+		if (message != "Block index of a block sparse matrix is out of range!")
+			throw std::runtime_error("TEST_1 in 'tensor_block_sparse_testing_suit' failed!\n");
+
+		std::cout << "\tTEST 1 PASSED.\n";
+	}
+
+	void TEST_2()
+	{
+		tensor<float, 2> m(48, 64);
+		std::iota(m.begin(), m.end(), 1.0f);
+
+		// Every other block is zero, in a checkerboard.
+		//
+		for (std::size_t i = 0; i < 48; i++)
+			for (std::size_t j = 0; j < 64; j++)
+				if ((i / 16 + j / 16) % 2 == 1)
+					m[i][j] = 0.0f;
+
+		block_sparse_matrix<float> blocks(m);
+
+		// Stored blocks are dense tensor objects that know where they start, in storage order.
+		//
+		std::size_t count = 0;
+
+		for (const auto block : std::as_const(blocks).tiles())
+		{
+			if (block.order_of_dimension(0) != 16 || block.order_of_dimension(1) != 16 || &block[0][0] != blocks.data() + count * 256
+				|| (block.origin(0) / 16 + block.origin(1) / 16) % 2 != 0)
+				throw std::runtime_error("TEST_2 in 'tensor_block_sparse_testing_suit' failed!\n");
+
+			for (std::size_t i = 0; i < 16; i++)
+				for (std::size_t j = 0; j < 16; j++)
+					if (block[i][j] != m[block.origin(0) + i][block.origin(1) + j])
+						throw std::runtime_error("TEST_2 in 'tensor_block_sparse_testing_suit' failed!\n");
+
+			count++;
+		}
+
+		// The last stored block is the one at (32, 32).
+		//
+		float expected = 0.0f;
+
+		for (std::size_t i = 32; i < 48; i++)
+			for (std::size_t j = 32; j < 48; j++)
+				expected += m[i][j];
+
+		if (count != 6 || blocks.tiles().size() != 6 || sum(blocks.tiles()[5]) != expected)
+			throw std::runtime_error("TEST_2 in 'tensor_block_sparse_testing_suit' failed!\n");
+
+		// Kernels on the blocks write through to the matrix, in parallel too.
+		//
+		for_each_tile(execution::par, blocks, [](auto& block)
+		{
+			block *= 2.0f;
+			block[0][0] = static_cast<float>(block.origin(0) + block.origin(1));
+		});
+
+		for (std::size_t i = 0; i < 48; i++)
+			for (std::size_t j = 0; j < 64; j++)
+				if (blocks(i, j) != ((i % 16 == 0 && j % 16 == 0 && m[i][j] != 0.0f) ? static_cast<float>(i + j) : 2.0f * m[i][j]))
+					throw std::runtime_error("TEST_2 in 'tensor_block_sparse_testing_suit' failed!\n");
+
+		std::cout << "\tTEST 2 PASSED.\n";
+	}
+
+	void TEST_3()
+	{
+		std::mt19937 generator(11);
+
+		// A 128x96 matrix of 32x32 blocks with about a third of them kept, products with dense matrices on both sides.
+		//
+		tensor<float, 2> w(128, 96);
+		std::fill(w.begin(), w.end(), 0.0f);
+
+		for (std::size_t block_row = 0; block_row < 4; block_row++)
+			for (std::size_t block_column = 0; block_column < 3; block_column++)
+				if (generator() % 3 == 0 || block_row == block_column)
+					for (std::size_t i = 0; i < 32; i++)
+						for (std::size_t j = 0; j < 32; j++)
+							w[block_row * 32 + i][block_column * 32 + j] = static_cast<float>(generator() % 9) - 4.0f;
+
+		const block_sparse_matrix<float, 32, 32> blocks(w);
+
+		tensor<float, 2> x(96, 50);
+		tensor<float, 2> y(300, 128);
+		std::generate(x.begin(), x.end(), [&generator]() { return static_cast<float>(generator() % 5); });
+		std::generate(y.begin(), y.end(), [&generator]() { return static_cast<float>(generator() % 5); });
+
+		const tensor<float, 2> wx = matmul(w, x);
+		const tensor<float, 2> yw = matmul(y, w);
+
+		if (matmul(blocks, x) != wx || matmul(execution::par, blocks, x) != wx || matmul(y, blocks) != yw || matmul(execution::par, y, blocks) != yw)
+			throw std::runtime_error("TEST_3 in 'tensor_block_sparse_testing_suit' failed!\n");
+
+		// No stored block at all gives zeros.
+		//
+		const block_sparse_matrix<float, 32, 32> empty(128, 96);
+		const tensor<float, 2> zeros = matmul(execution::par, empty, x);
+
+		if (std::any_of(zeros.begin(), zeros.end(), [](const float element) { return element != 0.0f; }))
+			throw std::runtime_error("TEST_3 in 'tensor_block_sparse_testing_suit' failed!\n");
+
+		bool caught = false;
+
+		try
+		{
+			matmul(blocks, y);
+		}
+		catch (const std::runtime_error&)
+		{
+			caught = true;
+		}
+
+		if (!caught)
+			throw std::runtime_error("TEST_3 in 'tensor_block_sparse_testing_suit' failed!\n");
+
+		// The accumulating kernel adds the product to what's there.
+		//
+		tensor<double, 2> a(20, 30), b(30, 40), c(20, 40, 1.0);
+		std::iota(a.begin(), a.end(), 0.0);
+		std::iota(b.begin(), b.end(), 0.0);
+
+		kernels::gemm<true>(20, 40, 30, a.data(), 30, std::size_t{ 1 }, b.data(), 40, std::size_t{ 1 }, c.data(), 40);
+
+		const tensor<double, 2> product = matmul(a, b);
+
+		for (std::size_t i = 0; i < 20; i++)
+			for (std::size_t j = 0; j < 40; j++)
+				if (c[i][j] != product[i][j] + 1.0)
+					throw std::runtime_error("TEST_3 in 'tensor_block_sparse_testing_suit' failed!\n");
+
+		std::cout << "\tTEST 3 PASSED.\n";
+	}
+
+	void RUN_ALL()
+	{
+		std::cout << "Running tensor block sparse tests...\n\n";
+
+		TEST_1();
+		TEST_2();
+		TEST_3();
+
+		std::cout << "\n";
+	}
+}
@@ -0,0 +1,189 @@
+#pragma once
+
+#include "../../../inc/tensor.hpp"
+#include "../../../inc/tensor_execution.hpp"
+#include "../../../inc/tensor_expressions.hpp"
+#include "../../../inc/tensor_static.hpp"
+
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+
+namespace tensor_broadcasting_testing_suit
+{
+	using namespace tensor_lib;
+
+	void TEST_1()
+	{
+		tensor<int, 2> m(3, 4);
+		tensor<int, 1> row(4);
+		tensor<int, 2> column(3, 1);
+
+		std::iota(m.begin(), m.end(), 0);
+		std::iota(row.begin(), row.end(), 100);
+		std::iota(column.begin(), column.end(), 10);
+
+		// A lower rank operand is aligned on the last axis, an axis of extent 1 is repeated.
+		//
+		const tensor<int, 2> with_row = m + row;
+		const tensor<int, 2> with_column = m * column;
+		const tensor<int, 2> outer = column - row;
+		const tensor<int, 2> chained = (m + row) * column + 1;
+
+		if (outer.order_of_dimension(0) != 3 || outer.order_of_dimension(1) != 4)
+			throw std::runtime_error("TEST_1 in 'tensor_broadcasting_testing_suit' failed!\n");
+
+		for (std::size_t i = 0; i < 3; i++)
+			for (std::size_t j = 0; j < 4; j++)
+				if (with_row[i][j] != m[i][j] + row[j] || with_column[i][j] != m[i][j] * column[i][0] || outer[i][j] != column[i][0] - row[j]
+					|| chained[i][j] != (m[i][j] + row[j]) * column[i][0] + 1)
+					throw std::runtime_error("TEST_1 in 'tensor_broadcasting_testing_suit' failed!\n");
+
+		// Rank 3 against rank 1 and rank 2 operands, with chunks crossing many short rows.
+		//
+		tensor<float, 3> cube(7, 300, 3);
+		tensor<float, 1> bias(3);
+		tensor<float, 2> plane(300, 1);
+
+		std::iota(cube.begin(), cube.end(), 0.0f);
+		std::iota(bias.begin(), bias.end(), 1.0f);
+		std::iota(plane.begin(), plane.end(), -5.0f);
+
+		const tensor<float, 3> shifted = cube * bias + plane;
+
+		for (std::size_t i = 0; i < 7; i++)
+			for (std::size_t j = 0; j < 300; j++)
+				for (std::size_t k = 0; k < 3; k++)
+					if (shifted[i][j][k] != cube[i][j][k] * bias[k] + plane[j][0])
+						throw std::runtime_error("TEST_1 in 'tensor_broadcasting_testing_suit' failed!\n");
+
+		// Elements that aren't evaluated by chunks go through the same indexing.
+		//
+		tensor<std::string, 2> words(2, 2);
+		tensor<std::string, 1> suffixes(2);
+		words[0][0] = "a";
+		words[0][1] = "b";
+		words[1][0] = "c";
+		words[1][1] = "d";
+		suffixes[0] = "x";
+		suffixes[1] = "y";
+
+		const tensor<std::string, 2> joined = words + suffixes;
+
+		if (joined[0][0] != "ax" || joined[0][1] != "by" || joined[1][0] != "cx" || joined[1][1] != "dy")
+			throw std::runtime_error("TEST_1 in 'tensor_broadcasting_testing_suit' failed!\n");
+
+		std::cout << "\tTEST 1 PASSED.\n";
+	}
+
+	void TEST_2()
+	{
+		tensor<int, 2> m(3, 4);
+		tensor<int, 2> other(3, 3);
+		std::iota(m.begin(), m.end(), 1);
+
+		bool caught = false;
+
+		try { m = m + other; }
+		catch (const std::runtime_error&) { caught = true; }
+
+		if (!caught)
+			throw std::runtime_error("TEST_2 in 'tensor_broadcasting_testing_suit' failed!\n");
+
+		// The broadcast row is part of the destination, it must be read before being overwritten.
+		//
+		const tensor<int, 2> original = m;
+		const tensor<int, 1> first_row = m[0];
+
+		m = m + m[0];
+
+		for (std::size_t i = 0; i < 3; i++)
+			for (std::size_t j = 0; j < 4; j++)
+				if (m[i][j] != original[i][j] + first_row[j])
+					throw std::runtime_error("TEST_2 in 'tensor_broadcasting_testing_suit' failed!\n");
+
+		m = original;
+		m -= m[2];
+
+		for (std::size_t i = 0; i < 3; i++)
+			for (std::size_t j = 0; j < 4; j++)
+				if (m[i][j] != original[i][j] - original[2][j])
+					throw std::runtime_error("TEST_2 in 'tensor_broadcasting_testing_suit' failed!\n");
+
+		// A destination that would have to grow to hold the broadcast result is an error, and is left as it was.
+		//
+		tensor<int, 2> row(1, 4);
+		std::iota(row.begin(), row.end(), 10);
+		const tensor<int, 2> row_original = row;
+
+		caught = false;
+
+		try { row += m; }
+		catch (const std::runtime_error&) { caught = true; }
+
+		if (!caught || row != row_original)
+			throw std::runtime_error("TEST_2 in 'tensor_broadcasting_testing_suit' failed!\n");
+
+		caught = false;
+
+		try { assign(execution::par, row, row * m); }
+		catch (const std::runtime_error&) { caught = true; }
+
+		if (!caught || row != row_original)
+			throw std::runtime_error("TEST_2 in 'tensor_broadcasting_testing_suit' failed!\n");
+
+		tensor<double, 2> big(256, 1024);
+		std::iota(big.begin(), big.end(), 0.0);
+		const tensor<double, 2> big_original = big;
+
+		assign(execution::par, big, big * big[1]);
+
+		for (std::size_t i = 0; i < 256; i++)
+			for (std::size_t j = 0; j < 1024; j++)
+				if (big[i][j] != big_original[i][j] * big_original[1][j])
+					throw std::runtime_error("TEST_2 in 'tensor_broadcasting_testing_suit' failed!\n");
+
+		std::cout << "\tTEST 2 PASSED.\n";
+	}
+
+	void TEST_3()
+	{
+		tensor<int, 3> cube(2, 3, 4, 1);
+		tensor<int, 1> row(4);
+		std::iota(row.begin(), row.end(), 0);
+
+		// Subdimension destinations keep their shape, so the expression must have it.
+		//
+		cube[1] = cube[1] + row;
+		cube[0] += row * 2;
+
+		for (std::size_t j = 0; j < 3; j++)
+			for (std::size_t k = 0; k < 4; k++)
+				if (cube[0][j][k] != 1 + 2 * row[k] || cube[1][j][k] != 1 + row[k])
+					throw std::runtime_error("TEST_3 in 'tensor_broadcasting_testing_suit' failed!\n");
+
+		// Static tensors broadcast like any other tensor object.
+		//
+		static_matrix<int, 2, 3> s = { { 1, 2, 3 }, { 4, 5, 6 } };
+		static_tensor<int, 3> offsets = { 10, 20, 30 };
+
+		const static_matrix<int, 2, 3> moved = s + offsets;
+
+		if (moved(0, 0) != 11 || moved(0, 2) != 33 || moved(1, 1) != 25)
+			throw std::runtime_error("TEST_3 in 'tensor_broadcasting_testing_suit' failed!\n");
+
+		std::cout << "\tTEST 3 PASSED.\n";
+	}
+
+	void RUN_ALL()
+	{
+		std::cout << "Running tensor broadcasting tests...\n\n";
+
+		TEST_1();
+		TEST_2();
+		TEST_3();
+
+		std::cout << "\n";
+	}
+}
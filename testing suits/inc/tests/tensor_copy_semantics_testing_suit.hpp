@@ -0,0 +1,156 @@
+#pragma once
+
+#include "../../../inc/tensor.hpp"
+
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+
+namespace tensor_copy_semantics_testing_suit
+{
+	using namespace tensor_lib;
+
+	// Copy construction and copy assignment throw once 'copies_left' reaches zero.
+	//
+	struct THROWING_COPY
+	{
+		static inline int copies_left = 1000;
+
+		int value = 0;
+
+		THROWING_COPY() = default;
+
+		THROWING_COPY(const int init) : value{ init } {}
+
+		THROWING_COPY(const THROWING_COPY& other) : value{ other.value }
+		{
+			if (--copies_left < 0)
+				throw std::runtime_error("Copy failed!");
+		}
+
+		THROWING_COPY& operator=(const THROWING_COPY& other)
+		{
+			if (--copies_left < 0)
+				throw std::runtime_error("Copy failed!");
+
+			value = other.value;
+			return *this;
+		}
+	};
+
+	void TEST_1()
+	{
+		tensor<float, 3> source(4, 5, 6), destination(4, 5, 6);
+		std::iota(source.begin(), source.end(), 0.0f);
+
+		const float* buffer = destination.data();
+		destination = source;
+
+		if (destination.data() != buffer || !(destination == source))
+			throw std::runtime_error("TEST_1 in 'tensor_copy_semantics_testing_suit' failed!\n");
+
+		// Same number of elements in a different shape, and a subdimension of the same size: the buffer is reused as well.
+		//
+		tensor<float, 3> reshaped(2, 10, 6);
+		reshaped = source;
+
+		tensor<float, 4> stack(3, 2, 60, 1);
+		std::iota(stack.begin(), stack.end(), 0.0f);
+		buffer = reshaped.data();
+		reshaped = stack[2];
+
+		if (reshaped.data() != buffer || reshaped.order_of_dimension(0) != 2 || reshaped.order_of_dimension(1) != 60 || reshaped(1, 59, 0) != 359.0f)
+			throw std::runtime_error("TEST_1 in 'tensor_copy_semantics_testing_suit' failed!\n");
+
+		const tensor<float, 3>& alias = destination;
+		destination = alias;
+
+		if (destination.data() == nullptr || !(destination == source))
+			throw std::runtime_error("TEST_1 in 'tensor_copy_semantics_testing_suit' failed!\n");
+
+		std::cout << "\tTEST 1 PASSED.\n";
+	}
+
+	void TEST_2()
+	{
+		tensor<std::string, 2> words(2, 3, std::string(40, 'a')), other(5, 5, std::string(40, 'b'));
+		const tensor<std::string, 2> empty;
+
+		other = words;
+
+		if (!(other == words) || other.order_of_dimension(0) != 2)
+			throw std::runtime_error("TEST_2 in 'tensor_copy_semantics_testing_suit' failed!\n");
+
+		other = empty;
+
+		if (!other.empty() || other.data() != nullptr)
+			throw std::runtime_error("TEST_2 in 'tensor_copy_semantics_testing_suit' failed!\n");
+
+		const tensor<std::string, 3> cube(2, 1, 3, std::string(40, 'c'));
+		other = cube[1];
+
+		if (other.order_of_dimension(0) != 1 || other.order_of_dimension(1) != 3 || other[0][2] != cube[1][0][2])
+			throw std::runtime_error("TEST_2 in 'tensor_copy_semantics_testing_suit' failed!\n");
+
+		std::cout << "\tTEST 2 PASSED.\n";
+	}
+
+	void TEST_3()
+	{
+		// A copy that fails halfway leaves the destination as it was, whether its size changes or not.
+		//
+		tensor<THROWING_COPY, 2> source(3, 4), same_size(4, 3), other_size(2, 2);
+
+		for (std::size_t index = 0; index < 12; index++)
+		{
+			source.data()[index] = static_cast<int>(index);
+			same_size.data()[index] = -1;
+		}
+
+		for (tensor<THROWING_COPY, 2>* destination : { &same_size, &other_size })
+		{
+			const auto ranks = destination->get_ranks();
+			const std::size_t rows = ranks[0], columns = ranks[1];
+			bool thrown = false;
+
+			THROWING_COPY::copies_left = 5;
+
+			try
+			{
+				*destination = source;
+			}
+			catch (const std::runtime_error&)
+			{
+				thrown = true;
+			}
+
+			THROWING_COPY::copies_left = 1000;
+
+			if (!thrown || destination->order_of_dimension(0) != rows || destination->order_of_dimension(1) != columns)
+				throw std::runtime_error("TEST_3 in 'tensor_copy_semantics_testing_suit' failed!\n");
+
+			for (const auto& element : *destination)
+				if (destination == &same_size && element.value != -1)
+					throw std::runtime_error("TEST_3 in 'tensor_copy_semantics_testing_suit' failed!\n");
+		}
+
+		same_size = source;
+
+		if (same_size(2, 3).value != 11 || same_size.order_of_dimension(0) != 3)
+			throw std::runtime_error("TEST_3 in 'tensor_copy_semantics_testing_suit' failed!\n");
+
+		std::cout << "\tTEST 3 PASSED.\n";
+	}
+
+	void RUN_ALL()
+	{
+		std::cout << "Running tensor copy semantics tests...\n\n";
+
+		TEST_1();
+		TEST_2();
+		TEST_3();
+
+		std::cout << "\n";
+	}
+}
@@ -0,0 +1,282 @@
+#pragma once
+
+#include "../../../inc/tensor.hpp"
+#include "../../../inc/tensor_einsum.hpp"
+#include "../../../inc/tensor_matmul.hpp"
+#include "../../../inc/tensor_view.hpp"
+
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+
+namespace tensor_einsum_testing_suit
+{
+	using namespace tensor_lib;
+
+	// Small integer values keep every partial sum exact, so the GEMM based contractions must match the loops bit for bit.
+	//
+	template <typename T, std::size_t Rank>
+	void FILL(tensor<T, Rank>& tsor, const int seed)
+	{
+		int value = seed;
+
+		for (auto& element : tsor)
+		{
+			element = static_cast<T>(value % 7 - 3);
+			value += 5;
+		}
+	}
+
+	void TEST_1()
+	{
+		tensor<int, 2> a(4, 5);
+		tensor<int, 2> b(5, 3);
+		tensor<int, 2> square(4, 4);
+		tensor<int, 1> u(4);
+		tensor<int, 1> v(3);
+
+		FILL(a, 1);
+		FILL(b, 2);
+		FILL(square, 3);
+		FILL(u, 4);
+		FILL(v, 5);
+
+		const auto product = matmul(a, b);
+
+		if (einsum<"ij,jk->ik">(a, b) != product || einsum<"ij,jk">(a, b) != product || einsum<"ji,jk->ik">(transpose(a), b) != product)
+			throw std::runtime_error("TEST_1 in 'tensor_einsum_testing_suit' failed!\n");
+
+		// Single operand forms: transpose, trace, diagonal and sums.
+		//
+		const tensor<int, 2> transposed = einsum<"ij->ji">(a);
+		const int trace = einsum<"ii->">(square);
+		const tensor<int, 1> diagonal = einsum<"ii->i">(square);
+		const int total = einsum<"ij->">(a);
+		const tensor<int, 1> column_sums = einsum<"ij->j">(a);
+
+		int expected_trace = 0;
+
+		for (std::size_t i = 0; i < 4; i++)
+		{
+			expected_trace += square[i][i];
+
+			if (diagonal[i] != square[i][i])
+				throw std::runtime_error("TEST_1 in 'tensor_einsum_testing_suit' failed!\n");
+		}
+
+		if (trace != expected_trace || total != std::accumulate(a.begin(), a.end(), 0))
+			throw std::runtime_error("TEST_1 in 'tensor_einsum_testing_suit' failed!\n");
+
+		for (std::size_t i = 0; i < 4; i++)
+			for (std::size_t j = 0; j < 5; j++)
+				if (transposed[j][i] != a[i][j])
+					throw std::runtime_error("TEST_1 in 'tensor_einsum_testing_suit' failed!\n");
+
+		for (std::size_t j = 0; j < 5; j++)
+		{
+			int sum = 0;
+
+			for (std::size_t i = 0; i < 4; i++)
+				sum += a[i][j];
+
+			if (column_sums[j] != sum)
+				throw std::runtime_error("TEST_1 in 'tensor_einsum_testing_suit' failed!\n");
+		}
+
+		// Outer and inner products.
+		//
+		const tensor<int, 2> outer = einsum<"i,j->ij">(u, v);
+		const int dot = einsum<"i,i">(u, u);
+
+		int expected_dot = 0;
+
+		for (std::size_t i = 0; i < 4; i++)
+		{
+			expected_dot += u[i] * u[i];
+
+			for (std::size_t j = 0; j < 3; j++)
+				if (outer[i][j] != u[i] * v[j])
+					throw std::runtime_error("TEST_1 in 'tensor_einsum_testing_suit' failed!\n");
+		}
+
+		if (dot != expected_dot)
+			throw std::runtime_error("TEST_1 in 'tensor_einsum_testing_suit' failed!\n");
+
+		std::cout << "\tTEST 1 PASSED.\n";
+	}
+
+	void TEST_2()
+	{
+		tensor<double, 4> a(3, 4, 5, 6);
+		tensor<double, 4> b(5, 6, 2, 3);
+		tensor<double, 3> c(6, 5, 2);
+
+		FILL(a, 1);
+		FILL(b, 2);
+		FILL(c, 3);
+
+		// Read in place by a single GEMM.
+		//
+		const tensor<double, 4> ab = einsum<"ijkl,klmn->ijmn">(a, b);
+
+		for (std::size_t i = 0; i < 3; i++)
+			for (std::size_t j = 0; j < 4; j++)
+				for (std::size_t m = 0; m < 2; m++)
+					for (std::size_t n = 0; n < 3; n++)
+					{
+						double sum = 0.0;
+
+						for (std::size_t k = 0; k < 5; k++)
+							for (std::size_t l = 0; l < 6; l++)
+								sum += a[i][j][k][l] * b[k][l][m][n];
+
+						if (ab[i][j][m][n] != sum)
+							throw std::runtime_error("TEST_2 in 'tensor_einsum_testing_suit' failed!\n");
+					}
+
+		// The contracted axes of 'c' are in the other order and the output is permuted, so 'c' and the product are copied.
+		//
+		const tensor<double, 3> ac = einsum<"ijkl,lkm->mji">(a, c);
+
+		if (ac.order_of_dimension(0) != 2 || ac.order_of_dimension(1) != 4 || ac.order_of_dimension(2) != 3)
+			throw std::runtime_error("TEST_2 in 'tensor_einsum_testing_suit' failed!\n");
+
+		for (std::size_t i = 0; i < 3; i++)
+			for (std::size_t j = 0; j < 4; j++)
+				for (std::size_t m = 0; m < 2; m++)
+				{
+					double sum = 0.0;
+
+					for (std::size_t k = 0; k < 5; k++)
+						for (std::size_t l = 0; l < 6; l++)
+							sum += a[i][j][k][l] * c[l][k][m];
+
+					if (ac[m][j][i] != sum)
+						throw std::runtime_error("TEST_2 in 'tensor_einsum_testing_suit' failed!\n");
+				}
+
+		// Batch labels, a transposed right operand, and labels summed or repeated within one operand.
+		//
+		tensor<double, 3> x(3, 4, 5);
+		tensor<double, 3> y(3, 6, 5);
+		tensor<double, 3> z(3, 4, 4);
+
+		FILL(x, 4);
+		FILL(y, 5);
+		FILL(z, 6);
+
+		const tensor<double, 3> xy = einsum<"bij,bkj->bik">(x, y);
+		const tensor<double, 2> summed = einsum<"bij,ckj->ik">(x, y);
+		const tensor<double, 2> traced = einsum<"bii,bkj->kj">(z, y);
+
+		for (std::size_t i = 0; i < 4; i++)
+			for (std::size_t k = 0; k < 6; k++)
+			{
+				double all_batches = 0.0;
+
+				for (std::size_t batch = 0; batch < 3; batch++)
+				{
+					double sum = 0.0;
+
+					for (std::size_t j = 0; j < 5; j++)
+						sum += x[batch][i][j] * y[batch][k][j];
+
+					if (xy[batch][i][k] != sum)
+						throw std::runtime_error("TEST_2 in 'tensor_einsum_testing_suit' failed!\n");
+
+					for (std::size_t other = 0; other < 3; other++)
+						for (std::size_t j = 0; j < 5; j++)
+							all_batches += x[batch][i][j] * y[other][k][j];
+				}
+
+				if (summed[i][k] != all_batches)
+					throw std::runtime_error("TEST_2 in 'tensor_einsum_testing_suit' failed!\n");
+			}
+
+		for (std::size_t k = 0; k < 6; k++)
+			for (std::size_t j = 0; j < 5; j++)
+			{
+				double sum = 0.0;
+
+				for (std::size_t batch = 0; batch < 3; batch++)
+					for (std::size_t i = 0; i < 4; i++)
+						sum += z[batch][i][i] * y[batch][k][j];
+
+				if (traced[k][j] != sum)
+					throw std::runtime_error("TEST_2 in 'tensor_einsum_testing_suit' failed!\n");
+			}
+
+		std::cout << "\tTEST 2 PASSED.\n";
+	}
+
+	void TEST_3()
+	{
+		tensor<double, 4> a(3, 4, 5, 6);
+		tensor<double, 4> b(5, 6, 2, 3);
+		tensor<double, 3> c(6, 5, 2);
+		tensor<double, 1> u(3);
+		tensor<double, 1> v(2);
+
+		FILL(a, 1);
+		FILL(b, 2);
+		FILL(c, 3);
+		FILL(u, 4);
+		FILL(v, 5);
+
+		if (tensordot<2>(a, b) != einsum<"ijkl,klmn->ijmn">(a, b) || tensordot(a, c, { 3, 2 }, { 0, 1 }) != einsum<"ijkl,lkm->ijm">(a, c))
+			throw std::runtime_error("TEST_3 in 'tensor_einsum_testing_suit' failed!\n");
+
+		if (tensordot<1>(a[0][0], c) != einsum<"kl,lmn->kmn">(a[0][0], c) || tensordot<0>(u, v) != einsum<"i,j->ij">(u, v))
+			throw std::runtime_error("TEST_3 in 'tensor_einsum_testing_suit' failed!\n");
+
+		if (tensordot<1>(u, u) != einsum<"i,i->">(u, u))
+			throw std::runtime_error("TEST_3 in 'tensor_einsum_testing_suit' failed!\n");
+
+		// Contracted axes of different sizes, repeated axes and axes out of range.
+		//
+		bool caught = false;
+
+		try { einsum<"ij,ij->i">(a[0][0], c[0]); }
+		catch (const std::runtime_error&) { caught = true; }
+
+		if (!caught)
+			throw std::runtime_error("TEST_3 in 'tensor_einsum_testing_suit' failed!\n");
+
+		caught = false;
+
+		try { einsum<"ii->i">(a[0][0]); }
+		catch (const std::runtime_error&) { caught = true; }
+
+		if (!caught)
+			throw std::runtime_error("TEST_3 in 'tensor_einsum_testing_suit' failed!\n");
+
+		caught = false;
+
+		try { tensordot(a, c, { 2, 2 }, { 0, 1 }); }
+		catch (const std::runtime_error&) { caught = true; }
+
+		if (!caught)
+			throw std::runtime_error("TEST_3 in 'tensor_einsum_testing_suit' failed!\n");
+
+		caught = false;
+
+		try { tensordot(a, c, { 4 }, { 0 }); }
+		catch (const std::runtime_error&) { caught = true; }
+
+		if (!caught)
+			throw std::runtime_error("TEST_3 in 'tensor_einsum_testing_suit' failed!\n");
+
+		std::cout << "\tTEST 3 PASSED.\n";
+	}
+
+	void RUN_ALL()
+	{
+		std::cout << "Running tensor einsum tests...\n\n";
+
+		TEST_1();
+		TEST_2();
+		TEST_3();
+
+		std::cout << "\n";
+	}
+}
@@ -0,0 +1,176 @@
+#pragma once
+
+#include "../../../inc/tensor.hpp"
+#include "../../../inc/tensor_execution.hpp"
+#include "../../../inc/tensor_expressions.hpp"
+#include "../../../inc/tensor_matmul.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+namespace tensor_execution_testing_suit
+{
+	using namespace tensor_lib;
+
+	void TEST_1()
+	{
+		execution::thread_pool pool(4);
+		std::vector<std::atomic<int>> visits(10007);
+
+		pool.parallel_for(visits.size(), 16, [&visits](const std::size_t first, const std::size_t last)
+		{
+			if (last - first > 16)
+				throw std::runtime_error("TEST_1 in 'tensor_execution_testing_suit' failed!\n");
+
+			for (std::size_t index = first; index < last; index++)
+				visits[index]++;
+		});
+
+		if (!std::all_of(visits.begin(), visits.end(), [](const auto& count) { return count.load() == 1; }))
+			throw std::runtime_error("TEST_1 in 'tensor_execution_testing_suit' failed!\n");
+
+		// Nested loops run on the same pool without deadlocking.
+		//
+		std::atomic<std::size_t> total = 0;
+
+		pool.parallel_for(8, 1, [&pool, &total](const std::size_t first, const std::size_t last)
+		{
+			for (std::size_t outer = first; outer < last; outer++)
+			{
+				pool.parallel_for(100, 10, [&total](const std::size_t inner_first, const std::size_t inner_last)
+				{
+					total += inner_last - inner_first;
+				});
+			}
+		});
+
+		if (total != 800)
+			throw std::runtime_error("TEST_1 in 'tensor_execution_testing_suit' failed!\n");
+
+		std::cout << "\tTEST 1 PASSED.\n";
+	}
+
+	void TEST_2()
+	{
+		execution::thread_pool pool(3);
+		std::atomic<std::size_t> done = 0;
+		bool thrown = false;
+
+		try
+		{
+			pool.parallel_for(1000, 10, [&done](const std::size_t first, const std::size_t last)
+			{
+				if (first <= 500 && 500 < last)
+					throw std::runtime_error("expected");
+
+				done += last - first;
+			});
+		}
+		catch (const std::runtime_error&)
+		{
+			thrown = true;
+		}
+
+		// The exception only surfaces once every other task has finished.
+		//
+		if (!thrown || done < 990 || done >= 1000)
+			throw std::runtime_error("TEST_2 in 'tensor_execution_testing_suit' failed!\n");
+
+		std::cout << "\tTEST 2 PASSED.\n";
+	}
+
+	void TEST_3()
+	{
+		execution::set_thread_count(4);
+		execution::set_grain_size(1000);
+
+		if (execution::thread_count() != 4 || execution::grain_size() != 1000)
+			throw std::runtime_error("TEST_3 in 'tensor_execution_testing_suit' failed!\n");
+
+		tensor<float, 3> a(6, 70, 90), b(6, 70, 90, 2.0f), c(6, 70, 90, 0.5f);
+		std::iota(a.begin(), a.end(), 0.0f);
+
+		tensor<float, 3> expected = a * b + c;
+		tensor<float, 3> result;
+
+		assign(execution::par, result, a * b + c); // an empty tensor takes the shape of the expression
+
+		if (!(result == expected))
+			throw std::runtime_error("TEST_3 in 'tensor_execution_testing_suit' failed!\n");
+
+		assign(execution::par_unseq, result[2], result[2] - c[2]); // the destination is also read by the expression
+
+		for (std::size_t index = 0; index < 70 * 90; index++)
+			if (result[2].data()[index] != expected[2].data()[index] - 0.5f)
+				throw std::runtime_error("TEST_3 in 'tensor_execution_testing_suit' failed!\n");
+
+		fill(execution::par, result, 3);
+
+		if (!std::all_of(result.cbegin(), result.cend(), [](const float val) { return val == 3.0f; }))
+			throw std::runtime_error("TEST_3 in 'tensor_execution_testing_suit' failed!\n");
+
+		copy(execution::par, a, result);
+
+		if (!(result == a))
+			throw std::runtime_error("TEST_3 in 'tensor_execution_testing_suit' failed!\n");
+
+		bool thrown = false;
+
+		try
+		{
+			copy(execution::par, tensor<float, 2>(3, 3), result[1]);
+		}
+		catch (const std::runtime_error&)
+		{
+			thrown = true;
+		}
+
+		if (!thrown)
+			throw std::runtime_error("TEST_3 in 'tensor_execution_testing_suit' failed!\n");
+
+		std::cout << "\tTEST 3 PASSED.\n";
+	}
+
+	void TEST_4()
+	{
+		tensor<double, 2> a(300, 170), b(170, 90);
+
+		for (std::size_t index = 0; index < a.size_of_current_tensor(); index++)
+			a.data()[index] = static_cast<double>(static_cast<int>(index % 7) - 3);
+
+		for (std::size_t index = 0; index < b.size_of_current_tensor(); index++)
+			b.data()[index] = static_cast<double>(static_cast<int>(index % 5) - 2);
+
+		const auto expected = matmul(execution::seq, a, b);
+
+		if (!(matmul(execution::par, a, b) == expected))
+			throw std::runtime_error("TEST_4 in 'tensor_execution_testing_suit' failed!\n");
+
+		tensor<double, 3> out(2, 300, 90);
+		matmul_into(execution::par_unseq, out[1], a, b);
+
+		if (!(out[1] == expected))
+			throw std::runtime_error("TEST_4 in 'tensor_execution_testing_suit' failed!\n");
+
+		execution::set_thread_count(std::thread::hardware_concurrency());
+		execution::set_grain_size(std::size_t{ 1 } << 15);
+
+		std::cout << "\tTEST 4 PASSED.\n";
+	}
+
+	void RUN_ALL()
+	{
+		std::cout << "Running tensor execution tests...\n\n";
+
+		TEST_1();
+		TEST_2();
+		TEST_3();
+		TEST_4();
+
+		std::cout << "\n";
+	}
+}
@@ -0,0 +1,158 @@
+#pragma once
+
+#include "../../../inc/tensor.hpp"
+#include "../../../inc/tensor_expressions.hpp"
+
+#include <algorithm>
+#include <array>
+#include <iostream>
+
+namespace tensor_expressions_testing_suit
+{
+	using namespace tensor_lib;
+
+	void TEST_1()
+	{
+		tensor<int, 2> a(2, 3), b(2, 3), c(2, 3), d(2, 3);
+		b = { { 1, 2, 3 }, { 4, 5, 6 } };
+		c = { { 2, 2, 2 }, { 3, 3, 3 } };
+		d = { { 1, 1, 1 }, { 1, 1, 1 } };
+
+		const int* buffer = a.data();
+
+		a = b * c + d;
+
+		std::array expected = { 3, 5, 7, 13, 16, 19 };
+
+		if (!std::equal(a.cbegin(), a.cend(), expected.cbegin()))
+			throw std::runtime_error("TEST_1 in 'tensor_expressions_testing_suit' failed!\n");
+
+		if (a.data() != buffer) // same shape, no reallocation
+			throw std::runtime_error("TEST_1 in 'tensor_expressions_testing_suit' failed!\n");
+
+		std::cout << "\tTEST 1 PASSED.\n";
+	}
+
+	void TEST_2()
+	{
+		tensor<double, 3> a(2, 2, 2), b(2, 2, 2);
+		std::fill(a.begin(), a.end(), 4.0);
+		std::fill(b.begin(), b.end(), 2.0);
+
+		tensor<double, 3> result = (a - b) / 2.0 + 1.0 - -sqrt(a);
+
+		if (!std::equal(result.get_ranks().begin(), result.get_ranks().end(), a.get_ranks().begin()))
+			throw std::runtime_error("TEST_2 in 'tensor_expressions_testing_suit' failed!\n");
+
+		for (const auto val : result)
+		{
+			if (val != 4.0)
+				throw std::runtime_error("TEST_2 in 'tensor_expressions_testing_suit' failed!\n");
+		}
+
+		std::cout << "\tTEST 2 PASSED.\n";
+	}
+
+	void TEST_3()
+	{
+		tensor<int, 3> tsor(2, 2, 3);
+		int aux = 0;
+		for (auto& val : tsor)
+		{
+			val = aux++;
+		}
+
+		tsor[1] = tsor[0] * 10 - 1;
+
+		std::array expected = { 0, 1, 2, 3, 4, 5, -1, 9, 19, 29, 39, 49 };
+
+		if (!std::equal(tsor.cbegin(), tsor.cend(), expected.cbegin()))
+			throw std::runtime_error("TEST_3 in 'tensor_expressions_testing_suit' failed!\n");
+
+		std::cout << "\tTEST 3 PASSED.\n";
+	}
+
+	void TEST_4()
+	{
+		tensor<int, 2> tsor(2, 3);
+		tsor = { { 1, -2, 3 }, { -4, 5, -6 } };
+
+		const auto& const_tsor = tsor;
+		tensor<int, 1> result = abs(const_tsor[1]) + 2 * const_tsor[0];
+
+		std::array expected = { 6, 1, 12 };
+
+		if (!std::equal(result.cbegin(), result.cend(), expected.cbegin()))
+			throw std::runtime_error("TEST_4 in 'tensor_expressions_testing_suit' failed!\n");
+
+		std::cout << "\tTEST 4 PASSED.\n";
+	}
+
+	void TEST_5()
+	{
+		tensor<int, 2> tsor(2, 2), other(2, 2);
+		tsor = { { 1, 2 }, { 3, 4 } };
+		other = { { 1, 1 }, { 2, 2 } };
+
+		tsor += other;
+		tsor[0] *= 3;
+		tsor -= 1;
+
+		std::array expected = { 5, 8, 4, 5 };
+
+		if (!std::equal(tsor.cbegin(), tsor.cend(), expected.cbegin()))
+			throw std::runtime_error("TEST_5 in 'tensor_expressions_testing_suit' failed!\n");
+
+		std::cout << "\tTEST 5 PASSED.\n";
+	}
+
+	void TEST_6()
+	{
+		tensor<int, 2> tsor(2, 3), other(3, 2);
+
+		try
+		{
+			tsor = tsor + other; // shapes differ
+		}
+		catch (...)
+		{
+			std::cout << "\tTEST 6 PASSED.\n";
+			return;
+		}
+
+		throw std::runtime_error("TEST_6 in 'tensor_expressions_testing_suit' failed!\n");
+	}
+
+	void TEST_7()
+	{
+		tensor<int, 2> tsor(2, 2), result;
+		tsor = { { 1, 2 }, { 3, 4 } };
+
+		result = tsor * tsor; // 'result' adopts the shape of the expression
+
+		std::array expected = { 1, 4, 9, 16 };
+
+		if (result.order_of_dimension(0) != 2 || result.order_of_dimension(1) != 2)
+			throw std::runtime_error("TEST_7 in 'tensor_expressions_testing_suit' failed!\n");
+
+		if (!std::equal(result.cbegin(), result.cend(), expected.cbegin()))
+			throw std::runtime_error("TEST_7 in 'tensor_expressions_testing_suit' failed!\n");
+
+		std::cout << "\tTEST 7 PASSED.\n";
+	}
+
+	void RUN_ALL()
+	{
+		std::cout << "Running tensor expressions tests...\n\n";
+
+		TEST_1();
+		TEST_2();
+		TEST_3();
+		TEST_4();
+		TEST_5();
+		TEST_6();
+		TEST_7();
+
+		std::cout << "\n";
+	}
+}
@@ -0,0 +1,159 @@
+#pragma once
+
+#include "../../../inc/tensor.hpp"
+#include "../../../inc/tensor_io.hpp"
+#include "../../../inc/tensor_static.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <filesystem>
+#include <iostream>
+#include <limits>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+namespace tensor_io_testing_suit
+{
+	using namespace tensor_lib;
+
+	static_assert(dtype_of_v<float> == dtype::float32 && dtype_of_v<double> == dtype::float64);
+	static_assert(dtype_of_v<std::int8_t> == dtype::int8 && dtype_of_v<std::uint16_t> == dtype::uint16 && dtype_of_v<std::int64_t> == dtype::int64);
+	static_assert(dtype_of_v<bool> == dtype::boolean && dtype_of_v<const std::uint32_t> == dtype::uint32);
+
+	template <typename Load>
+	bool THROWS(Load load)
+	{
+		try
+		{
+			load();
+		}
+		catch (const std::runtime_error&)
+		{
+			return true;
+		}
+
+		return false;
+	}
+
+	void TEST_1()
+	{
+		// Every bit of the elements survives, including values text output would round.
+		//
+		tensor<double, 3> cube(3, 4, 5);
+		std::iota(cube.begin(), cube.end(), 0.1);
+		cube(2, 3, 4) = std::numeric_limits<double>::denorm_min();
+
+		std::stringstream stream;
+		save(stream, cube);
+
+		if (stream.str().size() != 64 + cube.size_of_current_tensor() * sizeof(double))
+			throw std::runtime_error("TEST_1 in 'tensor_io_testing_suit' failed!\n");
+
+		const tensor<double, 3> loaded = load<double, 3>(stream);
+
+		if (!(loaded == cube) || loaded.order_of_dimension(2) != 5)
+			throw std::runtime_error("TEST_1 in 'tensor_io_testing_suit' failed!\n");
+
+		// Subdimensions, static tensors and empty tensors are saved the same way, several tensors can share a stream.
+		//
+		std::stringstream many;
+		const static_tensor<std::int16_t, 2, 3> small{ { 1, -2, 3 }, { -4, 5, -6 } };
+
+		save(many, cube[1]);
+		save(many, small);
+		save(many, tensor<float, 2>());
+
+		const tensor<double, 2> slice = load<double, 2>(many);
+		const tensor<std::int16_t, 2> matrix = load<std::int16_t, 2>(many);
+		const tensor<float, 2> empty = load<float, 2>(many);
+
+		if (slice(3, 4) != cube(1, 3, 4) || matrix(1, 2) != -6 || matrix.order_of_dimension(0) != 2 || !empty.empty())
+			throw std::runtime_error("TEST_1 in 'tensor_io_testing_suit' failed!\n");
+
+		std::cout << "\tTEST 1 PASSED.\n";
+	}
+
+	void TEST_2()
+	{
+		const std::filesystem::path path = std::filesystem::temp_directory_path() / "tensor_io_testing_suit.tnsr";
+
+		tensor<std::uint8_t, 4> pixels(2, 8, 8, 3);
+		std::iota(pixels.begin(), pixels.end(), std::uint8_t{ 0 });
+
+		save(path, pixels);
+		const tensor<std::uint8_t, 4> loaded = load<std::uint8_t, 4>(path);
+
+		if (!(loaded == pixels))
+			throw std::runtime_error("TEST_2 in 'tensor_io_testing_suit' failed!\n");
+
+		// Rank and element type are checked against the file.
+		//
+		if (!THROWS([&]() { load<std::uint8_t, 3>(path); }) || !THROWS([&]() { load<std::int8_t, 4>(path); }) || !THROWS([&]() { load<float, 4>(path); }))
+			throw std::runtime_error("TEST_2 in 'tensor_io_testing_suit' failed!\n");
+
+		std::filesystem::remove(path);
+
+		if (!THROWS([&]() { load<std::uint8_t, 4>(path); }))
+			throw std::runtime_error("TEST_2 in 'tensor_io_testing_suit' failed!\n");
+
+		std::cout << "\tTEST 2 PASSED.\n";
+	}
+
+	void TEST_3()
+	{
+		const tensor<std::uint32_t, 1> values{ 0x01020304u, 0xA0B0C0D0u };
+
+		std::stringstream stream;
+		save(stream, values);
+		const std::string bytes = stream.str();
+
+		// Truncated files and files that aren't tensor files are rejected.
+		//
+		std::stringstream truncated(bytes.substr(0, bytes.size() - 1)), header_only(bytes.substr(0, 20)), garbage(std::string(64, 'x'));
+
+		if (!THROWS([&]() { load<std::uint32_t, 1>(truncated); }) || !THROWS([&]() { load<std::uint32_t, 1>(header_only); }) || !THROWS([&]() { load<std::uint32_t, 1>(garbage); }))
+			throw std::runtime_error("TEST_3 in 'tensor_io_testing_suit' failed!\n");
+
+		// Sizes whose product wraps around are rejected instead of giving a tensor larger than its buffer.
+		//
+		std::stringstream pair_stream;
+		save(pair_stream, tensor<float, 2>(1, 2, 1.0f));
+		std::string huge = pair_stream.str();
+		huge[23] = static_cast<char>(0x80);
+		huge[16] = 1;
+
+		std::stringstream wrapping(huge);
+
+		if (!THROWS([&]() { load<float, 2>(wrapping); }))
+			throw std::runtime_error("TEST_3 in 'tensor_io_testing_suit' failed!\n");
+
+		// A file written on a machine of the other byte order is swapped on load.
+		//
+		std::string swapped = bytes;
+		swapped[7] = (std::endian::native == std::endian::little) ? 1 : 0;
+		std::reverse(swapped.begin() + 64, swapped.begin() + 68);
+		std::reverse(swapped.begin() + 68, swapped.begin() + 72);
+
+		std::stringstream foreign(swapped);
+		const tensor<std::uint32_t, 1> loaded = load<std::uint32_t, 1>(foreign);
+
+		if (!(loaded == values))
+			throw std::runtime_error("TEST_3 in 'tensor_io_testing_suit' failed!\n");
+
+		std::cout << "\tTEST 3 PASSED.\n";
+	}
+
+	void RUN_ALL()
+	{
+		std::cout << "Running tensor io tests...\n\n";
+
+		TEST_1();
+		TEST_2();
+		TEST_3();
+
+		std::cout << "\n";
+	}
+}
@@ -0,0 +1,199 @@
+#pragma once
+
+#include "../../../inc/tensor.hpp"
+#include "../../../inc/tensor_expressions.hpp"
+#include "../../../inc/tensor_kernels.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <iostream>
+#include <numeric>
+#include <vector>
+
+namespace tensor_kernels_testing_suit
+{
+	using namespace tensor_lib;
+
+	static constexpr std::array instruction_sets = { kernels::instruction_set::scalar, kernels::instruction_set::sse2, kernels::instruction_set::avx2, kernels::instruction_set::avx512 };
+
+	// Runs 'test' once for every instruction set the CPU supports, so the vectorized loops and their scalar tails are all exercised.
+	//
+	template <typename Test>
+	void FOR_EACH_INSTRUCTION_SET(const Test& test)
+	{
+		for (const auto isa : instruction_sets)
+		{
+			if (isa > kernels::detected_instruction_set())
+				break;
+
+			kernels::set_instruction_set(isa);
+			test();
+		}
+
+		kernels::set_instruction_set(kernels::detected_instruction_set());
+	}
+
+	template <typename T>
+	bool CHECK_BINARY_KERNELS(const std::size_t n)
+	{
+		std::vector<T> lhs(n), rhs(n), out(n);
+
+		for (std::size_t index = 0; index < n; index++)
+		{
+			lhs[index] = static_cast<T>(index % 17) - static_cast<T>(8);
+			rhs[index] = static_cast<T>(index % 5) + static_cast<T>(1);
+		}
+
+		kernels::add(lhs.data(), rhs.data(), out.data(), n);
+		for (std::size_t index = 0; index < n; index++)
+			if (out[index] != lhs[index] + rhs[index]) return false;
+
+		kernels::subtract(lhs.data(), rhs.data(), out.data(), n);
+		for (std::size_t index = 0; index < n; index++)
+			if (out[index] != lhs[index] - rhs[index]) return false;
+
+		kernels::multiply(lhs.data(), rhs.data(), out.data(), n);
+		for (std::size_t index = 0; index < n; index++)
+			if (out[index] != lhs[index] * rhs[index]) return false;
+
+		kernels::divide(lhs.data(), rhs.data(), out.data(), n);
+		for (std::size_t index = 0; index < n; index++)
+			if (out[index] != lhs[index] / rhs[index]) return false;
+
+		kernels::minimum(lhs.data(), rhs.data(), out.data(), n);
+		for (std::size_t index = 0; index < n; index++)
+			if (out[index] != std::min(lhs[index], rhs[index])) return false;
+
+		kernels::maximum(lhs.data(), rhs.data(), out.data(), n);
+		for (std::size_t index = 0; index < n; index++)
+			if (out[index] != std::max(lhs[index], rhs[index])) return false;
+
+		const T scalar = static_cast<T>(3);
+
+		kernels::binary<std::minus<>, true, false>(&scalar, rhs.data(), out.data(), n);
+		for (std::size_t index = 0; index < n; index++)
+			if (out[index] != scalar - rhs[index]) return false;
+
+		kernels::fma<false, true, false>(lhs.data(), &scalar, rhs.data(), out.data(), n);
+		for (std::size_t index = 0; index < n; index++)
+			if (out[index] != lhs[index] * scalar + rhs[index]) return false;
+
+		return true;
+	}
+
+	void TEST_1()
+	{
+		FOR_EACH_INSTRUCTION_SET([]()
+		{
+			for (const std::size_t n : { 0u, 1u, 7u, 16u, 33u, 100u, 1029u })
+			{
+				if (!CHECK_BINARY_KERNELS<float>(n) || !CHECK_BINARY_KERNELS<double>(n) || !CHECK_BINARY_KERNELS<std::int32_t>(n))
+					throw std::runtime_error("TEST_1 in 'tensor_kernels_testing_suit' failed!\n");
+			}
+		});
+
+		std::cout << "\tTEST 1 PASSED.\n";
+	}
+
+	void TEST_2()
+	{
+		FOR_EACH_INSTRUCTION_SET([]()
+		{
+			for (const std::size_t n : { 0u, 3u, 64u, 250u, 1001u })
+			{
+				std::vector<std::int32_t> source(n), destination(n, -1);
+				std::iota(source.begin(), source.end(), 0);
+
+				kernels::copy(source.data(), destination.data(), n);
+
+				if (source != destination || !kernels::equal(source.data(), destination.data(), n))
+					throw std::runtime_error("TEST_2 in 'tensor_kernels_testing_suit' failed!\n");
+
+				if (n)
+				{
+					destination[n - 1] = -1;
+
+					if (kernels::equal(source.data(), destination.data(), n))
+						throw std::runtime_error("TEST_2 in 'tensor_kernels_testing_suit' failed!\n");
+				}
+
+				std::vector<double> filled(n);
+				kernels::fill(filled.data(), n, 2.5);
+
+				if (!std::all_of(filled.begin(), filled.end(), [](const double val) { return val == 2.5; }))
+					throw std::runtime_error("TEST_2 in 'tensor_kernels_testing_suit' failed!\n");
+			}
+		});
+
+		std::cout << "\tTEST 2 PASSED.\n";
+	}
+
+	void TEST_3()
+	{
+		tensor<float, 2> a(37, 41, 1.5f), b(37, 41, 2.0f), c(37, 41, 0.25f);
+
+		FOR_EACH_INSTRUCTION_SET([&]()
+		{
+			tensor<float, 2> result = a * b + c;
+
+			if (!std::all_of(result.cbegin(), result.cend(), [](const float val) { return val == 3.25f; }))
+				throw std::runtime_error("TEST_3 in 'tensor_kernels_testing_suit' failed!\n");
+
+			result = minimum(result, b) - -maximum(c, 1.0f);
+
+			if (!std::all_of(result.cbegin(), result.cend(), [](const float val) { return val == 3.0f; }))
+				throw std::runtime_error("TEST_3 in 'tensor_kernels_testing_suit' failed!\n");
+		});
+
+		std::cout << "\tTEST 3 PASSED.\n";
+	}
+
+	void TEST_4()
+	{
+		tensor<int, 2> tsor(3, 700);
+		std::iota(tsor.begin(), tsor.end(), 0);
+
+		tsor[1] = tsor[1] + tsor[1] * 2; // the destination is also read by the expression
+
+		for (std::size_t index = 0; index < 700; index++)
+		{
+			if (tsor[1][index] != 3 * (700 + static_cast<int>(index)))
+				throw std::runtime_error("TEST_4 in 'tensor_kernels_testing_suit' failed!\n");
+		}
+
+		std::cout << "\tTEST 4 PASSED.\n";
+	}
+
+	void TEST_5()
+	{
+		tensor<double, 2> tsor(4, 5, 1.0);
+		tensor<double, 2> copy = tsor;
+
+		if (!(copy == tsor) || !(copy[2] == tsor[3]))
+			throw std::runtime_error("TEST_5 in 'tensor_kernels_testing_suit' failed!\n");
+
+		copy[2][4] = 0.0;
+
+		if (copy == tsor || copy[2] == tsor[2])
+			throw std::runtime_error("TEST_5 in 'tensor_kernels_testing_suit' failed!\n");
+
+		if (tensor<double, 2>(4, 5) == tensor<double, 2>(5, 4))
+			throw std::runtime_error("TEST_5 in 'tensor_kernels_testing_suit' failed!\n");
+
+		std::cout << "\tTEST 5 PASSED.\n";
+	}
+
+	void RUN_ALL()
+	{
+		std::cout << "Running tensor kernels tests...\n\n";
+
+		TEST_1();
+		TEST_2();
+		TEST_3();
+		TEST_4();
+		TEST_5();
+
+		std::cout << "\n";
+	}
+}
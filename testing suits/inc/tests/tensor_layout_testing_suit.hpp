@@ -0,0 +1,241 @@
+#pragma once
+
+#include "../../../inc/tensor.hpp"
+#include "../../../inc/tensor_einsum.hpp"
+#include "../../../inc/tensor_layout.hpp"
+#include "../../../inc/tensor_matmul.hpp"
+#include "../../../inc/tensor_view.hpp"
+
+#include <array>
+#include <cstddef>
+#include <iostream>
+#include <memory_resource>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+
+namespace tensor_layout_testing_suit
+{
+	using namespace tensor_lib;
+
+	// A user provided layout: row-major, with the rows stored last to first.
+	//
+	struct layout_reversed_rows
+	{
+		template <std::size_t Rank>
+		struct mapping
+		{
+			layout_right::mapping<Rank> row_major;
+
+			mapping(const std::array<std::size_t, Rank>& extents) : row_major{ extents } {}
+
+			const std::array<std::size_t, Rank>& extents() const { return row_major.extents(); }
+
+			std::size_t required_span_size() const { return row_major.required_span_size(); }
+
+			template <typename First, typename... Rest>
+			std::size_t operator() (const First first, const Rest ... rest) const
+			{
+				return row_major(extents()[0] - 1 - first, rest...);
+			}
+		};
+	};
+
+	// A layout that leaves gaps in the buffer, which tensors refuse.
+	//
+	struct layout_padded
+	{
+		template <std::size_t Rank>
+		struct mapping
+		{
+			layout_right::mapping<Rank> row_major;
+
+			mapping(const std::array<std::size_t, Rank>& extents) : row_major{ extents } {}
+
+			const std::array<std::size_t, Rank>& extents() const { return row_major.extents(); }
+
+			std::size_t required_span_size() const { return 2 * row_major.required_span_size(); }
+
+			template <typename... Indices>
+			std::size_t operator() (const Indices ... indices) const
+			{
+				return 2 * row_major(indices...);
+			}
+		};
+	};
+
+	void TEST_1()
+	{
+		tensor<int, 2> m(3, 4);
+		std::iota(m.begin(), m.end(), 0);
+
+		column_major_matrix<int> fortran(m);
+
+		if (fortran.order_of_dimension(0) != 3 || fortran.order_of_dimension(1) != 4 || fortran.stride(0) != 1 || fortran.stride(1) != 3)
+			throw std::runtime_error("TEST_1 in 'tensor_layout_testing_suit' failed!\n");
+
+		// Columns are contiguous, and the iterators walk the buffer column after column.
+		//
+		for (std::size_t j = 0; j < 4; j++)
+			for (std::size_t i = 0; i < 3; i++)
+				if (fortran.data()[j * 3 + i] != m[i][j] || fortran(i, j) != m[i][j] || fortran[i][j] != m[i][j])
+					throw std::runtime_error("TEST_1 in 'tensor_layout_testing_suit' failed!\n");
+
+		int expected = 0;
+
+		for (const int element : fortran)
+		{
+			if (element != m[expected % 3][expected / 3])
+				throw std::runtime_error("TEST_1 in 'tensor_layout_testing_suit' failed!\n");
+
+			expected++;
+		}
+
+		fortran[2][1] = -1;
+
+		if (relayout<layout_right>(fortran)[2][1] != -1 || relayout<layout_left>(m) == fortran)
+			throw std::runtime_error("TEST_1 in 'tensor_layout_testing_suit' failed!\n");
+
+		fortran[2][1] = m[2][1];
+
+		if (relayout<layout_right>(fortran) != m || relayout<layout_left>(m) != fortran)
+			throw std::runtime_error("TEST_1 in 'tensor_layout_testing_suit' failed!\n");
+
+		// Higher ranks, subdimensions as sources, and elements that aren't arithmetic.
+		//
+		tensor<std::string, 3> words(2, 3, 2);
+
+		for (std::size_t i = 0; i < words.size_of_current_tensor(); i++)
+			words.data()[i] = std::to_string(i);
+
+		const layout_tensor<std::string, 3, layout_left> left(words);
+		const layout_tensor<std::string, 2, layout_left> plane(words[1]);
+
+		for (std::size_t i = 0; i < 2; i++)
+			for (std::size_t j = 0; j < 3; j++)
+				for (std::size_t k = 0; k < 2; k++)
+					if (left(i, j, k) != words[i][j][k] || left[i][j][k] != words[i][j][k] || left.data()[k * 6 + j * 2 + i] != words[i][j][k]
+						|| plane[j][k] != words[1][j][k])
+						throw std::runtime_error("TEST_1 in 'tensor_layout_testing_suit' failed!\n");
+
+		std::cout << "\tTEST 1 PASSED.\n";
+	}
+
+	void TEST_2()
+	{
+		column_major_matrix<double> a(2, 3);
+		std::iota(a.begin(), a.end(), 1.0);
+
+		// Growing keeps every element at its indices, the strides follow the new sizes.
+		//
+		const column_major_matrix<double> original = a;
+		a.resize_preserve(3, 4);
+
+		if (a.stride(1) != 3 || a.size_of_current_tensor() != 12)
+			throw std::runtime_error("TEST_2 in 'tensor_layout_testing_suit' failed!\n");
+
+		for (std::size_t i = 0; i < 3; i++)
+			for (std::size_t j = 0; j < 4; j++)
+				if (a(i, j) != ((i < 2 && j < 3) ? original(i, j) : 0.0))
+					throw std::runtime_error("TEST_2 in 'tensor_layout_testing_suit' failed!\n");
+
+		a.resize_preserve(1, 2);
+
+		if (a(0, 0) != original(0, 0) || a(0, 1) != original(0, 1) || a.size_of_current_tensor() != 2)
+			throw std::runtime_error("TEST_2 in 'tensor_layout_testing_suit' failed!\n");
+
+		a.resize(4, 2);
+
+		if (a.order_of_dimension(0) != 4 || a.stride(1) != 4 || a(3, 1) != 0.0)
+			throw std::runtime_error("TEST_2 in 'tensor_layout_testing_suit' failed!\n");
+
+		// Strided layouts are viewed with their strides, so they can be multiplied without being copied to row-major first.
+		//
+		tensor<double, 2> x(4, 5);
+		tensor<double, 2> y(5, 3);
+		std::iota(x.begin(), x.end(), 1.0);
+		std::iota(y.begin(), y.end(), -7.0);
+
+		const column_major_matrix<double> fx(x);
+		const column_major_matrix<double> fy(y);
+		const tensor<double, 2> product = einsum<"ij,jk->ik">(view(fx), view(fy));
+
+		if (product != matmul(x, y) || view(fx).transpose().to_tensor() != view(x).transpose().to_tensor())
+			throw std::runtime_error("TEST_2 in 'tensor_layout_testing_suit' failed!\n");
+
+		std::cout << "\tTEST 2 PASSED.\n";
+	}
+
+	void TEST_3()
+	{
+		tensor<int, 2> m(3, 2);
+		std::iota(m.begin(), m.end(), 0);
+
+		const layout_tensor<int, 2, layout_reversed_rows> reversed(m);
+
+		if (reversed.data()[0] != 4 || reversed.data()[1] != 5 || reversed.data()[5] != 1 || reversed[2][1] != 5 || relayout<layout_right>(reversed) != m)
+			throw std::runtime_error("TEST_3 in 'tensor_layout_testing_suit' failed!\n");
+
+		// Copies between two layouts that aren't row-major.
+		//
+		const column_major_matrix<int> left(reversed);
+
+		if (left.data()[0] != 0 || left.data()[3] != 1 || relayout<layout_right>(left) != m)
+			throw std::runtime_error("TEST_3 in 'tensor_layout_testing_suit' failed!\n");
+
+		bool caught = false;
+
+		try { layout_tensor<int, 2, layout_padded> padded(2, 2); }
+		catch (const std::runtime_error&) { caught = true; }
+
+		if (!caught)
+			throw std::runtime_error("TEST_3 in 'tensor_layout_testing_suit' failed!\n");
+
+		// Copies and moves keep the layout and the elements, moved from tensors are empty.
+		//
+		layout_tensor<int, 2, layout_reversed_rows> copy = reversed;
+		layout_tensor<int, 2, layout_reversed_rows> moved = std::move(copy);
+
+		if (moved != reversed || !copy.empty() || moved.capacity() != 6)
+			throw std::runtime_error("TEST_3 in 'tensor_layout_testing_suit' failed!\n");
+
+		copy = moved;
+		moved = layout_tensor<int, 2, layout_reversed_rows>(1, 1);
+
+		if (copy != reversed || moved.size_of_current_tensor() != 1)
+			throw std::runtime_error("TEST_3 in 'tensor_layout_testing_suit' failed!\n");
+
+		// Copy assignment keeps the allocator of the destination when it doesn't propagate.
+		//
+		std::pmr::monotonic_buffer_resource scratch;
+		column_major_matrix<double, std::pmr::polymorphic_allocator<double>> target(std::allocator_arg, &scratch, 2, 2);
+		column_major_matrix<double, std::pmr::polymorphic_allocator<double>> source(3, 4);
+		std::iota(source.begin(), source.end(), 1.0);
+
+		target = source;
+
+		if (target != source || target.get_allocator().resource() != &scratch)
+			throw std::runtime_error("TEST_3 in 'tensor_layout_testing_suit' failed!\n");
+
+		// Empty shapes are copied as they are.
+		//
+		const column_major_matrix<int> no_columns(5, 0);
+		const column_major_matrix<int> no_columns_copy = no_columns;
+
+		if (no_columns_copy != no_columns || no_columns_copy.order_of_dimension(0) != 5)
+			throw std::runtime_error("TEST_3 in 'tensor_layout_testing_suit' failed!\n");
+
+		std::cout << "\tTEST 3 PASSED.\n";
+	}
+
+	void RUN_ALL()
+	{
+		std::cout << "Running tensor layout tests...\n\n";
+
+		TEST_1();
+		TEST_2();
+		TEST_3();
+
+		std::cout << "\n";
+	}
+}
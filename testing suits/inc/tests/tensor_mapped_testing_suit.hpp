@@ -0,0 +1,145 @@
+#pragma once
+
+#include "../../../inc/tensor.hpp"
+#include "../../../inc/tensor_io.hpp"
+#include "../../../inc/tensor_mapped.hpp"
+#include "../../../inc/tensor_reductions.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+
+namespace tensor_mapped_testing_suit
+{
+	using namespace tensor_lib;
+
+	inline std::filesystem::path TEMPORARY_FILE(const tensor<float, 3>& tsor)
+	{
+		const std::filesystem::path path = std::filesystem::temp_directory_path() / "tensor_mapped_testing_suit.tnsr";
+		save(path, tsor);
+
+		return path;
+	}
+
+	void TEST_1()
+	{
+		tensor<float, 3> cube(4, 5, 6);
+		std::iota(cube.begin(), cube.end(), 0.0f);
+		const std::filesystem::path path = TEMPORARY_FILE(cube);
+
+		{
+			mapped_tensor<float, 3> mapped(path);
+
+			if (mapped.order_of_dimension(1) != 5 || mapped.size_of_current_tensor() != 120 || mapped(3, 4, 5) != 119.0f || mapped[2][1][0] != cube[2][1][0])
+				throw std::runtime_error("TEST_1 in 'tensor_mapped_testing_suit' failed!\n");
+
+			// Views of the mapping are ordinary tensor objects.
+			//
+			const tensor<float, 3> copy(mapped.view());
+
+			if (!(copy == cube) || sum(mapped.view()) != sum(cube) || reinterpret_cast<std::uintptr_t>(mapped.data()) % 64 != 0)
+				throw std::runtime_error("TEST_1 in 'tensor_mapped_testing_suit' failed!\n");
+
+			mapped_tensor<float, 3> moved(std::move(mapped));
+
+			if (!mapped.empty() || mapped.data() != nullptr || moved(0, 0, 1) != 1.0f)
+				throw std::runtime_error("TEST_1 in 'tensor_mapped_testing_suit' failed!\n");
+		}
+
+		bool thrown = false;
+
+		try
+		{
+			mapped_tensor<float, 2> wrong_rank(path);
+		}
+		catch (const std::runtime_error&)
+		{
+			thrown = true;
+		}
+
+		// Sizes whose byte count wraps around can't pass for a short file.
+		//
+		bool wrapped = false;
+
+		try
+		{
+			mapped_tensor<float, 2> huge(path, 64, { (std::size_t{ 1 } << 62) + 1, 4 });
+		}
+		catch (const std::runtime_error&)
+		{
+			wrapped = true;
+		}
+
+		std::filesystem::remove(path);
+
+		if (!thrown || !wrapped)
+			throw std::runtime_error("TEST_1 in 'tensor_mapped_testing_suit' failed!\n");
+
+		std::cout << "\tTEST 1 PASSED.\n";
+	}
+
+	void TEST_2()
+	{
+		const tensor<float, 3> cube(2, 3, 4, 1.0f);
+		const std::filesystem::path path = TEMPORARY_FILE(cube);
+
+		// Private copies of the pages never reach the file.
+		//
+		{
+			mapped_tensor<float, 3> private_copy(path, map_mode::copy_on_write);
+			private_copy.writable_view()[1][2][3] = 5.0f;
+
+			if (private_copy(1, 2, 3) != 5.0f || load<float, 3>(path)(1, 2, 3) != 1.0f)
+				throw std::runtime_error("TEST_2 in 'tensor_mapped_testing_suit' failed!\n");
+		}
+
+		{
+			mapped_tensor<float, 3> shared(path, map_mode::read_write);
+			const mapped_tensor<float, 3> reader(path);
+
+			shared.writable_view()[0] = tensor<float, 2>(3, 4, 7.0f);
+			shared.flush();
+
+			if (reader(0, 2, 3) != 7.0f)
+				throw std::runtime_error("TEST_2 in 'tensor_mapped_testing_suit' failed!\n");
+		}
+
+		const tensor<float, 3> written = load<float, 3>(path);
+
+		if (written(0, 1, 1) != 7.0f || written(1, 0, 0) != 1.0f)
+			throw std::runtime_error("TEST_2 in 'tensor_mapped_testing_suit' failed!\n");
+
+		mapped_tensor<float, 3> read_only(path);
+		bool thrown = false;
+
+		try
+		{
+			read_only.writable_view();
+		}
+		catch (const std::runtime_error&)
+		{
+			thrown = true;
+		}
+
+		std::filesystem::remove(path);
+
+		if (!thrown)
+			throw std::runtime_error("TEST_2 in 'tensor_mapped_testing_suit' failed!\n");
+
+		std::cout << "\tTEST 2 PASSED.\n";
+	}
+
+	void RUN_ALL()
+	{
+		std::cout << "Running tensor mapped tests...\n\n";
+
+		TEST_1();
+		TEST_2();
+
+		std::cout << "\n";
+	}
+}
@@ -0,0 +1,168 @@
+#pragma once
+
+#include "../../../inc/tensor.hpp"
+#include "../../../inc/tensor_matmul.hpp"
+#include "tensor_kernels_testing_suit.hpp"
+
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+
+namespace tensor_matmul_testing_suit
+{
+	using namespace tensor_lib;
+
+	// Small integer values keep every partial sum exact, so the blocked kernels must match the naive product bit for bit.
+	//
+	template <typename T>
+	tensor<T, 2> MAKE_MATRIX(const std::size_t rows, const std::size_t columns, const int seed)
+	{
+		tensor<T, 2> result(rows, columns);
+
+		for (std::size_t i = 0; i < rows; i++)
+			for (std::size_t j = 0; j < columns; j++)
+				result[i][j] = static_cast<T>(static_cast<int>((i * 7 + j * 3 + static_cast<std::size_t>(seed)) % 9) - 4);
+
+		return result;
+	}
+
+	template <typename T, typename Lhs, typename Rhs>
+	tensor<T, 2> NAIVE_MATMUL(const Lhs& a, const Rhs& b)
+	{
+		tensor<T, 2> result(a.order_of_dimension(0), b.order_of_dimension(1), T{});
+
+		for (std::size_t i = 0; i < a.order_of_dimension(0); i++)
+			for (std::size_t j = 0; j < b.order_of_dimension(1); j++)
+				for (std::size_t p = 0; p < a.order_of_dimension(1); p++)
+					result[i][j] += a[i][p] * b[p][j];
+
+		return result;
+	}
+
+	template <typename T>
+	bool CHECK_MATMUL(const std::size_t rows, const std::size_t depth, const std::size_t columns)
+	{
+		const auto a = MAKE_MATRIX<T>(rows, depth, 1);
+		const auto b = MAKE_MATRIX<T>(depth, columns, 2);
+
+		return matmul(a, b) == NAIVE_MATMUL<T>(a, b);
+	}
+
+	void TEST_1()
+	{
+		// Covers partial micro-tiles, more rows than a row block (144) and more depth than a depth block (256).
+		//
+		tensor_kernels_testing_suit::FOR_EACH_INSTRUCTION_SET([]()
+		{
+			for (const auto& [rows, depth, columns] : { std::array<std::size_t, 3>{ 1, 1, 1 }, { 5, 3, 7 }, { 16, 16, 16 }, { 31, 17, 45 }, { 150, 270, 67 } })
+			{
+				if (!CHECK_MATMUL<float>(rows, depth, columns) || !CHECK_MATMUL<double>(rows, depth, columns) || !CHECK_MATMUL<std::int32_t>(rows, depth, columns))
+					throw std::runtime_error("TEST_1 in 'tensor_matmul_testing_suit' failed!\n");
+			}
+		});
+
+		std::cout << "\tTEST 1 PASSED.\n";
+	}
+
+	void TEST_2()
+	{
+		tensor<double, 3> lhs(2, 20, 30, 1.0);
+		tensor<double, 3> rhs(3, 30, 25, 2.0);
+		const tensor<double, 3>& const_rhs = rhs;
+
+		// subdimensions and const_subdimensions are multiplied in place
+		//
+		const auto product = matmul(lhs[1], const_rhs[2]);
+
+		if (product.order_of_dimension(0) != 20 || product.order_of_dimension(1) != 25)
+			throw std::runtime_error("TEST_2 in 'tensor_matmul_testing_suit' failed!\n");
+
+		for (const auto val : product)
+			if (val != 60.0)
+				throw std::runtime_error("TEST_2 in 'tensor_matmul_testing_suit' failed!\n");
+
+		tensor<double, 3> out(2, 20, 25, -1.0);
+		matmul_into(out[0], lhs[0], rhs[1]);
+
+		if (!(out[0] == product))
+			throw std::runtime_error("TEST_2 in 'tensor_matmul_testing_suit' failed!\n");
+
+		for (const auto val : out[1])
+			if (val != -1.0)
+				throw std::runtime_error("TEST_2 in 'tensor_matmul_testing_suit' failed!\n");
+
+		std::cout << "\tTEST 2 PASSED.\n";
+	}
+
+	void TEST_3()
+	{
+		auto a = MAKE_MATRIX<float>(40, 40, 3);
+		const auto expected = NAIVE_MATMUL<float>(a, a);
+
+		matmul_into(a, a, a); // the destination is also both operands
+
+		if (!(a == expected))
+			throw std::runtime_error("TEST_3 in 'tensor_matmul_testing_suit' failed!\n");
+
+		tensor<float, 2> out;
+		matmul_into(out, MAKE_MATRIX<float>(3, 8, 0), MAKE_MATRIX<float>(8, 5, 0)); // a matrix is resized to fit the product
+
+		if (out.order_of_dimension(0) != 3 || out.order_of_dimension(1) != 5)
+			throw std::runtime_error("TEST_3 in 'tensor_matmul_testing_suit' failed!\n");
+
+		std::cout << "\tTEST 3 PASSED.\n";
+	}
+
+	void TEST_4()
+	{
+		const tensor<int, 2> a(3, 4, 1), b(5, 2, 1);
+		tensor<int, 3> out(2, 3, 3);
+
+		bool thrown = false;
+
+		try
+		{
+			const auto product = matmul(a, b);
+		}
+		catch (const std::runtime_error&)
+		{
+			thrown = true;
+		}
+
+		if (!thrown)
+			throw std::runtime_error("TEST_4 in 'tensor_matmul_testing_suit' failed!\n");
+
+		thrown = false;
+
+		try
+		{
+			matmul_into(out[0], a, tensor<int, 2>(4, 2, 1)); // a 3x2 product doesn't fit in a 3x3 subdimension
+		}
+		catch (const std::runtime_error&)
+		{
+			thrown = true;
+		}
+
+		if (!thrown)
+			throw std::runtime_error("TEST_4 in 'tensor_matmul_testing_suit' failed!\n");
+
+		const auto zero_depth = matmul(tensor<int, 2>(3, 0), tensor<int, 2>(0, 2));
+
+		if (!zero_depth.empty())
+			throw std::runtime_error("TEST_4 in 'tensor_matmul_testing_suit' failed!\n");
+
+		std::cout << "\tTEST 4 PASSED.\n";
+	}
+
+	void RUN_ALL()
+	{
+		std::cout << "Running tensor matmul tests...\n\n";
+
+		TEST_1();
+		TEST_2();
+		TEST_3();
+		TEST_4();
+
+		std::cout << "\n";
+	}
+}
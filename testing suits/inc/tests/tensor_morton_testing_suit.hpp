@@ -0,0 +1,191 @@
+#pragma once
+
+#include "../../../inc/tensor.hpp"
+#include "../../../inc/tensor_layout.hpp"
+#include "../../../inc/tensor_morton.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+namespace tensor_morton_testing_suit
+{
+	using namespace tensor_lib;
+
+	void TEST_1()
+	{
+		static_assert(morton_encode(1, 0, 1) == 0b101 && morton_encode(0, 2, 0) == 0b010'000 && morton_encode(3, 1) == 0b1011);
+		static_assert(morton_decode<3>(0b110'011)[0] == 2 && morton_decode<3>(0b110'011)[1] == 3 && morton_decode<3>(0b110'011)[2] == 1);
+
+		// Codes and indices convert both ways, far beyond the sizes of real tensors.
+		//
+		for (std::size_t i = 0; i < 2000000; i += 999)
+		{
+			const std::array<std::size_t, 3> indices{ i, (i * 7) % 2097152, 2097151 - i };
+			const std::array<std::size_t, 2> pair{ i * 2047, i };
+
+			if (morton_decode<3>(morton_encode(indices[0], indices[1], indices[2])) != indices || morton_decode<2>(morton_encode(pair[0], pair[1])) != pair)
+				throw std::runtime_error("TEST_1 in 'tensor_morton_testing_suit' failed!\n");
+		}
+
+		// A 4x4 matrix is stored as four 2x2 blocks, each in Z order.
+		//
+		tensor<int, 2> m(4, 4);
+		std::iota(m.begin(), m.end(), 0);
+
+		const morton_matrix<int> z(m);
+
+		const std::array<int, 16> expected{ 0, 1, 4, 5, 2, 3, 6, 7, 8, 9, 12, 13, 10, 11, 14, 15 };
+
+		if (!std::equal(expected.begin(), expected.end(), z.data()) || !std::equal(expected.begin(), expected.end(), z.begin()) || relayout<layout_right>(z) != m)
+			throw std::runtime_error("TEST_1 in 'tensor_morton_testing_suit' failed!\n");
+
+		// Sizes have to be the same power of two.
+		//
+		bool caught = false;
+
+		try
+		{
+			morton_cube<int> cube(4, 4, 2);
+		}
+		catch (const std::runtime_error&)
+		{
+			caught = true;
+		}
+
+		if (!caught)
+			throw std::runtime_error("TEST_1 in 'tensor_morton_testing_suit' failed!\n");
+
+		caught = false;
+
+		try
+		{
+			morton_matrix<int> matrix(6, 6);
+		}
+		catch (const std::runtime_error&)
+		{
+			caught = true;
+		}
+
+		if (!caught)
+			throw std::runtime_error("TEST_1 in 'tensor_morton_testing_suit' failed!\n");
+
+		std::cout << "\tTEST 1 PASSED.\n";
+	}
+
+	void TEST_2()
+	{
+		tensor<double, 3> volume(32, 32, 32);
+		std::iota(volume.begin(), volume.end(), 0.0);
+
+		// Bulk conversions both ways, to other layouts, and from a subdimension.
+		//
+		morton_cube<double> z(volume);
+
+		for (std::size_t i = 0; i < 32; i++)
+			for (std::size_t j = 0; j < 32; j++)
+				for (std::size_t k = 0; k < 32; k++)
+					if (z(i, j, k) != volume[i][j][k] || z[i][j][k] != volume[i][j][k] || z.data()[morton_encode(i, j, k)] != volume[i][j][k])
+						throw std::runtime_error("TEST_2 in 'tensor_morton_testing_suit' failed!\n");
+
+		const layout_tensor<double, 3, layout_left> left(z);
+		const morton_cube<double> from_left(left);
+		const morton_matrix<double> plane(volume[5]);
+
+		if (relayout<layout_right>(z) != volume || relayout<layout_right>(left) != volume || from_left != z || relayout<layout_right>(plane) != volume[5])
+			throw std::runtime_error("TEST_2 in 'tensor_morton_testing_suit' failed!\n");
+
+		// Growing to the next power of two keeps the elements at their indices.
+		//
+		z.resize_preserve(64, 64, 64);
+
+		if (z(31, 31, 31) != volume[31][31][31] || z(31, 32, 31) != 0.0 || z(63, 63, 63) != 0.0 || z.size_of_current_tensor() != 64 * 64 * 64)
+			throw std::runtime_error("TEST_2 in 'tensor_morton_testing_suit' failed!\n");
+
+		std::cout << "\tTEST 2 PASSED.\n";
+	}
+
+	void TEST_3()
+	{
+		tensor<int, 3> volume(8, 8, 8);
+		std::iota(volume.begin(), volume.end(), 0);
+
+		morton_cube<int> z(volume);
+
+		// Stepping along an axis gives the code of the neighbour.
+		//
+		for (std::size_t i = 0; i < 8; i++)
+			for (std::size_t j = 0; j < 8; j++)
+				for (std::size_t k = 1; k < 7; k++)
+					if (z.mapping().step(morton_encode(i, j, k), 2, 1) != morton_encode(i, j, k + 1) || z.mapping().step(morton_encode(k, i, j), 0, -1) != morton_encode(k - 1, i, j))
+						throw std::runtime_error("TEST_3 in 'tensor_morton_testing_suit' failed!\n");
+
+		// Every neighbour inside the cube is visited once, with its indices, and nothing outside it.
+		//
+		const auto visit_all = [&volume](const morton_cube<int>& cube, const std::array<std::size_t, 3>& index, const bool diagonals)
+		{
+			std::vector<int> seen;
+
+			const auto check = [&](const std::array<std::size_t, 3>& neighbor, const int& element)
+			{
+				std::size_t distance = 0;
+
+				for (std::size_t axis = 0; axis < 3; axis++)
+					distance += neighbor[axis] != index[axis];
+
+				if (distance == 0 || (!diagonals && distance != 1) || element != volume[neighbor[0]][neighbor[1]][neighbor[2]])
+					throw std::runtime_error("TEST_3 in 'tensor_morton_testing_suit' failed!\n");
+
+				seen.push_back(element);
+			};
+
+			if (diagonals)
+				for_each_neighbor(cube, index, check);
+			else
+				for_each_face_neighbor(cube, index, check);
+
+			std::sort(seen.begin(), seen.end());
+
+			if (std::adjacent_find(seen.begin(), seen.end()) != seen.end())
+				throw std::runtime_error("TEST_3 in 'tensor_morton_testing_suit' failed!\n");
+
+			return seen.size();
+		};
+
+		if (visit_all(z, { 3, 4, 5 }, true) != 26 || visit_all(z, { 0, 0, 0 }, true) != 7 || visit_all(z, { 7, 3, 0 }, true) != 11
+			|| visit_all(z, { 3, 4, 5 }, false) != 6 || visit_all(z, { 0, 7, 0 }, false) != 3 || visit_all(z, { 7, 4, 5 }, false) != 5)
+			throw std::runtime_error("TEST_3 in 'tensor_morton_testing_suit' failed!\n");
+
+		// Neighbours of a non-const tensor can be written.
+		//
+		for_each_face_neighbor(z, { 4, 4, 4 }, [](const std::array<std::size_t, 3>&, int& element) { element = -1; });
+
+		if (z(3, 4, 4) != -1 || z(5, 4, 4) != -1 || z(4, 3, 4) != -1 || z(4, 4, 5) != -1 || z(4, 4, 4) != volume[4][4][4] || z(5, 5, 4) != volume[5][5][4])
+			throw std::runtime_error("TEST_3 in 'tensor_morton_testing_suit' failed!\n");
+
+		morton_matrix<int> m(4, 4);
+		int count = 0;
+
+		for_each_neighbor(m, { 1, 2 }, [&count](const std::array<std::size_t, 2>&, int&) { count++; });
+
+		if (count != 8)
+			throw std::runtime_error("TEST_3 in 'tensor_morton_testing_suit' failed!\n");
+
+		std::cout << "\tTEST 3 PASSED.\n";
+	}
+
+	void RUN_ALL()
+	{
+		std::cout << "Running tensor morton tests...\n\n";
+
+		TEST_1();
+		TEST_2();
+		TEST_3();
+
+		std::cout << "\n";
+	}
+}
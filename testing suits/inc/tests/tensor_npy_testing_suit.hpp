@@ -0,0 +1,166 @@
+#pragma once
+
+#include "../../../inc/tensor.hpp"
+#include "../../../inc/tensor_npy.hpp"
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+namespace tensor_npy_testing_suit
+{
+	using namespace tensor_lib;
+
+	// .npy file as numpy.save writes it: preamble, header dict padded with spaces to 64 bytes and the data.
+	//
+	inline std::string NPY_FILE(const std::string& dict, const std::string& data)
+	{
+		std::string header = dict;
+		header.append((64 - (10 + header.size() + 1) % 64) % 64, ' ');
+		header += '\n';
+
+		return std::string("\x93NUMPY\x01\x00", 8) + static_cast<char>(header.size() & 0xFF) + static_cast<char>(header.size() >> 8) + header + data;
+	}
+
+	template <typename Load>
+	bool THROWS(Load load)
+	{
+		try
+		{
+			load();
+		}
+		catch (const std::runtime_error&)
+		{
+			return true;
+		}
+
+		return false;
+	}
+
+	void TEST_1()
+	{
+		// Byte for byte what numpy writes for the same arrays.
+		//
+		tensor<std::int32_t, 2> matrix(2, 3);
+		std::iota(matrix.begin(), matrix.end(), 0);
+
+		std::stringstream stream;
+		save_npy(stream, matrix);
+
+		const std::string expected = NPY_FILE("{'descr': '<i4', 'fortran_order': False, 'shape': (2, 3), }", std::string(reinterpret_cast<const char*>(matrix.data()), 24));
+
+		if (std::endian::native == std::endian::little && (stream.str() != expected || stream.str().size() != 128 + 24))
+			throw std::runtime_error("TEST_1 in 'tensor_npy_testing_suit' failed!\n");
+
+		std::stringstream vector_stream;
+		save_npy(vector_stream, tensor<std::uint8_t, 1>(5, 7));
+
+		if (vector_stream.str().find("'descr': '|u1', 'fortran_order': False, 'shape': (5,), }") == std::string::npos)
+			throw std::runtime_error("TEST_1 in 'tensor_npy_testing_suit' failed!\n");
+
+		const tensor<std::int32_t, 2> loaded = load_npy<std::int32_t, 2>(stream);
+		const tensor<std::uint8_t, 1> bytes = load_npy<std::uint8_t, 1>(vector_stream);
+
+		if (!(loaded == matrix) || bytes.order_of_dimension(0) != 5 || bytes[4] != 7)
+			throw std::runtime_error("TEST_1 in 'tensor_npy_testing_suit' failed!\n");
+
+		std::cout << "\tTEST 1 PASSED.\n";
+	}
+
+	void TEST_2()
+	{
+		// A Fortran ordered 2x3 array of big endian doubles, as numpy.save writes np.asfortranarray(a.astype('>f8')).
+		//
+		const double column_major[] = { 0.0, 3.0, 1.0, 4.0, 2.0, 5.0 };
+		std::string data(reinterpret_cast<const char*>(column_major), sizeof(column_major));
+
+		if (std::endian::native == std::endian::little)
+			for (std::size_t element = 0; element < 6; element++)
+				std::reverse(data.begin() + 8 * element, data.begin() + 8 * element + 8);
+
+		std::stringstream stream(NPY_FILE("{'descr': '>f8', 'fortran_order': True, 'shape': (2, 3), }", data));
+		const tensor<double, 2> loaded = load_npy<double, 2>(stream);
+
+		if (loaded.order_of_dimension(1) != 3 || loaded(0, 1) != 1.0 || loaded(1, 0) != 3.0 || loaded(1, 2) != 5.0)
+			throw std::runtime_error("TEST_2 in 'tensor_npy_testing_suit' failed!\n");
+
+		// Rank and dtype are checked, dtypes without an equivalent are rejected.
+		//
+		const std::string floats = NPY_FILE("{'descr': '<f4', 'fortran_order': False, 'shape': (2, 2), }", std::string(16, '\0'));
+		const std::string halves = NPY_FILE("{'descr': '<f2', 'fortran_order': False, 'shape': (4,), }", std::string(8, '\0'));
+
+		if (!THROWS([&]() { std::stringstream in(floats); load_npy<float, 3>(in); }) || !THROWS([&]() { std::stringstream in(floats); load_npy<double, 2>(in); })
+			|| !THROWS([&]() { std::stringstream in(halves); load_npy<std::int16_t, 1>(in); }) || !THROWS([&]() { std::stringstream in("not a npy file"); load_npy<float, 1>(in); }))
+			throw std::runtime_error("TEST_2 in 'tensor_npy_testing_suit' failed!\n");
+
+		// Shapes whose product wraps around, or with sizes that don't fit in 64 bits, are corrupted headers.
+		//
+		const std::string wrapping = NPY_FILE("{'descr': '<f4', 'fortran_order': False, 'shape': (9223372036854775809, 2), }", std::string(8, '\0'));
+		const std::string too_long = NPY_FILE("{'descr': '<f4', 'fortran_order': False, 'shape': (99999999999999999999,), }", std::string(8, '\0'));
+
+		if (!THROWS([&]() { std::stringstream in(wrapping); load_npy<float, 2>(in); }) || !THROWS([&]() { std::stringstream in(too_long); load_npy<float, 1>(in); }))
+			throw std::runtime_error("TEST_2 in 'tensor_npy_testing_suit' failed!\n");
+
+		std::stringstream in(floats);
+
+		if (load_npy<float, 2>(in)(1, 1) != 0.0f)
+			throw std::runtime_error("TEST_2 in 'tensor_npy_testing_suit' failed!\n");
+
+		std::cout << "\tTEST 2 PASSED.\n";
+	}
+
+	void TEST_3()
+	{
+		const std::filesystem::path npy_path = std::filesystem::temp_directory_path() / "tensor_npy_testing_suit.npy";
+		const std::filesystem::path npz_path = std::filesystem::temp_directory_path() / "tensor_npy_testing_suit.npz";
+
+		tensor<float, 3> weights(2, 3, 4);
+		std::iota(weights.begin(), weights.end(), 0.5f);
+		const tensor<bool, 1> mask{ true, false, true };
+
+		save_npy(npy_path, weights);
+
+		{
+			npz_writer archive(npz_path);
+			archive.add("weights", weights);
+			archive.add("mask", mask);
+		}
+
+		const mapped_tensor<float, 3> mapped = map_npy<float, 3>(npy_path);
+
+		if (!(load_npy<float, 3>(npy_path) == weights) || mapped(1, 2, 3) != weights(1, 2, 3) || mapped.data()[0] != 0.5f)
+			throw std::runtime_error("TEST_3 in 'tensor_npy_testing_suit' failed!\n");
+
+		const tensor<float, 3> from_archive = load_npz<float, 3>(npz_path, "weights");
+		const tensor<bool, 1> mask_from_archive = load_npz<bool, 1>(npz_path, "mask.npy");
+		const mapped_tensor<float, 3> mapped_member = map_npz<float, 3>(npz_path, "weights");
+
+		if (!(from_archive == weights) || !(mask_from_archive == mask) || mapped_member(0, 2, 1) != weights(0, 2, 1))
+			throw std::runtime_error("TEST_3 in 'tensor_npy_testing_suit' failed!\n");
+
+		if (!THROWS([&]() { load_npz<float, 3>(npz_path, "bias"); }) || !THROWS([&]() { load_npz<float, 2>(npz_path, "weights"); }))
+			throw std::runtime_error("TEST_3 in 'tensor_npy_testing_suit' failed!\n");
+
+		std::filesystem::remove(npy_path);
+		std::filesystem::remove(npz_path);
+
+		std::cout << "\tTEST 3 PASSED.\n";
+	}
+
+	void RUN_ALL()
+	{
+		std::cout << "Running tensor npy tests...\n\n";
+
+		TEST_1();
+		TEST_2();
+		TEST_3();
+
+		std::cout << "\n";
+	}
+}
@@ -0,0 +1,265 @@
+#pragma once
+
+#include "../../../inc/tensor.hpp"
+#include "../../../inc/tensor_execution.hpp"
+#include "../../../inc/tensor_reductions.hpp"
+#include "tensor_kernels_testing_suit.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+
+namespace tensor_reductions_testing_suit
+{
+	using namespace tensor_lib;
+
+	template <typename T>
+	bool CHECK_FULL_REDUCTIONS(const std::size_t n)
+	{
+		tensor<T, 1> values(n);
+
+		for (std::size_t index = 0; index < n; index++)
+			values[index] = static_cast<T>(static_cast<int>((index * 7) % 13) - 6);
+
+		T expected_sum = 0, expected_min = values[0], expected_max = values[0];
+		std::size_t expected_argmin = 0, expected_argmax = 0;
+
+		for (std::size_t index = 0; index < n; index++)
+		{
+			expected_sum += values[index];
+
+			if (values[index] < expected_min)
+			{
+				expected_min = values[index];
+				expected_argmin = index;
+			}
+
+			if (values[index] > expected_max)
+			{
+				expected_max = values[index];
+				expected_argmax = index;
+			}
+		}
+
+		tensor<T, 1> factors(n, T{ 1 });
+		factors[n / 2] = 2;
+		factors[n - 1] = -3;
+
+		return sum(values) == expected_sum && min(values) == expected_min && max(values) == expected_max
+			&& argmin(values) == expected_argmin && argmax(values) == expected_argmax
+			&& prod(factors) == static_cast<T>((n / 2 == n - 1) ? -3 : -6);
+	}
+
+	void TEST_1()
+	{
+		tensor_kernels_testing_suit::FOR_EACH_INSTRUCTION_SET([]()
+		{
+			for (const std::size_t n : { 1u, 2u, 7u, 64u, 100u, 1029u, 40000u })
+			{
+				if (!CHECK_FULL_REDUCTIONS<float>(n) || !CHECK_FULL_REDUCTIONS<double>(n) || !CHECK_FULL_REDUCTIONS<std::int32_t>(n))
+					throw std::runtime_error("TEST_1 in 'tensor_reductions_testing_suit' failed!\n");
+			}
+		});
+
+		const tensor<double, 2> matrix = { { 1.0, 2.0 }, { 3.0, 6.0 } };
+
+		if (mean(matrix) != 3.0 || reduce(matrix, [](const double lhs, const double rhs) { return lhs > rhs ? lhs : rhs; }) != 6.0)
+			throw std::runtime_error("TEST_1 in 'tensor_reductions_testing_suit' failed!\n");
+
+		const tensor<int, 2> empty;
+
+		if (sum(empty) != 0 || prod(empty) != 1)
+			throw std::runtime_error("TEST_1 in 'tensor_reductions_testing_suit' failed!\n");
+
+		bool thrown = false;
+
+		try
+		{
+			static_cast<void>(min(empty));
+		}
+		catch (const std::runtime_error&)
+		{
+			thrown = true;
+		}
+
+		if (!thrown)
+			throw std::runtime_error("TEST_1 in 'tensor_reductions_testing_suit' failed!\n");
+
+		std::cout << "\tTEST 1 PASSED.\n";
+	}
+
+	template <typename Tensor>
+	bool CHECK_AXIS_REDUCTIONS(const Tensor& cube)
+	{
+		const std::size_t sizes[3] = { cube.order_of_dimension(0), cube.order_of_dimension(1), cube.order_of_dimension(2) };
+
+		for (std::size_t axis = 0; axis < 3; axis++)
+		{
+			const auto sums = sum(cube, axis);
+			const auto largest = max(cube, axis);
+			const auto largest_indices = argmax(cube, axis);
+			const std::size_t other[2] = { axis == 0 ? 1u : 0u, axis == 2 ? 1u : 2u };
+
+			if (sums.order_of_dimension(0) != sizes[other[0]] || sums.order_of_dimension(1) != sizes[other[1]])
+				return false;
+
+			for (std::size_t i = 0; i < sizes[other[0]]; i++)
+			{
+				for (std::size_t j = 0; j < sizes[other[1]]; j++)
+				{
+					int expected_sum = 0, expected_max = 0;
+					std::size_t expected_argmax = 0;
+
+					for (std::size_t k = 0; k < sizes[axis]; k++)
+					{
+						std::size_t index[3];
+						index[axis] = k;
+						index[other[0]] = i;
+						index[other[1]] = j;
+
+						const int value = cube[index[0]][index[1]][index[2]];
+						expected_sum += value;
+
+						if (k == 0 || value > expected_max)
+						{
+							expected_max = value;
+							expected_argmax = k;
+						}
+					}
+
+					if (sums[i][j] != expected_sum || largest[i][j] != expected_max || largest_indices[i][j] != expected_argmax)
+						return false;
+				}
+			}
+		}
+
+		return true;
+	}
+
+	void TEST_2()
+	{
+		tensor<int, 3> cube(5, 6, 7);
+
+		for (std::size_t index = 0; index < cube.size_of_current_tensor(); index++)
+			cube.data()[index] = static_cast<int>((index * 11) % 17) - 8;
+
+		if (!CHECK_AXIS_REDUCTIONS(cube))
+			throw std::runtime_error("TEST_2 in 'tensor_reductions_testing_suit' failed!\n");
+
+		// Rows longer than one column block, and a subdimension as the operand.
+		//
+		tensor<int, 3> wide(2, 3, 5000);
+
+		for (std::size_t index = 0; index < wide.size_of_current_tensor(); index++)
+			wide.data()[index] = static_cast<int>(index % 23);
+
+		if (!CHECK_AXIS_REDUCTIONS(wide))
+			throw std::runtime_error("TEST_2 in 'tensor_reductions_testing_suit' failed!\n");
+
+		const auto columns = reduce<0>(wide[1], std::bit_or<>{});
+
+		for (std::size_t column = 0; column < 5000; column++)
+			if (columns[column] != (wide[1][0][column] | wide[1][1][column] | wide[1][2][column]))
+				throw std::runtime_error("TEST_2 in 'tensor_reductions_testing_suit' failed!\n");
+
+		const tensor<double, 2> matrix = { { 1.0, 2.0, 3.0 }, { 3.0, 6.0, 3.0 } };
+		const auto row_means = mean(matrix, 1);
+		const auto column_products = prod(matrix, 0);
+
+		if (row_means[0] != 2.0 || row_means[1] != 4.0 || column_products[0] != 3.0 || column_products[1] != 12.0 || column_products[2] != 9.0)
+			throw std::runtime_error("TEST_2 in 'tensor_reductions_testing_suit' failed!\n");
+
+		if (!sum(tensor<int, 3>(), 1).empty())
+			throw std::runtime_error("TEST_2 in 'tensor_reductions_testing_suit' failed!\n");
+
+		bool thrown = false;
+
+		try
+		{
+			const auto sums = sum(cube, 3);
+		}
+		catch (const std::runtime_error&)
+		{
+			thrown = true;
+		}
+
+		if (!thrown)
+			throw std::runtime_error("TEST_2 in 'tensor_reductions_testing_suit' failed!\n");
+
+		std::cout << "\tTEST 2 PASSED.\n";
+	}
+
+	void TEST_3()
+	{
+		// Summed one after another in float, ten million 0.1f drift to about 1087937 (9% off), pairwise sums stay within 1e-5.
+		//
+		const std::size_t n = 10000000;
+		const double exact = static_cast<double>(0.1f) * static_cast<double>(n);
+		const tensor<float, 1> values(n, 0.1f);
+		const tensor<float, 2> rows(n / 4, 4, 0.1f);
+
+		tensor_kernels_testing_suit::FOR_EACH_INSTRUCTION_SET([&]()
+		{
+			if (std::abs(sum(values) - exact) > exact * 1e-5 || std::abs(sum(execution::par, values) - exact) > exact * 1e-5)
+				throw std::runtime_error("TEST_3 in 'tensor_reductions_testing_suit' failed!\n");
+
+			for (const auto column : sum(rows, 0))
+				if (std::abs(column * 4.0 - exact) > exact * 1e-5)
+					throw std::runtime_error("TEST_3 in 'tensor_reductions_testing_suit' failed!\n");
+		});
+
+		std::cout << "\tTEST 3 PASSED.\n";
+	}
+
+	void TEST_4()
+	{
+		tensor<int, 3> cube(9, 40, 300);
+
+		for (std::size_t index = 0; index < cube.size_of_current_tensor(); index++)
+			cube.data()[index] = static_cast<int>((index * 13) % 101) - 50;
+
+		tensor<double, 1> values(300000);
+		std::iota(values.begin(), values.end(), 0.5);
+		values[123457] = 1e9;
+
+		execution::set_thread_count(4);
+		execution::set_grain_size(1000);
+
+		for (std::size_t axis = 0; axis < 3; axis++)
+		{
+			if (!(sum(execution::par, cube, axis) == sum(cube, axis)) || !(argmin(execution::par_unseq, cube, axis) == argmin(cube, axis)))
+				throw std::runtime_error("TEST_4 in 'tensor_reductions_testing_suit' failed!\n");
+		}
+
+		if (max(execution::par, cube) != 50 || argmax(execution::par, values) != 123457 || argmin(execution::par, cube) != argmin(cube))
+			throw std::runtime_error("TEST_4 in 'tensor_reductions_testing_suit' failed!\n");
+
+		// The blocks of a parallel reduction don't depend on the number of threads, neither does the result.
+		//
+		const double four_threads = sum(execution::par, values);
+		execution::set_thread_count(1);
+
+		if (sum(execution::par, values) != four_threads)
+			throw std::runtime_error("TEST_4 in 'tensor_reductions_testing_suit' failed!\n");
+
+		execution::set_thread_count(std::thread::hardware_concurrency());
+		execution::set_grain_size(std::size_t{ 1 } << 15);
+
+		std::cout << "\tTEST 4 PASSED.\n";
+	}
+
+	void RUN_ALL()
+	{
+		std::cout << "Running tensor reductions tests...\n\n";
+
+		TEST_1();
+		TEST_2();
+		TEST_3();
+		TEST_4();
+
+		std::cout << "\n";
+	}
+}
@@ -0,0 +1,170 @@
+#pragma once
+
+#include "../../../inc/tensor.hpp"
+#include "../../../inc/tensor_expressions.hpp"
+#include "../../../inc/tensor_matmul.hpp"
+
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+
+namespace tensor_reshape_testing_suit
+{
+	using namespace tensor_lib;
+
+	void TEST_1()
+	{
+		tensor<int, 3> t(2, 3, 4);
+		std::iota(t.begin(), t.end(), 0);
+
+		auto matrix = t.reshape<2>(6, 4);
+		auto flat = t.flatten();
+		auto expanded = t.unsqueeze<1>();
+		auto squeezed = expanded.squeeze<1>();
+
+		if (matrix.data() != t.data() || flat.data() != t.data() || expanded.data() != t.data() || squeezed.data() != t.data())
+			throw std::runtime_error("TEST_1 in 'tensor_reshape_testing_suit' failed!\n");
+
+		if (matrix.order_of_dimension(0) != 6 || matrix.order_of_dimension(1) != 4 || flat.size_of_current_tensor() != 24
+			|| expanded.order_of_dimension(1) != 1 || expanded.order_of_dimension(2) != 3 || squeezed.get_ranks()[2] != 4)
+			throw std::runtime_error("TEST_1 in 'tensor_reshape_testing_suit' failed!\n");
+
+		for (std::size_t i = 0; i < 2; i++)
+			for (std::size_t j = 0; j < 3; j++)
+				for (std::size_t k = 0; k < 4; k++)
+					if (matrix[i * 3 + j][k] != t[i][j][k] || flat[(i * 3 + j) * 4 + k] != t[i][j][k] || expanded[i][0][j][k] != t[i][j][k]
+						|| squeezed(i, j, k) != t[i][j][k])
+						throw std::runtime_error("TEST_1 in 'tensor_reshape_testing_suit' failed!\n");
+
+		// Writes through a view land in the tensor, views of views and copies of views share the same elements.
+		//
+		matrix[5][3] = -1;
+		flat[0] = -2;
+		auto copy = matrix;
+		auto rows = t[1].reshape<2>(4, 3);
+		rows[0][1] = -3;
+
+		if (t[1][2][3] != -1 || t[0][0][0] != -2 || copy[0][0] != -2 || t[1][0][1] != -3 || copy.data() != t.data())
+			throw std::runtime_error("TEST_1 in 'tensor_reshape_testing_suit' failed!\n");
+
+		const tensor<int, 3>& constant = t;
+		const auto constant_flat = constant.flatten();
+		const auto constant_row = constant[0].reshape<2>(2, 6);
+
+		if (constant_flat[23] != -1 || constant_row[1][5] != t[0][2][3])
+			throw std::runtime_error("TEST_1 in 'tensor_reshape_testing_suit' failed!\n");
+
+		std::cout << "\tTEST 1 PASSED.\n";
+	}
+
+	void TEST_2()
+	{
+		tensor<double, 3> t(2, 3, 4);
+		std::iota(t.begin(), t.end(), 1.0);
+		const tensor<double, 3> original = t;
+
+		// Views are tensor objects, they can be read by expressions and matmul and be assigned to.
+		//
+		auto matrix = t.reshape<2>(6, 4);
+		const tensor<double, 2> doubled = matrix + matrix;
+		const tensor<double, 2> product = matmul(t.reshape<2>(8, 3), original[0]);
+
+		matrix = matrix * 2.0;
+		t.flatten() += 1.0;
+
+		for (std::size_t i = 0; i < 24; i++)
+			if (doubled[i / 4][i % 4] != 2.0 * original.data()[i] || t.data()[i] != 2.0 * original.data()[i] + 1.0)
+				throw std::runtime_error("TEST_2 in 'tensor_reshape_testing_suit' failed!\n");
+
+		for (std::size_t i = 0; i < 8; i++)
+			for (std::size_t j = 0; j < 4; j++)
+			{
+				double sum = 0.0;
+
+				for (std::size_t k = 0; k < 3; k++)
+					sum += original.data()[i * 3 + k] * original[0][k][j];
+
+				if (product[i][j] != sum)
+					throw std::runtime_error("TEST_2 in 'tensor_reshape_testing_suit' failed!\n");
+			}
+
+		bool caught = false;
+
+		try { t.reshape<2>(5, 5); }
+		catch (const std::runtime_error&) { caught = true; }
+
+		if (!caught)
+			throw std::runtime_error("TEST_2 in 'tensor_reshape_testing_suit' failed!\n");
+
+		caught = false;
+
+		try { t.squeeze<0>(); }
+		catch (const std::runtime_error&) { caught = true; }
+
+		if (!caught)
+			throw std::runtime_error("TEST_2 in 'tensor_reshape_testing_suit' failed!\n");
+
+		std::cout << "\tTEST 2 PASSED.\n";
+	}
+
+	void TEST_3()
+	{
+		tensor<std::string, 2> words(2, 3);
+
+		for (std::size_t i = 0; i < 6; i++)
+			words.data()[i] = std::to_string(i);
+
+		// An rvalue gives its buffer to the reshaped tensor, no element is copied.
+		//
+		const std::string* buffer = words.data();
+		tensor<std::string, 3> cube = std::move(words).reshape<3>(3, 1, 2);
+
+		if (cube.data() != buffer || !words.empty() || cube[2][0][1] != "5" || cube.order_of_dimension(1) != 1)
+			throw std::runtime_error("TEST_3 in 'tensor_reshape_testing_suit' failed!\n");
+
+		tensor<std::string, 2> squeezed = std::move(cube).squeeze<1>();
+		tensor<std::string, 1> flat = std::move(squeezed).flatten();
+		tensor<std::string, 2> column = std::move(flat).unsqueeze<1>();
+
+		if (column.data() != buffer || column.order_of_dimension(0) != 6 || column.order_of_dimension(1) != 1 || column[4][0] != "4")
+			throw std::runtime_error("TEST_3 in 'tensor_reshape_testing_suit' failed!\n");
+
+		// The emptied tensor can be given a shape again.
+		//
+		words = tensor<std::string, 2>(1, 1);
+		words[0][0] = "x";
+		column.push_back(std::move(words).reshape<1>(1));
+
+		if (column.order_of_dimension(0) != 7 || column[6][0] != "x")
+			throw std::runtime_error("TEST_3 in 'tensor_reshape_testing_suit' failed!\n");
+
+		bool caught = false;
+
+		try { tensor<std::string, 1> wrong = std::move(column).reshape<1>(8); }
+		catch (const std::runtime_error&) { caught = true; }
+
+		if (!caught || column.size_of_current_tensor() != 7)
+			throw std::runtime_error("TEST_3 in 'tensor_reshape_testing_suit' failed!\n");
+
+		// Reshaping an empty tensor to sizes with a 0 among them gives a tensor with all its sizes 0, like any other empty tensor.
+		//
+		const tensor<std::string, 2> no_columns = tensor<std::string, 1>().reshape<2>(5, 0);
+
+		if (!no_columns.empty() || no_columns.order_of_dimension(0) != 0 || no_columns.order_of_dimension(1) != 0 || no_columns != tensor<std::string, 2>(5, 0))
+			throw std::runtime_error("TEST_3 in 'tensor_reshape_testing_suit' failed!\n");
+
+		std::cout << "\tTEST 3 PASSED.\n";
+	}
+
+	void RUN_ALL()
+	{
+		std::cout << "Running tensor reshape tests...\n\n";
+
+		TEST_1();
+		TEST_2();
+		TEST_3();
+
+		std::cout << "\n";
+	}
+}
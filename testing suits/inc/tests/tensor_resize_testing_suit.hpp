@@ -4,6 +4,7 @@
 
 #include <algorithm>
 #include <iostream>
+#include <string>
 
 namespace tensor_resize_testing_suit
 {
@@ -87,6 +88,100 @@ namespace tensor_resize_testing_suit
 		std::cout << "\tTEST 4 PASSED.\n";
 	}
 
+	void TEST_5()
+	{
+		tensor<int, 3> tsor(4, 5, 6);
+		const int* buffer = tsor.data();
+
+		// Smaller or equally sized shapes reuse the buffer.
+		//
+		tsor.resize(2, 3, 4);
+		tsor.resize(6, 5, 4);
+
+		if (tsor.data() != buffer || tsor.capacity() != 120 || tsor.size_of_current_tensor() != 120)
+			throw std::runtime_error("TEST_5 in 'tensor_resize_testing_suit' failed!\n");
+
+		tsor.resize(0, 1, 1);
+
+		if (!tsor.empty() || tsor.capacity() != 120)
+			throw std::runtime_error("TEST_5 in 'tensor_resize_testing_suit' failed!\n");
+
+		tsor.shrink_to_fit();
+
+		if (tsor.capacity() != 0 || tsor.data() != nullptr)
+			throw std::runtime_error("TEST_5 in 'tensor_resize_testing_suit' failed!\n");
+
+		tsor.reserve(1000);
+		buffer = tsor.data();
+		tsor.resize(10, 10, 10);
+
+		if (tsor.data() != buffer || tsor.capacity() != 1000)
+			throw std::runtime_error("TEST_5 in 'tensor_resize_testing_suit' failed!\n");
+
+		tsor.resize(2, 2, 2);
+		tsor(1, 1, 1) = 7;
+		tsor.shrink_to_fit();
+
+		if (tsor.capacity() != 8 || tsor(1, 1, 1) != 7)
+			throw std::runtime_error("TEST_5 in 'tensor_resize_testing_suit' failed!\n");
+
+		std::cout << "\tTEST 5 PASSED.\n";
+	}
+
+	void TEST_6()
+	{
+		tensor<int, 3> tsor(3, 4, 5);
+
+		for (std::size_t i = 0; i < 3; i++)
+			for (std::size_t j = 0; j < 4; j++)
+				for (std::size_t k = 0; k < 5; k++)
+					tsor(i, j, k) = static_cast<int>(100 * i + 10 * j + k);
+
+		// Changing every dimension keeps each element at its indices.
+		//
+		tsor.resize_preserve(2, 6, 3);
+
+		for (std::size_t i = 0; i < 2; i++)
+			for (std::size_t j = 0; j < 6; j++)
+				for (std::size_t k = 0; k < 3; k++)
+					if (tsor(i, j, k) != (j < 4 ? static_cast<int>(100 * i + 10 * j + k) : 0))
+						throw std::runtime_error("TEST_6 in 'tensor_resize_testing_suit' failed!\n");
+
+		// Growing the first dimension appends rows in place, doubling the capacity when it runs out.
+		//
+		tensor<float, 2> series(1, 8);
+		std::size_t reallocations = 0;
+		const float* buffer = series.data();
+
+		for (std::size_t rows = 2; rows <= 1000; rows++)
+		{
+			series.resize_preserve(rows, 8);
+			series(rows - 1, 7) = static_cast<float>(rows);
+
+			if (series.data() != buffer)
+			{
+				buffer = series.data();
+				++reallocations;
+			}
+		}
+
+		if (reallocations > 10 || series.capacity() < 8000 || series(999, 7) != 1000.0f || series(500, 7) != 501.0f)
+			throw std::runtime_error("TEST_6 in 'tensor_resize_testing_suit' failed!\n");
+
+		series.resize_preserve(10, 8);
+
+		if (series.data() != buffer || series(9, 7) != 10.0f || series.size_of_current_tensor() != 80)
+			throw std::runtime_error("TEST_6 in 'tensor_resize_testing_suit' failed!\n");
+
+		tensor<std::string, 1> words(2, std::string(50, 'w'));
+		words.resize_preserve(100);
+
+		if (words[1] != std::string(50, 'w') || !words[99].empty())
+			throw std::runtime_error("TEST_6 in 'tensor_resize_testing_suit' failed!\n");
+
+		std::cout << "\tTEST 6 PASSED.\n";
+	}
+
 	void RUN_ALL()
 	{
 		std::cout << "Running tensor resize tests...\n\n";
@@ -95,6 +190,8 @@ namespace tensor_resize_testing_suit
 		TEST_2();
 		TEST_3();
 		TEST_4();
+		TEST_5();
+		TEST_6();
 
 		std::cout << "\n";
 	}
@@ -0,0 +1,232 @@
+#pragma once
+
+#include "../../../inc/tensor.hpp"
+#include "../../../inc/tensor_execution.hpp"
+#include "../../../inc/tensor_matmul.hpp"
+#include "../../../inc/tensor_sparse.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace tensor_sparse_testing_suit
+{
+	using namespace tensor_lib;
+
+	void TEST_1()
+	{
+		tensor<int, 2> m(4, 5);
+		std::fill(m.begin(), m.end(), 0);
+		m[0][3] = 7;
+		m[2][0] = -2;
+		m[2][4] = 5;
+		m[3][1] = 1;
+
+		// Only the non-zero elements are stored, in row-major order, and dense tensors come back whole.
+		//
+		const sparse_tensor<int, 2> coordinates(m);
+		const csr_matrix<int> compressed(m);
+
+		const std::array<std::size_t, 8> expected_indices{ 0, 3, 2, 0, 2, 4, 3, 1 };
+		const std::array<std::size_t, 5> expected_offsets{ 0, 1, 1, 3, 4 };
+		const std::array<std::size_t, 4> expected_columns{ 3, 0, 4, 1 };
+		const std::array<int, 4> expected_values{ 7, -2, 5, 1 };
+
+		if (coordinates.nonzeros() != 4 || !std::ranges::equal(coordinates.indices(), expected_indices) || !std::ranges::equal(coordinates.values(), expected_values)
+			|| !std::ranges::equal(compressed.row_offsets(), expected_offsets) || !std::ranges::equal(compressed.column_indices(), expected_columns)
+			|| !std::ranges::equal(compressed.values(), expected_values))
+			throw std::runtime_error("TEST_1 in 'tensor_sparse_testing_suit' failed!\n");
+
+		if (coordinates.to_dense() != m || compressed.to_dense() != m || csr_matrix<int>(coordinates) != compressed || sparse_tensor<int, 2>(compressed) != coordinates)
+			throw std::runtime_error("TEST_1 in 'tensor_sparse_testing_suit' failed!\n");
+
+		for (std::size_t i = 0; i < 4; i++)
+			for (std::size_t j = 0; j < 5; j++)
+				if (coordinates(i, j) != m[i][j] || compressed(i, j) != m[i][j] || (coordinates.find(i, j) != nullptr) != (m[i][j] != 0))
+					throw std::runtime_error("TEST_1 in 'tensor_sparse_testing_suit' failed!\n");
+
+		// Subdimensions convert too, and stored elements can be changed in place.
+		//
+		tensor<float, 3> volume(3, 4, 5);
+		std::fill(volume.begin(), volume.end(), 0.0f);
+		volume[1][2][3] = 1.5f;
+
+		sparse_tensor<float, 2> plane(volume[1]);
+		*plane.find(2, 3) = 4.0f;
+
+		if (plane.nonzeros() != 1 || plane(2, 3) != 4.0f || plane.index(0) != std::array<std::size_t, 2>{ 2, 3 } || sparse_tensor<float, 2>(volume[0]).nonzeros() != 0)
+			throw std::runtime_error("TEST_1 in 'tensor_sparse_testing_suit' failed!\n");
+
+		std::cout << "\tTEST 1 PASSED.\n";
+	}
+
+	void TEST_2()
+	{
+		// Unsorted triplets, repeated ones are added up.
+		//
+		const std::vector<std::array<std::size_t, 3>> indices{ { 1, 2, 3 }, { 0, 0, 1 }, { 1, 2, 3 }, { 0, 4, 0 }, { 0, 0, 1 }, { 1, 2, 3 } };
+		const std::vector<double> values{ 1.0, 2.0, 3.0, 4.0, 5.0, 6.0 };
+
+		const sparse_tensor<double, 3> small({ 2, 5, 4 }, indices, values);
+
+		if (small.nonzeros() != 3 || small(1, 2, 3) != 10.0 || small(0, 0, 1) != 7.0 || small(0, 4, 0) != 4.0 || small(1, 1, 1) != 0.0
+			|| small.index(0) != std::array<std::size_t, 3>{ 0, 0, 1 } || small.index(2) != std::array<std::size_t, 3>{ 1, 2, 3 })
+			throw std::runtime_error("TEST_2 in 'tensor_sparse_testing_suit' failed!\n");
+
+		// Parallel construction sorts and merges slices, and gives the same tensor as the sequential one.
+		//
+		std::mt19937 generator(7);
+		std::vector<std::array<std::size_t, 2>> random_indices(200000);
+		std::vector<float> random_values(random_indices.size());
+
+		for (std::size_t n = 0; n < random_indices.size(); n++)
+		{
+			random_indices[n] = { generator() % 300, generator() % 500 };
+			random_values[n] = static_cast<float>(generator() % 8);
+		}
+
+		const sparse_tensor<float, 2> sequential({ 300, 500 }, random_indices, random_values);
+		const sparse_tensor<float, 2> parallel(execution::par, { 300, 500 }, random_indices, random_values);
+		const csr_matrix<float> compressed(execution::par, { 300, 500 }, random_indices, random_values);
+
+		tensor<float, 2> dense(300, 500);
+		std::fill(dense.begin(), dense.end(), 0.0f);
+
+		for (std::size_t n = 0; n < random_indices.size(); n++)
+			dense[random_indices[n][0]][random_indices[n][1]] += random_values[n];
+
+		if (parallel != sequential || sequential.to_dense() != dense || compressed.to_dense() != dense || csr_matrix<float>(sequential) != compressed)
+			throw std::runtime_error("TEST_2 in 'tensor_sparse_testing_suit' failed!\n");
+
+		// Indices out of range and missing values are errors.
+		//
+		bool caught = false;
+
+		try
+		{
+			sparse_tensor<double, 3> wrong({ 2, 5, 3 }, indices, values);
+		}
+		catch (const std::runtime_error&)
+		{
+			caught = true;
+		}
+
+		if (!caught)
+			throw std::runtime_error("TEST_2 in 'tensor_sparse_testing_suit' failed!\n");
+
+		caught = false;
+
+		try
+		{
+			csr_matrix<float> wrong(execution::par, { 300, 500 }, random_indices, std::span<const float>(random_values).first(10));
+		}
+		catch (const std::runtime_error&)
+		{
+			caught = true;
+		}
+
+		if (!caught)
+			throw std::runtime_error("TEST_2 in 'tensor_sparse_testing_suit' failed!\n");
+
+		std::cout << "\tTEST 2 PASSED.\n";
+	}
+
+	void TEST_3()
+	{
+		tensor<double, 2> a(40, 30);
+		std::fill(a.begin(), a.end(), 0.0);
+
+		for (std::size_t n = 0; n < 40; n++)
+			a[n][(n * 7) % 30] = static_cast<double>(n + 1);
+
+		a[3][0] = -1.0;
+
+		const csr_matrix<double> sparse_a(a);
+
+		tensor<double, 2> b(30, 20);
+		tensor<double, 1> x(30);
+		tensor<double, 2> c(10, 40);
+		std::iota(b.begin(), b.end(), 0.0);
+		std::iota(x.begin(), x.end(), 1.0);
+		std::iota(c.begin(), c.end(), -5.0);
+
+		// Sparse products match the dense ones, whatever the policy.
+		//
+		const tensor<double, 2> ab = matmul(a, b);
+		const tensor<double, 2> ca = matmul(c, a);
+		const tensor<double, 2> ax = matmul(a, x.reshape<2>(30, 1));
+
+		if (matmul(sparse_a, b) != ab || matmul(execution::par, sparse_a, b) != ab || matmul(c, sparse_a) != ca || matmul(execution::par, c, sparse_a) != ca)
+			throw std::runtime_error("TEST_3 in 'tensor_sparse_testing_suit' failed!\n");
+
+		const tensor<double, 1> y = matmul(execution::par, sparse_a, x);
+
+		for (std::size_t i = 0; i < 40; i++)
+			if (y(i) != ax[i][0])
+				throw std::runtime_error("TEST_3 in 'tensor_sparse_testing_suit' failed!\n");
+
+		bool caught = false;
+
+		try
+		{
+			matmul(sparse_a, c);
+		}
+		catch (const std::runtime_error&)
+		{
+			caught = true;
+		}
+
+		if (!caught)
+			throw std::runtime_error("TEST_3 in 'tensor_sparse_testing_suit' failed!\n");
+
+		// Element-wise operations with dense tensors: sums are dense, products keep the sparsity.
+		//
+		const sparse_tensor<double, 2> sparse_coordinates(a);
+
+		tensor<double, 2> d(40, 30);
+		std::iota(d.begin(), d.end(), 1.0);
+
+		if (sparse_a + d != tensor<double, 2>(a + d) || d - sparse_coordinates != tensor<double, 2>(d - a) || sparse_coordinates - d != tensor<double, 2>(a - d))
+			throw std::runtime_error("TEST_3 in 'tensor_sparse_testing_suit' failed!\n");
+
+		const csr_matrix<double> product = d * sparse_a;
+		const sparse_tensor<double, 2> quotient = sparse_coordinates / d;
+		const csr_matrix<double> scaled = -(2.0 * sparse_a / 4.0);
+
+		if (product.nonzeros() != sparse_a.nonzeros() || product.to_dense() != tensor<double, 2>(a * d) || quotient.to_dense() != tensor<double, 2>(a / d)
+			|| scaled.to_dense() != tensor<double, 2>(a * -0.5))
+			throw std::runtime_error("TEST_3 in 'tensor_sparse_testing_suit' failed!\n");
+
+		caught = false;
+
+		try
+		{
+			tensor<double, 2> wrong = sparse_a + b;
+		}
+		catch (const std::runtime_error&)
+		{
+			caught = true;
+		}
+
+		if (!caught)
+			throw std::runtime_error("TEST_3 in 'tensor_sparse_testing_suit' failed!\n");
+
+		std::cout << "\tTEST 3 PASSED.\n";
+	}
+
+	void RUN_ALL()
+	{
+		std::cout << "Running tensor sparse tests...\n\n";
+
+		TEST_1();
+		TEST_2();
+		TEST_3();
+
+		std::cout << "\n";
+	}
+}
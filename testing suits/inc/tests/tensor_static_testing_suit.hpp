@@ -0,0 +1,131 @@
+#pragma once
+
+#include "../../../inc/tensor.hpp"
+#include "../../../inc/tensor_expressions.hpp"
+#include "../../../inc/tensor_matmul.hpp"
+#include "../../../inc/tensor_reductions.hpp"
+#include "../../../inc/tensor_static.hpp"
+
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+
+namespace tensor_static_testing_suit
+{
+	using namespace tensor_lib;
+
+	// The elements live inline and the shape is only in the type.
+	//
+	static_assert(sizeof(static_matrix<float, 4, 4>) == 16 * sizeof(float));
+	static_assert(sizeof(static_tensor<double, 3, 3, 3>) == 27 * sizeof(double));
+	static_assert(std::is_trivially_copyable_v<static_matrix<float, 4, 4>>);
+	static_assert(tensor_object<static_tensor<int, 2, 5>> && tensor_object<static_subdimension<const int, 5>>);
+
+	static_assert([]()
+	{
+		static_matrix<int, 3, 3> m = { { 1, 2, 3 }, { 4, 5, 6 }, { 7, 8, 9 } };
+		m[1][2] = 60;
+		return m[1][2] + m(2, 0) + static_matrix<int, 3, 3>::size_of_subdimension(1);
+	}() == 70);
+
+	static_assert([]()
+	{
+		const static_matrix<int, 2, 2> rotation = { { 0, -1 }, { 1, 0 } };
+		const auto half_turn = matmul(rotation, rotation);
+		return half_turn(0, 0) == -1 && half_turn(0, 1) == 0 && half_turn(1, 0) == 0 && half_turn(1, 1) == -1;
+	}());
+
+	void TEST_1()
+	{
+		static_tensor<int, 2, 3, 4> cube;
+		std::iota(cube.begin(), cube.end(), 0);
+
+		for (std::size_t i = 0; i < 2; i++)
+			for (std::size_t j = 0; j < 3; j++)
+				for (std::size_t k = 0; k < 4; k++)
+					if (cube[i][j][k] != static_cast<int>(i * 12 + j * 4 + k) || cube(i, j, k) != cube[i][j][k])
+						throw std::runtime_error("TEST_1 in 'tensor_static_testing_suit' failed!\n");
+
+		const auto& const_cube = cube;
+
+		if (const_cube[1][2][3] != 23 || cube.order_of_dimension(1) != 3 || cube.size_of_current_tensor() != 24 || cube.empty())
+			throw std::runtime_error("TEST_1 in 'tensor_static_testing_suit' failed!\n");
+
+		cube[1] = static_tensor<int, 3, 4>(7);
+		cube[0][1] = cube[1][2];
+
+		if (cube(0, 1, 3) != 7 || cube(1, 0, 0) != 7 || cube(0, 0, 3) != 3)
+			throw std::runtime_error("TEST_1 in 'tensor_static_testing_suit' failed!\n");
+
+		bool thrown = false;
+
+		try
+		{
+			static_cast<void>(static_matrix<int, 2, 2>{ { 1, 2, 3 }, { 4, 5, 6 } });
+		}
+		catch (const std::runtime_error&)
+		{
+			thrown = true;
+		}
+
+		if (!thrown)
+			throw std::runtime_error("TEST_1 in 'tensor_static_testing_suit' failed!\n");
+
+		std::cout << "\tTEST 1 PASSED.\n";
+	}
+
+	void TEST_2()
+	{
+		// Static tensors are tensor objects: they mix with dynamic tensors in expressions, comparisons, matmul and reductions.
+		//
+		const static_matrix<float, 2, 3> a = { { 1.0f, 2.0f, 3.0f }, { 4.0f, 5.0f, 6.0f } };
+		const matrix<float> b = { { 1.0f, 1.0f, 1.0f }, { 2.0f, 2.0f, 2.0f } };
+
+		static_matrix<float, 2, 3> c = a * 2.0f + b;
+		c += a;
+
+		const matrix<float> expected = { { 4.0f, 7.0f, 10.0f }, { 14.0f, 17.0f, 20.0f } };
+
+		if (!(c == expected) || !(expected == c))
+			throw std::runtime_error("TEST_2 in 'tensor_static_testing_suit' failed!\n");
+
+		const static_matrix<float, 3, 2> d(1.0f);
+		const auto product = matmul(a, d);
+		const auto dynamic_product = matmul(b, d);
+
+		if (product(0, 0) != 6.0f || product(1, 1) != 15.0f || dynamic_product[1][0] != 6.0f || sum(c) != 72.0f || sum(c, 0)[2] != 30.0f)
+			throw std::runtime_error("TEST_2 in 'tensor_static_testing_suit' failed!\n");
+
+		const static_matrix<float, 2, 3> from_dynamic(expected);
+
+		if (!(from_dynamic == expected))
+			throw std::runtime_error("TEST_2 in 'tensor_static_testing_suit' failed!\n");
+
+		bool thrown = false;
+
+		try
+		{
+			static_matrix<float, 3, 3> wrong;
+			wrong = b;
+		}
+		catch (const std::runtime_error&)
+		{
+			thrown = true;
+		}
+
+		if (!thrown)
+			throw std::runtime_error("TEST_2 in 'tensor_static_testing_suit' failed!\n");
+
+		std::cout << "\tTEST 2 PASSED.\n";
+	}
+
+	void RUN_ALL()
+	{
+		std::cout << "Running tensor static tests...\n\n";
+
+		TEST_1();
+		TEST_2();
+
+		std::cout << "\n";
+	}
+}
@@ -0,0 +1,154 @@
+#pragma once
+
+#include "../../../inc/tensor.hpp"
+#include "../../../inc/tensor_io.hpp"
+#include "../../../inc/tensor_reductions.hpp"
+#include "../../../inc/tensor_stream.hpp"
+
+#include <filesystem>
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+namespace tensor_stream_testing_suit
+{
+	using namespace tensor_lib;
+
+	void TEST_1()
+	{
+		const std::filesystem::path path = std::filesystem::temp_directory_path() / "tensor_stream_testing_suit.tnsr";
+
+		tensor<int, 3> cube(10, 3, 2);
+		std::iota(cube.begin(), cube.end(), 0);
+		save(path, cube);
+
+		// Slabs of 4, 4 and 2 rows, in order, each a rank 3 subdimension.
+		//
+		tensor_stream<int, 3> stream(path, 4);
+		std::vector<int> values;
+		std::vector<std::size_t> rows, first_rows;
+
+		for (auto slab : stream)
+		{
+			rows.push_back(slab.order_of_dimension(0));
+			first_rows.push_back(stream.current_row());
+			values.insert(values.end(), slab.begin(), slab.end());
+
+			if (slab(slab.order_of_dimension(0) - 1, 2, 1) != cube(stream.current_row() + slab.order_of_dimension(0) - 1, 2, 1))
+				throw std::runtime_error("TEST_1 in 'tensor_stream_testing_suit' failed!\n");
+		}
+
+		if (rows != std::vector<std::size_t>{ 4, 4, 2 } || first_rows != std::vector<std::size_t>{ 0, 4, 8 } || !std::equal(values.begin(), values.end(), cube.begin(), cube.end()))
+			throw std::runtime_error("TEST_1 in 'tensor_stream_testing_suit' failed!\n");
+
+		// A single slab bigger than the tensor, and reductions over slabs.
+		//
+		int total = 0;
+
+		for (auto slab : tensor_stream<int, 3>(path, 100))
+			total += sum(slab);
+
+		if (total != sum(cube))
+			throw std::runtime_error("TEST_1 in 'tensor_stream_testing_suit' failed!\n");
+
+		bool thrown = false;
+
+		try
+		{
+			tensor_stream<float, 3> wrong_type(path, 4);
+		}
+		catch (const std::runtime_error&)
+		{
+			thrown = true;
+		}
+
+		std::filesystem::remove(path);
+
+		if (!thrown)
+			throw std::runtime_error("TEST_1 in 'tensor_stream_testing_suit' failed!\n");
+
+		std::cout << "\tTEST 1 PASSED.\n";
+	}
+
+	void TEST_2()
+	{
+		const std::filesystem::path path = std::filesystem::temp_directory_path() / "tensor_stream_testing_suit.tnsr";
+
+		tensor<double, 2> expected(25, 5);
+		std::iota(expected.begin(), expected.end(), 0.0);
+
+		// Slabs filled in place, then whole tensors split across slabs.
+		//
+		{
+			tensor_stream_writer<double, 2> out(path, 8, 5);
+
+			for (std::size_t row = 0; row < 10; row += 5)
+			{
+				auto slab = out.slab();
+
+				for (std::size_t index = 0; index < 5 * 5; index++)
+					slab.data()[index] = static_cast<double>(row * 5 + index);
+
+				out.commit(5);
+			}
+
+			tensor<double, 2> rest(15, 5);
+			std::iota(rest.begin(), rest.end(), 50.0);
+			out.write(rest);
+
+			if (out.rows() != 25)
+				throw std::runtime_error("TEST_2 in 'tensor_stream_testing_suit' failed!\n");
+		}
+
+		const tensor<double, 2> written = load<double, 2>(path);
+
+		if (!(written == expected))
+			throw std::runtime_error("TEST_2 in 'tensor_stream_testing_suit' failed!\n");
+
+		std::filesystem::remove(path);
+
+		std::cout << "\tTEST 2 PASSED.\n";
+	}
+
+	void TEST_3()
+	{
+		// A file cut short fails on the slab that can't be read, the exception of the background read reaches the loop.
+		//
+		const std::filesystem::path path = std::filesystem::temp_directory_path() / "tensor_stream_testing_suit.tnsr";
+
+		save(path, tensor<float, 2>(100, 10, 1.0f));
+		std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+
+		std::size_t slabs = 0;
+		bool thrown = false;
+
+		try
+		{
+			for (auto slab : tensor_stream<float, 2>(path, 30))
+				slabs += slab(0, 0) == 1.0f;
+		}
+		catch (const std::runtime_error&)
+		{
+			thrown = true;
+		}
+
+		std::filesystem::remove(path);
+
+		if (!thrown || slabs != 3)
+			throw std::runtime_error("TEST_3 in 'tensor_stream_testing_suit' failed!\n");
+
+		std::cout << "\tTEST 3 PASSED.\n";
+	}
+
+	void RUN_ALL()
+	{
+		std::cout << "Running tensor stream tests...\n\n";
+
+		TEST_1();
+		TEST_2();
+		TEST_3();
+
+		std::cout << "\n";
+	}
+}
@@ -8,6 +8,29 @@
 #include "tensor_iteration_testing_suit.hpp"
 #include "tensor_replace_testing_suit.hpp"
 #include "tensor_exceptions_testing_suit.hpp"
+#include "tensor_expressions_testing_suit.hpp"
+#include "tensor_kernels_testing_suit.hpp"
+#include "tensor_matmul_testing_suit.hpp"
+#include "tensor_execution_testing_suit.hpp"
+#include "tensor_reductions_testing_suit.hpp"
+#include "tensor_view_testing_suit.hpp"
+#include "tensor_static_testing_suit.hpp"
+#include "tensor_access_testing_suit.hpp"
+#include "tensor_allocators_testing_suit.hpp"
+#include "tensor_copy_semantics_testing_suit.hpp"
+#include "tensor_append_testing_suit.hpp"
+#include "tensor_io_testing_suit.hpp"
+#include "tensor_mapped_testing_suit.hpp"
+#include "tensor_npy_testing_suit.hpp"
+#include "tensor_stream_testing_suit.hpp"
+#include "tensor_einsum_testing_suit.hpp"
+#include "tensor_broadcasting_testing_suit.hpp"
+#include "tensor_reshape_testing_suit.hpp"
+#include "tensor_layout_testing_suit.hpp"
+#include "tensor_tiled_testing_suit.hpp"
+#include "tensor_morton_testing_suit.hpp"
+#include "tensor_sparse_testing_suit.hpp"
+#include "tensor_block_sparse_testing_suit.hpp"
 
 #include <iostream>
 #include <type_traits>
@@ -26,5 +49,28 @@ namespace tensor_testing_suit
 		tensor_resize_testing_suit::RUN_ALL();
 		tensor_iteration_testing_suit::RUN_ALL();
 		tensor_exceptions_testing_suit::RUN_ALL();
+		tensor_expressions_testing_suit::RUN_ALL();
+		tensor_kernels_testing_suit::RUN_ALL();
+		tensor_matmul_testing_suit::RUN_ALL();
+		tensor_execution_testing_suit::RUN_ALL();
+		tensor_reductions_testing_suit::RUN_ALL();
+		tensor_view_testing_suit::RUN_ALL();
+		tensor_static_testing_suit::RUN_ALL();
+		tensor_access_testing_suit::RUN_ALL();
+		tensor_allocators_testing_suit::RUN_ALL();
+		tensor_copy_semantics_testing_suit::RUN_ALL();
+		tensor_append_testing_suit::RUN_ALL();
+		tensor_io_testing_suit::RUN_ALL();
+		tensor_mapped_testing_suit::RUN_ALL();
+		tensor_npy_testing_suit::RUN_ALL();
+		tensor_stream_testing_suit::RUN_ALL();
+		tensor_einsum_testing_suit::RUN_ALL();
+		tensor_broadcasting_testing_suit::RUN_ALL();
+		tensor_reshape_testing_suit::RUN_ALL();
+		tensor_layout_testing_suit::RUN_ALL();
+		tensor_tiled_testing_suit::RUN_ALL();
+		tensor_morton_testing_suit::RUN_ALL();
+		tensor_sparse_testing_suit::RUN_ALL();
+		tensor_block_sparse_testing_suit::RUN_ALL();
 	}
 }
\ No newline at end of file
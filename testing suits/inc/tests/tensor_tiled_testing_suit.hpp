@@ -0,0 +1,182 @@
+#pragma once
+
+#include "../../../inc/tensor.hpp"
+#include "../../../inc/tensor_execution.hpp"
+#include "../../../inc/tensor_layout.hpp"
+#include "../../../inc/tensor_reductions.hpp"
+#include "../../../inc/tensor_tiled.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+namespace tensor_tiled_testing_suit
+{
+	using namespace tensor_lib;
+
+	void TEST_1()
+	{
+		// A 5x5 matrix in 2x2 tiles: four whole tiles, four cut to 2x1 or 1x2 on the edges and a 1x1 one in the corner.
+		//
+		tensor<int, 2> m(5, 5);
+		std::iota(m.begin(), m.end(), 0);
+
+		const tiled_matrix<int, 2, 2> tiled(m);
+
+		const std::array<int, 25> expected{ 0, 1, 5, 6, 2, 3, 7, 8, 4, 9,
+											10, 11, 15, 16, 12, 13, 17, 18, 14, 19,
+											20, 21, 22, 23, 24 };
+
+		if (!std::equal(expected.begin(), expected.end(), tiled.data()) || tiled.size_of_current_tensor() != 25 || tiled.mapping().tile_count() != 9)
+			throw std::runtime_error("TEST_1 in 'tensor_tiled_testing_suit' failed!\n");
+
+		for (std::size_t i = 0; i < 5; i++)
+			for (std::size_t j = 0; j < 5; j++)
+				if (tiled(i, j) != m[i][j] || tiled[i][j] != m[i][j])
+					throw std::runtime_error("TEST_1 in 'tensor_tiled_testing_suit' failed!\n");
+
+		// Every element has its own place in the buffer, whatever the sizes.
+		//
+		tiled_cube<int, 4, 4, 4> cube(5, 9, 7);
+		std::vector<int> seen(cube.size_of_current_tensor(), 0);
+
+		for (std::size_t i = 0; i < 5; i++)
+			for (std::size_t j = 0; j < 9; j++)
+				for (std::size_t k = 0; k < 7; k++)
+					seen[cube.mapping()(i, j, k)]++;
+
+		if (std::count(seen.begin(), seen.end(), 1) != static_cast<std::ptrdiff_t>(seen.size()) || cube.mapping().tile_count() != 2 * 3 * 2)
+			throw std::runtime_error("TEST_1 in 'tensor_tiled_testing_suit' failed!\n");
+
+		// Round trips through row-major, and a tiled tensor growing around its elements.
+		//
+		tensor<int, 3> volume(5, 9, 7);
+		std::iota(volume.begin(), volume.end(), 0);
+
+		cube = tiled_cube<int, 4, 4, 4>(volume);
+
+		if (relayout<layout_right>(cube) != volume || relayout<layout_right>(tiled) != m)
+			throw std::runtime_error("TEST_1 in 'tensor_tiled_testing_suit' failed!\n");
+
+		cube.resize_preserve(6, 9, 8);
+
+		for (std::size_t i = 0; i < 6; i++)
+			for (std::size_t j = 0; j < 9; j++)
+				for (std::size_t k = 0; k < 8; k++)
+					if (cube(i, j, k) != ((i < 5 && k < 7) ? volume[i][j][k] : 0))
+						throw std::runtime_error("TEST_1 in 'tensor_tiled_testing_suit' failed!\n");
+
+		std::cout << "\tTEST 1 PASSED.\n";
+	}
+
+	void TEST_2()
+	{
+		tensor<int, 2> m(10, 7);
+		std::iota(m.begin(), m.end(), 0);
+
+		tiled_matrix<int, 4, 4> tiled(m);
+
+		// Tiles come in storage order, each knows where it starts and holds the elements of the tensor from there.
+		//
+		std::size_t count = 0;
+		std::size_t elements = 0;
+		const int* expected_data = tiled.data();
+
+		for (auto tile : tiled.tiles())
+		{
+			if (tile.origin(0) != (count / 2) * 4 || tile.origin(1) != (count % 2) * 4 || &tile[0][0] != expected_data)
+				throw std::runtime_error("TEST_2 in 'tensor_tiled_testing_suit' failed!\n");
+
+			for (std::size_t i = 0; i < tile.order_of_dimension(0); i++)
+				for (std::size_t j = 0; j < tile.order_of_dimension(1); j++)
+					if (tile[i][j] != m[tile.origin(0) + i][tile.origin(1) + j])
+						throw std::runtime_error("TEST_2 in 'tensor_tiled_testing_suit' failed!\n");
+
+			count++;
+			elements += tile.size_of_current_tensor();
+			expected_data += tile.size_of_current_tensor();
+		}
+
+		if (count != 6 || elements != 70 || tiled.tiles()[5].order_of_dimension(0) != 2 || tiled.tiles()[5].order_of_dimension(1) != 3)
+			throw std::runtime_error("TEST_2 in 'tensor_tiled_testing_suit' failed!\n");
+
+		// Tiles are tensor objects, expressions and reductions work on them and write through to the tensor.
+		//
+		for (auto tile : tiled.tiles())
+			tile += tile;
+
+		const auto& constant = tiled;
+		int total = 0;
+
+		for (const auto tile : constant.tiles())
+			total += sum(tile);
+
+		if (total != 2 * sum(m))
+			throw std::runtime_error("TEST_2 in 'tensor_tiled_testing_suit' failed!\n");
+
+		for (std::size_t i = 0; i < 10; i++)
+			for (std::size_t j = 0; j < 7; j++)
+				if (tiled(i, j) != 2 * m[i][j])
+					throw std::runtime_error("TEST_2 in 'tensor_tiled_testing_suit' failed!\n");
+
+		std::cout << "\tTEST 2 PASSED.\n";
+	}
+
+	void TEST_3()
+	{
+		tensor<float, 3> volume(20, 18, 33);
+		std::iota(volume.begin(), volume.end(), 0.0f);
+
+		tiled_cube<float, 8, 8, 8> sequential(volume);
+		tiled_cube<float, 8, 8, 8> parallel(volume);
+
+		// A per tile kernel using the position of the tile.
+		//
+		const auto kernel = [](auto& tile)
+		{
+			const float shift = static_cast<float>(tile.origin(0) + tile.origin(1) + tile.origin(2));
+
+			for (float& element : tile)
+				element = element * 0.5f + shift;
+		};
+
+		for_each_tile(sequential, kernel);
+		for_each_tile(execution::par, parallel, kernel);
+
+		if (sequential != parallel)
+			throw std::runtime_error("TEST_3 in 'tensor_tiled_testing_suit' failed!\n");
+
+		for (std::size_t i = 0; i < 20; i++)
+			for (std::size_t j = 0; j < 18; j++)
+				for (std::size_t k = 0; k < 33; k++)
+					if (sequential(i, j, k) != volume[i][j][k] * 0.5f + static_cast<float>(i / 8 * 8 + j / 8 * 8 + k / 8 * 8))
+						throw std::runtime_error("TEST_3 in 'tensor_tiled_testing_suit' failed!\n");
+
+		// Empty tensors have no tiles.
+		//
+		tiled_matrix<int> empty;
+		std::size_t visited = 0;
+
+		for_each_tile(execution::par, empty, [&visited](auto&) { visited++; });
+
+		if (visited != 0 || empty.tiles().size() != 0 || empty.tiles().begin() != empty.tiles().end())
+			throw std::runtime_error("TEST_3 in 'tensor_tiled_testing_suit' failed!\n");
+
+		std::cout << "\tTEST 3 PASSED.\n";
+	}
+
+	void RUN_ALL()
+	{
+		std::cout << "Running tensor tiled tests...\n\n";
+
+		TEST_1();
+		TEST_2();
+		TEST_3();
+
+		std::cout << "\n";
+	}
+}
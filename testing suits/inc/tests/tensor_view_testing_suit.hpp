@@ -0,0 +1,189 @@
+#pragma once
+
+#include "../../../inc/tensor.hpp"
+#include "../../../inc/tensor_view.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <iterator>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+namespace tensor_view_testing_suit
+{
+	using namespace tensor_lib;
+
+	static_assert(std::forward_iterator<tensor_view<float, 3>::iterator>);
+
+	void TEST_1()
+	{
+		tensor<int, 3> cube(2, 3, 4);
+		std::iota(cube.begin(), cube.end(), 0);
+
+		const auto dense = view(cube);
+		const auto transposed = transpose(cube);
+		const auto permuted = permute<1, 0, 2>(cube);
+
+		if (!dense.is_contiguous() || transposed.is_contiguous() || permuted.is_contiguous())
+			throw std::runtime_error("TEST_1 in 'tensor_view_testing_suit' failed!\n");
+
+		if (transposed.extent(0) != 4 || transposed.extent(1) != 3 || transposed.extent(2) != 2 || permuted.extent(0) != 3 || permuted.extent(1) != 2)
+			throw std::runtime_error("TEST_1 in 'tensor_view_testing_suit' failed!\n");
+
+		for (std::size_t i = 0; i < 2; i++)
+			for (std::size_t j = 0; j < 3; j++)
+				for (std::size_t k = 0; k < 4; k++)
+					if (dense(i, j, k) != cube[i][j][k] || transposed(k, j, i) != cube[i][j][k] || permuted(j, i, k) != cube[i][j][k] || permuted[j][i][k] != cube[i][j][k])
+						throw std::runtime_error("TEST_1 in 'tensor_view_testing_suit' failed!\n");
+
+		// Views share the buffer of the tensor.
+		//
+		transposed(3, 2, 1) = -1;
+
+		if (cube[1][2][3] != -1)
+			throw std::runtime_error("TEST_1 in 'tensor_view_testing_suit' failed!\n");
+
+		// The strided iterator walks the view in row-major order.
+		//
+		std::vector<int> walked(transposed.begin(), transposed.end());
+		std::vector<int> expected;
+
+		for (std::size_t k = 0; k < 4; k++)
+			for (std::size_t j = 0; j < 3; j++)
+				for (std::size_t i = 0; i < 2; i++)
+					expected.push_back(cube[i][j][k]);
+
+		if (walked != expected)
+			throw std::runtime_error("TEST_1 in 'tensor_view_testing_suit' failed!\n");
+
+		std::cout << "\tTEST 1 PASSED.\n";
+	}
+
+	void TEST_2()
+	{
+		tensor<int, 2> matrix(5, 7);
+		std::iota(matrix.begin(), matrix.end(), 0);
+
+		const auto every_other_column = slice(matrix, 1, 1, 7, 2);
+
+		if (every_other_column.extent(0) != 5 || every_other_column.extent(1) != 3)
+			throw std::runtime_error("TEST_2 in 'tensor_view_testing_suit' failed!\n");
+
+		for (std::size_t i = 0; i < 5; i++)
+			for (std::size_t j = 0; j < 3; j++)
+				if (every_other_column(i, j) != matrix[i][1 + 2 * j])
+					throw std::runtime_error("TEST_2 in 'tensor_view_testing_suit' failed!\n");
+
+		// Whole rows of a row-major tensor stay dense, a single column of a matrix has extent 1 in its last axis and is strided.
+		//
+		if (!slice(matrix, 0, 1, 4).is_contiguous() || slice(matrix, 1, 2, 3).is_contiguous() || !slice(matrix, 0, 2, 3).is_contiguous())
+			throw std::runtime_error("TEST_2 in 'tensor_view_testing_suit' failed!\n");
+
+		const auto diag = diagonal(matrix);
+
+		if (diag.extent(0) != 5)
+			throw std::runtime_error("TEST_2 in 'tensor_view_testing_suit' failed!\n");
+
+		for (std::size_t i = 0; i < 5; i++)
+			if (diag[i] != matrix[i][i])
+				throw std::runtime_error("TEST_2 in 'tensor_view_testing_suit' failed!\n");
+
+		// Views of views compose their strides.
+		//
+		const auto reversed_slice = view(matrix).transpose().slice(0, 0, 7, 3).slice(1, 1, 5, 2);
+
+		for (std::size_t i = 0; i < 3; i++)
+			for (std::size_t j = 0; j < 2; j++)
+				if (reversed_slice(i, j) != matrix[1 + 2 * j][3 * i])
+					throw std::runtime_error("TEST_2 in 'tensor_view_testing_suit' failed!\n");
+
+		if (!slice(matrix, 0, 3, 3).empty())
+			throw std::runtime_error("TEST_2 in 'tensor_view_testing_suit' failed!\n");
+
+		bool thrown = false;
+
+		try
+		{
+			static_cast<void>(slice(matrix, 1, 2, 8));
+		}
+		catch (const std::runtime_error&)
+		{
+			thrown = true;
+		}
+
+		if (!thrown)
+			throw std::runtime_error("TEST_2 in 'tensor_view_testing_suit' failed!\n");
+
+		std::cout << "\tTEST 2 PASSED.\n";
+	}
+
+	void TEST_3()
+	{
+		tensor<float, 2> matrix(40, 30);
+		std::iota(matrix.begin(), matrix.end(), 0.0f);
+
+		const tensor<float, 2>& const_matrix = matrix;
+		const tensor_view<const float, 2> transposed = transpose(const_matrix);
+		const auto copy = transposed.to_tensor();
+
+		if (copy.order_of_dimension(0) != 30 || copy.order_of_dimension(1) != 40)
+			throw std::runtime_error("TEST_3 in 'tensor_view_testing_suit' failed!\n");
+
+		for (std::size_t i = 0; i < 30; i++)
+			for (std::size_t j = 0; j < 40; j++)
+				if (copy[i][j] != matrix[j][i])
+					throw std::runtime_error("TEST_3 in 'tensor_view_testing_suit' failed!\n");
+
+		if (!(view(matrix).to_tensor() == matrix))
+			throw std::runtime_error("TEST_3 in 'tensor_view_testing_suit' failed!\n");
+
+		// Writing through views: a strided fill, a transposed assignment and a dense assignment.
+		//
+		tensor<float, 2> result(30, 40);
+
+		slice(result, 1, 0, 40, 2).fill(-1.0f);
+
+		for (std::size_t i = 0; i < 30; i++)
+			for (std::size_t j = 0; j < 40; j++)
+				if ((j % 2 == 0) != (result[i][j] == -1.0f))
+					throw std::runtime_error("TEST_3 in 'tensor_view_testing_suit' failed!\n");
+
+		transpose(result).assign(matrix);
+
+		if (!(result == copy))
+			throw std::runtime_error("TEST_3 in 'tensor_view_testing_suit' failed!\n");
+
+		view(result).assign(transposed);
+
+		if (!(result == copy))
+			throw std::runtime_error("TEST_3 in 'tensor_view_testing_suit' failed!\n");
+
+		bool thrown = false;
+
+		try
+		{
+			view(result).assign(matrix);
+		}
+		catch (const std::runtime_error&)
+		{
+			thrown = true;
+		}
+
+		if (!thrown)
+			throw std::runtime_error("TEST_3 in 'tensor_view_testing_suit' failed!\n");
+
+		std::cout << "\tTEST 3 PASSED.\n";
+	}
+
+	void RUN_ALL()
+	{
+		std::cout << "Running tensor view tests...\n\n";
+
+		TEST_1();
+		TEST_2();
+		TEST_3();
+
+		std::cout << "\n";
+	}
+}